@@ -291,18 +291,18 @@ int main() {
   // edgeDetection->configure("ratio", "2.5");
 
   // === 1. 创建融合策略（外部传入）===
-  auto fusion_strategy =
-      [](const std::vector<CapturedFrame>& frames) -> CapturedFrame {
+  auto fusion_strategy = [](const SyncedFrameSet& set) -> CapturedFrame {
     // TODO(cmx): 根据需求的变化，前端机只负责采集一个相机图像并且处理
     // 所以说，我们需要做的仅仅就是通过改变一个相机的ROI,或者是丢弃多余的部分来达到(图像融合的操作)
     // 每一台前端机是单独发给服务器的
-    if (frames.size() != 2) {
+    // 不完整的组里缺失的相机为空指针
+    if (set.frames.size() != 2 || set.partial || !set.frames[0]) {
       return {};
     }
 
     // 实现图像融合逻辑
     // 这里只是一个占位符实现
-    return frames[0];  // 返回第一帧作为示例
+    return *set.frames[0];  // 返回第一帧作为示例
   };
 
   // === 2. 创建协调器 - 使用2个相机 ===
@@ -0,0 +1,173 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: execution_topology_benchmark.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+// 多相机处理线程拓扑对比：每相机独立线程池 vs 节点共享池 vs 按 CPU/NUMA 分区
+// 用法: execution_topology_benchmark [相机数量] [每种拓扑运行秒数]
+// 在多路 Linux 服务器上分区方案按 NUMA 节点分配，否则按 CPU 平均切分
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cameras/ExecutionTopology.hpp"
+#include "cameras/FramePipeline.hpp"
+#include "cameras/FramePool.hpp"
+
+namespace {
+
+// 线扫相机典型帧尺寸，单色
+constexpr size_t kFrameBytes = 8192 * 2600;
+
+// 模拟算法：整帧灰度直方图，受内存带宽和缓存影响明显
+uint64_t histogram_checksum(const std::vector<uint8_t>& data) {
+  std::array<uint32_t, 256> hist{};
+  for (uint8_t value : data) {
+    ++hist[value];
+  }
+  uint64_t sum = 0;
+  for (size_t i = 0; i < hist.size(); ++i) {
+    sum += hist[i] * i;
+  }
+  return sum;
+}
+
+double run_case(const std::vector<ExecutionConfig>& configs, int seconds) {
+  const size_t cams = configs.size();
+  std::vector<std::unique_ptr<FrameBufferPool>> frame_pools;
+  std::vector<std::unique_ptr<FramePipeline>> pipelines;
+  std::atomic<uint64_t> sink{0};
+
+  FramePipelineConfig pipeline_config;
+  pipeline_config.capacity = 4;
+  pipeline_config.policy = FrameOverflowPolicy::Block;
+
+  for (size_t i = 0; i < cams; ++i) {
+    ExecutionBinding binding;
+    binding.configure(configs[i]);
+    auto lane = binding.lane();
+    auto frame_pool = std::make_unique<FrameBufferPool>(8);
+    lane->pool()->run_local([&]() { frame_pool->reserve(kFrameBytes, 8); });
+    pipelines.push_back(std::make_unique<FramePipeline>(
+        [lane](FramePipeline::Task task) { lane->submit(std::move(task)); },
+        [&sink](const std::shared_ptr<CapturedFrame>& frame) {
+          sink.fetch_add(histogram_checksum(frame->data),
+                         std::memory_order_relaxed);
+        },
+        pipeline_config));
+    frame_pools.push_back(std::move(frame_pool));
+  }
+
+  // 相机 SDK 回调线程：把采集缓冲拷进帧池的帧后送入流水线
+  std::vector<uint8_t> source(kFrameBytes);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source[i] = static_cast<uint8_t>(i * 31);
+  }
+  std::atomic<bool> stop{false};
+  std::vector<std::thread> producers;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < cams; ++i) {
+    producers.emplace_back([&, i]() {
+      while (!stop.load(std::memory_order_relaxed)) {
+        auto frame = frame_pools[i]->acquire(kFrameBytes);
+        std::memcpy(frame->data.data(), source.data(), kFrameBytes);
+        pipelines[i]->push(std::move(frame));
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(std::chrono::seconds(seconds));
+  stop.store(true);
+  uint64_t processed = 0;
+  for (auto& pipeline : pipelines) {
+    pipeline->stop();  // 唤醒阻塞的生产者并等待处理中的帧
+    processed += pipeline->stats().processed;
+  }
+  auto end = std::chrono::steady_clock::now();
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  return processed / std::chrono::duration<double>(end - start).count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const size_t cams = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 4;
+  const int seconds = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 5;
+  const size_t cpus = std::max(std::thread::hardware_concurrency(), 1u);
+
+  // 原来的做法：每个相机一个 CPU 核数大小的线程池
+  std::vector<ExecutionConfig> per_camera(cams);
+  for (size_t i = 0; i < cams; ++i) {
+    per_camera[i].pool = "bench_camera" + std::to_string(i);
+  }
+
+  std::vector<ExecutionConfig> shared(cams);
+  for (auto& config : shared) {
+    config.pool = "bench_shared";
+  }
+
+  // 多路服务器按 NUMA 节点分区，同一节点上的相机共用一个池
+  int nodes = 0;
+  while (!numa_node_cpus(nodes).empty()) {
+    ++nodes;
+  }
+  std::vector<ExecutionConfig> partitioned(cams);
+  for (size_t i = 0; i < cams; ++i) {
+    if (nodes > 1) {
+      const int node = static_cast<int>(i % nodes);
+      partitioned[i].pool = "bench_node" + std::to_string(node);
+      partitioned[i].numa_node = node;
+    } else {
+      // 相机比 CPU 多时相邻的相机落在同一个 CPU 上
+      const size_t first = cpus * i / cams;
+      const size_t last = std::max(first + 1, cpus * (i + 1) / cams) - 1;
+      partitioned[i].pool = "bench_part" + std::to_string(i);
+      partitioned[i].cpus = std::to_string(first) + "-" + std::to_string(last);
+    }
+  }
+
+  std::cout << cams << " cameras, frame " << kFrameBytes << " bytes, "
+            << std::thread::hardware_concurrency() << " cpus, " << nodes
+            << " numa nodes, " << seconds << " s per case\n";
+  std::cout << "  per-camera pools: " << run_case(per_camera, seconds)
+            << " frames/s\n";
+  std::cout << "  shared pool:      " << run_case(shared, seconds)
+            << " frames/s\n";
+  std::cout << "  partitioned:      " << run_case(partitioned, seconds)
+            << " frames/s (" << (nodes > 1 ? "by numa node" : "by cpu range")
+            << ")\n";
+  return 0;
+}
@@ -0,0 +1,201 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: framed_receive_benchmark.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+// 回环 TCP 上的接收吞吐（报文/秒）和每条报文的堆分配次数：
+// async_receive_frames()（报文以 span 交出）vs async_receive()（逐条拷贝）
+// 用法: framed_receive_benchmark [报文条数]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "asio.hpp"
+#include "protocol/AsioTcpTransport.hpp"
+#include "protocol/LegacyCodec.hpp"
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+}  // namespace
+
+// 统计全局堆分配次数
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// 特征上报和状态报文交替，一批报文预先编码好反复发送
+std::vector<uint8_t> make_batch(size_t features, size_t messages) {
+  protocol::LegacyCodec codec;
+  protocol::FeatureReport report;
+  report.roll_id = "BENCH_ROLL_0001";
+  report.features.assign(features, {1, 0.5f});
+  protocol::FrontendStatus status;
+  status.capture = true;
+
+  const auto feature_data = codec.encode_features(report);
+  const auto status_data = codec.encode_status(status);
+  std::vector<uint8_t> batch;
+  for (size_t i = 0; i < messages; ++i) {
+    const auto& data = i % 2 == 0 ? feature_data : status_data;
+    batch.insert(batch.end(), data.begin(), data.end());
+  }
+  return batch;
+}
+
+struct CaseResult {
+  double messages_per_second = 0.0;
+  double megabytes_per_second = 0.0;
+  double allocations_per_message = 0.0;
+};
+
+// 发送线程把 batch 写 rounds 遍，接收端用 receive 收完 total 条报文
+template <typename Receive>
+CaseResult run_case(const std::vector<uint8_t>& batch, size_t rounds,
+                    size_t total, Receive&& receive) {
+  asio::io_context io_ctx;
+  asio::ip::tcp::acceptor acceptor(
+      io_ctx, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  const uint16_t port = acceptor.local_endpoint().port();
+
+  std::thread sender([&acceptor, &batch, rounds]() {
+    asio::error_code ec;
+    auto socket = acceptor.accept(ec);
+    if (ec) {
+      return;
+    }
+    for (size_t i = 0; i < rounds && !ec; ++i) {
+      asio::write(socket, asio::buffer(batch), ec);
+    }
+  });
+
+  protocol::AsioTcpTransport transport(io_ctx);
+  bool connected = false;
+  transport.async_connect("127.0.0.1", port,
+                          [&connected](std::error_code ec) {
+                            if (ec) {
+                              std::cerr << "connect failed: " << ec.message()
+                                        << "\n";
+                            }
+                            connected = true;
+                          });
+  while (!connected && io_ctx.run_one()) {
+  }
+  io_ctx.restart();  // 连接完成时没有其它任务，io_context 已经停下
+
+  size_t received = 0;
+  size_t bytes = 0;
+  uint64_t allocations = 0;
+  std::chrono::steady_clock::time_point start;
+  receive(transport, [&](size_t frame_bytes) {
+    if (received == 0) {
+      // 从第一条报文开始计时，排除连接建立和缓冲区初始扩容
+      allocations = g_allocations.load();
+      start = std::chrono::steady_clock::now();
+    }
+    bytes += frame_bytes;
+    return ++received < total;
+  });
+  io_ctx.run();
+  const auto end = std::chrono::steady_clock::now();
+  const uint64_t used = g_allocations.load() - allocations;
+  sender.join();
+
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  return {received / seconds, bytes / seconds / 1e6,
+          static_cast<double>(used) / std::max<size_t>(received, 1)};
+}
+
+void print(const char* name, const CaseResult& result) {
+  std::cout << "  " << name << result.messages_per_second << " msg/s, "
+            << result.megabytes_per_second << " MB/s, "
+            << result.allocations_per_message << " allocs/msg\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const size_t total =
+      argc > 1 ? std::max(std::atoi(argv[1]), 2) : 1000000;
+  constexpr size_t kBatchMessages = 1000;
+  const size_t rounds = (total + kBatchMessages - 1) / kBatchMessages;
+
+  for (size_t features : {4, 256}) {
+    const auto batch = make_batch(features, kBatchMessages);
+
+    // on_frame 返回 false 时停止接收并关闭连接
+    auto frames_case = run_case(
+        batch, rounds, total, [](auto& transport, auto on_frame) {
+          transport.async_receive_frames(
+              [&transport, on_frame](std::error_code ec,
+                                     std::span<const uint8_t> frame) mutable {
+                if (!ec && !on_frame(frame.size())) {
+                  transport.close();
+                }
+              });
+        });
+
+    auto receive_case = run_case(
+        batch, rounds, total, [](auto& transport, auto on_frame) {
+          using OnFrame = decltype(on_frame);
+          struct Loop {
+            protocol::AsioTcpTransport& transport;
+            OnFrame on_frame;
+            void operator()(std::error_code ec, std::vector<uint8_t> data) {
+              if (ec) {
+                return;
+              }
+              if (on_frame(data.size())) {
+                transport.async_receive(*this);
+              } else {
+                transport.close();
+              }
+            }
+          };
+          transport.async_receive(Loop{transport, on_frame});
+        });
+
+    std::cout << features << " features/report, "
+              << batch.size() / kBatchMessages << " bytes/msg avg\n";
+    print("async_receive_frames (span): ", frames_case);
+    print("async_receive (vector):      ", receive_case);
+  }
+  return 0;
+}
@@ -0,0 +1,164 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: legacy_codec_benchmark.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+// 特征上报编码与发送路径的耗时和堆分配次数：
+// 每条报文新建 vector vs 编码到复用的发送缓冲区（经 ProtocolSession 发送）
+// 用法: legacy_codec_benchmark [迭代次数]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "protocol/LegacyCodec.hpp"
+#include "protocol/ProtocolSession.hpp"
+#include "protocol/SendBufferPool.hpp"
+
+namespace {
+
+std::atomic<uint64_t> g_allocations{0};
+
+}  // namespace
+
+// 统计全局堆分配次数
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+// 立即完成发送的传输层，只持有缓冲区到回调返回
+class SinkTransport : public protocol::ITransportAdapter {
+ public:
+  void async_connect(const std::string&, uint16_t,
+                     std::function<void(std::error_code)> callback) override {
+    callback({});
+  }
+  void async_send(std::span<const uint8_t> data,
+                  SendCallback callback) override {
+    bytes_ += data.size();
+    callback({});
+  }
+  void async_send_buffer(SharedBuffer data, SendCallback callback,
+                         protocol::MessageClass) override {
+    bytes_ += data->size();
+    callback({});
+  }
+  void async_receive(ReceiveCallback callback) override {}
+  void close() override {}
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  size_t bytes_ = 0;
+};
+
+protocol::FeatureReport make_report(size_t features) {
+  protocol::FeatureReport report;
+  report.roll_id = "BENCH_ROLL_0001";
+  report.features.reserve(features);
+  for (size_t i = 0; i < features; ++i) {
+    report.features.emplace_back(1, static_cast<float>(i) * 1e-4f);
+  }
+  report.special_images.fill(1.0f);
+  return report;
+}
+
+struct CaseResult {
+  double us_per_message = 0.0;
+  double allocations_per_message = 0.0;
+};
+
+template <typename Fn>
+CaseResult run_case(int iterations, Fn&& fn) {
+  fn();  // 预热，让复用的缓冲区扩容到位
+  const uint64_t allocations = g_allocations.load();
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    fn();
+  }
+  const auto end = std::chrono::steady_clock::now();
+  return {std::chrono::duration<double, std::micro>(end - start).count() /
+              iterations,
+          static_cast<double>(g_allocations.load() - allocations) /
+              iterations};
+}
+
+void print(const char* name, const CaseResult& result) {
+  std::cout << "  " << name << result.us_per_message << " us/msg, "
+            << result.allocations_per_message << " allocs/msg\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? std::max(std::atoi(argv[1]), 1) : 2000;
+
+  protocol::LegacyCodec codec;
+  protocol::SendBufferPool pool;
+  auto transport = std::make_unique<SinkTransport>();
+  auto* sink = transport.get();
+  protocol::ProtocolSession session(std::make_unique<protocol::LegacyCodec>(),
+                                    std::make_unique<SinkTransport>(),
+                                    std::move(transport));
+
+  size_t checksum = 0;
+  for (size_t features : {16, 1000, 4000, 16000}) {
+    const auto report = make_report(features);
+
+    auto vector_case = run_case(iterations, [&]() {
+      auto data = codec.encode_features(report);
+      checksum += data.back();
+    });
+    auto pooled_case = run_case(iterations, [&]() {
+      auto buffer = pool.acquire(codec.encoded_features_size(report));
+      codec.encode_features_to(report, *buffer);
+      checksum += buffer->back();
+    });
+    auto session_case = run_case(iterations, [&]() {
+      session.async_send_features(report, [](std::error_code) {});
+    });
+
+    std::cout << features << " features ("
+              << codec.encoded_features_size(report) << " bytes/msg)\n";
+    print("encode_features (new vector): ", vector_case);
+    print("encode_features_to (pooled):  ", pooled_case);
+    print("session send (pooled):        ", session_case);
+  }
+  std::cout << "checksum " << checksum << ", sent " << sink->bytes()
+            << " bytes\n";
+  return 0;
+}
@@ -0,0 +1,141 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: merge_holes_benchmark.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+// 孔洞合并对比：逐对 O(n²) 扫描 vs 网格邻居查询
+// 用法: merge_holes_benchmark [孔洞数量] [合并距离]
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <opencv2/core.hpp>
+#include <vector>
+
+#include "algo/HoleMerge.hpp"
+
+namespace {
+
+// 线扫相机典型帧尺寸
+constexpr int kFrameRows = 2600;
+constexpr int kFrameCols = 8192;
+
+// 改造前的实现：每个种子与全部孔洞算一次欧氏距离
+std::vector<algo::HoleInfo> legacy_merge(
+    const std::vector<algo::HoleInfo>& holes, int distance_threshold,
+    const config::HoleDetectionConfig& config) {
+  std::vector<bool> merged(holes.size(), false);
+  std::vector<algo::HoleInfo> result;
+  for (size_t i = 0; i < holes.size(); ++i) {
+    if (merged[i]) {
+      continue;
+    }
+    std::vector<size_t> close_indices;
+    for (size_t j = 0; j < holes.size(); ++j) {
+      double dx = static_cast<double>(holes[i].center.x - holes[j].center.x);
+      double dy = static_cast<double>(holes[i].center.y - holes[j].center.y);
+      if (!merged[j] && std::sqrt(dx * dx + dy * dy) <= distance_threshold) {
+        close_indices.push_back(j);
+        merged[j] = true;
+      }
+    }
+    if (close_indices.size() == 1) {
+      result.push_back(holes[close_indices[0]]);
+      continue;
+    }
+    // 合并结果的构造与新实现共用，这里只需要把同一组交给它
+    std::vector<algo::HoleInfo> group;
+    for (size_t idx : close_indices) {
+      group.push_back(holes[idx]);
+    }
+    auto merged_group = algo::merge_close_holes(group, INT_MAX / 2, config);
+    result.push_back(merged_group.front());
+  }
+  for (size_t i = 0; i < result.size(); ++i) {
+    result[i].index = static_cast<int>(i + 1);
+  }
+  return result;
+}
+
+std::vector<algo::HoleInfo> make_holes(int count) {
+  cv::RNG rng(42);
+  std::vector<algo::HoleInfo> holes(count);
+  for (int i = 0; i < count; ++i) {
+    auto& hole = holes[i];
+    hole.index = i + 1;
+    hole.center = cv::Point(rng.uniform(0, kFrameCols),
+                            rng.uniform(0, kFrameRows));
+    hole.area = rng.uniform(1, 40);
+    hole.width = rng.uniform(1, 8);
+    hole.height = rng.uniform(1, 8);
+    hole.pixel_diameter = 2.0 * std::sqrt(hole.area / CV_PI);
+    hole.top_y = hole.center.y - hole.height / 2;
+    hole.bottom_y = hole.top_y + hole.height;
+  }
+  return holes;
+}
+
+bool same(const algo::HoleInfo& a, const algo::HoleInfo& b) {
+  return a.index == b.index && a.center == b.center && a.area == b.area &&
+         a.width == b.width && a.height == b.height &&
+         a.merged_count == b.merged_count && a.top_y == b.top_y &&
+         a.bottom_y == b.bottom_y && a.pixel_diameter == b.pixel_diameter;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int count = argc > 1 ? std::atoi(argv[1]) : 12000;
+  int distance = argc > 2 ? std::max(0, std::atoi(argv[2])) : 20;
+
+  config::HoleDetectionConfig config{};
+  auto holes = make_holes(count);
+
+  auto start = std::chrono::steady_clock::now();
+  auto legacy = legacy_merge(holes, distance, config);
+  auto mid = std::chrono::steady_clock::now();
+  auto grid = algo::merge_close_holes(holes, distance, config);
+  auto end = std::chrono::steady_clock::now();
+
+  if (legacy.size() != grid.size()) {
+    std::cerr << "merged hole count differs\n";
+    return 1;
+  }
+  for (size_t i = 0; i < legacy.size(); ++i) {
+    if (!same(legacy[i], grid[i])) {
+      std::cerr << "merged hole " << i << " differs\n";
+      return 1;
+    }
+  }
+
+  using ms = std::chrono::duration<double, std::milli>;
+  std::cout << count << " holes, merge distance " << distance << " -> "
+            << grid.size() << " merged\n";
+  std::cout << "  pairwise scan: " << ms(mid - start).count() << " ms\n";
+  std::cout << "  grid lookup:   " << ms(end - mid).count() << " ms\n";
+  return 0;
+}
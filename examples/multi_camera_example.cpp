@@ -26,6 +26,7 @@
 
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <thread>
 #include <utility>
@@ -42,22 +43,19 @@
 #include "cameras/MultiCameraCoordinator.hpp"
 
 // 示例：创建一个简单的帧处理器
-class SimpleFrameProcessor {
+class SimpleFrameProcessor : public FrameProcessor {
  public:
   explicit SimpleFrameProcessor(const std::string& name) : name_(name) {}
 
-  void operator()(const CapturedFrame& frame) {
+  void process(const CapturedFrame& frame) override {
     std::cout << name_ << " processed frame of size: " << frame.data.size()
               << ", width: " << frame.width() << ", height: " << frame.height()
               << std::endl;
   }
 
-  // 添加转换为FrameProcessor的函数
-  operator FrameProcessor() {  // NOLINT
-    auto lambda = [this](const CapturedFrame& frame) {
-      this->operator()(frame);
-    };
-    return make_function_processor(std::move(lambda));
+  // 相机保存的是 clone() 出的副本
+  std::shared_ptr<FrameProcessor> clone() const override {
+    return std::make_shared<SimpleFrameProcessor>(*this);
   }
 
  private:
@@ -72,20 +70,22 @@ int main() {
             << std::endl;
 
   // 创建融合策略
-  auto fusion_strategy =
-      [](const std::vector<CapturedFrame>& frames) -> CapturedFrame {
-    std::cout << "Fusion strategy called with " << frames.size() << " frames"
-              << std::endl;
+  auto fusion_strategy = [](const SyncedFrameSet& set) -> CapturedFrame {
+    std::cout << "Fusion strategy called with " << set.frames.size()
+              << " frames" << (set.partial ? " (partial)" : "")
+              << ", skew: " << set.skew << std::endl;
 
-    // 这里只是一个占位符实现
-    if (!frames.empty()) {
+    // 这里只是一个占位符实现，缺失的相机为空指针
+    if (!set.frames.empty()) {
       std::cout << "Fusing frames with sizes: ";
-      for (size_t i = 0; i < frames.size(); ++i) {
-        std::cout << frames[i].data.size() << " ";
+      for (const auto& frame : set.frames) {
+        std::cout << (frame ? frame->data.size() : 0) << " ";
       }
       std::cout << std::endl;
 
-      return frames[0];  // 返回第一帧作为示例
+      if (set.frames[0]) {
+        return *set.frames[0];  // 返回第一帧作为示例
+      }
     }
     return CapturedFrame{};  // 返回空帧
   };
@@ -0,0 +1,92 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: signal_bus_benchmark.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+// ImageSignalBus 广播开销对比：每个订阅者深拷贝 vs 共享只读视图
+// 用法: signal_bus_benchmark [订阅者数量] [迭代次数]
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <opencv2/core.hpp>
+#include <string>
+
+#include "cameras/ImageSignalBus.hpp"
+
+namespace {
+
+// 线扫相机典型帧尺寸
+constexpr int kFrameRows = 2600;
+constexpr int kFrameCols = 8192;
+
+double run_case(ImageSignalBus::ImageDelivery delivery, const char* ns,
+                int subscribers, int iterations, const cv::Mat& frame) {
+  auto& bus = ImageSignalBus::instance(ns);
+  bus.declare_signal("bench");
+
+  std::atomic<size_t> sink{0};
+  for (int i = 0; i < subscribers; ++i) {
+    bus.subscribe(
+        "bench",
+        [&sink](const cv::Mat& img) {
+          sink.fetch_add(img.at<uchar>(0, 0), std::memory_order_relaxed);
+        },
+        delivery);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    bus.emit("bench", frame);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::milli>(end - start).count() /
+         iterations;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int subscribers = argc > 1 ? std::atoi(argv[1]) : 4;
+  int iterations = argc > 2 ? std::atoi(argv[2]) : 50;
+
+  cv::Mat frame(kFrameRows, kFrameCols, CV_8UC1);
+  cv::randu(frame, 0, 255);
+
+  double copy_ms = run_case(ImageSignalBus::ImageDelivery::PrivateCopy,
+                            "bench_copy", subscribers, iterations, frame);
+  double shared_ms = run_case(ImageSignalBus::ImageDelivery::Shared,
+                              "bench_shared", subscribers, iterations, frame);
+
+  std::cout << "frame " << kFrameCols << "x" << kFrameRows << ", "
+            << subscribers << " subscribers, " << iterations
+            << " iterations\n";
+  std::cout << "  private copy: " << copy_ms << " ms/emit ("
+            << copy_ms / subscribers << " ms/subscriber)\n";
+  std::cout << "  shared view:  " << shared_ms << " ms/emit ("
+            << shared_ms / subscribers << " ms/subscriber)\n";
+  return 0;
+}
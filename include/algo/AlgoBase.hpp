@@ -25,11 +25,11 @@
  */
 
 #pragma once
+#include <cassert>
 #include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -46,9 +46,13 @@ struct AlgoParamInfo {
   std::string current_value;  // 可用于 UI 显示
 };
 
+// 信号类型：图像信号给本地 GUI，特征信号给服务器
+enum class AlgoSignalKind { Image, Feature };
+
 struct AlgoSignalInfo {
   std::string name;
   std::string description;
+  AlgoSignalKind kind = AlgoSignalKind::Image;
 };
 
 /**
@@ -73,11 +77,16 @@ class AlgoBase {
    * 而且必须用adapter才能使用算法，我们的设计是很完美的，相当于自动defer初始化
    */
   void initialize() {
+    bus_ = &ImageSignalBus::instance();
     auto signals = get_signal_info();
     for (const auto& sig : signals) {
-      ImageSignalBus::instance().declare_signal(sig.name);
-      declared_signals_.insert(sig.name);
+      if (sig.kind == AlgoSignalKind::Feature) {
+        feature_signals_[sig.name] = bus_->declare_feature(sig.name);
+      } else {
+        image_signals_[sig.name] = bus_->declare_signal(sig.name);
+      }
     }
+    on_initialized();
   }
 
   /**
@@ -151,9 +160,22 @@ class AlgoBase {
    * @param img 处理结果图像
    */
   void emit_image(const std::string& name, const cv::Mat& img) {
-    assert(!declared_signals_.empty() && "AlgoBase::initialize() not called!");
-    if (declared_signals_.count(name)) {
-      ImageSignalBus::instance().emit(name, img);
+    assert(bus_ && "AlgoBase::initialize() not called!");
+    if (auto it = image_signals_.find(name); it != image_signals_.end()) {
+      bus_->emit(it->second, img);
+    }
+  }
+
+  /**
+   * @brief 给本地GUI发送已共享的处理结果（零拷贝）
+   * @param name 信号名称
+   * @param img 只读共享图像
+   */
+  void emit_image(const std::string& name,
+                  const ImageSignalBus::SharedImage& img) {
+    assert(bus_ && "AlgoBase::initialize() not called!");
+    if (auto it = image_signals_.find(name); it != image_signals_.end()) {
+      bus_->emit(it->second, img);
     }
   }
 
@@ -164,17 +186,47 @@ class AlgoBase {
    */
   void emit_feature(const std::string& name,
                     const ImageSignalBus::FeatureData& data) {
-    assert(!declared_signals_.empty() && "AlgoBase::initialize() not called!");
-    if (declared_signals_.count(name)) {
-      ImageSignalBus::instance().emit_feature(name, data);
+    assert(bus_ && "AlgoBase::initialize() not called!");
+    if (auto it = feature_signals_.find(name); it != feature_signals_.end()) {
+      bus_->emit_feature(it->second, data);
     }
   }
 
+  // 按句柄发送，省去按名查找；句柄通过 image_signal()/feature_signal() 获取
+  void emit_image(ImageSignalBus::ImageSignal signal, const cv::Mat& img) {
+    assert(bus_ && "AlgoBase::initialize() not called!");
+    bus_->emit(signal, img);
+  }
+  void emit_feature(ImageSignalBus::FeatureSignal signal,
+                    const ImageSignalBus::FeatureData& data) {
+    assert(bus_ && "AlgoBase::initialize() not called!");
+    bus_->emit_feature(signal, data);
+  }
+
+  // 查询 initialize() 中声明的信号句柄，未声明时返回无效句柄
+  ImageSignalBus::ImageSignal image_signal(const std::string& name) const {
+    auto it = image_signals_.find(name);
+    return it != image_signals_.end() ? it->second
+                                      : ImageSignalBus::ImageSignal{};
+  }
+  ImageSignalBus::FeatureSignal feature_signal(const std::string& name) const {
+    auto it = feature_signals_.find(name);
+    return it != feature_signals_.end() ? it->second
+                                        : ImageSignalBus::FeatureSignal{};
+  }
+
  protected:
+  // initialize() 声明完信号后调用，派生类在这里缓存常用的信号句柄
+  virtual void on_initialized() {}
+
   // 配置映射表，将配置键映射到相应的处理函数
   std::unordered_map<std::string, std::function<void(const std::string&)>>
       configMap_;
-  std::unordered_set<std::string> declared_signals_;
+  // initialize() 之后只读，发射线程可以并发查找
+  ImageSignalBus* bus_ = nullptr;
+  std::unordered_map<std::string, ImageSignalBus::ImageSignal> image_signals_;
+  std::unordered_map<std::string, ImageSignalBus::FeatureSignal>
+      feature_signals_;
 };
 /*
  * @breief 宏定义，用于定义算法元信息,提供类似静态反射，获取元信息的功能
@@ -210,6 +262,11 @@ class AlgoAdapter : public FrameProcessor {
     }
   }
 
+  // 副本与原适配器共享同一个算法实例
+  std::shared_ptr<FrameProcessor> clone() const override {
+    return std::make_shared<AlgoAdapter>(*this);
+  }
+
  private:
   AlgoPtr algo_;  // 智能指针保证生命周期
 };
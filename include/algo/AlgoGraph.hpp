@@ -0,0 +1,103 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: AlgoGraph.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "algo/AlgoBase.hpp"
+#include "algo/LatencyHistogram.hpp"
+#include "cameras/FrameProcessor.hpp"
+
+namespace algo {
+
+struct AlgoNodeTiming {
+  std::string name;
+  LatencySnapshot latency;
+  uint64_t failures = 0;  // 抛出异常的次数，失败节点的下游本帧跳过
+  uint64_t skipped = 0;   // 因上游失败被跳过的次数
+};
+
+/**
+ * @brief 以有向无环图组织多个算法的帧处理器
+ *
+ * 每帧按依赖关系调度节点：互不依赖的节点在线程池上并行执行，
+ * 全部节点结束后 process() 才返回，因此节点可以直接引用同一帧而不拷贝。
+ * 节点之间通过 CapturedFrame::derived 共享中间结果（如灰度裁剪图），
+ * 产出中间结果的阶段节点排在使用它的算法之前即可。
+ *
+ * 节点只能依赖已经添加的节点，天然无环。拷贝或 clone() 出的图与原图
+ * 共享节点、线程池和耗时统计。
+ */
+class AlgoGraph : public FrameProcessor {
+ public:
+  using NodeId = size_t;
+  using Stage = std::function<void(const CapturedFrame&)>;
+  using Task = std::function<void()>;
+  using Executor = std::function<void(Task)>;
+
+  // 默认的线程数。process() 本身已在相机工作线程上执行，图的线程池只负责
+  // 并行的兄弟节点，按核数开线程会与相机线程池叠加，造成超额订阅
+  static constexpr size_t kDefaultThreads = 2;
+
+  // 使用图自己的线程池，threads 为 0 时取 kDefaultThreads
+  explicit AlgoGraph(size_t threads = kDefaultThreads);
+  // 使用外部执行器。不要传入调用 process() 的线程池：
+  // 池中线程都在等待本帧结束时，派发出去的节点永远得不到执行
+  explicit AlgoGraph(Executor executor);
+
+  /**
+   * @brief 添加算法节点，会调用 algo->initialize() 声明信号
+   * @param depends_on 必须先完成的节点
+   * @throw std::invalid_argument 依赖了不存在的节点
+   */
+  NodeId add_algorithm(AlgoPtr algo,
+                       const std::vector<NodeId>& depends_on = {});
+
+  // 添加普通阶段节点，通常用来预先算好多个算法共用的中间结果
+  NodeId add_stage(std::string name, Stage stage,
+                   const std::vector<NodeId>& depends_on = {});
+
+  void process(const CapturedFrame& frame) override;
+
+  std::shared_ptr<FrameProcessor> clone() const override;
+
+  size_t size() const;
+
+  // 各节点的耗时分布，顺序与添加顺序一致
+  std::vector<AlgoNodeTiming> get_node_timing() const;
+
+ private:
+  struct State;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace algo
@@ -0,0 +1,75 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameProducts.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include <opencv2/core.hpp>
+
+#include "cameras/FrameProcessor.hpp"
+
+namespace algo {
+
+/**
+ * 多个算法共用的单帧派生数据，缓存在 CapturedFrame::derived 中：
+ * 第一次请求时计算，之后所有算法拿到同一份只读结果，随帧一起释放。
+ * 结果可能直接引用帧缓冲区，需要在帧释放后继续使用时请自行 clone()。
+ */
+
+using GrayHistogram = std::array<uint32_t, 256>;
+
+// 帧像素的 Mat 视图，不拷贝；按数据大小区分单通道和 BGR 三通道
+cv::Mat frame_view(const CapturedFrame& frame);
+
+/**
+ * @brief 去掉左右白边后的内容列范围（含 10 像素边距）
+ *
+ * 只对宽高都超过 1000 的图像裁剪，找不到白边时返回整宽。
+ */
+cv::Range content_columns(const cv::Mat& gray);
+
+// 整帧灰度图，单通道帧直接引用帧缓冲区
+std::shared_ptr<const cv::Mat> frame_gray(const CapturedFrame& frame);
+
+// 内容列范围，见 content_columns()
+std::shared_ptr<const cv::Range> frame_content_columns(
+    const CapturedFrame& frame);
+
+// 内容区域灰度图，是 frame_gray() 的列裁剪视图
+std::shared_ptr<const cv::Mat> frame_content_gray(const CapturedFrame& frame);
+
+// 内容区域灰度金字塔的第 level 层，0 层即内容区域，每层宽高减半
+std::shared_ptr<const cv::Mat> frame_pyramid(const CapturedFrame& frame,
+                                             int level);
+
+// 内容区域的 256 级灰度直方图
+std::shared_ptr<const GrayHistogram> frame_histogram(
+    const CapturedFrame& frame);
+
+}  // namespace algo
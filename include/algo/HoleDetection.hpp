@@ -26,11 +26,17 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <string>
 #include <vector>
 
 #include "algo/AlgoBase.hpp"
 #include "algo/AlgorithmConfigTraits.hpp"
+#include "algo/LatencyHistogram.hpp"
 #include "config/ConfigObserver.hpp"
 #include "config/GlobalConfig.hpp"
 
@@ -53,6 +59,25 @@ struct PartitionConfig {
   int right_thresh = 20;
 };
 
+// 针孔检测的处理阶段，Total 为单帧端到端耗时
+enum class HoleDetectionStage {
+  Preprocess,
+  Threshold,
+  Components,
+  Extract,
+  Merge,
+  Emit,
+  Total,
+  Count
+};
+
+struct StageLatency {
+  std::string stage;
+  LatencySnapshot latency;
+};
+
+class StreamingHoleLabeler;
+
 class HoleDetection : public AlgoBase {
  public:
   ALGO_METADATA("HoleDetection", "针孔检测")
@@ -60,6 +85,7 @@ class HoleDetection : public AlgoBase {
 
   HoleDetection();
   explicit HoleDetection(const Config& cfg);
+  ~HoleDetection() override;
   void process(const CapturedFrame& frame) override;
 
   std::vector<AlgoParamInfo> get_parameter_info() const override;
@@ -67,6 +93,25 @@ class HoleDetection : public AlgoBase {
 
   void update_config(const Config& new_cfg);
 
+  /**
+   * @brief 流式检测：喂入线扫条带的下一段连续行
+   *
+   * 跨行块的孔洞会被接续标记，孔洞闭合后在所在行块处理结束时通过
+   * hole_features 发出。行块必须按采集顺序串行送入，列数变化视为新条带。
+   */
+  void process_rows(const cv::Mat& rows);
+
+  // 结束当前条带，发出所有尚未闭合的孔洞
+  void end_stream();
+
+  // 各阶段耗时的 p50/p99/max，统计常驻开启
+  std::vector<StageLatency> get_stage_latency() const;
+  // 通过日志输出各阶段耗时，process() 也会按固定间隔自动输出
+  void log_stage_latency() const;
+
+ protected:
+  void on_initialized() override;
+
  private:
   void parse_partition_params();
 
@@ -74,6 +119,19 @@ class HoleDetection : public AlgoBase {
   Config config_;
   PartitionConfig parsed_params_;
   mutable std::shared_mutex config_mutex_;
+  // initialize() 时取到的特征信号句柄，之后只读
+  ImageSignalBus::FeatureSignal hole_features_;
+
+  // 流式检测状态，由 stream_mutex_ 串行化
+  std::mutex stream_mutex_;
+  std::unique_ptr<StreamingHoleLabeler> stream_;
+  int stream_source_cols_ = -1;
+  int stream_x_begin_ = 0;
+  int stream_block_rows_ = 0;
+
+  std::array<LatencyHistogram, static_cast<size_t>(HoleDetectionStage::Count)>
+      stage_latency_;
+  std::atomic<int64_t> last_latency_log_ns_{0};
 };
 
 }  // namespace algo
@@ -0,0 +1,64 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: HoleMerge.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <opencv2/core.hpp>
+#include <vector>
+
+#include "config/GlobalConfig.hpp"
+
+namespace algo {
+
+struct HoleInfo {
+  int index;
+  cv::Point center;
+  double pixel_diameter;
+  int area;
+  bool merged = false;
+  int merged_count = 1;
+  double real_diameter = -1.0;
+  int width;                  // 添加宽度属性
+  int height;                 // 添加高度属性
+  double real_area = -1.0;    // 添加实际面积属性
+  double real_width = -1.0;   // 添加实际宽度属性
+  double real_height = -1.0;  // 添加实际高度属性
+  int top_y;                  // 添加上边界Y坐标
+  int bottom_y;               // 添加下边界Y坐标
+};
+
+/**
+ * @brief 合并距离不超过 distance_threshold 的孔洞
+ *
+ * 按输入顺序取未合并的孔洞作为种子，把与种子中心距离不超过阈值的所有未合并
+ * 孔洞并入同一组。邻居查询走边长为阈值的网格，只比较平方距离，
+ * 输出与逐对扫描的实现完全一致。
+ */
+std::vector<HoleInfo> merge_close_holes(
+    const std::vector<HoleInfo>& holes, int distance_threshold,
+    const config::HoleDetectionConfig& config);
+
+}  // namespace algo
@@ -0,0 +1,107 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: LatencyHistogram.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace algo {
+
+struct LatencySnapshot {
+  uint64_t count = 0;
+  uint64_t p50_ns = 0;
+  uint64_t p99_ns = 0;
+  uint64_t max_ns = 0;
+};
+
+/**
+ * @brief 常驻开启的耗时直方图（HDR 风格的对数-线性分桶）
+ *
+ * 每个 2 的幂区间再均分 16 个桶，分位数的相对误差不超过 1/16；最大值精确。
+ * 每个线程写自己的分片（按线程序号取模，最多 64 片，首次写入时分配），
+ * 记录只有一次无竞争的 relaxed 原子加，不加锁；读取时汇总所有分片。
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr int kSubBuckets = 1 << kSubBucketBits;
+  static constexpr int kMaxExponent = 40;  // 2^40 ns ≈ 18 分钟
+  static constexpr int kBuckets =
+      kSubBuckets + (kMaxExponent - kSubBucketBits + 1) * kSubBuckets;
+  static constexpr int kMaxShards = 64;
+
+  LatencyHistogram() = default;
+  ~LatencyHistogram();
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+  void record(uint64_t value_ns) noexcept;
+  void record(std::chrono::steady_clock::duration elapsed) noexcept {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+    record(ns.count() > 0 ? static_cast<uint64_t>(ns.count()) : 0);
+  }
+
+  LatencySnapshot snapshot() const;
+
+  static int bucket_index(uint64_t value_ns) noexcept;
+  // 桶内代表值（区间中点）
+  static uint64_t bucket_value(int index) noexcept;
+
+ private:
+  struct alignas(64) Shard {
+    std::array<std::atomic<uint64_t>, kBuckets> counts{};
+    std::atomic<uint64_t> max{0};
+  };
+
+  Shard* local_shard() noexcept;
+
+  std::array<std::atomic<Shard*>, kMaxShards> shards_{};
+};
+
+// 作用域计时：析构时把耗时记入直方图，传入空指针则不计时
+class LatencyScope {
+ public:
+  explicit LatencyScope(LatencyHistogram* histogram) noexcept
+      : histogram_(histogram),
+        start_(histogram ? std::chrono::steady_clock::now()
+                         : std::chrono::steady_clock::time_point{}) {}
+  ~LatencyScope() {
+    if (histogram_) {
+      histogram_->record(std::chrono::steady_clock::now() - start_);
+    }
+  }
+  LatencyScope(const LatencyScope&) = delete;
+  LatencyScope& operator=(const LatencyScope&) = delete;
+
+ private:
+  LatencyHistogram* histogram_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace algo
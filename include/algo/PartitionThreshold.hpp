@@ -0,0 +1,69 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: PartitionThreshold.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include "algo/HoleDetection.hpp"
+
+namespace algo {
+
+/**
+ * @brief 三段分区阈值的列边界
+ *
+ * x < left_end 使用左阈值，x < mid_end 使用中阈值，其余使用右阈值；
+ * 与按左、中、右顺序依次调用 cv::threshold 覆盖写入的结果一致。
+ */
+struct PartitionBands {
+  int left_end = 0;
+  int mid_end = 0;
+  int left_thresh = 0;
+  int mid_thresh = 0;
+  int right_thresh = 0;
+};
+
+PartitionBands make_partition_bands(int width, const PartitionConfig& params);
+
+/**
+ * @brief 对一行的 [x_begin, x_end) 列做分区二值化（THRESH_BINARY, 255）
+ *
+ * 一次遍历整行，按列区间切换阈值；src 指向整行行首（列号与 bands 一致），
+ * dst 指向 x_begin 对应的输出位置。
+ */
+void threshold_partitioned_row(const uchar* src, uchar* dst, int x_begin,
+                               int x_end, const PartitionBands& bands);
+
+/**
+ * @brief 按行块并行对整幅 CV_8UC1 图像做分区二值化
+ */
+cv::Mat threshold_partitioned(const cv::Mat& image,
+                              const PartitionBands& bands);
+
+// 当前 CPU 上选中的行内核名称（avx2 / simd / scalar），用于日志和基准
+const char* partition_threshold_kernel_name();
+
+}  // namespace algo
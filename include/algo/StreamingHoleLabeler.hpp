@@ -0,0 +1,100 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: StreamingHoleLabeler.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <opencv2/core.hpp>
+#include <vector>
+
+#include "algo/PartitionThreshold.hpp"
+
+namespace algo {
+
+// 流式标记得到的一个已闭合连通域，行号是条带内的全局行号
+struct StreamingComponent {
+  int64_t area = 0;
+  int64_t sum_x = 0;  // 像素坐标整数和，质心 = sum / area
+  int64_t sum_y = 0;
+  int left = INT_MAX;
+  int right = -1;  // 闭区间
+  int64_t top = 0;
+  int64_t bottom = 0;  // 闭区间
+};
+
+/**
+ * @brief 线扫条带的行增量连通域标记（8 邻接）
+ *
+ * 每次喂入若干行，按分区阈值二值化后提取行程（run），只与上一行的行程
+ * 做连通判断；某个连通域在新的一行里没有任何行程时即视为闭合并回调。
+ * 只保留上一行的行程和仍然打开的连通域，内存与条带长度无关。
+ * 非线程安全，行块必须按采集顺序串行送入。
+ */
+class StreamingHoleLabeler {
+ public:
+  using ClosedCallback = std::function<void(const StreamingComponent&)>;
+
+  // 开始新条带，丢弃所有未闭合的连通域
+  void reset(int width, const PartitionBands& bands);
+  void set_bands(const PartitionBands& bands) { bands_ = bands; }
+
+  // 喂入 CV_8UC1 行块，列数必须等于 width()
+  void push_rows(const cv::Mat& rows, const ClosedCallback& on_closed);
+  // 条带结束：所有未闭合的连通域按闭合处理
+  void finish(const ClosedCallback& on_closed);
+
+  int width() const noexcept { return width_; }
+  int64_t rows_consumed() const noexcept { return row_; }
+  size_t open_components() const noexcept { return comps_.size(); }
+
+ private:
+  struct Run {
+    int begin;
+    int end;  // 闭区间
+    int label;
+  };
+
+  int find(int label) noexcept;
+  int unite(int a, int b) noexcept;
+  int new_component();
+  void push_row(const uchar* src, const ClosedCallback& on_closed);
+
+  int width_ = 0;
+  int64_t row_ = 0;
+  PartitionBands bands_;
+  std::vector<uchar> binary_row_;
+  std::vector<Run> prev_runs_;
+  std::vector<Run> cur_runs_;
+  std::vector<int> parent_;
+  std::vector<StreamingComponent> comps_;
+  // 每行结束时把仍然打开的连通域压缩成连续编号
+  std::vector<int> remap_;
+  std::vector<StreamingComponent> next_comps_;
+};
+
+}  // namespace algo
@@ -32,8 +32,10 @@
 #include <string>
 #include <unordered_map>
 
+#include "asio/awaitable.hpp"
 #include "asio/ip/tcp.hpp"
-#include "protocol/ProtocolSession.hpp"
+#include "protocol/FanoutSession.hpp"
+#include "protocol/ReconnectingTransport.hpp"
 #include "redis/RedisClient.hpp"
 
 namespace business {
@@ -42,7 +44,10 @@ class BusinessManager {
  public:
   BusinessManager(asio::io_context& io_ctx, const std::string& local_ip,
                   const std::string& main_server_ip = "192.1.53.9",
-                  const std::string& backup_server_ip = "");
+                  const std::string& backup_server_ip = "",
+                  const protocol::ReconnectConfig& reconnect = {},
+                  const std::string& spill_dir = "",
+                  const protocol::FanoutConfig& fanout = {});
   ~BusinessManager() = default;
 
   void start();
@@ -55,38 +60,41 @@ class BusinessManager {
   using StartCallback = std::function<void(const std::string& roll_id)>;
   void set_start_callback(StartCallback callback);
 
-  // 获取上报会话（用于 19300）
-  std::shared_ptr<protocol::ProtocolSession> get_report_session() const {
-    return report_session_;
+  // 获取上报会话（用于 19300），同时发往主服务器和备份服务器
+  std::shared_ptr<protocol::FanoutSession> get_report_fanout() const {
+    return report_fanout_;
   }
 
-  // 获取备份上报会话
-  std::shared_ptr<protocol::ProtocolSession> get_backup_report_session() const {
-    return backup_report_session_;
-  }
-
-  // 获取遥测会话（用于 19700）
-  std::shared_ptr<protocol::ProtocolSession> get_telemetry_session() const {
-    return telemetry_session_;
-  }
-
-  // 获取备份遥测会话
-  std::shared_ptr<protocol::ProtocolSession> get_backup_telemetry_session()
-      const {
-    return backup_telemetry_session_;
+  // 获取遥测会话（用于 19700），仅主控机创建
+  std::shared_ptr<protocol::FanoutSession> get_telemetry_fanout() const {
+    return telemetry_fanout_;
   }
 
  private:
   void start_master();
   void start_worker();
+  // 创建带断线重连的传输层，name 区分各会话的溢写文件
+  std::unique_ptr<protocol::ITransportAdapter> make_transport(
+      const std::string& name);
+  void create_report_fanout();
+  // 为会话添加主服务器或备份服务器目的地并发起连接
+  void add_destination(protocol::FanoutSession& fanout, bool backup,
+                       uint16_t port);
+
+  // 监听协程：接受连接，每条连接在自己的协程里处理
+  using ConnectionHandler =
+      asio::awaitable<void> (BusinessManager::*)(asio::ip::tcp::socket);
+  std::unique_ptr<asio::ip::tcp::acceptor> open_acceptor(uint16_t port);
+  asio::awaitable<void> accept_loop(asio::ip::tcp::acceptor& acceptor,
+                                    ConnectionHandler handler);
 
   // 7000 监听
   void start_listening_7000();
-  void handle_7000_connection(std::shared_ptr<asio::ip::tcp::socket> socket);
+  asio::awaitable<void> handle_7000_connection(asio::ip::tcp::socket socket);
 
   // 19800 监听
   void start_listening_19800();
-  void handle_19800_connection(std::shared_ptr<asio::ip::tcp::socket> socket);
+  asio::awaitable<void> handle_19800_connection(asio::ip::tcp::socket socket);
 
   // 遥测聚合
   void aggregate_telemetry(const std::string& machine_id,
@@ -99,19 +107,15 @@ class BusinessManager {
   std::string redis_host_;
   std::string main_server_ip_;
   std::string backup_server_ip_;
+  protocol::ReconnectConfig reconnect_;
+  std::string spill_dir_;  // 空表示不溢写
+  protocol::FanoutConfig fanout_;
 
   std::unique_ptr<redis::RedisClient> redis_;
 
-  // 主协议会话
-  std::shared_ptr<protocol::ProtocolSession> report_session_;  // 19300 主服务器
-  std::shared_ptr<protocol::ProtocolSession>
-      telemetry_session_;  // 19700 主服务器
-
-  // 备份协议会话
-  std::shared_ptr<protocol::ProtocolSession>
-      backup_report_session_;  // 19300 备份服务器
-  std::shared_ptr<protocol::ProtocolSession>
-      backup_telemetry_session_;  // 19700 备份服务器
+  // 协议会话，每条报文编码一次后发往主备服务器
+  std::shared_ptr<protocol::FanoutSession> report_fanout_;     // 19300
+  std::shared_ptr<protocol::FanoutSession> telemetry_fanout_;  // 19700
 
   // 监听器
   std::unique_ptr<asio::ip::tcp::acceptor> acceptor_7000_;
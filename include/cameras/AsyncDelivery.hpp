@@ -0,0 +1,219 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: AsyncDelivery.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "logging/CaponLogging.hpp"
+
+// 异步订阅者的积压策略
+enum class DeliveryOverflow {
+  LatestOnly,  // 积压超过容量时丢弃最旧的，适合预览这类只关心最新值的订阅者
+  Lossless     // 从不丢弃，积压超过容量告警，达到上限时阻塞发射线程
+};
+
+struct AsyncDeliveryConfig {
+  size_t capacity = 1;  // LatestOnly 的队列长度；Lossless 的告警水位
+  DeliveryOverflow policy = DeliveryOverflow::LatestOnly;
+  // Lossless 的硬上限：积压达到后 push 阻塞等待投递线程腾出空间（背压），
+  // 0 表示不限。消息可能经 FeatureData::frame 引用整帧图像，不宜放开
+  size_t max_depth = 1024;
+};
+
+struct AsyncDeliveryStats {
+  uint64_t delivered = 0;  // 已交给回调的条数
+  uint64_t dropped = 0;    // 因积压被丢弃的条数
+  size_t depth = 0;        // 当前积压条数
+  size_t high_water = 0;   // 历史最大积压条数
+  uint64_t blocked = 0;    // Lossless 达到上限、发射线程等待的次数
+};
+
+/**
+ * @brief 异步订阅的控制句柄
+ *
+ * 由 ImageSignalBus::subscribe_*_async 返回，不持有也不影响订阅本身，
+ * 丢弃返回值即可一直订阅到进程结束。
+ */
+class AsyncSubscription {
+ public:
+  virtual ~AsyncSubscription() = default;
+  virtual AsyncDeliveryStats stats() const = 0;
+  // 停止投递：丢弃积压并等待正在执行的回调返回，之后的消息直接丢弃
+  virtual void stop() = 0;
+};
+
+/**
+ * @brief 单个订阅者的投递队列和投递线程
+ *
+ * 发射线程只在 push() 中短暂持锁入队，回调在投递线程上执行，
+ * 慢订阅者只会让自己的队列积压，不会拖住算法线程。
+ * 同一订阅者的回调始终串行执行，顺序与 push 一致。
+ *
+ * 队列状态由投递线程共同持有：最后一个引用在回调里释放时，析构发生在
+ * 投递线程上，无法 join 自己，只能 detach，此时状态留给投递线程收尾
+ */
+template <typename T>
+class AsyncDeliveryQueue : public AsyncSubscription {
+ public:
+  using Handler = std::function<void(const T&)>;
+
+  AsyncDeliveryQueue(Handler handler, const AsyncDeliveryConfig& config)
+      : state_(std::make_shared<State>()) {
+    state_->handler = std::move(handler);
+    state_->config = config;
+    if (state_->config.capacity == 0) {
+      state_->config.capacity = 1;
+    }
+    state_->warn_depth = state_->config.capacity;
+    worker_ = std::thread([state = state_]() { run(*state); });
+  }
+
+  ~AsyncDeliveryQueue() override {
+    stop();
+    if (worker_.joinable()) {
+      worker_.detach();
+    }
+  }
+
+  AsyncDeliveryQueue(const AsyncDeliveryQueue&) = delete;
+  AsyncDeliveryQueue& operator=(const AsyncDeliveryQueue&) = delete;
+
+  void push(T value) {
+    auto& state = *state_;
+    // 被挤掉的消息放到锁外释放，大图像的析构不占用队列锁
+    T evicted{};
+    {
+      std::unique_lock lock(state.mutex);
+      if (state.stopped) {
+        return;
+      }
+      // 回调里再次 push 时不能等自己，直接入队
+      if (state.config.policy == DeliveryOverflow::Lossless &&
+          state.config.max_depth > 0 &&
+          state.queue.size() >= state.config.max_depth &&
+          worker_.get_id() != std::this_thread::get_id()) {
+        ++state.stats.blocked;
+        state.space.wait(lock, [&state]() {
+          return state.stopped || state.queue.size() < state.config.max_depth;
+        });
+        if (state.stopped) {
+          return;
+        }
+      }
+      if (state.config.policy == DeliveryOverflow::LatestOnly &&
+          state.queue.size() >= state.config.capacity) {
+        evicted = std::move(state.queue.front());
+        state.queue.pop_front();
+        ++state.stats.dropped;
+      }
+      state.queue.push_back(std::move(value));
+      if (state.queue.size() > state.stats.high_water) {
+        state.stats.high_water = state.queue.size();
+      }
+      if (state.config.policy == DeliveryOverflow::Lossless &&
+          state.queue.size() > state.warn_depth) {
+        // 积压每翻一倍告警一次，避免刷屏
+        LOG_WARN("Async subscriber backlog reached {} messages",
+                 state.queue.size());
+        state.warn_depth = state.queue.size() * 2;
+      }
+      // 持锁通知：回调可能随即释放队列对象，解锁后不能再访问状态
+      state.ready.notify_one();
+    }
+  }
+
+  AsyncDeliveryStats stats() const override {
+    std::lock_guard lock(state_->mutex);
+    AsyncDeliveryStats stats = state_->stats;
+    stats.depth = state_->queue.size();
+    return stats;
+  }
+
+  void stop() override {
+    std::deque<T> discarded;
+    {
+      std::lock_guard lock(state_->mutex);
+      if (!state_->stopped) {
+        state_->stopped = true;
+        state_->stats.dropped += state_->queue.size();
+        discarded.swap(state_->queue);
+      }
+    }
+    state_->ready.notify_all();
+    state_->space.notify_all();
+    // 在回调里调用 stop() 时不能 join 自己，留给析构函数
+    if (worker_.joinable() && worker_.get_id() != std::this_thread::get_id()) {
+      worker_.join();
+    }
+  }
+
+ private:
+  struct State {
+    Handler handler;
+    AsyncDeliveryConfig config;
+
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable space;  // Lossless 背压时等待出队
+    std::deque<T> queue;
+    size_t warn_depth = 0;
+    bool stopped = false;
+    AsyncDeliveryStats stats;
+  };
+
+  // 只访问共享状态，回调里释放了队列对象也能安全返回
+  static void run(State& state) {
+    std::unique_lock lock(state.mutex);
+    while (true) {
+      state.ready.wait(
+          lock, [&state]() { return state.stopped || !state.queue.empty(); });
+      if (state.stopped) {
+        return;
+      }
+      T value = std::move(state.queue.front());
+      state.queue.pop_front();
+      lock.unlock();
+      state.space.notify_one();
+      if (state.handler) {
+        state.handler(value);
+      }
+      lock.lock();
+      ++state.stats.delivered;
+    }
+  }
+
+  std::shared_ptr<State> state_;
+  std::thread worker_;
+};
@@ -28,6 +28,7 @@
 
 #include <memory>
 
+#include "cameras/FramePipeline.hpp"
 #include "concurrentqueue.h"
 #include "protocol/messages.hpp"
 class FrameProcessor;
@@ -42,8 +43,16 @@ class CameraCapture {
   virtual void stop() = 0;
   virtual void set_config(const CameraConfig&) = 0;
   virtual void set_roi(int x, int y, int width, int height) = 0;
+  // 原始帧预览队列，默认关闭，打开后才会把采集到的帧放进去
+  // 只在确实有人消费 get_frame_queue() 时打开，否则帧会被队列长期占住
+  virtual void set_frame_queue_enabled(bool enabled) = 0;
   virtual moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>>&
   get_frame_queue() = 0;
   virtual protocol::FrontendStatus get_status() const = 0;
   virtual void add_frame_processor(const FrameProcessor& processor) = 0;
+  // 采集到算法之间的有界流水线
+  virtual void set_pipeline_config(const FramePipelineConfig& config) = 0;
+  virtual FramePipelineStats get_pipeline_stats() const = 0;
+  // 处理线程池与绑核，见 ExecutionTopology
+  virtual void set_execution_config(const ExecutionConfig& config) = 0;
 };
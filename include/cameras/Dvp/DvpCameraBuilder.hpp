@@ -227,7 +227,7 @@ class DvpCameraBuilder {
     std::optional<double> trigger_delay;
 
     // 回调
-    std::vector<FrameProcessor> frame_processors;
+    std::vector<std::shared_ptr<FrameProcessor>> frame_processors;
     std::unordered_map<DvpEventType, DvpEventHandler> event_handlers;
   };
 
@@ -26,13 +26,16 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <shared_mutex>
 
-#include "BS_thread_pool.hpp"
 #include "cameras/CameraCapture.hpp"
 #include "cameras/Dvp/DvpConfig.hpp"
 #include "cameras/Dvp/DvpEventManager.hpp"
+#include "cameras/ExecutionTopology.hpp"
+#include "cameras/FramePipeline.hpp"
+#include "cameras/FramePool.hpp"
 #include "cameras/FrameProcessor.hpp"
 #include "concurrentqueue.h"
 #include "protocol/messages.hpp"
@@ -58,9 +61,17 @@ class DvpCameraCapture : public CameraCapture {
   virtual void register_event_handler(DvpEventType event,
                                       DvpEventHandler handler);
   void add_frame_processor(const FrameProcessor& processor) override;
+  void set_pipeline_config(const FramePipelineConfig& config) override;
+  void set_execution_config(const ExecutionConfig& config) override;
+  FramePipelineStats get_pipeline_stats() const override;
   virtual DvpEventManager* get_event_manager() const;
-  auto& get_frame_processor() const { return user_processor_; }
+  std::shared_ptr<FrameProcessor> get_frame_processor() const {
+    return user_processor_.load();
+  }
 
+  void set_frame_queue_enabled(bool enabled) override {
+    frame_queue_enabled_.store(enabled);
+  }
   // 获取图像队列的引用
   moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>>& get_frame_queue()
       override {
@@ -81,6 +92,8 @@ class DvpCameraCapture : public CameraCapture {
   void process_frame(const dvpFrame& frame, const void* buffer);
   void update_camera_params();  // 应用配置到 SDK
   void update_status(const protocol::FrontendStatus& new_status);
+  void prewarm_frame_pool();  // 按 ROI 预分配帧缓冲
+  void handle_frame(const std::shared_ptr<CapturedFrame>& frame);
   protocol::FrontendStatus current_status_;
 
   dvpHandle handle_ = 0;
@@ -88,14 +101,19 @@ class DvpCameraCapture : public CameraCapture {
   std::shared_ptr<DvpConfig> config_;
   mutable std::shared_mutex config_mutex_;
   mutable std::shared_mutex status_mutex_;
+  std::atomic<bool> frame_queue_enabled_{false};
   moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>> frame_queue_;
+  FrameBufferPool frame_pool_;  // 帧缓冲池，回调线程从这里取帧
 
 // 结果队列
 #ifdef SAVE_RESULT_IMAGE_QUEUE
   moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>> result_queue_;
 #endif
 
-  BS::thread_pool<> thread_pool_{std::thread::hardware_concurrency()};
-  FrameProcessor user_processor_;  // 用户自定义的帧处理器，目前最多只有一个
+  ExecutionBinding workers_;  // 处理线程池，默认与其他相机共用
+  // 用户自定义的帧处理器，目前最多只有一个；多个算法用 AlgoGraph 组合
+  std::atomic<std::shared_ptr<FrameProcessor>> user_processor_;
   std::unique_ptr<DvpEventManager> event_manager_;
+  // 放在线程池和处理器之后，析构时最先停止
+  FramePipeline pipeline_;
 };
@@ -0,0 +1,96 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ExecutionTopology.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "cameras/WorkerPool.hpp"
+#include "config/CameraConfig.hpp"
+
+/**
+ * @brief 解析 CPU 列表，如 "0-3,8,10-11"
+ * @throw std::invalid_argument 格式错误
+ */
+std::vector<int> parse_cpu_list(const std::string& text);
+
+// NUMA 节点包含的逻辑 CPU，无法获取时返回空
+std::vector<int> numa_node_cpus(int node);
+
+// 把当前线程绑定到给定的逻辑 CPU，平台不支持或失败时返回 false
+bool pin_current_thread(const std::vector<int>& cpus);
+
+/**
+ * @brief 节点级执行拓扑：按名字管理处理线程池
+ *
+ * 以前每个相机各建一个 CPU 核数大小的线程池，N 个相机就是 N 倍超额订阅。
+ * 现在默认所有相机共用一个 CPU 核数大小的 shared 池；也可以给相机指定
+ * 不同的池名并绑定各自的 CPU（或 NUMA 节点），把相机隔离到不同的核上。
+ * 池在最后一个使用它的相机释放后销毁。
+ */
+class ExecutionTopology {
+ public:
+  static ExecutionTopology& instance();
+
+  /**
+   * @brief 取得配置对应的线程池，同名的池已存在时直接复用
+   * @note 同名池以第一次创建时的线程数和绑核为准，配置不一致时输出警告
+   */
+  std::shared_ptr<WorkerPool> acquire(const ExecutionConfig& config);
+
+ private:
+  ExecutionTopology() = default;
+
+  std::mutex mutex_;
+  std::unordered_map<std::string, std::weak_ptr<WorkerPool>> pools_;
+};
+
+/**
+ * @brief 相机持有的调度通道
+ *
+ * 未调用 configure() 时，第一次提交任务才在 shared 池里建通道，
+ * 因此按配置切换到独立池的相机不会顺带创建用不上的 shared 池。
+ */
+class ExecutionBinding {
+ public:
+  // 运行中调用也安全，已提交的任务仍在原来的通道里执行
+  void configure(const ExecutionConfig& config);
+
+  std::shared_ptr<WorkerPool::Lane> lane();
+  std::shared_ptr<WorkerPool> pool() { return lane()->pool(); }
+
+  void submit(WorkerPool::Task task) { lane()->submit(std::move(task)); }
+
+ private:
+  std::atomic<std::shared_ptr<WorkerPool::Lane>> lane_;
+};
@@ -0,0 +1,97 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FeatureReorderBuffer.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include "algo/LatencyHistogram.hpp"
+#include "cameras/ImageSignalBus.hpp"
+
+struct FeatureReorderConfig {
+  // 每个相机最多暂存的结果数（向上取 2 的幂），也是允许的最大乱序跨度，
+  // 更晚的结果到达时不再等待最早的缺口
+  size_t window = 64;
+  // 缺口（丢帧或处理慢的帧）的最长等待时间，从最早暂存的结果到达起算
+  std::chrono::milliseconds timeout{200};
+  // 后台按 timeout/2 检查超时，相机停帧时暂存的结果也能及时放出
+  bool watchdog = true;
+};
+
+struct FeatureReorderStats {
+  uint64_t released = 0;     // 按序放出的结果数
+  uint64_t reordered = 0;    // 乱序到达（同一相机已到过更大序号）的结果数
+  uint64_t skipped = 0;      // 超时或窗口已满时放弃等待的序号数
+  uint64_t late = 0;         // 所在序号已被跳过后才到达、被丢弃的结果数
+  uint64_t unsequenced = 0;  // 没有采集序号、直接放出的结果数
+  size_t pending = 0;        // 当前暂存的结果数
+  algo::LatencySnapshot hold_latency;  // 结果到达到放出的耗时（纳秒）
+};
+
+/**
+ * @brief 特征结果重排：按帧的采集序号把各相机的结果恢复成采集顺序
+ *
+ * 同一相机的帧在线程池上并行处理，emit_feature 的先后与采集顺序无关。
+ * push() 收到结果后按 (stream_id, camera_id) 分到各相机的窗口，
+ * 驱动名写死相机 ID 的多台相机也各自排序。序号连续的结果立即
+ * 放出，前面有缺口的先暂存。缺口等待超过 timeout，或乱序跨度超过 window
+ * 时跳过缺口；跳过之后才到达的结果视为迟到并丢弃，保证放出顺序严格递增。
+ *
+ * 相机的第一个结果不作为起点直接放出，而是暂存一个 timeout，
+ * 让并行处理中更早的帧有机会先到。sequence 为 0 的结果（如按文件或
+ * 流式检测产生的）不参与排序，直接放出。回调串行执行，不持有内部锁。
+ */
+class FeatureReorderBuffer {
+ public:
+  using FeatureData = ImageSignalBus::FeatureData;
+  using Handler = std::function<void(const FeatureData&)>;
+
+  explicit FeatureReorderBuffer(Handler handler,
+                                const FeatureReorderConfig& config = {});
+  ~FeatureReorderBuffer();
+
+  FeatureReorderBuffer(const FeatureReorderBuffer&) = delete;
+  FeatureReorderBuffer& operator=(const FeatureReorderBuffer&) = delete;
+
+  // 任意线程调用，可以直接作为 subscribe_feature 的回调
+  void push(FeatureData data);
+
+  // 不推送新结果，只检查超时
+  void poll();
+
+  // 放弃所有缺口，按序放出全部暂存的结果（如停止检测时）
+  void flush();
+
+  FeatureReorderStats stats() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
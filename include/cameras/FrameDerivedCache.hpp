@@ -0,0 +1,135 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameDerivedCache.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief 附着在单帧上的派生数据缓存（灰度图、裁剪区域等中间结果）
+ *
+ * 每个键只计算一次：并发请求同一个键时只有一个线程执行计算，
+ * 其余线程等待并拿到同一份只读结果。计算抛出异常时不缓存，下次请求重试。
+ * 缓存随帧释放（或归还帧池）一起清空；拷贝帧时不复制缓存，副本按需重算。
+ */
+class FrameDerivedCache {
+ public:
+  FrameDerivedCache() = default;
+  FrameDerivedCache(const FrameDerivedCache&) noexcept {}
+  FrameDerivedCache& operator=(const FrameDerivedCache&) noexcept {
+    // 帧内容被整体替换，旧的派生数据随之失效
+    clear();
+    return *this;
+  }
+
+  /**
+   * @brief 取出键对应的结果，不存在时调用 compute() 计算并缓存
+   * @param compute 返回 T 或 std::shared_ptr<const T>
+   * @return 同一个键以不同类型请求时返回空
+   */
+  template <typename T, typename Compute>
+  std::shared_ptr<const T> get_or_compute(const std::string& key,
+                                          Compute&& compute) {
+    auto entry = find_or_insert(key);
+    std::call_once(entry->once, [&]() {
+      entry->value = to_shared<T>(std::forward<Compute>(compute)());
+      entry->type = std::type_index(typeid(T));
+      entry->ready.store(true, std::memory_order_release);
+    });
+    if (entry->type != std::type_index(typeid(T))) {
+      return nullptr;
+    }
+    return std::static_pointer_cast<const T>(entry->value);
+  }
+
+  // 只查询已经算好的结果，不触发计算
+  template <typename T>
+  std::shared_ptr<const T> find(const std::string& key) const {
+    std::shared_ptr<Entry> entry;
+    {
+      std::lock_guard lock(mutex_);
+      auto it = entries_.find(key);
+      if (it == entries_.end()) {
+        return nullptr;
+      }
+      entry = it->second;
+    }
+    if (!entry->ready.load(std::memory_order_acquire) ||
+        entry->type != std::type_index(typeid(T))) {
+      return nullptr;
+    }
+    return std::static_pointer_cast<const T>(entry->value);
+  }
+
+  // 直接放入外部算好的结果，键已存在时保留原值
+  template <typename T>
+  void put(const std::string& key, std::shared_ptr<const T> value) {
+    get_or_compute<T>(key, [&value]() { return std::move(value); });
+  }
+
+  void clear() {
+    std::lock_guard lock(mutex_);
+    entries_.clear();
+  }
+
+ private:
+  struct Entry {
+    std::once_flag once;
+    std::atomic<bool> ready{false};
+    std::shared_ptr<const void> value;
+    std::type_index type{typeid(void)};
+  };
+
+  template <typename T, typename R>
+  static std::shared_ptr<const T> to_shared(R&& result) {
+    using Result = std::decay_t<R>;
+    if constexpr (std::is_convertible_v<Result, std::shared_ptr<const T>>) {
+      return std::forward<R>(result);
+    } else {
+      return std::make_shared<const T>(std::forward<R>(result));
+    }
+  }
+
+  std::shared_ptr<Entry> find_or_insert(const std::string& key) {
+    std::lock_guard lock(mutex_);
+    auto& entry = entries_[key];
+    if (!entry) {
+      entry = std::make_shared<Entry>();
+    }
+    return entry;
+  }
+
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_ptr<Entry>> entries_;
+};
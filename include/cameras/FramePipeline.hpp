@@ -0,0 +1,117 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FramePipeline.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "cameras/FrameProcessor.hpp"
+#include "config/CameraConfig.hpp"
+
+// 单个相机流水线的运行计数
+struct FramePipelineStats {
+  uint64_t enqueued = 0;   // 进入队列的帧数
+  uint64_t dropped = 0;    // 因溢出或抽帧被丢弃的帧数
+  uint64_t processed = 0;  // 处理完成的帧数
+  size_t depth = 0;        // 当前排队帧数
+  size_t high_water = 0;   // 历史最大排队帧数
+};
+
+/**
+ * @brief 采集回调与 FrameProcessor::process 之间的有界流水线
+ *
+ * 采集线程调用 push() 入队，队列满时按 FrameOverflowPolicy 处理；
+ * 处理任务通过 Executor 提交（相机所属的处理线程池，见 ExecutionTopology），
+ * 同时在跑的任务数不超过 max_in_flight，因此内存占用上限为
+ * capacity + max_in_flight 帧。每个任务只处理一帧，还有积压时重新提交，
+ * 多个相机共用线程池时由池的调度决定下一帧处理哪个相机。
+ *
+ * 帧出队交给处理任务时按顺序写入 meta.sequence，并写入本流水线的
+ * meta.stream_id。溢出或抽帧丢弃的帧不占序号，下游按序号重排结果时
+ * 不会因为丢帧等待缺口。
+ */
+class FramePipeline {
+ public:
+  using Task = std::function<void()>;
+  using Executor = std::function<void(Task)>;
+  using Handler = std::function<void(const std::shared_ptr<CapturedFrame>&)>;
+
+  FramePipeline(Executor executor, Handler handler,
+                const FramePipelineConfig& config = {});
+  ~FramePipeline();
+
+  FramePipeline(const FramePipeline&) = delete;
+  FramePipeline& operator=(const FramePipeline&) = delete;
+
+  /**
+   * @brief 提交一帧
+   * @return 帧被接收返回 true，被丢弃或流水线已停止返回 false
+   * @note Block 策略下可能阻塞调用线程
+   */
+  bool push(std::shared_ptr<CapturedFrame> frame);
+
+  // 运行时调整配置，缩容时保留最新的帧
+  void set_config(const FramePipelineConfig& config);
+  FramePipelineConfig get_config() const;
+
+  FramePipelineStats stats() const;
+
+  // 重新开始接收帧
+  void start();
+  // 停止接收并丢弃排队的帧，等待正在处理的帧完成
+  void stop();
+
+ private:
+  void drain();
+  std::shared_ptr<CapturedFrame> pop_front_locked();
+  size_t effective_max_in_flight() const;
+
+  Executor executor_;
+  Handler handler_;
+  FramePipelineConfig config_;
+  const uint64_t stream_id_;  // 进程内唯一，区分各流水线的序号空间
+
+  mutable std::mutex mutex_;
+  std::condition_variable not_full_;
+  std::condition_variable idle_;
+
+  // 固定容量的环形队列，稳态下不分配内存
+  std::vector<std::shared_ptr<CapturedFrame>> ring_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+
+  size_t active_workers_ = 0;
+  uint64_t sample_counter_ = 0;
+  uint64_t sequence_ = 0;  // 最近一帧出队时分配的序号
+  bool stopped_ = false;
+  FramePipelineStats stats_;
+};
@@ -0,0 +1,77 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FramePool.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "cameras/FrameProcessor.hpp"
+
+namespace detail {
+struct FramePoolState;
+}  // namespace detail
+
+/**
+ * @brief 按帧字节数分桶的 CapturedFrame 缓冲池
+ *
+ * acquire() 返回的 shared_ptr 在最后一个引用释放时自动把帧放回池中，
+ * 连同 shared_ptr 控制块一起复用，稳态下每帧不产生堆分配。
+ * 池对象可以先于帧析构，未归还的帧会在释放时自行清理。
+ *
+ * 线程安全：acquire 和帧的释放可以在任意线程进行
+ */
+class FrameBufferPool {
+ public:
+  struct Stats {
+    uint64_t hits = 0;    // 命中缓存的次数
+    uint64_t misses = 0;  // 需要新分配的次数
+  };
+
+  explicit FrameBufferPool(size_t max_cached_per_size = 16);
+
+  /**
+   * @brief 预分配指定大小的帧，通常在相机启动时按 ROI 调用
+   * @param bytes 单帧字节数
+   * @param count 预分配数量（不超过 max_cached_per_size）
+   */
+  void reserve(size_t bytes, size_t count);
+
+  /**
+   * @brief 获取一帧 data.size() == bytes 的缓冲区
+   * @note 元信息已清空，像素内容为上一次使用的残留，调用方负责整体覆盖
+   */
+  std::shared_ptr<CapturedFrame> acquire(size_t bytes);
+
+  // 当前缓存中某个尺寸的空闲帧数量
+  size_t cached_count(size_t bytes) const;
+
+  Stats stats() const;
+
+ private:
+  std::shared_ptr<detail::FramePoolState> state_;
+};
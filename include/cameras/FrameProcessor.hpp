@@ -32,6 +32,8 @@
 #include <utility>
 #include <vector>
 
+#include "cameras/FrameDerivedCache.hpp"
+
 // 通用帧元信息结构，不依赖特定相机类型
 struct FrameMetadata {
   int iWidth = 0;           // 图像宽度
@@ -44,13 +46,26 @@ struct FrameMetadata {
   std::string cameraId;     // 相机ID
   int bitDepth = 0;         // 位深
   double frameRate = 0.0;   // 帧率
+  // 相机内的处理序号，帧流水线出队时按采集顺序编号，从 1 开始，
+  // 被流水线丢弃的帧不占序号；0 表示未经流水线
+  uint64_t sequence = 0;
+  // 分配 sequence 的流水线编号，进程内唯一；cameraId 相同的两个相机
+  // 也能靠它区分序号空间
+  uint64_t stream_id = 0;
   // 可以根据需要添加更多通用字段
 };
 
 // 帧数据结构,无关于相机类型
-struct CapturedFrame {
+// 由共享指针持有时（相机流水线、帧池）可以通过 weak_from_this() 延长寿命
+struct CapturedFrame : std::enable_shared_from_this<CapturedFrame> {
   std::vector<uint8_t> data;  // 图像数据
   FrameMetadata meta;         // 通用元信息（宽/高/格式/曝光等）
+  // 多个算法共享的派生数据，处理线程只读访问帧时也可以填充
+  mutable FrameDerivedCache derived;
+
+  // 声明默认构造，使 CapturedFrame{} 走值初始化而不是聚合初始化：
+  // 聚合初始化会在调用方直接构造 enable_shared_from_this，而它的构造函数受保护
+  CapturedFrame() = default;
 
   // 便捷访问
   int width() const { return meta.iWidth; }
@@ -63,6 +78,7 @@ struct CapturedFrame {
   std::string camera_id() const { return meta.cameraId; }
   int bit_depth() const { return meta.bitDepth; }
   double frame_rate() const { return meta.frameRate; }
+  uint64_t sequence() const { return meta.sequence; }
 };
 
 // 帧处理器接口
@@ -74,6 +90,24 @@ class FrameProcessor {
     // 默认空实现
   }
 
+  /**
+   * @brief 以共享引用接收帧，相机流水线走这个入口
+   *
+   * 需要在回调返回后继续持有帧的处理器（如多相机同步）覆盖它，
+   * 直接保存引用而不拷贝像素；默认转给 process()。
+   */
+  virtual void process_shared(const std::shared_ptr<CapturedFrame>& frame) {
+    process(*frame);
+  }
+
+  /**
+   * @brief 复制出一份独立持有的处理器
+   *
+   * 相机和构建器按基类引用接收处理器，保存时通过它保留派生类型。
+   * 纯虚函数：派生类必须覆盖，不会再悄悄保存一个被切片的空处理器。
+   */
+  virtual std::shared_ptr<FrameProcessor> clone() const = 0;
+
   // 添加默认构造函数以允许赋值
   FrameProcessor() = default;
   // 添加拷贝构造函数和赋值操作符
@@ -89,6 +123,10 @@ class FunctionFrameProcessor : public FrameProcessor {
 
   void process(const CapturedFrame& frame) override { func_(frame); }
 
+  std::shared_ptr<FrameProcessor> clone() const override {
+    return std::make_shared<FunctionFrameProcessor>(*this);
+  }
+
  private:
   Func func_;
 };
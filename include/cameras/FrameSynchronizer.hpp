@@ -0,0 +1,116 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameSynchronizer.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "algo/LatencyHistogram.hpp"
+#include "cameras/FrameProcessor.hpp"
+
+// 等不齐一组帧时的处理方式
+enum class SyncTimeoutPolicy {
+  EmitPartial,    // 到达的相机不少于 min_cameras 时发出不完整的一组
+  DropIncomplete  // 丢弃不完整的一组
+};
+
+struct FrameSyncConfig {
+  uint64_t tolerance = 1000;  // 同一组帧键值的最大偏差（默认键为微秒时间戳）
+  // 从一组的首帧到达起，等待缺失相机的时长
+  std::chrono::milliseconds timeout{50};
+  SyncTimeoutPolicy timeout_policy = SyncTimeoutPolicy::EmitPartial;
+  size_t min_cameras = 1;     // EmitPartial 时至少需要的相机数
+  // 每个相机入队环的容量（向上取 2 的幂），也是等待匹配的帧数上限，
+  // 积压超过它时最早的一组不再等待超时
+  size_t ring_capacity = 16;
+  // 后台按 timeout/2 检查超时，所有相机都停帧时也能及时发出
+  bool watchdog = true;
+  // 每个相机只由一个线程按键值顺序推送时置 true：缺失的相机已送来更晚的帧
+  // 即可判定这一组凑不齐，不必等到超时。流水线并发处理同一相机时帧可能乱序，
+  // 保持 false，只按超时判断
+  bool in_order = false;
+};
+
+// 匹配好的一组帧，frames 按相机序号排列，缺失的相机为空
+struct SyncedFrameSet {
+  std::vector<std::shared_ptr<const CapturedFrame>> frames;
+  uint64_t key = 0;   // 组内最小键值
+  uint64_t skew = 0;  // 组内最大与最小键值之差
+  bool partial = false;
+};
+
+struct FrameSyncStats {
+  uint64_t complete_sets = 0;
+  uint64_t partial_sets = 0;
+  uint64_t dropped_sets = 0;    // 不完整且按策略丢弃的组
+  uint64_t dropped_frames = 0;  // 入队环已满或迟到（所属组已发出）的帧
+  algo::LatencySnapshot skew;            // 组内键值偏差分布，单位同键值
+  algo::LatencySnapshot fusion_latency;  // 首帧到达到整组发出的耗时（纳秒）
+};
+
+/**
+ * @brief 多相机帧同步器：按时间戳（或自定义键，如触发计数）把各相机的帧配成组
+ *
+ * 每个相机一个无锁有界环形队列，push() 只入队帧的共享引用，不拷贝像素。
+ * 入队后尝试取得匹配权，同一时刻只有一个线程做匹配并调用回调，
+ * 其余线程入队后立即返回；回调按组的先后顺序串行执行。
+ *
+ * 匹配规则：以各相机最早待匹配帧中的最小键值为参考，每个相机取
+ * [参考, 参考 + tolerance] 内最早的一帧。所有相机到齐即发出；等待超过
+ * timeout（in_order 时缺失的相机已送来更晚的帧也算），则按策略发出
+ * 不完整的一组或丢弃。同一相机乱序到达的帧在等待期间按键值重排。
+ */
+class FrameSynchronizer {
+ public:
+  using KeyFunc = std::function<uint64_t(const CapturedFrame&)>;
+  using SetHandler = std::function<void(const SyncedFrameSet&)>;
+
+  // key 为空时使用 meta.uTimestamp
+  FrameSynchronizer(size_t num_cams, SetHandler handler,
+                    const FrameSyncConfig& config = {}, KeyFunc key = {});
+  ~FrameSynchronizer();
+
+  FrameSynchronizer(const FrameSynchronizer&) = delete;
+  FrameSynchronizer& operator=(const FrameSynchronizer&) = delete;
+
+  // 任意线程调用；同一相机可以被多个线程并发推送
+  void push(size_t cam_index, std::shared_ptr<const CapturedFrame> frame);
+
+  // 不推送新帧，只检查超时
+  void poll();
+
+  FrameSyncStats stats() const;
+  size_t camera_count() const;
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
@@ -141,7 +141,7 @@ class IkapCameraBuilder {
     std::optional<uint32_t> link_timeout;
 
     // 事件/帧处理器
-    std::vector<FrameProcessor> frame_processors;
+    std::vector<std::shared_ptr<FrameProcessor>> frame_processors;
     std::unordered_map<IkapEventType, IkapEventHandler> event_handlers;
   };
   Config config_;
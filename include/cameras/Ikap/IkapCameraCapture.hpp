@@ -30,9 +30,11 @@
 #include <shared_mutex>
 #include <thread>
 
-#include "BS_thread_pool.hpp"
 #include "IKapCDef.h"
 #include "cameras/CameraCapture.hpp"
+#include "cameras/ExecutionTopology.hpp"
+#include "cameras/FramePipeline.hpp"
+#include "cameras/FramePool.hpp"
 #include "cameras/FrameProcessor.hpp"
 #include "cameras/Ikap/IkapConfig.hpp"
 #include "cameras/Ikap/IkapEventManager.hpp"
@@ -54,9 +56,15 @@ class IkapCameraCapture : public CameraCapture {
 
   void register_event_handler(IkapEventType type, IkapEventHandler handler);
   void add_frame_processor(const FrameProcessor& processor) override;
+  void set_pipeline_config(const FramePipelineConfig& config) override;
+  void set_execution_config(const ExecutionConfig& config) override;
+  FramePipelineStats get_pipeline_stats() const override;
   protocol::FrontendStatus get_status() const override;
 
   IkapEventManager* get_event_manager() const { return event_manager_.get(); }
+  void set_frame_queue_enabled(bool enabled) override {
+    frame_queue_enabled_.store(enabled);
+  }
   moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>>& get_frame_queue()
       override {
     return frame_queue_;
@@ -68,6 +76,7 @@ class IkapCameraCapture : public CameraCapture {
   void process_frame(ITKBUFFER buffer);
   void update_camera_params();
   void update_status(const protocol::FrontendStatus& status);
+  void prewarm_frame_pool();  // 按 ROI 预分配帧缓冲
 
   protocol::FrontendStatus current_status_;
   ITKDEVICE handle_ = nullptr;
@@ -77,8 +86,13 @@ class IkapCameraCapture : public CameraCapture {
   std::shared_ptr<IkapConfig> config_;  // 替换为IkapConfig，和DVP的config_一致
   mutable std::shared_mutex config_mutex_;
   mutable std::shared_mutex status_mutex_;
+  std::atomic<bool> frame_queue_enabled_{false};
   moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>> frame_queue_;
+  FrameBufferPool frame_pool_;  // 帧缓冲池，流回调从这里取帧
 
-  BS::thread_pool<> thread_pool_{std::thread::hardware_concurrency()};
-  FrameProcessor user_processor_;
+  ExecutionBinding workers_;  // 处理线程池，默认与其他相机共用
+  // 运行中可以替换，处理线程按快照读取
+  std::atomic<std::shared_ptr<FrameProcessor>> user_processor_;
+  // 放在线程池和处理器之后，析构时最先停止
+  FramePipeline pipeline_;
 };
@@ -27,6 +27,7 @@
 // ImageSignalBus.hpp
 #pragma once
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <shared_mutex>
@@ -37,15 +38,39 @@
 // cv
 #include <opencv2/core/mat.hpp>
 
+#include "cameras/AsyncDelivery.hpp"
+#include "cameras/SignalTable.hpp"
+
+struct CapturedFrame;
+
 class ImageSignalBus {
  public:
   using ImageCallback = std::function<void(const cv::Mat&)>;
 
+  // 引用计数的只读图像，所有订阅者共享同一块像素缓冲区
+  using SharedImage = std::shared_ptr<const cv::Mat>;
+  using SharedImageCallback = std::function<void(const SharedImage&)>;
+
+  /**
+   * @brief 图像投递方式
+   *
+   * PrivateCopy: 订阅者拿到自己独占的深拷贝，可以随意修改（默认）
+   * Shared: 订阅者拿到共享缓冲区的只读视图，不产生拷贝；
+   * 回调中不能修改图像，也不能在发射方原地改写后继续持有这个视图
+   */
+  enum class ImageDelivery { Shared, PrivateCopy };
+
   struct FeatureData {
     std::string roll_id;
     std::vector<std::pair<int, float>> features;
     std::array<float, 20> special_images;
     std::string camera_id;
+    // 产生该结果的帧的采集序号，用于按采集顺序重排，0 表示不参与重排
+    uint64_t sequence = 0;
+    // sequence 所属的序号空间（帧流水线编号），0 时只按 camera_id 区分
+    uint64_t stream_id = 0;
+    // 产生该结果的帧，只在需要随上报发送图片时附带，可能为空
+    std::shared_ptr<const CapturedFrame> frame;
   };
 
   struct StatusData {
@@ -58,6 +83,24 @@ class ImageSignalBus {
   using FeatureCallback = std::function<void(const FeatureData&)>;
   using StatusCallback = std::function<void(const StatusData&)>;
 
+  /**
+   * @brief 预解析的信号句柄
+   *
+   * 由 declare_* 返回，内部只是信号表下标。按句柄 emit 不加锁也不哈希信号名，
+   * 适合每帧都要发射的算法线程。句柄只在签发它的总线实例上有效，
+   * 默认构造的句柄无效，对其 emit 什么也不做。
+   */
+  template <typename Tag>
+  struct SignalHandle {
+    uint32_t index = SignalTable<Tag>::kInvalidIndex;
+    bool valid() const noexcept {
+      return index != SignalTable<Tag>::kInvalidIndex;
+    }
+  };
+  using ImageSignal = SignalHandle<SharedImageCallback>;
+  using FeatureSignal = SignalHandle<FeatureCallback>;
+  using StatusSignal = SignalHandle<StatusCallback>;
+
   // 单例
   /**
    * @brief 获取ImageSignalBus实例
@@ -70,35 +113,93 @@ class ImageSignalBus {
 
   static ImageSignalBus& instance(const std::string& ns = "default");
 
-  // 算法调用：声明自己能提供哪些信号
-  void declare_signal(const std::string& signal_name);
+  // 算法调用：声明自己能提供哪些信号，返回的句柄可缓存下来用于 emit
+  ImageSignal declare_signal(const std::string& signal_name);
+  FeatureSignal declare_feature(const std::string& name);
+  StatusSignal declare_status(const std::string& name);
+
+  /**
+   * @brief UI 或其他模块调用：订阅某个信号
+   *
+   * @param delivery 默认给每个订阅者一份深拷贝，与原有行为一致；
+   * 确认回调只读且不跨帧持有图像时，可显式传入 ImageDelivery::Shared 省去拷贝
+   */
+  void subscribe(const std::string& signal_name, ImageCallback callback,
+                 ImageDelivery delivery = ImageDelivery::PrivateCopy);
 
-  // UI 或其他模块调用：订阅某个信号
-  void subscribe(const std::string& signal_name, ImageCallback callback);
+  // 订阅共享图像本身，适合需要跨线程持有图像的订阅者（如 GUI 预览）
+  void subscribe_shared(const std::string& signal_name,
+                        SharedImageCallback callback);
 
-  // 算法内部调用：广播图像（自动深拷贝）
+  /**
+   * @brief 异步订阅：回调在订阅者自己的投递线程上执行
+   *
+   * 发射线程只负责入队，慢订阅者（GUI 预览、网络转发）不会阻塞算法线程。
+   * 默认只保留最新一帧；返回的句柄可查询积压统计或停止投递，可以忽略。
+   */
+  std::shared_ptr<AsyncSubscription> subscribe_async(
+      const std::string& signal_name, SharedImageCallback callback,
+      const AsyncDeliveryConfig& config = {});
+
+  /**
+   * @brief 算法内部调用：广播图像
+   *
+   * 共享给订阅者的缓冲区最多拷贝一次，与订阅者数量无关：
+   * - img 自己持有引用计数缓冲区时直接共享，不拷贝
+   * - img 引用外部内存（如 CapturedFrame 的缓冲区）时拷贝一次再共享；
+   *   PrivateCopy 订阅者直接从原视图拷贝自己的副本，全是这类订阅者时
+   *   不再额外拷贝共享缓冲区
+   * @note 图像被广播后，调用方不应再原地修改其像素
+   */
   void emit(const std::string& signal_name, const cv::Mat& img);
 
+  // 算法内部调用：广播已经共享的图像，零拷贝
+  void emit(const std::string& signal_name, const SharedImage& img);
+
+  /**
+   * @brief 按句柄广播，语义与字符串版本相同
+   * @note 回调在发射线程上执行，但不持有总线的任何锁，
+   * 回调中可以继续订阅或发射；期间新增的订阅从下一次 emit 开始生效
+   */
+  void emit(ImageSignal signal, const cv::Mat& img);
+  void emit(ImageSignal signal, const SharedImage& img);
+
   // 与服务器之间通信：订阅特征和状态
   void subscribe_feature(const std::string& name, FeatureCallback cb);
   void subscribe_status(const std::string& name, StatusCallback cb);
+  // 特征的异步订阅，默认不丢弃（Lossless），积压超过 64 条开始告警，
+  // 达到 256 条时发射线程等待投递线程腾出空间
+  std::shared_ptr<AsyncSubscription> subscribe_feature_async(
+      const std::string& name, FeatureCallback cb,
+      const AsyncDeliveryConfig& config = {64, DeliveryOverflow::Lossless,
+                                           256});
   void emit_feature(const std::string& name, const FeatureData& data);
   void emit_status(const std::string& name, const StatusData& data);
+  void emit_feature(FeatureSignal signal, const FeatureData& data);
+  void emit_status(StatusSignal signal, const StatusData& data);
 
  private:
   ImageSignalBus() = default;
   ImageSignalBus(const ImageSignalBus&) = delete;
   ImageSignalBus& operator=(const ImageSignalBus&) = delete;
 
-  // 图像信号
-  std::unordered_map<std::string, std::vector<ImageCallback>> subscribers_;
-  // 数据信号
-  std::unordered_map<std::string, std::vector<FeatureCallback>>
-      feature_subscribers_;
-  std::unordered_map<std::string, std::vector<StatusCallback>>
-      status_subscribers_;
+  // 图像订阅者；private_copy 的回调当场深拷贝、不持有收到的图像，
+  // 外部内存的视图可以直接交给它，不必先拷成共享缓冲区
+  struct ImageSubscriber {
+    SharedImageCallback callback;
+    bool private_copy = false;
+  };
+
+  void add_subscriber(const std::string& signal_name,
+                      ImageSubscriber subscriber);
+  void dispatch(const SignalTable<ImageSubscriber>::Snapshot& subscribers,
+                const SharedImage& img);
 
-  mutable std::shared_mutex mutex_;
+  // 图像信号，普通回调在订阅时按投递方式包装成共享回调
+  SignalTable<ImageSubscriber> subscribers_;
+  // 数据信号
+  SignalTable<FeatureCallback> feature_subscribers_;
+  SignalTable<StatusCallback> status_subscribers_;
 
   // 改成存储 unique_ptr
   static std::unordered_map<std::string, std::unique_ptr<ImageSignalBus>>
@@ -25,78 +25,101 @@
  */
 
 #pragma once
-#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <functional>
 #include <memory>
-#include <mutex>
 #include <utility>
-#include <vector>
 
 #include "cameras/FrameProcessor.hpp"
-
-class CapturedFrame;
+#include "cameras/FrameSynchronizer.hpp"
 
 // MultiCameraCoordinator.hpp
+/**
+ * @brief 多相机协调器：各相机的帧经 FrameSynchronizer 按时间戳配组后融合
+ *
+ * 每个相机用 make_processor_for(i) 取得自己的处理器，帧以共享引用入队，
+ * 配好的一组交给融合函数，融合结果再交给下游处理器。等不齐时按
+ * FrameSyncConfig 的超时策略发出不完整的一组（缺失的相机为空指针）或丢弃。
+ */
 class MultiCameraCoordinator {
  public:
-  using FusionFunc =
-      std::function<CapturedFrame(const std::vector<CapturedFrame>&)>;
-
-  MultiCameraCoordinator(size_t num_cams, FusionFunc fuse_func)
-      : frames_(num_cams),
-        received_(num_cams, false),
-        fuse_func_(std::move(fuse_func)) {}
-
-  // 返回 FrameProcessor（实际是 FunctionFrameProcessor）
-  FrameProcessor make_processor_for(size_t cam_index) {
-    // 创建 lambda
-    auto lambda = [this, cam_index](const CapturedFrame& frame) {
-      this->on_frame(cam_index, frame);
-    };
-    // 用工具函数包装成 FrameProcessor
-    return make_function_processor(std::move(lambda));
+  using FusionFunc = std::function<CapturedFrame(const SyncedFrameSet&)>;
+
+  MultiCameraCoordinator(size_t num_cams, FusionFunc fuse_func,
+                         const FrameSyncConfig& config = {},
+                         FrameSynchronizer::KeyFunc key = {})
+      : shared_(std::make_shared<Shared>()) {
+    shared_->fuse_func = std::move(fuse_func);
+    // 回调只持有 Shared 的弱引用，协调器析构后不会再触发融合
+    std::weak_ptr<Shared> weak = shared_;
+    sync_ = std::make_shared<FrameSynchronizer>(
+        num_cams,
+        [weak](const SyncedFrameSet& set) {
+          if (auto shared = weak.lock()) {
+            shared->on_set(set);
+          }
+        },
+        config, std::move(key));
+  }
+
+  // 相机 cam_index 专用的处理器，可以按值传给相机，复制后仍指向同一个同步器
+  class CameraProcessor : public FrameProcessor {
+   public:
+    CameraProcessor(std::shared_ptr<FrameSynchronizer> sync, size_t cam_index)
+        : sync_(std::move(sync)), cam_index_(cam_index) {}
+
+    // 只拿到引用时不得不拷贝一份
+    void process(const CapturedFrame& frame) override {
+      sync_->push(cam_index_, std::make_shared<const CapturedFrame>(frame));
+    }
+
+    void process_shared(const std::shared_ptr<CapturedFrame>& frame) override {
+      sync_->push(cam_index_, frame);
+    }
+
+    std::shared_ptr<FrameProcessor> clone() const override {
+      return std::make_shared<CameraProcessor>(*this);
+    }
+
+   private:
+    std::shared_ptr<FrameSynchronizer> sync_;
+    size_t cam_index_;
+  };
+
+  CameraProcessor make_processor_for(size_t cam_index) {
+    return CameraProcessor(sync_, cam_index);
   }
 
   // 重载make_processor_for的括号函数
-  FrameProcessor operator[](size_t cam_index) {
+  CameraProcessor operator[](size_t cam_index) {
     return make_processor_for(cam_index);
   }
 
- private:
-  void on_frame(size_t cam_index, const CapturedFrame& frame) {
-    std::lock_guard lock(mutex_);
-    frames_[cam_index] = frame;
-    received_[cam_index] = true;
-
-    if (std::all_of(received_.begin(), received_.end(),
-                    [](bool b) { return b; })) {
-      // 所有帧到齐，执行融合
-      auto fused = fuse_func_(frames_);
+  void set_downstream_processor(std::unique_ptr<FrameProcessor> proc) {
+    shared_->downstream.store(std::shared_ptr<FrameProcessor>(std::move(proc)));
+  }
 
-      // 融合后做什么？例如：
-      // - 交给算法处理
-      // - 发送到 ImageSignalBus
-      // - 入队供 GUI 显示
+  FrameSyncStats stats() const { return sync_->stats(); }
 
+ private:
+  struct Shared {
+    void on_set(const SyncedFrameSet& set) {
+      if (!fuse_func) {
+        return;
+      }
+      auto fused = fuse_func(set);
       // 处理完后，最后还是要交由通用算法处理
-      if (downstream_processor_) {
-        downstream_processor_->process(fused);
+      if (auto proc = downstream.load()) {
+        proc->process(fused);
       }
-
-      // 重置状态（或加超时机制）
-      std::fill(received_.begin(), received_.end(), false);
     }
-  }
 
-  std::vector<CapturedFrame> frames_;
-  std::vector<bool> received_;
-  FusionFunc fuse_func_;
-  std::unique_ptr<FrameProcessor> downstream_processor_;
-  std::mutex mutex_;
+    FusionFunc fuse_func;
+    std::atomic<std::shared_ptr<FrameProcessor>> downstream;
+  };
 
- public:
-  void set_downstream_processor(std::unique_ptr<FrameProcessor> proc) {
-    downstream_processor_ = std::move(proc);
-  }
+  std::shared_ptr<Shared> shared_;
+  // 不放进 Shared：回调里释放 Shared 时不能连带析构同步器
+  std::shared_ptr<FrameSynchronizer> sync_;
 };
@@ -0,0 +1,81 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameRecorder.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "cameras/FrameProcessor.hpp"
+
+struct FrameRecorderConfig {
+  std::string path;                // 输出文件，建议使用 .cfpr 扩展名
+  size_t chunk_bytes = 8u << 20;   // 每次顺序写入的块大小
+  size_t max_pending_chunks = 4;   // 等待落盘的最大块数，超出后丢帧
+};
+
+struct FrameRecorderStats {
+  uint64_t frames_written = 0;  // 已进入块缓冲的帧数
+  uint64_t frames_dropped = 0;  // 磁盘跟不上或写入失败丢弃的帧数
+  uint64_t bytes_written = 0;   // 已写到文件的字节数
+};
+
+namespace detail {
+class FrameRecorderImpl;
+}
+
+/**
+ * @brief 把采集到的帧原样录制到分块文件中，配合 RecordingReader 回放
+ *
+ * process() 只把帧拷贝进内存中的块缓冲，写满一块后交给独立的写线程
+ * 整块顺序写入，调用线程不会等待磁盘 IO；写线程跟不上时丢弃新帧并计数。
+ * 拷贝后的 FrameRecorder 共享同一个文件和写线程。
+ */
+class FrameRecorder : public FrameProcessor {
+ public:
+  explicit FrameRecorder(const FrameRecorderConfig& config);
+  ~FrameRecorder() override;
+
+  FrameRecorder(const FrameRecorder&) = default;
+  FrameRecorder& operator=(const FrameRecorder&) = default;
+
+  // 创建文件并启动写线程
+  bool open();
+  // 落盘剩余数据并写入索引，之后的帧被忽略
+  void close();
+  bool is_open() const;
+
+  void process(const CapturedFrame& frame) override;
+  // 相机保存的副本与原对象共享文件和写线程
+  std::shared_ptr<FrameProcessor> clone() const override;
+
+  FrameRecorderStats stats() const;
+
+ private:
+  std::shared_ptr<detail::FrameRecorderImpl> impl_;
+};
@@ -0,0 +1,106 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: RecordingFormat.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 录制文件(.cfpr)的磁盘布局，字段均为本机字节序
+//
+//   FileHeader
+//   Chunk 0: ChunkHeader | FrameRecord | FrameRecord | ...
+//   Chunk 1: ...
+//   IndexEntry[frame_count]
+//   FileFooter
+//
+// FrameRecord = FrameRecordHeader | camera_id | 填充 | 图像数据 | 填充，
+// 图像数据按 kRecordAlignment 对齐，mmap 回放时可直接作为图像缓冲使用。
+// 录制中断导致没有 FileFooter 时，读取端顺序扫描块重建索引。
+namespace recording {
+
+constexpr char kFileMagic[8] = {'C', 'F', 'P', 'R', 'E', 'C', '0', '1'};
+constexpr char kFooterMagic[8] = {'C', 'F', 'P', 'I', 'D', 'X', '0', '1'};
+constexpr uint32_t kChunkMagic = 0x4B4E4843;   // "CHNK"
+constexpr uint32_t kRecordMagic = 0x4D415246;  // "FRAM"
+constexpr uint32_t kFormatVersion = 1;
+constexpr size_t kRecordAlignment = 64;
+
+constexpr size_t align_up(size_t value) {
+  return (value + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t header_bytes;
+  uint8_t reserved[48];
+};
+
+struct ChunkHeader {
+  uint32_t magic;
+  uint32_t frame_count;
+  uint64_t payload_bytes;  // 不含 ChunkHeader 本身
+  uint8_t reserved[48];
+};
+
+struct FrameRecordHeader {
+  uint32_t magic;
+  uint32_t camera_id_bytes;
+  int32_t width;
+  int32_t height;
+  int32_t format;
+  int32_t pixel_format;
+  int32_t bit_depth;
+  int32_t reserved0;
+  double exposure_us;
+  double gain;
+  double frame_rate;
+  uint64_t timestamp;
+  uint64_t data_offset;  // 图像数据相对记录起点的偏移
+  uint64_t data_bytes;
+  uint8_t reserved[48];
+};
+
+struct IndexEntry {
+  uint64_t record_offset;  // 记录在文件中的绝对偏移
+  uint64_t timestamp;
+};
+
+struct FileFooter {
+  uint64_t index_offset;
+  uint64_t frame_count;
+  char magic[8];
+  uint8_t reserved[8];
+};
+
+static_assert(sizeof(FileHeader) == 64);
+static_assert(sizeof(ChunkHeader) == 64);
+static_assert(sizeof(FrameRecordHeader) == 128);
+static_assert(sizeof(IndexEntry) == 16);
+static_assert(sizeof(FileFooter) == 32);
+
+}  // namespace recording
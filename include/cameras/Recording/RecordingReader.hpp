@@ -0,0 +1,84 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: RecordingReader.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cameras/FrameProcessor.hpp"
+#include "cameras/Recording/RecordingFormat.hpp"
+
+// 指向映射内存的只读帧，生命周期不超过所属的 RecordingReader
+struct RecordedFrameView {
+  FrameMetadata meta;
+  const uint8_t* data = nullptr;
+  size_t size = 0;
+};
+
+/**
+ * @brief 以内存映射方式读取 FrameRecorder 生成的录制文件
+ *
+ * 帧数据不做拷贝，直接指向映射区；文件缺少索引（录制中断）时
+ * 顺序扫描完整的块重建索引，截断的尾块被忽略。
+ */
+class RecordingReader {
+ public:
+  RecordingReader() = default;
+  ~RecordingReader();
+
+  RecordingReader(const RecordingReader&) = delete;
+  RecordingReader& operator=(const RecordingReader&) = delete;
+
+  bool open(const std::string& path);
+  void close();
+  bool is_open() const { return base_ != nullptr; }
+
+  size_t size() const { return index_.size(); }
+  RecordedFrameView frame(size_t index) const;
+
+  // 是否有完整的文件尾索引（false 表示索引是扫描重建的）
+  bool has_footer_index() const { return has_footer_index_; }
+
+ private:
+  bool load_footer_index();
+  void rebuild_index();
+  // 检查 offset 处的记录完整落在 [offset, end) 内，索引和扫描共用
+  bool record_in_bounds(uint64_t offset, uint64_t end) const;
+
+  const uint8_t* base_ = nullptr;
+  size_t file_size_ = 0;
+#ifdef _WIN32
+  void* file_handle_ = nullptr;
+  void* mapping_handle_ = nullptr;
+#else
+  int fd_ = -1;
+#endif
+  std::vector<recording::IndexEntry> index_;
+  bool has_footer_index_ = false;
+};
@@ -0,0 +1,134 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FileReplayCameraCapture.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cameras/CameraCapture.hpp"
+#include "cameras/ExecutionTopology.hpp"
+#include "cameras/FramePipeline.hpp"
+#include "cameras/FramePool.hpp"
+#include "cameras/FrameProcessor.hpp"
+#include "cameras/Recording/RecordingReader.hpp"
+#include "cameras/Replay/ReplayConfig.hpp"
+#include "concurrentqueue.h"
+#include "protocol/messages.hpp"
+
+/**
+ * @brief 从磁盘回放图像的相机，不依赖任何相机 SDK
+ *
+ * 回放线程模拟相机的帧回调：从帧池取缓冲、拷贝一次数据、填写元信息，
+ * 然后和真实相机一样放入原始图像队列并交给有界流水线处理。
+ * 用于在没有采集卡的机器上测量完整链路的吞吐。
+ */
+class FileReplayCameraCapture : public CameraCapture {
+ public:
+  FileReplayCameraCapture(std::string camera_id, const ReplayConfig& config);
+  ~FileReplayCameraCapture() override;
+
+  bool start() override;
+  bool start(const FrameProcessor& processor) override;
+  void stop() override;
+  void set_config(const CameraConfig& cfg) override;
+  void set_config(const ReplayConfig& cfg);
+  ReplayConfig get_config() const;
+  void set_roi(int x, int y, int width, int height) override;
+
+  protocol::FrontendStatus get_status() const override;
+  void add_frame_processor(const FrameProcessor& processor) override;
+  void set_pipeline_config(const FramePipelineConfig& config) override;
+  void set_execution_config(const ExecutionConfig& config) override;
+  FramePipelineStats get_pipeline_stats() const override;
+
+  void set_frame_queue_enabled(bool enabled) override {
+    frame_queue_enabled_.store(enabled);
+  }
+  moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>>& get_frame_queue()
+      override {
+    return frame_queue_;
+  }
+
+  // 非循环模式下全部帧已经送出
+  bool finished() const { return finished_.load(); }
+  // 已送出的帧数
+  uint64_t frames_emitted() const { return frames_emitted_.load(); }
+
+ private:
+  // 已解码的一帧，preload 模式下常驻内存
+  struct DecodedImage {
+    std::vector<uint8_t> data;
+    int width = 0;
+    int height = 0;
+    int type = 0;  // OpenCV 类型
+  };
+
+  bool open_source();
+  void replay_loop();
+  // 读取下一帧到 frame，没有更多帧时返回 false
+  bool next_frame(const ReplayConfig& cfg, CapturedFrame& frame);
+  bool read_image(const ReplayConfig& cfg, size_t index, CapturedFrame& frame);
+  bool read_raw(const ReplayConfig& cfg, CapturedFrame& frame);
+  bool read_recording(CapturedFrame& frame);
+  void emit_frame(std::shared_ptr<CapturedFrame> frame);
+  size_t frame_bytes_hint() const;
+  void update_status(const protocol::FrontendStatus& status);
+
+  std::string camera_id_;
+  std::shared_ptr<ReplayConfig> config_;
+  mutable std::shared_mutex config_mutex_;
+  mutable std::shared_mutex status_mutex_;
+  protocol::FrontendStatus current_status_;
+
+  // 数据源：图像文件列表、原始帧文件或录制文件
+  std::vector<std::string> image_files_;
+  std::vector<DecodedImage> preloaded_;
+  std::ifstream raw_stream_;
+  size_t raw_frame_bytes_ = 0;
+  RecordingReader recording_;
+  size_t next_index_ = 0;
+
+  std::atomic<bool> running_{false};
+  std::atomic<bool> finished_{false};
+  std::atomic<uint64_t> frames_emitted_{0};
+  std::thread replay_thread_;
+
+  std::atomic<bool> frame_queue_enabled_{false};
+  moodycamel::ConcurrentQueue<std::shared_ptr<CapturedFrame>> frame_queue_;
+  FrameBufferPool frame_pool_;
+
+  ExecutionBinding workers_;  // 处理线程池，默认与其他相机共用
+  // 运行中可以替换，处理线程按快照读取
+  std::atomic<std::shared_ptr<FrameProcessor>> user_processor_;
+  // 放在线程池和处理器之后，析构时最先停止
+  FramePipeline pipeline_;
+};
@@ -0,0 +1,42 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReplayConfig.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+#include <string>
+
+#include "config/CameraConfig.hpp"
+
+// 文件回放相机配置
+// 帧率沿用 acquisition_frame_rate / acquisition_frame_rate_enable，
+// 未使能或为 0 时按最快速度回放；原始帧文件的尺寸取 roi_w × roi_h，
+// 通道数由 mono_state 决定（单色 1，否则 BGR 3）；
+// 录制文件按录制时的元信息原样回放
+struct ReplayConfig : public CameraConfig {
+  // 图像目录、单张图像、原始帧文件（.raw/.bin）或录制文件（.cfpr）
+  std::string source_path;
+  bool loop = true;         // 播放完后从头循环
+  bool preload = true;      // 启动时把图像全部解码到内存，回放时不再解码
+};
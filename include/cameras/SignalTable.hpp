@@ -0,0 +1,145 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: SignalTable.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 按下标寻址的信号表，订阅者列表以 RCU 方式发布
+ *
+ * 名字到下标的映射只在声明、订阅和字符串接口中使用，受 mutex_ 保护；
+ * 发射端拿下标直接取槽位，再原子地读出订阅者列表快照，不加锁也不哈希。
+ * 订阅时复制一份列表追加后整体替换（写时复制），正在遍历旧快照的发射端
+ * 不受影响。槽位按块分配，已发布的块地址不再变化，因此扩容不会与读者冲突。
+ */
+template <typename Callback>
+class SignalTable {
+ public:
+  using List = std::vector<Callback>;
+  using Snapshot = std::shared_ptr<const List>;
+
+  static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+  static constexpr uint32_t kChunkBits = 6;
+  static constexpr uint32_t kChunkSize = 1u << kChunkBits;
+  static constexpr uint32_t kMaxChunks = 64;  // 最多 4096 个信号
+
+  SignalTable() = default;
+  SignalTable(const SignalTable&) = delete;
+  SignalTable& operator=(const SignalTable&) = delete;
+
+  // 返回信号的下标，不存在时新建；同名信号总是得到同一个下标
+  uint32_t resolve(const std::string& name) {
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      if (auto it = names_.find(name); it != names_.end()) {
+        return it->second;
+      }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (auto it = names_.find(name); it != names_.end()) {
+      return it->second;
+    }
+    const uint32_t index = size_;
+    const uint32_t chunk = index >> kChunkBits;
+    if (chunk >= kMaxChunks) {
+      throw std::length_error("SignalTable: too many signals");
+    }
+    if (!owned_[chunk]) {
+      owned_[chunk] = std::make_unique<Slot[]>(kChunkSize);
+      chunks_[chunk].store(owned_[chunk].get(), std::memory_order_release);
+    }
+    names_.emplace(name, index);
+    ++size_;
+    published_.store(size_, std::memory_order_release);
+    return index;
+  }
+
+  // 只查找不新建
+  std::optional<uint32_t> find(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    if (auto it = names_.find(name); it != names_.end()) {
+      return it->second;
+    }
+    return std::nullopt;
+  }
+
+  void append(uint32_t index, Callback callback) {
+    // 写者之间串行，读者只看到完整替换后的列表
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    Slot* slot = slot_at(index);
+    if (!slot) {
+      return;
+    }
+    auto current = slot->subscribers.load(std::memory_order_acquire);
+    auto next = current ? std::make_shared<List>(*current)
+                        : std::make_shared<List>();
+    next->push_back(std::move(callback));
+    slot->subscribers.store(Snapshot(std::move(next)),
+                            std::memory_order_release);
+  }
+
+  // 发射端调用：无锁读取订阅者快照，下标无效或没有订阅者时返回空
+  Snapshot load(uint32_t index) const noexcept {
+    const Slot* slot = slot_at(index);
+    return slot ? slot->subscribers.load(std::memory_order_acquire)
+                : Snapshot();
+  }
+
+ private:
+  struct Slot {
+    std::atomic<Snapshot> subscribers;
+  };
+
+  Slot* slot_at(uint32_t index) const noexcept {
+    if (index >= published_.load(std::memory_order_acquire)) {
+      return nullptr;
+    }
+    Slot* chunk = chunks_[index >> kChunkBits].load(std::memory_order_acquire);
+    return chunk + (index & (kChunkSize - 1));
+  }
+
+  std::array<std::atomic<Slot*>, kMaxChunks> chunks_{};
+  std::atomic<uint32_t> published_{0};
+
+  // 以下只在持有 mutex_ 时访问
+  std::array<std::unique_ptr<Slot[]>, kMaxChunks> owned_;
+  std::unordered_map<std::string, uint32_t> names_;
+  uint32_t size_ = 0;
+  mutable std::shared_mutex mutex_;
+};
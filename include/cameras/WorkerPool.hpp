@@ -0,0 +1,162 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: WorkerPool.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 调度通道的优先级与公平性设置
+struct LaneOptions {
+  int priority = 0;      // 数值大的通道有任务时先执行
+  uint32_t weight = 1;   // 同优先级的通道按权重分配执行次数
+  bool ordered = false;  // 同一时刻最多执行一个任务，严格按提交顺序
+};
+
+struct LaneStats {
+  std::string name;
+  int priority = 0;
+  uint32_t weight = 1;
+  bool ordered = false;
+  uint64_t executed = 0;  // 已执行的任务数
+  uint64_t stolen = 0;    // 其中由非归属线程执行的任务数
+  size_t queued = 0;      // 当前排队的任务数
+};
+
+namespace detail {
+struct LaneState;
+}  // namespace detail
+
+/**
+ * @brief 多相机共用的工作窃取线程池
+ *
+ * 每个相机在池里有自己的通道（任务队列），通道创建时依次分配一个归属线程。
+ * 工作线程取任务的顺序：优先级高的通道优先；同优先级先取归属于自己的通道，
+ * 没有时从其他线程的通道窃取；多个候选通道按权重做步长调度，
+ * 积压的相机不会独占工作线程，空闲的核也会帮积压的相机处理。
+ *
+ * 绑核时第 i 个工作线程绑定到 cpus[i % cpus.size()]。
+ * 析构时先执行完所有已提交的任务，因此池不能在自己的工作线程上析构：
+ * 通道句柄在任务里释放时会把池的引用转交给独立线程释放；任务直接持有
+ * 池的 shared_ptr 时，不要让它成为最后一个引用。
+ */
+class WorkerPool : public std::enable_shared_from_this<WorkerPool> {
+ public:
+  using Task = std::function<void()>;
+
+  // 通道句柄，析构后通道里剩余的任务照常执行，排空后从池中移除。
+  // 可以在本池的任务里释放，池的最后一个引用不会在工作线程上释放
+  class Lane {
+   public:
+    ~Lane();
+    Lane(const Lane&) = delete;
+    Lane& operator=(const Lane&) = delete;
+
+    void submit(Task task);
+    const std::string& name() const;
+    const std::shared_ptr<WorkerPool>& pool() const { return pool_; }
+
+   private:
+    friend class WorkerPool;
+    Lane(std::shared_ptr<WorkerPool> pool,
+         std::shared_ptr<detail::LaneState> state);
+
+    std::shared_ptr<WorkerPool> pool_;
+    std::shared_ptr<detail::LaneState> state_;
+  };
+
+  WorkerPool(std::string name, size_t threads, std::vector<int> cpus);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // 池必须由 shared_ptr 持有；name 为空时自动编号
+  std::shared_ptr<Lane> create_lane(std::string name = {},
+                                    const LaneOptions& options = {});
+
+  // 提交到默认通道
+  void submit(Task task);
+
+  /**
+   * @brief 在一个工作线程上执行并等待完成
+   *
+   * 用于预分配帧缓冲：内存页在首次写入的线程所在 NUMA 节点上分配，
+   * 由绑核的工作线程写入即可让缓冲区落在处理线程的本地节点。
+   */
+  void run_local(const std::function<void()>& fn);
+
+  // 默认通道排在第一个
+  std::vector<LaneStats> lane_stats() const;
+
+  const std::string& name() const { return name_; }
+  size_t thread_count() const { return threads_; }
+  const std::vector<int>& cpus() const { return cpus_; }
+
+  // 当前线程是否是本池的工作线程
+  bool on_worker_thread() const;
+
+ private:
+  using LaneList = std::vector<std::shared_ptr<detail::LaneState>>;
+
+  std::shared_ptr<detail::LaneState> make_lane_state(
+      std::string name, const LaneOptions& options);
+  void enqueue(detail::LaneState& lane, Task task);
+  void retire(const std::shared_ptr<detail::LaneState>& lane);
+  void remove_lane(const detail::LaneState* lane);
+  void publish_ready(size_t count);
+  bool run_one(size_t worker);
+  void worker_loop(size_t worker);
+
+  std::string name_;
+  size_t threads_;
+  std::vector<int> cpus_;
+
+  // 通道列表写时复制，工作线程无锁遍历
+  mutable std::mutex lanes_mutex_;
+  std::atomic<std::shared_ptr<const LaneList>> lanes_;
+  std::shared_ptr<detail::LaneState> default_lane_;
+  size_t next_lane_id_ = 0;
+
+  std::atomic<uint64_t> virtual_clock_{0};  // 最近一次调度的通道虚拟时间
+  std::atomic<size_t> ready_{0};            // 当前可以取走的任务数
+  std::atomic<size_t> pending_{0};          // 排队和执行中的任务数
+  std::atomic<size_t> sleepers_{0};
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::condition_variable idle_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
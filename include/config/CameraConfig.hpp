@@ -25,8 +25,43 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
 // 相机品牌枚举
-enum class CameraBrand { DVP, IKap, MIND };
+enum class CameraBrand { DVP, IKap, MIND, Replay };
+
+// 帧流水线溢出策略
+enum class FrameOverflowPolicy {
+  DropOldest,   // 丢弃队列中最旧的帧，保证处理的是最新画面
+  DropNewest,   // 丢弃新到的帧，保证已排队的帧全部处理
+  Block,        // 阻塞采集回调直到有空位（会反压到相机 SDK 缓冲区）
+  SampleEveryN  // 每 N 帧取 1 帧，队列满时丢弃最旧的帧
+};
+
+// 采集到算法之间的有界帧流水线配置
+struct FramePipelineConfig {
+  size_t capacity = 8;         // 等待处理的最大帧数
+  size_t max_in_flight = 0;    // 同时处理的最大帧数，0 表示 CPU 核数
+  size_t sample_interval = 1;  // SampleEveryN 策略的 N
+  FrameOverflowPolicy policy = FrameOverflowPolicy::DropOldest;
+};
+
+// 相机处理线程的执行拓扑
+struct ExecutionConfig {
+  // 线程池名，同名的相机共用一个池；默认所有相机共用节点级的 shared 池
+  std::string pool = "shared";
+  size_t threads = 0;  // 0 表示绑定的 CPU 数，未绑定时为 CPU 核数
+  std::string cpus;    // 工作线程绑定的逻辑 CPU，如 "0-7,16"，空表示不绑定
+  int numa_node = -1;  // 未指定 cpus 时绑定该 NUMA 节点的全部 CPU
+  // 相机在池里的调度通道，见 WorkerPool
+  std::string lane;      // 通道名，用于统计，空则自动编号
+  int priority = 0;      // 数值大的相机有积压时先处理
+  uint32_t weight = 1;   // 同优先级相机按权重分配处理线程
+  bool ordered = false;  // 串行按采集顺序处理，下游需要保序时打开
+};
+
 // 通用相机配置结构
 struct CameraConfig {
   // 基本图像参数
@@ -24,6 +24,7 @@
  *  - CopyrightYear: 2025-2026
  */
 #pragma once
+#include <algorithm>
 #include <atomic>
 #include <exception>
 #include <filesystem>  //NOLINT
@@ -49,6 +50,7 @@ CONFIG_FORWARD_DECLARE(GlobalConfig)            // 全局配置
 CONFIG_FORWARD_DECLARE(HoleDetectionConfig)     // 孔洞检测配置项
 CONFIG_FORWARD_DECLARE(SurfaceDetectionConfig)  // 表面检测配置项
 CONFIG_FORWARD_DECLARE(LoggingConfig)           // 日志配置项
+CONFIG_FORWARD_DECLARE(ReportConfig)            // 特征上报配置项
 CONFIG_FORWARD_DECLARE(CameraEntry)             // 相机参数设置
 // ===========================================================================
 namespace config {
@@ -90,6 +92,10 @@ struct HoleDetectionConfig {
   float pixel_to_mm_width;
   float pixel_to_mm_height;
   std::string partition_params;
+  std::string tiling_mode = "none";  // none/vertical/horizontal 分块并行模式
+  int tile_count = 0;                // 分块数，0 表示按线程数
+  // 流式模式：帧按线扫条带的连续行块处理，需配合 pipeline_max_in_flight=1
+  bool streaming = false;
 
   static HoleDetectionConfig load(inicpp::IniManager &ini) {
     try {
@@ -136,6 +142,19 @@ struct HoleDetectionConfig {
               ? "0.3,0.4,0.3,20,23,20"
               : hole_section["partition_params"].String();
 
+      config.tiling_mode = hole_section["tiling_mode"].String().empty()
+                               ? "none"
+                               : hole_section["tiling_mode"].String();
+
+      config.tile_count = hole_section["tile_count"].String().empty()
+                              ? 0
+                              : std::stoi(hole_section["tile_count"].String());
+
+      config.streaming =
+          hole_section["streaming"].String().empty()
+              ? false
+              : static_cast<bool>(hole_section["streaming"]);
+
       return config;
     } catch (const std::exception &e) {
       std::cerr << "Exception: " << e.what()
@@ -163,6 +182,11 @@ struct HoleDetectionConfig {
             "像素到毫米高度转换系数");
     ini.set("hole_detection", "partition_params", "0.3,0.4,0.3,20,23,20",
             "分区参数(左中右比例和阈值)");
+    ini.set("hole_detection", "tiling_mode", "none",
+            "分块并行模式(none/vertical/horizontal)");
+    ini.set("hole_detection", "tile_count", 0, "分块数(0:按线程数)");
+    ini.set("hole_detection", "streaming", 0,
+            "流式行块检测(0:按帧 1:按条带连续行块)");
   }
 };
 
@@ -173,6 +197,35 @@ struct SurfaceDetectionConfig {
   // todo: 添加表面检测参数
 };
 
+// ==========================================
+//  算法图的配置项
+// ==========================================
+struct AlgoGraphConfig {
+  // 并行执行算法节点的线程数，与相机工作线程叠加，不宜按核数开
+  size_t threads{2};
+
+  static AlgoGraphConfig load(inicpp::IniManager &ini) {
+    AlgoGraphConfig config;
+    try {
+      auto graph_section = ini["algo_graph"];
+      if (!graph_section["threads"].String().empty()) {
+        config.threads =
+            std::max<size_t>(1, std::stoul(graph_section["threads"].String()));
+      }
+      return config;
+    } catch (const std::exception &e) {
+      std::cerr << "Exception: " << e.what()
+                << " when loading algo graph config params" << std::endl;
+      return AlgoGraphConfig{};
+    }
+  }
+
+  static void saveDefaults(inicpp::IniManager &ini) {
+    ini.set("algo_graph", "threads", 2,
+            "并行执行算法节点的线程数，每帧只有一个算法时用不到");
+  }
+};
+
 // ==========================================
 //  日志的配置项
 // ==========================================
@@ -371,6 +424,110 @@ struct LoggingConfig {
   }
 };
 
+// ==========================================
+//  特征上报的配置项
+// ==========================================
+struct ReportConfig {
+  std::string image_format{"none"};  // 随上报发送的图片：none/raw/jpeg/png
+  int jpeg_quality{90};              // JPEG 质量 0-100
+  int png_compression{3};            // PNG 压缩级别 0-9
+  size_t image_queue{8};             // 排队压缩的帧数上限
+  size_t exec_threads{2};            // 压缩线程数
+  std::string exec_cpus;             // 压缩线程绑定的 CPU，空表示不绑定
+  int reconnect_initial_ms{200};     // 断线重连的初始间隔
+  int reconnect_max_ms{30000};       // 断线重连的最大间隔
+  size_t offline_queue{4096};        // 断线期间内存暂存的上报条数
+  size_t offline_queue_mb{64};       // 断线期间内存暂存的上报字节数上限
+  std::string offline_spill_dir;     // 暂存满后溢写的目录，空表示丢弃最旧的
+  // 连接正常但写得慢时每个服务器各自排队的上报条数上限，
+  // 断线期间的上报由 offline_queue 暂存，不占这里的队列和窗口
+  size_t destination_queue{1024};
+  size_t destination_in_flight{4};   // 每个服务器同时在写的上报条数
+
+  static ReportConfig load(inicpp::IniManager &ini) {
+    ReportConfig config;
+    try {
+      auto report_section = ini["report"];
+      if (!report_section["image_format"].String().empty()) {
+        config.image_format = report_section["image_format"].String();
+      }
+      if (!report_section["jpeg_quality"].String().empty()) {
+        config.jpeg_quality =
+            std::clamp(std::stoi(report_section["jpeg_quality"].String()), 0,
+                       100);
+      }
+      if (!report_section["png_compression"].String().empty()) {
+        config.png_compression = std::clamp(
+            std::stoi(report_section["png_compression"].String()), 0, 9);
+      }
+      if (!report_section["image_queue"].String().empty()) {
+        config.image_queue =
+            std::stoul(report_section["image_queue"].String());
+      }
+      if (!report_section["exec_threads"].String().empty()) {
+        config.exec_threads =
+            std::stoul(report_section["exec_threads"].String());
+      }
+      config.exec_cpus = report_section["exec_cpus"].String();
+      if (!report_section["reconnect_initial_ms"].String().empty()) {
+        config.reconnect_initial_ms = std::max(
+            1, std::stoi(report_section["reconnect_initial_ms"].String()));
+      }
+      if (!report_section["reconnect_max_ms"].String().empty()) {
+        config.reconnect_max_ms = std::max(
+            config.reconnect_initial_ms,
+            std::stoi(report_section["reconnect_max_ms"].String()));
+      }
+      if (!report_section["offline_queue"].String().empty()) {
+        config.offline_queue =
+            std::stoul(report_section["offline_queue"].String());
+      }
+      if (!report_section["offline_queue_mb"].String().empty()) {
+        config.offline_queue_mb =
+            std::stoul(report_section["offline_queue_mb"].String());
+      }
+      config.offline_spill_dir =
+          report_section["offline_spill_dir"].String();
+      if (!report_section["destination_queue"].String().empty()) {
+        config.destination_queue =
+            std::stoul(report_section["destination_queue"].String());
+      }
+      if (!report_section["destination_in_flight"].String().empty()) {
+        config.destination_in_flight =
+            std::stoul(report_section["destination_in_flight"].String());
+      }
+      return config;
+    } catch (const std::exception &e) {
+      std::cerr << "Exception: " << e.what()
+                << " when loading report config params" << std::endl;
+      return ReportConfig{};
+    }
+  }
+
+  static void saveDefaults(inicpp::IniManager &ini) {
+    ini.set("report", "image_format", "none",
+            "随特征上报发送的图片 (none, raw, jpeg, png)");
+    ini.set("report", "jpeg_quality", 90, "JPEG 质量 (0-100)");
+    ini.set("report", "png_compression", 3, "PNG 压缩级别 (0-9)");
+    ini.set("report", "image_queue", 8,
+            "排队压缩的帧数上限，超出时上报不带图片");
+    ini.set("report", "exec_threads", 2, "图片压缩线程数");
+    ini.set("report", "exec_cpus", "", "压缩线程绑定的CPU，如 \"8-9\"");
+    ini.set("report", "reconnect_initial_ms", 200, "断线重连初始间隔(ms)");
+    ini.set("report", "reconnect_max_ms", 30000,
+            "断线重连最大间隔(ms)，每次失败翻倍");
+    ini.set("report", "offline_queue", 4096, "断线期间内存暂存的上报条数");
+    ini.set("report", "offline_queue_mb", 64, "断线期间内存暂存的字节数(MB)");
+    ini.set("report", "offline_spill_dir", "",
+            "暂存满后溢写到的目录，空表示丢弃最旧的上报");
+    ini.set("report", "destination_queue", 1024,
+            "每个服务器各自排队的上报条数，超出时丢弃该服务器最旧的"
+            "（断线期间由 offline_queue 暂存）");
+    ini.set("report", "destination_in_flight", 4,
+            "每个服务器同时在写的上报条数");
+  }
+};
+
 // ==========================================
 //  相机配置项
 // ==========================================
@@ -380,6 +537,8 @@ struct CameraEntry {
   CameraConfig config;
   std::string algorithm;                 // e.g. "HoleDetection"
   std::vector<std::string> event_specs;  // 事件类型处理器
+  FramePipelineConfig pipeline;          // 采集到算法的有界流水线
+  ExecutionConfig execution;             // 处理线程池与绑核
 
   static CameraEntry load(inicpp::IniManager &ini,
                           const std::string &section_name) {
@@ -401,6 +560,8 @@ struct CameraEntry {
         entry.brand = CameraBrand::DVP;
       } else if (brand_str == "MIND") {
         entry.brand = CameraBrand::MIND;
+      } else if (brand_str == "Replay") {
+        entry.brand = CameraBrand::Replay;
       } else {
         entry.brand = CameraBrand::IKap;  // 默认
       }
@@ -684,6 +845,60 @@ struct CameraEntry {
               : static_cast<bool>(
                     std::stoi(camera_section["flat_field_enable"].String()));
 
+      // === 帧流水线 ===
+      entry.pipeline.capacity =
+          camera_section["pipeline_capacity"].String().empty()
+              ? 8
+              : std::stoul(camera_section["pipeline_capacity"].String());
+      entry.pipeline.max_in_flight =
+          camera_section["pipeline_max_in_flight"].String().empty()
+              ? 0
+              : std::stoul(camera_section["pipeline_max_in_flight"].String());
+      entry.pipeline.sample_interval =
+          camera_section["pipeline_sample_interval"].String().empty()
+              ? 1
+              : std::stoul(
+                    camera_section["pipeline_sample_interval"].String());
+      std::string policy_str = camera_section["pipeline_policy"].String();
+      if (policy_str == "drop_newest") {
+        entry.pipeline.policy = FrameOverflowPolicy::DropNewest;
+      } else if (policy_str == "block") {
+        entry.pipeline.policy = FrameOverflowPolicy::Block;
+      } else if (policy_str == "sample") {
+        entry.pipeline.policy = FrameOverflowPolicy::SampleEveryN;
+      } else {
+        entry.pipeline.policy = FrameOverflowPolicy::DropOldest;  // 默认
+      }
+
+      // === 执行拓扑 ===
+      if (!camera_section["exec_pool"].String().empty()) {
+        entry.execution.pool = camera_section["exec_pool"].String();
+      }
+      entry.execution.threads =
+          camera_section["exec_threads"].String().empty()
+              ? 0
+              : std::stoul(camera_section["exec_threads"].String());
+      entry.execution.cpus = camera_section["exec_cpus"].String();
+      entry.execution.numa_node =
+          camera_section["exec_numa_node"].String().empty()
+              ? -1
+              : std::stoi(camera_section["exec_numa_node"].String());
+      entry.execution.lane = entry.id;
+      entry.execution.priority =
+          camera_section["exec_priority"].String().empty()
+              ? 0
+              : std::stoi(camera_section["exec_priority"].String());
+      entry.execution.weight =
+          camera_section["exec_weight"].String().empty()
+              ? 1
+              : static_cast<uint32_t>(
+                    std::stoul(camera_section["exec_weight"].String()));
+      entry.execution.ordered =
+          camera_section["exec_ordered"].String().empty()
+              ? false
+              : static_cast<bool>(
+                    std::stoi(camera_section["exec_ordered"].String()));
+
       return entry;
     } catch (const std::exception &e) {
       std::cerr << "Exception: " << e.what()
@@ -699,7 +914,7 @@ struct CameraEntry {
   static void saveDefaults(inicpp::IniManager &ini,
                            const std::string &section_name) {
     ini.set(section_name, "id", "cam1", "相机唯一标识");
-    ini.set(section_name, "brand", "IKap", "相机品牌 (IKap/DVP/MIND)");
+    ini.set(section_name, "brand", "IKap", "相机品牌 (IKap/DVP/MIND/Replay)");
     ini.set(section_name, "algorithm", "HoleDetection", "绑定的算法名");
 
     // 基本图像参数
@@ -784,6 +999,35 @@ struct CameraEntry {
     ini.set(section_name, "acquisition_frame_rate_enable", false,
             "采集帧率使能");
     ini.set(section_name, "flat_field_enable", false, "平场校正使能");
+
+    // 帧流水线
+    ini.set(section_name, "pipeline_capacity", 8, "算法等待队列最大帧数");
+    ini.set(section_name, "pipeline_max_in_flight", 0,
+            "同时处理的最大帧数 (0:CPU核数)");
+    ini.set(section_name, "pipeline_policy", "drop_oldest",
+            "队列满时的策略 (drop_oldest/drop_newest/block/sample)");
+    ini.set(section_name, "pipeline_sample_interval", 1,
+            "sample 策略下每 N 帧处理 1 帧");
+
+    // 执行拓扑
+    ini.set(section_name, "exec_pool", "shared",
+            "处理线程池名，同名相机共用 (shared:节点级共享池)");
+    ini.set(section_name, "exec_threads", 0,
+            "线程池线程数 (0:绑定的CPU数，未绑定时为CPU核数)");
+    ini.set(section_name, "exec_cpus", "",
+            "绑定的逻辑CPU，如 0-7,16 (空:不绑定)");
+    ini.set(section_name, "exec_numa_node", -1,
+            "未指定 exec_cpus 时绑定的 NUMA 节点 (-1:不绑定)");
+    ini.set(section_name, "exec_priority", 0, "调度优先级，大的先处理");
+    ini.set(section_name, "exec_weight", 1, "同优先级相机间的处理线程权重");
+    ini.set(section_name, "exec_ordered", false,
+            "串行按采集顺序处理 (下游需要保序时打开)");
+
+    // 文件回放（仅 brand=Replay 时使用）
+    ini.set(section_name, "replay_source", "",
+            "回放源：图像目录、单张图像或原始帧文件(.raw/.bin)");
+    ini.set(section_name, "replay_loop", true, "回放结束后循环");
+    ini.set(section_name, "replay_preload", true, "启动时预解码全部图像");
   }
 };
 
@@ -831,7 +1075,9 @@ struct GlobalConfig {
   std::string title;
   HoleDetectionConfig hole_detection;        // 针孔检测
   SurfaceDetectionConfig surface_detection;  // 表面检测
+  AlgoGraphConfig algo_graph;                // 算法图
   LoggingConfig logging_settings;            // 日志配置
+  ReportConfig report;                       // 特征上报
   std::vector<CameraEntry> camera_entries;   // 相机配置列表
   static GlobalConfig load();
 
@@ -839,7 +1085,9 @@ struct GlobalConfig {
     ini.set("", "title", "CFP", "应用标题");
     HoleDetectionConfig::saveDefaults(ini);
     // SurfaceDetectionConfig::saveDefaults(ini);
+    AlgoGraphConfig::saveDefaults(ini);
     LoggingConfig::saveDefaults(ini);
+    ReportConfig::saveDefaults(ini);
     save_camera_defaults(ini);
   }
 };
@@ -895,7 +1143,9 @@ inline GlobalConfig GlobalConfig::load() {
         ini[""]["title"].String().empty() ? "CFP" : ini[""]["title"].String();
     config.hole_detection = HoleDetectionConfig::load(ini);
     // config.surface_detection = SurfaceDetectionConfig::load(ini);
+    config.algo_graph = AlgoGraphConfig::load(ini);
     config.logging_settings = LoggingConfig::load(ini);
+    config.report = ReportConfig::load(ini);
     config.camera_entries = load_cameras_from_ini(ini);  // 加载多相机配置
     return config;
   } catch (std::exception &e) {
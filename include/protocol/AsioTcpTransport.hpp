@@ -26,22 +26,39 @@
 
 // Copyright (c) 2025 caomengxuan666
 #pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
+#include <system_error>
+#include <vector>
 
+#include "asio/awaitable.hpp"
 #include "asio/io_context.hpp"
 #include "asio/ip/tcp.hpp"
-#include "asio/streambuf.hpp"
+#include "protocol/FrameReader.hpp"
+#include "protocol/SendBufferPool.hpp"
 #include "protocol/TransportAdapter.hpp"
 
 namespace protocol {
 
+/**
+ * @brief 基于 asio 的 TCP 传输
+ *
+ * 接收端用 async_read_some 读入 FrameReader 的缓冲区，一次读到的多条报文
+ * 依次交出。async_receive() 和 async_receive_frames() 共用同一份缓冲数据，
+ * 同一时刻只能有一个接收在进行。
+ *
+ * 发送端所有报文进同一个发送队列，任意线程都可以发送。io 线程上同一时刻
+ * 只有一个写操作，报文不会交错；写的同时到达的小报文合并成一次 gather 写。
+ * 连接建立后打开 TCP_NODELAY，Control 报文写出即推送；超过 kMaxBatchBytes
+ * 的 Bulk 批次在 Linux 上写的期间打开 TCP_CORK，只发满段，写完后取消
+ */
 class AsioTcpTransport : public ITransportAdapter {
-  enum class ReceiveState {
-    WaitingForStartSignal,  // 等待开始信号
-    ReceivingFeatureData,   // 接收特征数据
-    ReceivingStatusData     // 接收状态数据
-  };
-
  public:
   explicit AsioTcpTransport(asio::io_context& io_ctx);
   ~AsioTcpTransport() override;
@@ -50,22 +67,96 @@ class AsioTcpTransport : public ITransportAdapter {
                      std::function<void(std::error_code)> callback) override;
   void async_send(std::span<const uint8_t> data,
                   SendCallback callback) override;
+  void async_send_buffer(
+      SharedBuffer data, SendCallback callback,
+      MessageClass message_class = MessageClass::Bulk) override;
+  void async_send_gather(
+      std::shared_ptr<const GatherMessage> message, SendCallback callback,
+      MessageClass message_class = MessageClass::Bulk) override;
   void async_receive(ReceiveCallback callback) override;
+  void async_receive_frames(FrameCallback callback) override;
   void close() override;
   asio::io_context& get_io_context() { return io_ctx_; }
 
+  // ===== 协程接口，须在 io_ctx_ 上的协程里调用 =====
+  // 发送走同一个发送队列，见 Awaitable.hpp 的 co_send_buffer/co_send_gather
+
+  // 异步解析和连接，不阻塞 io 线程
+  asio::awaitable<std::error_code> co_connect(std::string ip,
+                                              uint16_t port) override;
+  /**
+   * @brief 接收一条完整报文
+   *
+   * 直接读入 FrameReader 的缓冲区，frame 指向缓冲区内部，在下一次接收前
+   * 有效；不经过回调，也不拷贝报文，用不到 storage。
+   * 与 async_receive*() 不能同时使用
+   */
+  asio::awaitable<std::error_code> co_receive_frame(
+      std::span<const uint8_t>& frame,
+      std::vector<uint8_t>& storage) override;
+
+  struct SendStats {
+    uint64_t messages = 0;  // 已写出的报文数
+    uint64_t batches = 0;   // 合并后的写批次数
+    uint64_t syscalls = 0;  // 写系统调用次数（每次 async_write_some）
+    uint64_t bytes = 0;
+    size_t queue_depth = 0;      // 当前排队和正在写的报文数
+    size_t max_queue_depth = 0;  // 队列深度的峰值
+
+    double bytes_per_syscall() const {
+      return syscalls ? static_cast<double>(bytes) / syscalls : 0.0;
+    }
+    double messages_per_batch() const {
+      return batches ? static_cast<double>(messages) / batches : 0.0;
+    }
+  };
+
+  SendStats send_stats() const;
+
+  // 单次合并写的上限，超过 kMaxBatchBytes 的报文单独写
+  static constexpr size_t kMaxBatchMessages = 64;
+  static constexpr size_t kMaxBatchBytes = 64 * 1024;
+
  private:
-  void receive_status_data(ReceiveCallback callback);
-  void receive_feature_data(ReceiveCallback callback);
+  struct OutboundMessage {
+    SharedBuffer buffer;                          // 单块报文
+    std::shared_ptr<const GatherMessage> gather;  // 或分段报文
+    SendCallback callback;
+    MessageClass message_class = MessageClass::Bulk;
+    size_t bytes = 0;
+  };
+
+  // 连接建立后重置上一条连接的状态
+  void on_connected();
+  void enqueue(OutboundMessage message);
+  // 以下只在 io 线程调用
+  void start_write();
+  void write_some();
+  void finish_write(const std::error_code& ec);
+  void set_cork(bool enabled);
+
+  // 交出已缓冲的报文，不够一条时继续读
+  void dispatch_frames();
+  void receive_one(ReceiveCallback callback, bool deferred);
+
   asio::io_context& io_ctx_;
   asio::ip::tcp::socket socket_;
-  asio::streambuf read_buffer_;
-  bool is_connected_ = false;
-  ReceiveState state_ = ReceiveState::WaitingForStartSignal;
+  FrameReader reader_;
+  FrameCallback frame_callback_;  // async_receive_frames() 的回调
+  SendBufferPool send_buffers_;   // async_send() 拷贝数据用的缓冲区
+  std::atomic<bool> is_connected_{false};
 
-  void async_read_exact(
-      size_t size,
-      std::function<void(std::error_code, std::span<const uint8_t>)> handler);
+  mutable std::mutex send_mutex_;
+  std::deque<OutboundMessage> send_queue_;
+  bool writing_ = false;  // 已有写批次在进行（或已投递到 io 线程）
+  SendStats send_stats_;
+  // 正在写的批次，只在 io 线程访问，容量跨批次复用
+  std::vector<OutboundMessage> in_flight_;
+  std::vector<asio::const_buffer> write_buffers_;
+  size_t write_index_ = 0;  // write_buffers_ 中第一段未写完的位置
+  size_t batch_bytes_ = 0;
+  uint64_t batch_syscalls_ = 0;
+  bool corked_ = false;
 };
 
 }  // namespace protocol
@@ -0,0 +1,147 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: Awaitable.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "asio/associated_executor.hpp"
+#include "asio/async_result.hpp"
+#include "asio/awaitable.hpp"
+#include "asio/dispatch.hpp"
+#include "asio/recycling_allocator.hpp"
+#include "asio/redirect_error.hpp"
+#include "asio/use_awaitable.hpp"
+#include "protocol/TransportAdapter.hpp"
+
+/**
+ * 传输层的协程接口（C++20，asio::awaitable）
+ *
+ * 错误以返回的 std::error_code 给出，不抛异常。协程帧由 asio 从线程本地
+ * 缓存分配并复用；回调式接口的完成处理器经 recycling_allocator 包装，
+ * 稳态下每次等待不再单独分配 std::function 的目标对象和缓冲区。
+ * 协程须在传输层所属的 io_context 上运行（co_spawn(io_ctx, ...)）
+ */
+namespace protocol {
+
+namespace detail {
+
+/**
+ * @brief 把协程的完成处理器包装成传输层要求的可拷贝回调
+ *
+ * 处理器只能移动，放进 recycling_allocator 分配的共享块里；回调经处理器
+ * 关联的执行器恢复协程，传输层在其他线程回调时也不会在那个线程上继续执行
+ */
+template <typename Handler>
+class CallbackHandler {
+ public:
+  explicit CallbackHandler(Handler handler)
+      : handler_(std::allocate_shared<Handler>(
+            asio::recycling_allocator<Handler>(), std::move(handler))) {}
+
+  template <typename... Args>
+  void operator()(Args... args) const {
+    auto executor = asio::get_associated_executor(*handler_);
+    asio::dispatch(executor, [handler = handler_,
+                              ... args = std::move(args)]() mutable {
+      (*handler)(std::move(args)...);
+    });
+  }
+
+ private:
+  std::shared_ptr<Handler> handler_;
+};
+
+// 发起回调式操作并等待完成，错误码写入 ec，其余结果作为 co_await 的值
+template <typename... Results, typename Initiate>
+auto await_callback(Initiate initiate, std::error_code& ec) {
+  auto token = asio::redirect_error(asio::use_awaitable, ec);
+  return asio::async_initiate<decltype(token),
+                              void(std::error_code, Results...)>(
+      [](auto handler, Initiate initiate) {
+        using HandlerType = std::decay_t<decltype(handler)>;
+        initiate(CallbackHandler<HandlerType>(std::move(handler)));
+      },
+      token, std::move(initiate));
+}
+
+}  // namespace detail
+
+inline asio::awaitable<std::error_code> co_connect(
+    ITransportAdapter& transport, std::string ip, uint16_t port) {
+  std::error_code ec;
+  co_await detail::await_callback(
+      [&transport, &ip, port](auto callback) {
+        transport.async_connect(ip, port, std::move(callback));
+      },
+      ec);
+  co_return ec;
+}
+
+inline asio::awaitable<std::error_code> co_send_buffer(
+    ITransportAdapter& transport, ITransportAdapter::SharedBuffer data,
+    MessageClass message_class = MessageClass::Bulk) {
+  std::error_code ec;
+  co_await detail::await_callback(
+      [&transport, &data, message_class](auto callback) {
+        transport.async_send_buffer(std::move(data), std::move(callback),
+                                    message_class);
+      },
+      ec);
+  co_return ec;
+}
+
+inline asio::awaitable<std::error_code> co_send_gather(
+    ITransportAdapter& transport, std::shared_ptr<const GatherMessage> message,
+    MessageClass message_class = MessageClass::Bulk) {
+  std::error_code ec;
+  co_await detail::await_callback(
+      [&transport, &message, message_class](auto callback) {
+        transport.async_send_gather(std::move(message), std::move(callback),
+                                    message_class);
+      },
+      ec);
+  co_return ec;
+}
+
+// 接收一条完整报文到 data
+inline asio::awaitable<std::error_code> co_receive(
+    ITransportAdapter& transport, std::vector<uint8_t>& data) {
+  std::error_code ec;
+  data = co_await detail::await_callback<std::vector<uint8_t>>(
+      [&transport](auto callback) {
+        transport.async_receive(std::move(callback));
+      },
+      ec);
+  co_return ec;
+}
+
+}  // namespace protocol
@@ -0,0 +1,159 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FanoutSession.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "asio/awaitable.hpp"
+#include "protocol/ProtocolSession.hpp"
+#include "protocol/SendBufferPool.hpp"
+#include "protocol/TransportAdapter.hpp"
+#include "protocol/codec.hpp"
+#include "protocol/messages.hpp"
+
+namespace protocol {
+
+struct FanoutConfig {
+  // 每个目的地同时交给传输层、正在写的报文数，其余在本目的地的队列里
+  // 等待。被传输层暂存的报文（断线期间）不占窗口
+  size_t max_in_flight = 4;
+  // 每个目的地排队的报文上限，超出时丢弃本目的地最旧的报文
+  size_t max_queued_messages = 1024;
+  size_t max_queued_bytes = 64 * 1024 * 1024;
+};
+
+/**
+ * @brief 一次编码、发往多个服务器的上报会话
+ *
+ * 每条报文只编码一次，得到只读的共享缓冲区（或聚合写报文），各目的地
+ * 发送的是同一份数据。每个目的地有独立的队列和在途窗口：某个目的地写得
+ * 慢时只在自己的队列里积压，积压超过上限丢弃自己最旧的报文，不影响其他
+ * 目的地，也不阻塞调用线程。
+ *
+ * 断线时的缓冲交给传输层：ReconnectingTransport 等在断线期间暂存报文的
+ * 传输层通过 async_send_tracked() 的 on_buffered 告知报文已进入自己的
+ * 队列，报文随即离开在途窗口，本目的地的队列继续往下交付。断线期间的积压
+ * 因此只受传输层的上限和溢写约束，这里的队列与丢弃只针对连接正常但写得
+ * 慢的目的地。
+ *
+ * 发送回调对每个目的地各执行一次，参数为目的地名称和结果。
+ * 线程安全：发送接口可以在任意线程调用
+ */
+class FanoutSession {
+ public:
+  using SendCallback =
+      std::function<void(const std::string& destination, std::error_code)>;
+
+  struct DestinationStats {
+    std::string name;
+    uint64_t sent = 0;     // 写出成功的报文数
+    uint64_t failed = 0;   // 传输层返回错误的报文数
+    uint64_t dropped = 0;  // 队列满丢弃的报文数
+    uint64_t buffered = 0;  // 被传输层暂存、提前离开在途窗口的报文数
+    size_t queued = 0;     // 当前排队（未交给传输层）的报文数
+    size_t peak_queued = 0;
+    size_t in_flight = 0;  // 当前已交给传输层、未完成的报文数
+  };
+
+  explicit FanoutSession(std::unique_ptr<ICodec> codec,
+                         const FanoutConfig& config = {});
+  ~FanoutSession();
+
+  FanoutSession(const FanoutSession&) = delete;
+  FanoutSession& operator=(const FanoutSession&) = delete;
+
+  /**
+   * @brief 添加目的地，返回其序号
+   * @note 需在开始发送前添加完毕
+   */
+  size_t add_destination(const std::string& name,
+                         std::unique_ptr<ITransportAdapter> transport);
+  size_t destination_count() const { return destinations_.size(); }
+
+  void async_connect(size_t destination, const std::string& ip, uint16_t port,
+                     std::function<void(std::error_code)> callback);
+  // 协程版本，须在传输层所属 io_context 上的协程里调用
+  asio::awaitable<std::error_code> co_connect(size_t destination,
+                                              std::string ip, uint16_t port);
+
+  // 编码到复用的发送缓冲区；带共享图片时转为聚合写，图片不拷贝
+  void async_send_features(const FeatureReport& report, SendCallback callback);
+  void async_send_features(std::shared_ptr<const FeatureReport> report,
+                           SendCallback callback);
+  void async_send_status(const FrontendStatus& status, SendCallback callback);
+  void async_send_telemetry(const TelemetryData& telemetry,
+                            SendCallback callback);
+
+  // 以 operation_canceled 回调所有排队的报文并关闭各目的地的传输层
+  void close();
+
+  DestinationStats stats(size_t destination) const;
+
+ private:
+  // 各目的地的队列元素共享同一份编码结果
+  struct Queued {
+    ITransportAdapter::SharedBuffer buffer;
+    std::shared_ptr<const GatherMessage> gather;
+    MessageClass message_class = MessageClass::Bulk;
+    size_t bytes = 0;
+    SendCallback callback;
+  };
+  struct Destination {
+    std::string name;
+    std::unique_ptr<ITransportAdapter> transport;
+    mutable std::mutex mutex;
+    std::deque<Queued> queue;
+    size_t queued_bytes = 0;
+    size_t in_flight = 0;
+    bool pumping = false;  // 同一时刻只有一个线程向传输层交付，保持顺序
+    bool closed = false;
+    DestinationStats stats;
+  };
+
+  void fan_out(Queued message);
+  // 在途窗口有空位时把队首的报文交给传输层
+  void pump(Destination& destination);
+  // 报文离开在途窗口（被传输层暂存或写完成），以先到者为准，
+  // 已经离开过时返回 false。调用方持有 destination.mutex
+  bool release(Destination& destination, bool& released);
+  void on_sent(Destination& destination, const std::shared_ptr<bool>& released,
+               SendCallback callback, std::error_code ec);
+
+  std::unique_ptr<ICodec> codec_;
+  FanoutConfig config_;
+  SendBufferPool send_buffers_;
+  std::vector<std::unique_ptr<Destination>> destinations_;
+};
+
+}  // namespace protocol
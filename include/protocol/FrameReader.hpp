@@ -0,0 +1,97 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameReader.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+namespace protocol {
+
+/**
+ * @brief 传统协议的接收分帧器，所有报文共用一块可增长的接收缓冲区
+ *
+ * 用法：prepare() 取得可写区域交给 read_some，commit() 提交读到的字节数，
+ * 再反复调用 next() 取出已经完整的 'F'/'T' 报文。报文以指向缓冲区内部的
+ * span 交出，不拷贝也不分配，span 在下一次 prepare() 之前有效。
+ *
+ * 未读完的数据在可写区域不足时整体移到缓冲区开头；缓冲区只在单条报文
+ * 放不下时扩容，之后保持该大小，连续的大报文不会反复分配。
+ *
+ * 非线程安全，由所属传输层的 io 线程使用
+ */
+class FrameReader {
+ public:
+  enum class Status {
+    Complete,  // 取出了一条完整报文
+    NeedMore,  // 需要继续读
+    Invalid    // 报文头不合法或超长，数据流已经无法对齐
+  };
+
+  // 每次 read_some 至少提供的可写字节数
+  static constexpr size_t kMinRead = 16 * 1024;
+  // frame_size() 对不合法报文头的返回值
+  static constexpr size_t kInvalidFrame = SIZE_MAX;
+
+  explicit FrameReader(size_t initial_capacity = 64 * 1024,
+                       size_t max_frame_bytes = 256 * 1024 * 1024);
+
+  // 可写区域，一般不少于 kMinRead 字节；待补齐的报文较大时一次给够剩余部分
+  std::span<uint8_t> prepare();
+  void commit(size_t bytes);
+
+  /**
+   * @brief 取出下一条完整报文
+   * @param frame 返回 Complete 时指向报文（含首字节 'F'/'T'），否则为空
+   */
+  Status next(std::span<const uint8_t>& frame);
+
+  // 丢弃缓冲区中的全部数据（重连或数据流错位之后）
+  void reset();
+
+  size_t buffered() const { return end_ - begin_; }
+  size_t capacity() const { return capacity_; }
+
+  /**
+   * @brief 根据已收到的报文开头推算报文长度
+   * @return data 不足时为继续推算至少需要的字节数，data 达到该长度时即为
+   *         整条报文的字节数；报文头不合法时为 kInvalidFrame
+   */
+  static size_t frame_size(std::span<const uint8_t> data);
+
+ private:
+  void reserve(size_t required, size_t preferred);
+
+  std::unique_ptr<uint8_t[]> buffer_;
+  size_t capacity_ = 0;
+  size_t max_frame_bytes_ = 0;
+  size_t begin_ = 0;          // 未交出数据的起点
+  size_t end_ = 0;            // 已收到数据的终点
+  size_t pending_frame_ = 0;  // 开头未收全的报文至少还要凑齐的总长
+};
+
+}  // namespace protocol
@@ -34,7 +34,13 @@
 
 namespace protocol {
 
-/// @brief 老协议编解码器（兼容所有现场）
+/**
+ * @brief 老协议编解码器（兼容所有现场）
+ *
+ * 各报文的字段布局只描述一次，同一份描述既用于计算长度，也用于直接写入
+ * 输出缓冲区：定长字段就地补空格，不再生成临时字符串。返回 vector 的
+ * 接口只分配一次结果缓冲区，*_to 接口写入调用方的缓冲区，不产生堆分配。
+ */
 class LegacyCodec : public ICodec {
  public:
   std::vector<uint8_t> encode_config(const ServerConfig& config) override;
@@ -51,6 +57,19 @@ class LegacyCodec : public ICodec {
   std::optional<SegmentationParams> decode_segmentation_params(
       std::span<const uint8_t> data);
 
+  size_t encoded_config_size(const ServerConfig& config) override;
+  size_t encode_config_to(const ServerConfig& config,
+                          std::span<uint8_t> out) override;
+  size_t encoded_features_size(const FeatureReport& report) override;
+  size_t encode_features_to(const FeatureReport& report,
+                            std::span<uint8_t> out) override;
+  size_t encode_features_gather(
+      const FeatureReport& report, std::span<uint8_t> scratch,
+      std::span<std::span<const uint8_t>> segments) override;
+  size_t encoded_status_size(const FrontendStatus& status) override;
+  size_t encode_status_to(const FrontendStatus& status,
+                          std::span<uint8_t> out) override;
+
  private:
   void trim_trailing_spaces(std::string& s);
   void parse_optional_fields(std::span<const uint8_t> data, size_t offset,
@@ -27,8 +27,13 @@
 #pragma once
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
+#include <system_error>
+#include <vector>
 
+#include "asio/awaitable.hpp"
+#include "protocol/SendBufferPool.hpp"
 #include "protocol/TransportAdapter.hpp"
 #include "protocol/codec.hpp"
 #include "protocol/messages.hpp"
@@ -62,13 +67,51 @@ class ProtocolSession {
                      std::function<void(std::error_code)> callback);
   void async_receive_features(FeaturesCallback callback);
   void async_receive_status(StatusCallback callback);
+  // 编码到复用的发送缓冲区；带共享图片时转为下面的聚合写，图片不拷贝
   void async_send_features(const FeatureReport& report, SendCallback callback);
+  /**
+   * @brief 以聚合写发送特征上报
+   *
+   * 报文头写入报文自带的小缓冲区，特征列表和图片（report.image 可直接引用
+   * 帧缓冲区）原地发送，发送完成前持有 report。多个会话可以共享同一份 report
+   */
+  void async_send_features(std::shared_ptr<const FeatureReport> report,
+                           SendCallback callback);
   void async_send_status(const FrontendStatus& status, SendCallback callback);
 
+  // ===== 协程接口，须在传输层所属 io_context 上的协程里调用 =====
+  // 与上面的回调接口共用编码和发送队列，错误以返回值给出，不抛异常
+
+  asio::awaitable<std::error_code> co_connect(std::string ip, uint16_t port);
+  asio::awaitable<std::error_code> co_send_features(
+      std::shared_ptr<const FeatureReport> report);
+  asio::awaitable<std::error_code> co_send_status(FrontendStatus status);
+  asio::awaitable<std::error_code> co_send_telemetry(TelemetryData telemetry);
+  // 接收并解码一条报文，失败时 report/status 为空
+  asio::awaitable<std::error_code> co_receive_features(
+      std::shared_ptr<FeatureReport>& report);
+  asio::awaitable<std::error_code> co_receive_status(
+      std::shared_ptr<FrontendStatus>& status);
+
  private:
+  // 特征上报编码为聚合写报文，编解码器不支持时退回连续编码到 buffer
+  void encode_features(std::shared_ptr<const FeatureReport> report,
+                       ITransportAdapter::SharedBuffer& buffer,
+                       std::shared_ptr<const GatherMessage>& gather);
+  /**
+   * @brief 从上报连接接收一条报文
+   *
+   * AsioTcpTransport 直接读入其接收缓冲区，frame 指向缓冲区内部；其他
+   * 传输层退回 async_receive()，报文放在 storage 里
+   */
+  asio::awaitable<std::error_code> co_receive_frame(
+      std::span<const uint8_t>& frame, std::vector<uint8_t>& storage);
+
   std::unique_ptr<ICodec> codec_;
   std::unique_ptr<ITransportAdapter> config_transport_;
   std::unique_ptr<ITransportAdapter> report_transport_;
+  // 编码结果直接写入池中的缓冲区，传输层发送完成后归还
+  SendBufferPool send_buffers_;
 };
 
 }  // namespace protocol
@@ -0,0 +1,209 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReconnectingTransport.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "asio/io_context.hpp"
+#include "asio/steady_timer.hpp"
+#include "protocol/TransportAdapter.hpp"
+
+namespace protocol {
+
+struct ReconnectConfig {
+  // 重连间隔从 initial_backoff 开始每次翻倍，最大 max_backoff，
+  // 实际等待在 [间隔/2, 间隔] 内随机，避免多台前端机同时重连
+  std::chrono::milliseconds initial_backoff{200};
+  std::chrono::milliseconds max_backoff{30000};
+  // 断线期间内存里最多暂存的报文，超出时溢写到磁盘或丢弃最旧的
+  size_t max_queued_messages = 4096;
+  size_t max_queued_bytes = 64 * 1024 * 1024;
+  // 溢写文件路径，空表示不溢写
+  std::string spill_path;
+  // 连接空闲时持续接收，对端关闭或连接出错时立即发现并重连
+  bool health_check = true;
+};
+
+/**
+ * @brief 断线自动重连的传输层包装
+ *
+ * async_connect() 记住目标地址，第一次连接的结果照常回调，之后无论连接
+ * 失败还是中途断开都在后台按退避间隔重连，调用方不需要再管连接状态。
+ *
+ * 断线期间发送的 Bulk 报文（特征上报）进入有界队列，分段报文拷贝成一块，
+ * 不再持有帧缓冲区；队列满时按配置溢写到磁盘，否则丢弃最旧的并以
+ * no_buffer_space 回调。Control 报文（状态、遥测）周期发送、过时即无用，
+ * 断线时直接以 not_connected 回调，不暂存；连接可用时即使正在重放也直接
+ * 发出，不排在暂存的 Bulk 报文之后。
+ *
+ * 重连后先按原顺序重放暂存和溢写的报文（溢写文件分批读回，上一批写完再读
+ * 下一批），重放完才直发新的 Bulk 报文。发送出错的报文回到队列重发，因此同一条
+ * 报文可能送达多次（至少一次）。暂存报文的回调在最终写出或被丢弃时执行；
+ * 溢写的报文写入文件即回调成功（写文件失败以 io_error 回调），进程重启后
+ * 文件里剩下的报文在连上后继续重放。
+ *
+ * 溢写文件的读写都在 io_context 线程上进行，发送线程只把报文交给待写队列，
+ * 文件 I/O 期间不持有 mutex_。close() 和析构时把尚未写出的报文同步写完。
+ *
+ * 报文进入断线队列时 async_send_tracked() 的 on_buffered 被调用，上层
+ * （如 FanoutSession）据此释放自己的在途窗口，断线期间的积压只由这里的
+ * 上限和溢写约束。
+ *
+ * 发送接口只做入队，不会阻塞调用线程等待网络。
+ * 被包装的传输层需要支持 close() 之后再次 async_connect()
+ */
+class ReconnectingTransport : public ITransportAdapter {
+ public:
+  struct Stats {
+    uint64_t connects = 0;        // 成功建立连接的次数
+    uint64_t disconnects = 0;     // 检测到断线的次数
+    uint64_t replayed = 0;        // 重连后重放的报文数
+    uint64_t spilled = 0;         // 溢写到磁盘的报文数
+    uint64_t dropped = 0;         // 队列满丢弃的报文数
+    size_t queued = 0;            // 当前内存中暂存的报文数
+    size_t queued_bytes = 0;      // 当前内存中暂存的字节数
+    uint64_t spill_pending = 0;   // 磁盘上尚未重放的报文数
+    bool connected = false;
+  };
+
+  ReconnectingTransport(asio::io_context& io_ctx,
+                        std::unique_ptr<ITransportAdapter> inner,
+                        const ReconnectConfig& config = {});
+  ~ReconnectingTransport() override;
+
+  void async_connect(const std::string& ip, uint16_t port,
+                     std::function<void(std::error_code)> callback) override;
+  void async_send(std::span<const uint8_t> data,
+                  SendCallback callback) override;
+  void async_send_buffer(
+      SharedBuffer data, SendCallback callback,
+      MessageClass message_class = MessageClass::Bulk) override;
+  void async_send_gather(
+      std::shared_ptr<const GatherMessage> message, SendCallback callback,
+      MessageClass message_class = MessageClass::Bulk) override;
+  // 报文进入断线队列、溢写或发送失败回到队列时调用 on_buffered
+  void async_send_tracked(SharedBuffer data,
+                          std::shared_ptr<const GatherMessage> message,
+                          SendCallback callback, BufferedCallback on_buffered,
+                          MessageClass message_class) override;
+  void async_receive(ReceiveCallback callback) override;
+  void async_receive_frames(FrameCallback callback) override;
+  void close() override;
+
+  Stats stats() const;
+
+ private:
+  struct Pending {
+    SharedBuffer buffer;
+    std::shared_ptr<const GatherMessage> gather;  // 仅在线直发时使用
+    SendCallback callback;
+    MessageClass message_class = MessageClass::Bulk;
+    bool resume_replay = false;  // 重放批次的最后一条，写完后接着重放
+    BufferedCallback on_buffered;  // 第一次进入队列时调用
+  };
+  // 在锁外执行的回调
+  using Completion = std::pair<SendCallback, std::error_code>;
+
+  void send(Pending pending);
+  // 以下调用方持有 mutex_
+  // 返回报文是否进入了队列（或溢写），放不下时以 no_buffer_space 回调
+  bool enqueue_locked(Pending pending, std::vector<Completion>& completions);
+  bool spilling_locked() const;
+  // 交给 io 线程溢写
+  void spill_later_locked(Pending pending);
+  // 以下调用方持有 spill_io_mutex_，不持有 mutex_
+  void write_spill_backlog(std::vector<Completion>& completions);
+  bool write_spill(const Pending& pending);
+  void read_spill_batch();
+  void discard_spill();
+
+  void flush_spill();
+  void load_spill(uint64_t generation);
+  void recover_spill();
+  // 标记关闭并以 operation_aborted 回调暂存报文，已关闭时返回 false
+  bool abort_pending();
+
+  void send_online(Pending pending, uint64_t generation);
+  void on_send_result(const std::error_code& ec, Pending pending,
+                      uint64_t generation);
+  void start_connect();
+  void on_connected();
+  void on_connection_lost(uint64_t generation);
+  void schedule_reconnect();
+  void replay(uint64_t generation);
+  void start_health_check(uint64_t generation);
+  void on_frame(std::span<const uint8_t> frame);
+  void finish_first_connect(const std::error_code& ec);
+
+  asio::io_context& io_ctx_;
+  std::unique_ptr<ITransportAdapter> inner_;
+  ReconnectConfig config_;
+  asio::steady_timer timer_;
+  std::minstd_rand random_;
+
+  mutable std::mutex mutex_;
+  std::string ip_;
+  uint16_t port_ = 0;
+  std::function<void(std::error_code)> connect_callback_;
+  bool connected_ = false;
+  bool replaying_ = false;  // 重放未完成时新的 Bulk 报文也进队列，保证顺序
+  bool closed_ = false;
+  uint64_t generation_ = 0;  // 每次连上加一，丢弃旧连接的迟到回调
+  uint32_t attempts_ = 0;    // 连续失败的重连次数
+  // 发送失败回退的报文，比 queue_ 里的旧，重放时先发
+  std::deque<Pending> retry_;
+  // 断线期间新发送的报文
+  std::deque<Pending> queue_;
+  size_t queued_bytes_ = 0;
+  // 等待 io 线程写入溢写文件的报文，排在文件里已有报文之后
+  std::deque<Pending> spill_backlog_;
+  size_t spill_writing_ = 0;  // 已从 spill_backlog_ 取出、正在写的报文数
+  bool spill_flush_posted_ = false;
+  uint64_t spill_pending_ = 0;  // 文件里尚未读回的报文数
+  // 溢写文件：追加写，重放时顺序读，读完后删除。
+  // 由 spill_io_mutex_ 保护，需要同时持有时先锁 spill_io_mutex_
+  std::mutex spill_io_mutex_;
+  std::ofstream spill_out_;
+  std::ifstream spill_in_;
+  // 投递到 io 线程的任务持有它的弱引用，对象析构后任务不再执行
+  std::shared_ptr<bool> alive_ = std::make_shared<bool>(true);
+  Stats stats_;
+
+  FrameCallback frame_callback_;
+  ReceiveCallback receive_callback_;
+};
+
+}  // namespace protocol
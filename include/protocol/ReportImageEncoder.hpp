@@ -0,0 +1,113 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReportImageEncoder.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <opencv2/core/types.hpp>
+
+#include "algo/LatencyHistogram.hpp"
+#include "cameras/FrameProcessor.hpp"
+#include "config/CameraConfig.hpp"
+
+namespace protocol {
+
+// 随特征上报发送的图片格式
+enum class ReportImageFormat {
+  None,  // 不发送图片
+  Raw,   // 原始像素，整帧时直接引用帧缓冲区
+  Jpeg,
+  Png
+};
+
+/**
+ * @brief 解析图片格式名（none/raw/jpeg/png，不区分大小写）
+ * @throw std::invalid_argument 未知的格式名
+ */
+ReportImageFormat parse_report_image_format(const std::string& name);
+
+struct ReportImageConfig {
+  ReportImageFormat format = ReportImageFormat::None;
+  int jpeg_quality = 90;    // 0-100
+  int png_compression = 3;  // 0-9，越大越慢
+  // 排队和正在压缩的帧数上限，超出时这一帧的上报不带图片
+  size_t max_pending = 8;
+  // 压缩线程池，默认与相机处理线程分开
+  ExecutionConfig execution = {.pool = "report_image", .threads = 2};
+};
+
+/**
+ * @brief 特征上报的图片准备：按配置直接引用帧缓冲区或压缩成 JPEG/PNG
+ *
+ * 压缩在独立的线程池上进行，不占用相机处理线程和网络线程。
+ * 回调按 submit() 的顺序执行（上报已按采集顺序排好，这里不打乱），
+ * 没有帧、格式为 None、积压超限或压缩失败时回调拿到空指针，
+ * 上报照常发送，只是不带图片。析构时等待已提交的帧全部回调完成。
+ */
+class ReportImageEncoder {
+ public:
+  using SharedImage = std::shared_ptr<const std::vector<uint8_t>>;
+  using Callback = std::function<void(SharedImage)>;
+
+  struct Stats {
+    uint64_t shared = 0;   // 直接引用帧缓冲区的次数
+    uint64_t encoded = 0;  // 压缩或裁剪成功的次数
+    uint64_t dropped = 0;  // 积压超限没有准备图片的次数
+    uint64_t failed = 0;   // 压缩失败的次数
+    size_t pending = 0;    // 等待回调的提交数
+    algo::LatencySnapshot encode_latency;  // 单帧压缩耗时（纳秒）
+  };
+
+  explicit ReportImageEncoder(const ReportImageConfig& config = {});
+  ~ReportImageEncoder();
+
+  ReportImageEncoder(const ReportImageEncoder&) = delete;
+  ReportImageEncoder& operator=(const ReportImageEncoder&) = delete;
+
+  /**
+   * @brief 为一帧准备上报图片，完成后按提交顺序回调
+   * @param roi 裁剪区域（如缺陷外接框），为空时发送整帧
+   */
+  void submit(std::shared_ptr<const CapturedFrame> frame, Callback callback,
+              const cv::Rect& roi = {});
+
+  Stats stats() const;
+
+  // 整帧像素的共享视图，与帧共用引用计数，不拷贝
+  static SharedImage share_frame_data(
+      std::shared_ptr<const CapturedFrame> frame);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace protocol
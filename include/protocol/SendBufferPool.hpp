@@ -0,0 +1,75 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: SendBufferPool.hpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace protocol {
+
+namespace detail {
+struct SendBufferPoolState;
+}  // namespace detail
+
+/**
+ * @brief 发送缓冲区池，编码结果直接写入池中的缓冲区
+ *
+ * acquire() 返回的 shared_ptr 在最后一个引用释放时（通常是异步写完成时）
+ * 自动把缓冲区放回池中，vector 的容量连同 shared_ptr 控制块一起复用，
+ * 稳态下每条报文的编码和发送不产生堆分配。池对象可以先于缓冲区析构，
+ * 未归还的缓冲区会在释放时自行清理。
+ *
+ * 线程安全：acquire 和缓冲区的释放可以在任意线程进行
+ */
+class SendBufferPool {
+ public:
+  using Buffer = std::shared_ptr<std::vector<uint8_t>>;
+
+  struct Stats {
+    uint64_t hits = 0;    // 复用缓存且容量足够的次数
+    uint64_t misses = 0;  // 需要新分配或扩容的次数
+  };
+
+  explicit SendBufferPool(size_t max_cached = 32);
+
+  /**
+   * @brief 获取一个 size() == bytes 的缓冲区
+   * @note 内容为上一次使用的残留，调用方负责整体覆盖
+   */
+  Buffer acquire(size_t bytes);
+
+  // 当前缓存的空闲缓冲区数量
+  size_t cached_count() const;
+
+  Stats stats() const;
+
+ private:
+  std::shared_ptr<detail::SendBufferPoolState> state_;
+};
+
+}  // namespace protocol
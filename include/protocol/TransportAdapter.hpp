@@ -26,14 +26,53 @@
 
 // Copyright (c) 2025 caomengxuan666
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <memory>
 #include <span>
 #include <string>
 #include <system_error>
+#include <utility>
 #include <vector>
 
+#include "asio/awaitable.hpp"
+
 namespace protocol {
 
+/**
+ * @brief 报文类别，传输层据此决定合并与推送策略
+ */
+enum class MessageClass {
+  Control,  // 状态、遥测等小报文，写出后立即推送
+  Bulk      // 特征上报等大报文，允许攒成整段再发
+};
+
+/**
+ * @brief 聚合写的一条报文
+ *
+ * segments 的前 count 段按顺序组成报文，引用的内存（报文头、特征列表、
+ * 帧缓冲区等）由 keepalive 持有到发送完成。传输层以一次 gather 写发出，
+ * 不拼接
+ */
+struct GatherMessage {
+  static constexpr size_t kMaxSegments = 8;
+
+  std::array<std::span<const uint8_t>, kMaxSegments> segments;
+  size_t count = 0;
+  std::array<uint8_t, 256> scratch{};  // 报文头等小字段
+  std::shared_ptr<const void> keepalive;
+
+  size_t size() const {
+    size_t bytes = 0;
+    for (size_t i = 0; i < count; ++i) {
+      bytes += segments[i].size();
+    }
+    return bytes;
+  }
+};
+
 class ITransportAdapter {
  public:
   virtual ~ITransportAdapter() = default;
@@ -41,13 +80,101 @@ class ITransportAdapter {
   using SendCallback = std::function<void(std::error_code)>;
   using ReceiveCallback =
       std::function<void(std::error_code, std::vector<uint8_t>)>;
+  // 报文直接指向接收缓冲区，只在回调期间有效
+  using FrameCallback =
+      std::function<void(std::error_code, std::span<const uint8_t>)>;
+  using SharedBuffer = std::shared_ptr<const std::vector<uint8_t>>;
+  // 报文进入传输层自己的离线队列时调用，见 async_send_tracked()
+  using BufferedCallback = std::function<void()>;
 
   virtual void async_connect(const std::string& ip, uint16_t port,
                              std::function<void(std::error_code)> callback) = 0;
   virtual void async_send(std::span<const uint8_t> data,
                           SendCallback callback) = 0;
+  /**
+   * @brief 发送引用计数的缓冲区（如 SendBufferPool 中的编码结果）
+   *
+   * 传输层持有引用直到发送完成，不再拷贝数据。默认转给 async_send()
+   */
+  virtual void async_send_buffer(
+      SharedBuffer data, SendCallback callback,
+      MessageClass message_class = MessageClass::Bulk) {
+    async_send(*data, std::move(callback));
+  }
+  /**
+   * @brief 聚合写，见 GatherMessage
+   *
+   * 默认把各段拼接成一块再交给 async_send_buffer()
+   */
+  virtual void async_send_gather(
+      std::shared_ptr<const GatherMessage> message, SendCallback callback,
+      MessageClass message_class = MessageClass::Bulk) {
+    auto data = std::make_shared<std::vector<uint8_t>>();
+    data->reserve(message->size());
+    for (size_t i = 0; i < message->count; ++i) {
+      data->insert(data->end(), message->segments[i].begin(),
+                   message->segments[i].end());
+    }
+    async_send_buffer(std::move(data), std::move(callback), message_class);
+  }
+  /**
+   * @brief 发送，报文被传输层暂存时通知调用方
+   *
+   * 断线期间暂存报文的传输层（如 ReconnectingTransport）在报文进入自己的
+   * 有界队列时调用 on_buffered，之后这条报文受传输层的上限约束，调用方
+   * 可以把它移出自己的在途窗口；callback 仍在最终写出或丢弃时执行一次。
+   * on_buffered 最多调用一次，可能在本调用内同步执行。
+   *
+   * data 与 message 二选一。默认不暂存，转给 async_send_buffer() 或
+   * async_send_gather()
+   */
+  virtual void async_send_tracked(SharedBuffer data,
+                                  std::shared_ptr<const GatherMessage> message,
+                                  SendCallback callback,
+                                  BufferedCallback /*on_buffered*/,
+                                  MessageClass message_class) {
+    if (message) {
+      async_send_gather(std::move(message), std::move(callback),
+                        message_class);
+    } else {
+      async_send_buffer(std::move(data), std::move(callback), message_class);
+    }
+  }
   virtual void async_receive(ReceiveCallback callback) = 0;
+  /**
+   * @brief 持续接收，每收到一条完整报文回调一次
+   *
+   * 出错或连接关闭时以错误码回调一次后停止。默认逐条调用 async_receive()
+   */
+  virtual void async_receive_frames(FrameCallback callback) {
+    async_receive([this, callback = std::move(callback)](
+                      std::error_code ec, std::vector<uint8_t> data) mutable {
+      callback(ec, data);
+      if (!ec) {
+        async_receive_frames(std::move(callback));
+      }
+    });
+  }
   virtual void close() = 0;
+
+  // ===== 协程接口，须在传输层所属 io_context 上的协程里调用 =====
+
+  /**
+   * @brief 连接，错误以返回值给出
+   *
+   * 默认经 async_connect() 等待回调；能直接挂起协程的传输层覆盖它
+   * （如 AsioTcpTransport 异步解析地址）
+   */
+  virtual asio::awaitable<std::error_code> co_connect(std::string ip,
+                                                      uint16_t port);
+  /**
+   * @brief 接收一条完整报文，frame 在下一次接收前有效
+   *
+   * 默认经 async_receive() 把报文收进 storage，frame 指向 storage；
+   * 能在自己的接收缓冲区上直接切出报文的传输层覆盖它，不经过 storage
+   */
+  virtual asio::awaitable<std::error_code> co_receive_frame(
+      std::span<const uint8_t>& frame, std::vector<uint8_t>& storage);
 };
 
 }  // namespace protocol
@@ -26,6 +26,8 @@
 
 // Copyright (c) 2025 caomengxuan666
 #pragma once
+#include <algorithm>
+#include <cstddef>
 #include <optional>
 #include <span>
 
@@ -49,6 +51,59 @@ class ICodec {
   virtual std::vector<uint8_t> encode_status(const FrontendStatus& status) = 0;
   virtual std::optional<FrontendStatus> decode_status(
       std::span<const uint8_t> data) = 0;
+
+  // ===== 编码到调用方提供的缓冲区 =====
+  // *_size 返回编码后的字节数，*_to 写入 out 并返回写入的字节数，
+  // out 不够大时什么也不写，返回 0。配合复用的发送缓冲区，发送路径
+  // 不产生堆分配。默认实现走上面的接口再拷贝，编解码器可按需覆盖
+
+  virtual size_t encoded_config_size(const ServerConfig& config) {
+    return encode_config(config).size();
+  }
+  virtual size_t encode_config_to(const ServerConfig& config,
+                                  std::span<uint8_t> out) {
+    return copy_encoded(encode_config(config), out);
+  }
+
+  virtual size_t encoded_features_size(const FeatureReport& report) {
+    return encode_features(report).size();
+  }
+  virtual size_t encode_features_to(const FeatureReport& report,
+                                    std::span<uint8_t> out) {
+    return copy_encoded(encode_features(report), out);
+  }
+
+  /**
+   * @brief 特征上报的聚合写编码
+   *
+   * 定长的小字段写入 scratch，特征列表和图片数据直接引用 report 的内存，
+   * 按发送顺序填入 segments 并返回段数。不支持或空间不足时返回 0，
+   * 调用方退回连续编码。发送完成前 report 必须保持有效。
+   * 默认实现表示不支持聚合写，总是返回 0
+   */
+  virtual size_t encode_features_gather(
+      const FeatureReport& /*report*/, std::span<uint8_t> /*scratch*/,
+      std::span<std::span<const uint8_t>> /*segments*/) {
+    return 0;
+  }
+
+  virtual size_t encoded_status_size(const FrontendStatus& status) {
+    return encode_status(status).size();
+  }
+  virtual size_t encode_status_to(const FrontendStatus& status,
+                                  std::span<uint8_t> out) {
+    return copy_encoded(encode_status(status), out);
+  }
+
+ protected:
+  static size_t copy_encoded(const std::vector<uint8_t>& data,
+                             std::span<uint8_t> out) {
+    if (data.size() > out.size()) {
+      return 0;
+    }
+    std::copy(data.begin(), data.end(), out.begin());
+    return data.size();
+  }
 };
 
 }  // namespace protocol
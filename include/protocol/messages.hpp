@@ -28,7 +28,9 @@
 #pragma once
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -61,6 +63,14 @@ struct FeatureReport {
   std::vector<std::pair<int32_t, float>> features;  // 特征列表
   std::array<float, 20> special_images;             // 20个特殊图片信息
   std::vector<uint8_t> image_data;                  // 图片数据
+  // 引用计数的图片数据，非空时代替 image_data 发送。可以直接引用帧缓冲区
+  // 或压缩结果（见 ReportImageEncoder），发送完成前一直持有引用，不拷贝
+  std::shared_ptr<const std::vector<uint8_t>> image;
+
+  std::span<const uint8_t> image_bytes() const {
+    return image ? std::span<const uint8_t>(*image)
+                 : std::span<const uint8_t>(image_data);
+  }
 };
 
 /// @brief 前端机状态（32位）
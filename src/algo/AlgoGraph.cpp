@@ -0,0 +1,239 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: AlgoGraph.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/AlgoGraph.hpp"
+//
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "BS_thread_pool.hpp"
+#include "logging/CaponLogging.hpp"
+
+namespace algo {
+
+namespace {
+
+constexpr size_t kNoNode = static_cast<size_t>(-1);
+
+struct GraphNode {
+  std::string name;
+  AlgoGraph::Stage run;
+  std::vector<AlgoGraph::NodeId> dependents;
+  size_t dependency_count = 0;
+  LatencyHistogram latency;
+  std::atomic<uint64_t> failures{0};
+  std::atomic<uint64_t> skipped{0};
+};
+
+// 单帧的调度状态，由调用线程和执行节点的任务共同持有
+struct FrameRun {
+  explicit FrameRun(size_t nodes) : remaining(nodes), upstream_failed(nodes) {}
+
+  const CapturedFrame* frame = nullptr;
+  std::vector<std::atomic<size_t>> remaining;  // 尚未完成的上游数
+  std::vector<std::atomic<bool>> upstream_failed;
+  std::atomic<size_t> pending{0};  // 尚未结束的节点数
+  std::mutex mutex;
+  std::condition_variable done;
+};
+
+}  // namespace
+
+struct AlgoGraph::State {
+  // process() 持读锁直到本帧结束，添加节点持写锁
+  mutable std::shared_mutex mutex;
+  std::vector<std::unique_ptr<GraphNode>> nodes;
+  std::vector<NodeId> roots;
+
+  std::unique_ptr<BS::thread_pool<>> pool;
+  Executor executor;
+
+  NodeId add(std::string name, Stage stage,
+             const std::vector<NodeId>& depends_on) {
+    std::unique_lock lock(mutex);
+    const NodeId id = nodes.size();
+    for (NodeId dep : depends_on) {
+      if (dep >= id) {
+        throw std::invalid_argument("AlgoGraph: unknown dependency node");
+      }
+    }
+    auto node = std::make_unique<GraphNode>();
+    node->name = std::move(name);
+    node->run = std::move(stage);
+    for (NodeId dep : depends_on) {
+      nodes[dep]->dependents.push_back(id);
+      ++node->dependency_count;
+    }
+    if (node->dependency_count == 0) {
+      roots.push_back(id);
+    }
+    nodes.push_back(std::move(node));
+    return id;
+  }
+
+  // 任务只持有本帧状态；State 在 process() 返回前一直有效，
+  // 因此最后一个引用不会落在线程池自己的线程上
+  void submit(const std::shared_ptr<FrameRun>& run, NodeId id) {
+    executor([this, run, id]() { execute(run, id); });
+  }
+
+  // 执行一个节点，并接着执行它释放出的第一个下游，其余下游交给执行器
+  void execute(const std::shared_ptr<FrameRun>& run, NodeId id) {
+    while (id != kNoNode) {
+      GraphNode& node = *nodes[id];
+      bool ok = false;
+      if (run->upstream_failed[id].load(std::memory_order_relaxed)) {
+        node.skipped.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        try {
+          LatencyScope scope(&node.latency);
+          node.run(*run->frame);
+          ok = true;
+        } catch (const std::exception& e) {
+          node.failures.fetch_add(1, std::memory_order_relaxed);
+          LOG_ERROR("AlgoGraph node {} failed: {}", node.name, e.what());
+        } catch (...) {
+          node.failures.fetch_add(1, std::memory_order_relaxed);
+          LOG_ERROR("AlgoGraph node {} failed with unknown exception",
+                    node.name);
+        }
+      }
+
+      NodeId next = kNoNode;
+      for (NodeId dependent : node.dependents) {
+        if (!ok) {
+          run->upstream_failed[dependent].store(true,
+                                                std::memory_order_relaxed);
+        }
+        // acq_rel 保证下游看到上游的输出和失败标记
+        if (run->remaining[dependent].fetch_sub(
+                1, std::memory_order_acq_rel) == 1) {
+          if (next == kNoNode) {
+            next = dependent;
+          } else {
+            submit(run, dependent);
+          }
+        }
+      }
+
+      if (run->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard lock(run->mutex);
+        run->done.notify_all();
+      }
+      id = next;
+    }
+  }
+};
+
+AlgoGraph::AlgoGraph(size_t threads) : state_(std::make_shared<State>()) {
+  if (threads == 0) {
+    threads = kDefaultThreads;
+  }
+  state_->pool = std::make_unique<BS::thread_pool<>>(threads);
+  state_->executor = [pool = state_->pool.get()](Task task) {
+    pool->detach_task(std::move(task));
+  };
+}
+
+AlgoGraph::AlgoGraph(Executor executor) : state_(std::make_shared<State>()) {
+  state_->executor = std::move(executor);
+}
+
+AlgoGraph::NodeId AlgoGraph::add_algorithm(
+    AlgoPtr algo, const std::vector<NodeId>& depends_on) {
+  if (!algo) {
+    throw std::invalid_argument("AlgoGraph: null algorithm");
+  }
+  algo->initialize();
+  std::string name = algo->get_name();
+  return state_->add(
+      std::move(name),
+      [algo = std::move(algo)](const CapturedFrame& frame) {
+        algo->process(frame);
+      },
+      depends_on);
+}
+
+AlgoGraph::NodeId AlgoGraph::add_stage(std::string name, Stage stage,
+                                       const std::vector<NodeId>& depends_on) {
+  return state_->add(std::move(name), std::move(stage), depends_on);
+}
+
+void AlgoGraph::process(const CapturedFrame& frame) {
+  std::shared_lock lock(state_->mutex);
+  const size_t count = state_->nodes.size();
+  if (count == 0) {
+    return;
+  }
+
+  auto run = std::make_shared<FrameRun>(count);
+  run->frame = &frame;
+  run->pending.store(count, std::memory_order_relaxed);
+  for (size_t i = 0; i < count; ++i) {
+    run->remaining[i].store(state_->nodes[i]->dependency_count,
+                            std::memory_order_relaxed);
+  }
+
+  // 调用线程自己执行第一个根节点，其余根节点并行
+  const auto& roots = state_->roots;
+  for (size_t i = 1; i < roots.size(); ++i) {
+    state_->submit(run, roots[i]);
+  }
+  state_->execute(run, roots.front());
+
+  std::unique_lock wait_lock(run->mutex);
+  run->done.wait(wait_lock, [&run]() {
+    return run->pending.load(std::memory_order_acquire) == 0;
+  });
+}
+
+std::shared_ptr<FrameProcessor> AlgoGraph::clone() const {
+  return std::make_shared<AlgoGraph>(*this);
+}
+
+size_t AlgoGraph::size() const {
+  std::shared_lock lock(state_->mutex);
+  return state_->nodes.size();
+}
+
+std::vector<AlgoNodeTiming> AlgoGraph::get_node_timing() const {
+  std::shared_lock lock(state_->mutex);
+  std::vector<AlgoNodeTiming> timing;
+  timing.reserve(state_->nodes.size());
+  for (const auto& node : state_->nodes) {
+    timing.push_back({node->name, node->latency.snapshot(),
+                      node->failures.load(std::memory_order_relaxed),
+                      node->skipped.load(std::memory_order_relaxed)});
+  }
+  return timing;
+}
+
+}  // namespace algo
@@ -0,0 +1,218 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameProducts.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/FrameProducts.hpp"
+//
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+// for opencv
+#include <opencv2/imgproc.hpp>
+
+namespace algo {
+
+namespace {
+
+// 左右白边检测：采样行上二分查找白色像素占比的分界，再向内收 100 像素
+std::pair<int, int> find_horizontal_content_bounds_gray(
+    const cv::Mat& gray_image, double threshold_ratio = 0.1) noexcept {
+  int height = gray_image.rows;
+  int width = gray_image.cols;
+  if (gray_image.cols <= 1000 || gray_image.rows <= 1000) {
+    return {0, width - 1};
+  }
+  // 采样行数（For 2600行，sample 325行）
+  const int SAMPLE_STEP = height > 1000 ? 8 : 1;
+  const int SAMPLED_HEIGHT = (height + SAMPLE_STEP - 1) / SAMPLE_STEP;
+
+  // 预计算采样行的指针
+  std::vector<const uchar*> row_ptrs;
+  row_ptrs.reserve(SAMPLED_HEIGHT);
+  for (int y = 0; y < height; y += SAMPLE_STEP) {
+    row_ptrs.push_back(gray_image.ptr<uchar>(y));
+  }
+
+  // 白色边的阈值
+  const uchar WHITE_THRESHOLD = 200;
+  const double threshold_count = SAMPLED_HEIGHT * threshold_ratio;
+
+  // 检查左边是否需要裁剪
+  int x_min = 0;
+  int left_white_count = 0;
+  for (const auto* row : row_ptrs) {
+    if (row[0] > WHITE_THRESHOLD) {
+      ++left_white_count;
+    }
+  }
+
+  if (static_cast<double>(left_white_count) / SAMPLED_HEIGHT >
+      threshold_ratio) {
+    // 二分查左边界
+    int left = 0, right = width - 1;
+    while (left < right) {
+      int mid = (left + right) / 2;
+      int white_count = 0;
+      for (const auto* row : row_ptrs) {
+        if (row[mid] > WHITE_THRESHOLD) {
+          ++white_count;
+        }
+      }
+
+      if (static_cast<double>(white_count) / SAMPLED_HEIGHT > threshold_ratio) {
+        left = mid + 1;
+      } else {
+        right = mid;
+      }
+    }
+    x_min = left;
+  }
+
+  // 检查右边是否需要裁剪
+  int x_max = width - 1;
+  int right_white_count = 0;
+  for (const auto* row : row_ptrs) {
+    if (row[width - 1] > WHITE_THRESHOLD) {
+      ++right_white_count;
+    }
+  }
+
+  if (static_cast<double>(right_white_count) / SAMPLED_HEIGHT >
+      threshold_ratio) {
+    // 二分查找右边界
+    int left = 0, right = width - 1;
+    while (left < right) {
+      int mid = (left + right + 1) / 2;
+      int white_count = 0;
+      for (const auto* row : row_ptrs) {
+        if (row[mid] > WHITE_THRESHOLD) {
+          ++white_count;
+        }
+      }
+
+      if (static_cast<double>(white_count) / SAMPLED_HEIGHT > threshold_ratio) {
+        right = mid - 1;
+      } else {
+        left = mid;
+      }
+    }
+    x_max = left;
+  }
+
+  if (x_min == 0 && x_max >= width - 5) {
+    return {-1, -1};
+  }
+
+  constexpr int offset = 100;
+  x_min = std::max(0, x_min + offset);
+  x_max = std::min(width - 1, x_max - offset);
+
+  if (x_min >= x_max) {
+    return {-1, -1};
+  }
+
+  return {x_min, x_max};
+}
+
+}  // namespace
+
+cv::Mat frame_view(const CapturedFrame& frame) {
+  const size_t pixels = static_cast<size_t>(frame.width()) * frame.height();
+  const int type = frame.data.size() < pixels * 3 ? CV_8UC1 : CV_8UC3;
+  return cv::Mat(frame.height(), frame.width(), type,
+                 const_cast<uint8_t*>(frame.data.data()));
+}
+
+cv::Range content_columns(const cv::Mat& gray) {
+  auto [x_min, x_max] = find_horizontal_content_bounds_gray(gray);
+  if (x_min == -1 || x_max == -1) {
+    return cv::Range(0, gray.cols);
+  }
+  constexpr int margin = 10;
+  return cv::Range(std::max(0, x_min - margin),
+                   std::min(gray.cols - 1, x_max + margin) + 1);
+}
+
+std::shared_ptr<const cv::Mat> frame_gray(const CapturedFrame& frame) {
+  return frame.derived.get_or_compute<cv::Mat>("gray", [&frame]() {
+    cv::Mat view = frame_view(frame);
+    if (view.channels() == 1) {
+      return view;
+    }
+    cv::Mat gray;
+    cv::cvtColor(view, gray, cv::COLOR_BGR2GRAY);
+    return gray;
+  });
+}
+
+std::shared_ptr<const cv::Range> frame_content_columns(
+    const CapturedFrame& frame) {
+  return frame.derived.get_or_compute<cv::Range>("content_columns", [&frame]() {
+    return content_columns(*frame_gray(frame));
+  });
+}
+
+std::shared_ptr<const cv::Mat> frame_content_gray(const CapturedFrame& frame) {
+  return frame.derived.get_or_compute<cv::Mat>("content_gray", [&frame]() {
+    const cv::Mat& gray = *frame_gray(frame);
+    const cv::Range cols = *frame_content_columns(frame);
+    if (cols.start == 0 && cols.end == gray.cols) {
+      return gray;
+    }
+    return gray(cv::Range::all(), cols);
+  });
+}
+
+std::shared_ptr<const cv::Mat> frame_pyramid(const CapturedFrame& frame,
+                                             int level) {
+  if (level <= 0) {
+    return frame_content_gray(frame);
+  }
+  return frame.derived.get_or_compute<cv::Mat>(
+      "pyramid/" + std::to_string(level), [&frame, level]() {
+        cv::Mat down;
+        cv::pyrDown(*frame_pyramid(frame, level - 1), down);
+        return down;
+      });
+}
+
+std::shared_ptr<const GrayHistogram> frame_histogram(
+    const CapturedFrame& frame) {
+  return frame.derived.get_or_compute<GrayHistogram>("histogram", [&frame]() {
+    const cv::Mat& gray = *frame_content_gray(frame);
+    GrayHistogram hist{};
+    for (int y = 0; y < gray.rows; ++y) {
+      const uchar* row = gray.ptr<uchar>(y);
+      for (int x = 0; x < gray.cols; ++x) {
+        ++hist[row[x]];
+      }
+    }
+    return hist;
+  });
+}
+
+}  // namespace algo
@@ -34,21 +34,32 @@
  * FrameProcessor
  *    - process_single_image(const std::string&, const std::string&) - Process
  * image file
- *    - process_single_image(const Mat&) - Process video frame
+ *    - process_single_image(const CapturedFrame&) - Process video frame
+ *    - process_rows(const Mat&) - Streaming mode: consume consecutive row
+ *      blocks of a line-scan strip; holes are labeled across blocks by
+ *      StreamingHoleLabeler and emitted as soon as they close
  *
  * 2. Main processing chain:
- *    process() -> process_single_image(Mat) -> process_single_image_impl()
+ *    process() -> process_single_image(CapturedFrame) ->
+ *      process_single_image_impl()
  *    process_single_image(string, string) -> process_single_image_impl()
  *
  * 3. Detailed steps in process_single_image_impl():
- *    a. Preprocessing:
- *       - preprocess_for_hole_detection() -> preprocess_image_fast()
+ *    a. Preprocessing (done by the caller before process_single_image_impl):
+ *       - Frames: frame_content_gray() from FrameProducts, cached on the
+ *         frame so other algorithms reuse the same gray crop
+ *       - Files / Mats: preprocess_for_hole_detection() ->
+ *         preprocess_image_fast()
  *         * Convert to grayscale if needed
- *         * Crop image to remove mostly white borders
+ *         * Crop image to remove mostly white borders (content_columns())
  *    b. Thresholding:
  *       - threshold_image() -> apply_partitioned_threshold_parallel()
  *         * Apply different thresholds to different image partitions
- *         * Uses parallel processing for large images
+ *         * Large CV_8UC1 images use the fused SIMD row kernel in
+ *           PartitionThreshold (one pass over all three zones per row)
+ *       - With tiling_mode set, label_image() thresholds and labels
+ *         vertical/horizontal tiles in parallel and stitches components
+ *         across tile seams; the result matches the single-pass labeling
  *    c. Hole extraction:
  *       - extract_holes() -> connectedComponentsWithStats()
  *         * Identify connected components
@@ -64,27 +75,30 @@
  *       - For video frames: Just output statistics
  */
 
-// 是否启用详细日志输出和计时功能的编译期开关
-#ifndef ENABLE_HOLE_DETECTION_LOGGING
-#define ENABLE_HOLE_DETECTION_LOGGING 1
-#endif
-
 #include "algo/HoleDetection.hpp"
 //
 #include <algorithm>
 #include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdint>
 #include <filesystem>  //NOLINT
 #include <ios>
 #include <iostream>
-#include <ratio>  //NOLINT
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 // for opencv
 #include <opencv2/opencv.hpp>
 // utils
+#include "algo/FrameProducts.hpp"
+#include "algo/HoleMerge.hpp"
+#include "algo/PartitionThreshold.hpp"
+#include "algo/StreamingHoleLabeler.hpp"
+#include "logging/CaponLogging.hpp"
 
 using namespace algo;         // NOLINT
 using namespace cv;           // NOLINT
@@ -92,30 +106,6 @@ using namespace std::chrono;  // NOLINT
 using std::cout, std::endl, std::setprecision, std::fixed, std::cerr;
 namespace fs = std::filesystem;
 
-// 条件编译宏定义，用于控制日志输出和计时功能
-#if ENABLE_HOLE_DETECTION_LOGGING
-#define HOLE_DETECTION_LOG(x) cout << x
-#define HOLE_DETECTION_TIMING_START(name) \
-  auto name##_start = high_resolution_clock::now()
-#define HOLE_DETECTION_TIMING_END(name, msg)                                 \
-  auto name##_end = high_resolution_clock::now();                            \
-  const double name##_ms =                                                   \
-      duration_cast<duration<double, std::milli>>(name##_end - name##_start) \
-          .count();                                                          \
-  cout << (msg) << name##_ms << " ms" << endl
-
-#define HOLE_DETECTION_TIMING_ONLY(name)                                     \
-  auto name##_end = high_resolution_clock::now();                            \
-  const double name##_ms =                                                   \
-      duration_cast<duration<double, std::milli>>(name##_end - name##_start) \
-          .count()
-#else
-#define HOLE_DETECTION_LOG(x)
-#define HOLE_DETECTION_TIMING_START(name)
-#define HOLE_DETECTION_TIMING_END(name, msg)
-#define HOLE_DETECTION_TIMING_ONLY(name)
-#endif
-
 constexpr double M_PI{3.1415926535897932384626433832795};
 
 __forceinline static bool is_big_image(const Mat& image) noexcept {
@@ -127,22 +117,6 @@ __forceinline static double calculate_real_world_diameter(
   return pixel_diameter / pixel_per_mm;
 }
 
-__forceinline double euclidean_distance(const Point& a,
-                                        const Point& b) noexcept {
-  double dx = static_cast<double>(a.x - b.x);
-  double dy = static_cast<double>(a.y - b.y);
-  return std::sqrt(dx * dx + dy * dy);
-}
-
-static cv::Mat CapturedFrame2Mat(const CapturedFrame& frame) {
-  // 可选：校验数据大小（根据 CV_8UC3 假设）
-  // assert(frame.data.size() ==
-  //        static_cast<size_t>(frame.width() * frame.height() * 3));
-
-  return cv::Mat(frame.height(), frame.width(), CV_8UC3,
-                 const_cast<uint8_t*>(frame.data.data()));
-}
-
 static std::vector<std::string> get_image_files(const std::string& dir) {
   std::vector<std::string> extensions = {".jpg", ".jpeg", ".png", ".bmp",
                                          ".tiff"};
@@ -160,165 +134,28 @@ static std::vector<std::string> get_image_files(const std::string& dir) {
   return files;
 }
 
-static std::pair<int, int> find_horizontal_content_bounds_gray(
-    const Mat& gray_image, double threshold_ratio = 0.1) noexcept {
-  int height = gray_image.rows;
-  int width = gray_image.cols;
-  if (!is_big_image(gray_image)) {
-    return {0, width - 1};
-  }
-  // 采样行数（For 2600行，sample 325行）
-  const int SAMPLE_STEP = height > 1000 ? 8 : 1;
-  const int SAMPLED_HEIGHT = (height + SAMPLE_STEP - 1) / SAMPLE_STEP;
-
-  // 预计算采样行的指针
-  std::vector<const uchar*> row_ptrs;
-  row_ptrs.reserve(SAMPLED_HEIGHT);
-  for (int y = 0; y < height; y += SAMPLE_STEP) {
-    row_ptrs.push_back(gray_image.ptr<uchar>(y));
-  }
-
-  // 白色边的阈值
-  const uchar WHITE_THRESHOLD = 200;
-  const double threshold_count = SAMPLED_HEIGHT * threshold_ratio;
-
-  // 检查左边是否需要裁剪
-  int x_min = 0;
-  int left_white_count = 0;
-  for (const auto* row : row_ptrs) {
-    if (row[0] > WHITE_THRESHOLD) {
-      ++left_white_count;
-    }
-  }
-
-  if (static_cast<double>(left_white_count) / SAMPLED_HEIGHT >
-      threshold_ratio) {
-    // 二分查左边界
-    int left = 0, right = width - 1;
-    while (left < right) {
-      int mid = (left + right) / 2;
-      int white_count = 0;
-      for (const auto* row : row_ptrs) {
-        if (row[mid] > WHITE_THRESHOLD) {
-          ++white_count;
-        }
-      }
-
-      if (static_cast<double>(white_count) / SAMPLED_HEIGHT > threshold_ratio) {
-        left = mid + 1;
-      } else {
-        right = mid;
-      }
-    }
-    x_min = left;
-  }
-
-  // 检查右边是否需要裁剪
-  int x_max = width - 1;
-  int right_white_count = 0;
-  for (const auto* row : row_ptrs) {
-    if (row[width - 1] > WHITE_THRESHOLD) {
-      ++right_white_count;
-    }
-  }
-
-  if (static_cast<double>(right_white_count) / SAMPLED_HEIGHT >
-      threshold_ratio) {
-    // 二分查找右边界
-    int left = 0, right = width - 1;
-    while (left < right) {
-      int mid = (left + right + 1) / 2;
-      int white_count = 0;
-      for (const auto* row : row_ptrs) {
-        if (row[mid] > WHITE_THRESHOLD) {
-          ++white_count;
-        }
-      }
-
-      if (static_cast<double>(white_count) / SAMPLED_HEIGHT > threshold_ratio) {
-        right = mid - 1;
-      } else {
-        left = mid;
-      }
-    }
-    x_max = left;
-  }
-
-  if (x_min == 0 && x_max >= width - 5) {
-    return {-1, -1};
-  }
-
-  constexpr int offset = 100;
-  x_min = max(0, x_min + offset);
-  x_max = min(width - 1, x_max - offset);
-
-  if (x_min >= x_max) {
-    return {-1, -1};
-  }
-
-  return {x_min, x_max};
-}
-
 static Mat preprocess_image_fast(const Mat& image) noexcept {
-  HOLE_DETECTION_TIMING_START(total);
-
   // 直接获取灰度图（如果是彩色才转换）
   Mat gray;
   if (image.channels() == 3) {
-    HOLE_DETECTION_TIMING_START(cvt);
     cvtColor(image, gray, COLOR_BGR2GRAY);
-    HOLE_DETECTION_TIMING_END(cvt, "    Color conversion: ");
   } else {
     gray = image;  // 直接使用，不拷贝
   }
 
   // 直接在灰度图上找边界（跳过二值化！）
-  HOLE_DETECTION_TIMING_START(bounds);
-  auto [x_min, x_max] = find_horizontal_content_bounds_gray(gray);
-  HOLE_DETECTION_TIMING_END(bounds, "    Bounds search: ");
-
-  if (x_min == -1 || x_max == -1) {
-    HOLE_DETECTION_TIMING_END(total, "    Total preprocessing: ");
-    HOLE_DETECTION_LOG("    Total preprocessing: " << total_ms
-                                                   << " ms (no crop)" << endl);
-    return image;
+  Range cols = content_columns(gray);
+  if (cols.start == 0 && cols.end == gray.cols) {
+    return gray;
   }
 
-  constexpr int margin = 10;
-  x_min = max(0, x_min - margin);
-  x_max = min(gray.cols - 1, x_max + margin);
-
-  HOLE_DETECTION_TIMING_START(crop);
-  Mat cropped = image(Range::all(), Range(x_min, x_max + 1));
-  HOLE_DETECTION_TIMING_END(crop, "    Cropping:      ");
-
-  HOLE_DETECTION_TIMING_END(total, "    Total preprocessing: ");
-  HOLE_DETECTION_LOG("    Cropped from " << image.cols << "x" << image.rows
-                                         << " to " << cropped.cols << "x"
-                                         << cropped.rows << endl);
-
+  Mat cropped = gray(Range::all(), cols);
+  LOG_DEBUG("HoleDetection cropped {}x{} to {}x{}", image.cols, image.rows,
+            cropped.cols, cropped.rows);
   return cropped;
 }
 
 // ==================== PARALLEL THRESHOLDING ====================
-struct ParallelThresholdTask : public cv::ParallelLoopBody {
-  const Mat& src;
-  Mat& dst;
-  int start_col, end_col;
-  int thresh;
-
-  ParallelThresholdTask(const Mat& src_, Mat& dst_, int s, int e, int t)
-      : src(src_), dst(dst_), start_col(s), end_col(e), thresh(t) {}
-
-  void operator()(const cv::Range& rowRange) const override {
-    for (int r = rowRange.start; r < rowRange.end; ++r) {
-      Mat src_row = src.row(r).colRange(start_col, end_col);
-      Mat dst_row = dst.row(r).colRange(start_col, end_col);
-      threshold(src_row, dst_row, thresh, 255, THRESH_BINARY);
-    }
-  }
-};
-
 static Mat apply_partitioned_threshold_parallel(
     const cv::Mat& image, const PartitionConfig& params) noexcept {
   if (!is_big_image(image)) {
@@ -328,149 +165,283 @@ static Mat apply_partitioned_threshold_parallel(
     return binary;
   }
 
-  int width = image.cols;
-  Mat binary = Mat::zeros(image.size(), CV_8UC1);
+  // 单通道走融合行内核：一次遍历完成三段阈值，按行块并行
+  PartitionBands bands = make_partition_bands(image.cols, params);
+  if (image.type() == CV_8UC1) {
+    return threshold_partitioned(image, bands);
+  }
 
-  int left_end = static_cast<int>(width * params.left_ratio);
-  int mid_end =
-      static_cast<int>(width * (params.left_ratio + params.mid_ratio));
+  Mat binary(image.size(), CV_MAKETYPE(CV_8U, image.channels()));
+  const int band_cols[4] = {0, bands.left_end, bands.mid_end, image.cols};
+  const int band_thresh[3] = {bands.left_thresh, bands.mid_thresh,
+                              bands.right_thresh};
+  for (int k = 0; k < 3; ++k) {
+    if (band_cols[k + 1] > band_cols[k]) {
+      Mat dst = binary.colRange(band_cols[k], band_cols[k + 1]);
+      cv::threshold(image.colRange(band_cols[k], band_cols[k + 1]), dst,
+                    band_thresh[k], 255, cv::THRESH_BINARY);
+    }
+  }
+  return binary;
+}
+// =======================================================
 
-  int rows = image.rows;
+// ==================== TILED LABELING ====================
+// 连通域统计结果，单次标记和分块标记都产出这一结构，保证后续过滤一致
+struct ComponentStats {
+  int left;
+  int top;
+  int width;
+  int height;
+  int area;
+  double cx;
+  double cy;
+};
 
-  if (left_end > 0) {
-    cv::parallel_for_(
-        cv::Range(0, rows),
-        ParallelThresholdTask(image, binary, 0, left_end, params.left_thresh));
-  }
-  if (mid_end > left_end) {
-    cv::parallel_for_(cv::Range(0, rows),
-                      ParallelThresholdTask(image, binary, left_end, mid_end,
-                                            params.mid_thresh));
+enum class TilingMode { None, Vertical, Horizontal };
+
+static TilingMode parse_tiling_mode(const std::string& mode) noexcept {
+  if (mode == "vertical") {
+    return TilingMode::Vertical;
   }
-  if (width > mid_end) {
-    cv::parallel_for_(cv::Range(0, rows),
-                      ParallelThresholdTask(image, binary, mid_end, width,
-                                            params.right_thresh));
+  if (mode == "horizontal") {
+    return TilingMode::Horizontal;
   }
+  return TilingMode::None;
+}
 
-  return binary;
+// 单次标记：整幅二值图一次 connectedComponentsWithStats
+static std::vector<ComponentStats> label_components(const Mat& binary) {
+  Mat labels, stats, centroids;
+  int num_labels =
+      connectedComponentsWithStats(binary, labels, stats, centroids, 8, CV_32S);
+
+  std::vector<ComponentStats> components;
+  if (num_labels > 1) {
+    components.reserve(num_labels - 1);
+  }
+  for (int i = 1; i < num_labels; ++i) {
+    const int* s = stats.ptr<int>(i);
+    const double* c = centroids.ptr<double>(i);
+    components.push_back({s[CC_STAT_LEFT], s[CC_STAT_TOP], s[CC_STAT_WIDTH],
+                          s[CC_STAT_HEIGHT], s[CC_STAT_AREA], c[0], c[1]});
+  }
+  return components;
 }
-// =======================================================
 
-struct HoleInfo {
-  int index;
-  Point center;
-  double pixel_diameter;
-  int area;
-  bool merged = false;
-  int merged_count = 1;
-  double real_diameter = -1.0;
-  int width;                  // 添加宽度属性
-  int height;                 // 添加高度属性
-  double real_area = -1.0;    // 添加实际面积属性
-  double real_width = -1.0;   // 添加实际宽度属性
-  double real_height = -1.0;  // 添加实际高度属性
-  int top_y;                  // 添加上边界Y坐标
-  int bottom_y;               // 添加下边界Y坐标
+// 分块内的局部连通域，坐标已换算到整图
+struct TileComponent {
+  int left, top, right, bottom;  // 闭区间边界框
+  int64_t area;
+  int64_t sum_x, sum_y;  // 像素坐标整数和，合并后可精确还原质心
+  // OpenCV 按 2x2 块扫描顺序分配标签，(块行, 块列) 的最小值决定输出顺序
+  int key_row, key_col;
 };
 
-static std::vector<HoleInfo> merge_close_holes(
-    std::vector<HoleInfo>& holes, int distance_threshold,
-    const HoleDetection::Config& config) noexcept {
-  if (holes.size() <= 1) {
-    return holes;
+struct TileResult {
+  Rect roi;
+  Mat labels;
+  std::vector<TileComponent> components;
+};
+
+static int find_root(std::vector<int>& parent, int i) noexcept {
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i = parent[i];
+  }
+  return i;
+}
+
+static void unite(std::vector<int>& parent, int a, int b) noexcept {
+  a = find_root(parent, a);
+  b = find_root(parent, b);
+  if (a != b) {
+    parent[std::max(a, b)] = std::min(a, b);
   }
+}
 
-  std::vector<bool> merged(holes.size(), false);
-  std::vector<HoleInfo> merged_holes;
+// 对一个分块做分区阈值 + 连通域标记
+static void label_tile(const Mat& image, const PartitionConfig& params,
+                       TileResult& tile) {
+  const Rect& roi = tile.roi;
+  const PartitionBands bands = make_partition_bands(image.cols, params);
+
+  Mat binary(roi.size(), CV_8UC1);
+  for (int r = 0; r < roi.height; ++r) {
+    threshold_partitioned_row(image.ptr<uchar>(roi.y + r),
+                              binary.ptr<uchar>(r), roi.x, roi.x + roi.width,
+                              bands);
+  }
 
-  for (size_t i = 0; i < holes.size(); ++i) {
-    if (merged[i]) {
-      continue;
+  Mat stats, centroids;
+  int num_labels = connectedComponentsWithStats(binary, tile.labels, stats,
+                                                centroids, 8, CV_32S);
+  tile.components.clear();
+  if (num_labels > 1) {
+    tile.components.reserve(num_labels - 1);
+  }
+  for (int i = 1; i < num_labels; ++i) {
+    const int* s = stats.ptr<int>(i);
+    const double* c = centroids.ptr<double>(i);
+    TileComponent comp;
+    comp.area = s[CC_STAT_AREA];
+    comp.left = roi.x + s[CC_STAT_LEFT];
+    comp.top = roi.y + s[CC_STAT_TOP];
+    comp.right = comp.left + s[CC_STAT_WIDTH] - 1;
+    comp.bottom = comp.top + s[CC_STAT_HEIGHT] - 1;
+    // OpenCV 的质心是整数坐标和除以面积，这里反推出精确的整数和
+    comp.sum_x = std::llround(c[0] * static_cast<double>(comp.area)) +
+                 static_cast<int64_t>(roi.x) * comp.area;
+    comp.sum_y = std::llround(c[1] * static_cast<double>(comp.area)) +
+                 static_cast<int64_t>(roi.y) * comp.area;
+
+    comp.key_row = comp.top / 2;
+    comp.key_col = INT_MAX;
+    for (int gy = comp.key_row * 2; gy <= comp.key_row * 2 + 1; ++gy) {
+      int ly = gy - roi.y;
+      if (ly < 0 || ly >= roi.height) {
+        continue;
+      }
+      const int* row = tile.labels.ptr<int>(ly);
+      for (int x = s[CC_STAT_LEFT]; x < s[CC_STAT_LEFT] + s[CC_STAT_WIDTH];
+           ++x) {
+        if (row[x] == i) {
+          comp.key_col = std::min(comp.key_col, (roi.x + x) / 2);
+          break;
+        }
+      }
     }
+    tile.components.push_back(comp);
+  }
+}
 
-    std::vector<size_t> close_indices;
-    for (size_t j = 0; j < holes.size(); ++j) {
-      if (!merged[j] && euclidean_distance(holes[i].center, holes[j].center) <=
-                            distance_threshold) {
-        close_indices.push_back(j);
-        merged[j] = true;
-      }
+// 分块阈值 + 标记：各分块并行处理，接缝两侧 8 邻接的像素在拼接时合并，
+// 输出与整图单次标记逐项一致（面积、边界框、质心和顺序）
+static std::vector<ComponentStats> threshold_and_label_tiled(
+    const Mat& image, const PartitionConfig& params, TilingMode mode,
+    int tile_count) {
+  // 分块过窄时拼接开销会盖过并行收益
+  constexpr int kMinTileSpan = 256;
+  const bool vertical = mode == TilingMode::Vertical;
+  const int span = vertical ? image.cols : image.rows;
+  int tiles = tile_count > 0 ? tile_count : cv::getNumThreads();
+  tiles = std::clamp(tiles, 1, std::max(1, span / kMinTileSpan));
+
+  std::vector<TileResult> results(tiles);
+  for (int k = 0; k < tiles; ++k) {
+    int begin = static_cast<int>(static_cast<int64_t>(span) * k / tiles);
+    int end = static_cast<int>(static_cast<int64_t>(span) * (k + 1) / tiles);
+    results[k].roi = vertical ? Rect(begin, 0, end - begin, image.rows)
+                              : Rect(0, begin, image.cols, end - begin);
+  }
+
+  cv::parallel_for_(cv::Range(0, tiles), [&](const cv::Range& range) {
+    for (int k = range.start; k < range.end; ++k) {
+      label_tile(image, params, results[k]);
     }
+  });
 
-    if (close_indices.size() == 1) {
-      merged_holes.push_back(holes[close_indices[0]]);
-    } else {
-      double total_area = 0;
-      double total_cx = 0, total_cy = 0;
-      // 计算边界框
-      int min_x = INT_MAX, min_y = INT_MAX;
-      int max_x = INT_MIN, max_y = INT_MIN;
-
-      for (size_t idx : close_indices) {
-        total_area += holes[idx].area;
-        total_cx += holes[idx].center.x * holes[idx].area;
-        total_cy += holes[idx].center.y * holes[idx].area;
-
-        // 更新边界框
-        min_x = std::min(min_x, holes[idx].center.x - holes[idx].width / 2);
-        min_y = std::min(min_y, holes[idx].center.y - holes[idx].height / 2);
-        max_x = std::max(max_x, holes[idx].center.x + holes[idx].width / 2);
-        max_y = std::max(max_y, holes[idx].center.y + holes[idx].height / 2);
+  // 全局编号：分块偏移 + (局部标签 - 1)
+  std::vector<int> base(tiles + 1, 0);
+  for (int k = 0; k < tiles; ++k) {
+    base[k + 1] = base[k] + static_cast<int>(results[k].components.size());
+  }
+  std::vector<int> parent(base[tiles]);
+  for (int i = 0; i < base[tiles]; ++i) {
+    parent[i] = i;
+  }
+
+  // 接缝拼接：比较相邻分块的边界行/列，8 邻接即合并
+  for (int k = 0; k + 1 < tiles; ++k) {
+    const Mat& a = results[k].labels;
+    const Mat& b = results[k + 1].labels;
+    if (vertical) {
+      const int last = a.cols - 1;
+      for (int r = 0; r < a.rows; ++r) {
+        int la = a.at<int>(r, last);
+        if (la == 0) {
+          continue;
+        }
+        for (int dr = -1; dr <= 1; ++dr) {
+          int rr = r + dr;
+          if (rr < 0 || rr >= b.rows) {
+            continue;
+          }
+          int lb = b.at<int>(rr, 0);
+          if (lb != 0) {
+            unite(parent, base[k] + la - 1, base[k + 1] + lb - 1);
+          }
+        }
       }
-      int avg_cx = static_cast<int>(std::round(total_cx / total_area));
-      int avg_cy = static_cast<int>(std::round(total_cy / total_area));
-      double equiv_diam = 2.0 * std::sqrt(total_area / M_PI);
-
-      // 计算合并后的宽度和高度
-      int merged_width = max_x - min_x;
-      int merged_height = max_y - min_y;
-
-      HoleInfo merged_hole;
-      merged_hole.index = static_cast<int>(merged_holes.size()) + 1;
-      merged_hole.center = Point(avg_cx, avg_cy);
-      merged_hole.pixel_diameter = equiv_diam;
-      merged_hole.area = static_cast<int>(total_area);
-      merged_hole.width = merged_width;    // 设置合并后的宽度
-      merged_hole.height = merged_height;  // 设置合并后的高度
-      merged_hole.merged = true;
-      merged_hole.merged_count = static_cast<int>(close_indices.size());
-      merged_hole.top_y = min_y;     // 设置上边界Y坐标
-      merged_hole.bottom_y = max_y;  // 设置下边界Y坐标
-
-      // 计算实际尺寸
-      if (config.enable_real_world_calculation) {
-        merged_hole.real_width =
-            merged_width * config.pixel_to_mm_width;  // NOLINT
-        merged_hole.real_height =
-            merged_height * config.pixel_to_mm_height;  // NOLINT
-        merged_hole.real_area =
-            total_area * config.pixel_to_mm_width * config.pixel_to_mm_height;
-        for (size_t idx : close_indices) {
-          if (holes[idx].real_diameter > 0) {
-            merged_hole.real_diameter =
-                holes[idx].real_diameter * (total_area / holes[idx].area);
-            break;
+    } else {
+      const int* row_a = a.ptr<int>(a.rows - 1);
+      const int* row_b = b.ptr<int>(0);
+      for (int c = 0; c < a.cols; ++c) {
+        if (row_a[c] == 0) {
+          continue;
+        }
+        for (int dc = -1; dc <= 1; ++dc) {
+          int cc = c + dc;
+          if (cc >= 0 && cc < b.cols && row_b[cc] != 0) {
+            unite(parent, base[k] + row_a[c] - 1, base[k + 1] + row_b[cc] - 1);
           }
         }
       }
+    }
+  }
 
-      merged_holes.push_back(merged_hole);
+  // 按根节点汇总
+  std::vector<TileComponent> merged;
+  std::vector<int> slot(base[tiles], -1);
+  for (int k = 0; k < tiles; ++k) {
+    for (size_t j = 0; j < results[k].components.size(); ++j) {
+      const TileComponent& comp = results[k].components[j];
+      int root = find_root(parent, base[k] + static_cast<int>(j));
+      if (slot[root] < 0) {
+        slot[root] = static_cast<int>(merged.size());
+        merged.push_back(comp);
+        continue;
+      }
+      TileComponent& dst = merged[slot[root]];
+      dst.area += comp.area;
+      dst.sum_x += comp.sum_x;
+      dst.sum_y += comp.sum_y;
+      dst.left = std::min(dst.left, comp.left);
+      dst.top = std::min(dst.top, comp.top);
+      dst.right = std::max(dst.right, comp.right);
+      dst.bottom = std::max(dst.bottom, comp.bottom);
+      if (std::tie(comp.key_row, comp.key_col) <
+          std::tie(dst.key_row, dst.key_col)) {
+        dst.key_row = comp.key_row;
+        dst.key_col = comp.key_col;
+      }
     }
   }
 
-  for (size_t i = 0; i < merged_holes.size(); ++i) {
-    merged_holes[i].index = static_cast<int>(i + 1);
+  // 恢复整图标记的标签顺序
+  std::sort(merged.begin(), merged.end(),
+            [](const TileComponent& a, const TileComponent& b) {
+              return std::tie(a.key_row, a.key_col) <
+                     std::tie(b.key_row, b.key_col);
+            });
+
+  std::vector<ComponentStats> components;
+  components.reserve(merged.size());
+  for (const auto& comp : merged) {
+    const double area = static_cast<double>(comp.area);
+    components.push_back({comp.left, comp.top, comp.right - comp.left + 1,
+                          comp.bottom - comp.top + 1,
+                          static_cast<int>(comp.area),
+                          static_cast<double>(comp.sum_x) / area,
+                          static_cast<double>(comp.sum_y) / area});
   }
-  return merged_holes;
+  return components;
 }
+// =======================================================
 
 // Preprocess image for hole detection
 static Mat preprocess_for_hole_detection(const Mat& processed_image) noexcept {
-  HOLE_DETECTION_TIMING_START(prep);
-  Mat image = preprocess_image_fast(processed_image);
-  HOLE_DETECTION_TIMING_END(prep, "    Preprocessing:    ");
-  return image;
+  return preprocess_image_fast(processed_image);
 }
 
 // Apply threshold to image
@@ -486,23 +457,45 @@ static Mat threshold_image(const Mat& image, bool is_small_image,
   }
 
   // --- Partitioned Threshold ---
-  HOLE_DETECTION_TIMING_START(thresh);
-  Mat binary = apply_partitioned_threshold_parallel(image, params);
-  HOLE_DETECTION_TIMING_END(thresh, "    Thresholding:     ");
-  return binary;
+  return apply_partitioned_threshold_parallel(image, params);
 }
 
-// Extract hole information from binary image
-static std::vector<HoleInfo> extract_holes(
-    const Mat& image, const Mat& binary, bool is_small_image,
-    bool skip_edge_detection, const HoleDetection::Config& config) noexcept {
+static LatencyHistogram* stage_histogram(LatencyHistogram* stages,
+                                         HoleDetectionStage stage) noexcept {
+  return stages ? &stages[static_cast<int>(stage)] : nullptr;
+}
+
+// Threshold + connected components, tiled when configured
+static std::vector<ComponentStats> label_image(
+    const Mat& image, bool is_small_image, const HoleDetection::Config& config,
+    const PartitionConfig& parsed_params, LatencyHistogram* stages) {
+  TilingMode mode = parse_tiling_mode(config.tiling_mode);
+  // 分块只对大图的单通道分区阈值生效，其余情况走整图单次标记
+  if (mode != TilingMode::None && image.type() == CV_8UC1 &&
+      is_big_image(image)) {
+    // 分块路径里阈值和标记在同一个任务里完成，整体计入连通域阶段
+    LatencyScope scope(
+        stage_histogram(stages, HoleDetectionStage::Components));
+    return threshold_and_label_tiled(image, parsed_params, mode,
+                                     config.tile_count);
+  }
+
+  Mat binary;
+  {
+    LatencyScope scope(stage_histogram(stages, HoleDetectionStage::Threshold));
+    binary = threshold_image(image, is_small_image, config, parsed_params);
+  }
+
   // --- Connected Components ---
-  HOLE_DETECTION_TIMING_START(cc);
-  Mat labels, stats, centroids;
-  int num_labels =
-      connectedComponentsWithStats(binary, labels, stats, centroids, 8, CV_32S);
-  HOLE_DETECTION_TIMING_END(cc, "    ConnectedComps:   ");
+  LatencyScope scope(stage_histogram(stages, HoleDetectionStage::Components));
+  return label_components(binary);
+}
 
+// Extract hole information from labeled components
+static std::vector<HoleInfo> extract_holes(
+    const Mat& image, const std::vector<ComponentStats>& components,
+    bool is_small_image, bool skip_edge_detection,
+    const HoleDetection::Config& config) noexcept {
   // --- Adjust parameters for small images (like Python) ---
   int current_min_area = is_small_image ? 1 : config.min_defect_area;
 
@@ -512,25 +505,18 @@ static std::vector<HoleInfo> extract_holes(
   int height = image.rows;
   int width = image.cols;
 
-  if (num_labels > 1) {
-    hole_data.reserve(num_labels - 1);
-  }
-
-  const int* stats_ptr = stats.ptr<int>(0);
-  const double* centroids_ptr = centroids.ptr<double>(0);
-  int stats_cols = stats.cols;
-  int centroids_cols = centroids.cols;
+  hole_data.reserve(components.size());
 
-  for (int i = 1; i < num_labels; ++i) {
-    int area = stats_ptr[i * stats_cols + CC_STAT_AREA];
+  for (const auto& comp : components) {
+    int area = comp.area;
     if (area < current_min_area) {
       continue;
     }
 
-    int x = stats_ptr[i * stats_cols + CC_STAT_LEFT];
-    int y = stats_ptr[i * stats_cols + CC_STAT_TOP];
-    int w = stats_ptr[i * stats_cols + CC_STAT_WIDTH];
-    int h = stats_ptr[i * stats_cols + CC_STAT_HEIGHT];
+    int x = comp.left;
+    int y = comp.top;
+    int w = comp.width;
+    int h = comp.height;
 
     // --- Edge filtering: only for large images ---
     bool near_edge = false;
@@ -548,9 +534,8 @@ static std::vector<HoleInfo> extract_holes(
       continue;
     }
 
-    // Get centroid (x, y) - note: centroids[i][0] = x, [1] = y
-    double cx_d = centroids_ptr[i * centroids_cols + 0];
-    double cy_d = centroids_ptr[i * centroids_cols + 1];
+    double cx_d = comp.cx;
+    double cy_d = comp.cy;
     int cx = static_cast<int>(cx_d + 0.5);  // Round properly
     int cy = static_cast<int>(cy_d + 0.5);
 
@@ -588,12 +573,7 @@ static std::vector<HoleInfo> merge_holes(
       is_small_image ? 5 : config.merge_distance_threshold;
 
   // --- Merge close holes ---
-  HOLE_DETECTION_TIMING_START(merge);
-  auto merged_hole_data =
-      merge_close_holes(hole_data, current_merge_distance, config);
-  HOLE_DETECTION_TIMING_END(merge, "    Merging:          ");
-
-  return merged_hole_data;
+  return merge_close_holes(hole_data, current_merge_distance, config);
 }
 
 // Create visualization images
@@ -601,7 +581,6 @@ static std::pair<Mat, Mat> create_visualizations(
     const Mat& image, std::vector<HoleInfo>& merged_hole_data,
     const HoleDetection::Config& config) noexcept {
   // --- Visualization (with adaptive radius for small images) ---
-  HOLE_DETECTION_TIMING_START(vis);
   Mat result_image;
   cvtColor(image, result_image, COLOR_GRAY2BGR);
 
@@ -789,8 +768,6 @@ static std::pair<Mat, Mat> create_visualizations(
     }
   }
 
-  HOLE_DETECTION_TIMING_END(vis, "    Visualization:    ");
-
   return std::make_pair(contour_visualization, bbox_visualization);
 }
 
@@ -809,75 +786,93 @@ static void save_results(const Mat& result_image,
       output_dir + "/contours_" + base_name + ".jpg";
   std::string bbox_result_path = output_dir + "/bbox_" + base_name + ".jpg";
 
-  HOLE_DETECTION_TIMING_START(save);
   // 保存原始处理图像（无标注）
   imwrite(original_result_path, result_image);
   // 保存显示质心和轮廓的图像
   imwrite(contour_result_path, contour_visualization);
   // 保存显示边界框的图像
   imwrite(bbox_result_path, bbox_visualization);
-  HOLE_DETECTION_TIMING_END(save, "    Image saving:     ");
 
-  HOLE_DETECTION_LOG("  Results saved to: " << endl);
-  HOLE_DETECTION_LOG("    Original:   " << original_result_path << endl);
-  HOLE_DETECTION_LOG("    Contours:   " << contour_result_path << endl);
-  HOLE_DETECTION_LOG("    Bounding boxes: " << bbox_result_path << endl);
+  LOG_INFO("HoleDetection results saved: {}, {}, {}", original_result_path,
+           contour_result_path, bbox_result_path);
 }
 
 // load from local directory for debug
-static void process_single_image_impl(const Mat& processed_image,
+// image 为预处理后的灰度内容区域，frame 为来源帧，按文件处理时为空
+static void process_single_image_impl(const Mat& image,
                                       const std::string& image_path,
                                       const std::string& output_dir,
                                       const HoleDetection::Config& config,
                                       const PartitionConfig& parsed_params,
-                                      AlgoBase* algo_ptr) noexcept {
-  HOLE_DETECTION_TIMING_START(total);
-
-  // --- Preprocessing ---
-  Mat image = preprocess_for_hole_detection(processed_image);
-
+                                      AlgoBase* algo_ptr,
+                                      ImageSignalBus::FeatureSignal features,
+                                      LatencyHistogram* stages,
+                                      const CapturedFrame* frame) noexcept {
   // --- Check image size ---
   bool is_small_image = (image.rows <= 100 && image.cols <= 100);
   bool skip_edge_detection = (image.rows < 1000 || image.cols < 1000);
 
-  // --- Threshold ---
-  Mat binary = threshold_image(image, is_small_image, config, parsed_params);
+  // --- Threshold + label ---
+  auto components =
+      label_image(image, is_small_image, config, parsed_params, stages);
 
   // --- Extract holes ---
-  auto hole_data =
-      extract_holes(image, binary, is_small_image, skip_edge_detection, config);
+  std::vector<HoleInfo> hole_data;
+  {
+    LatencyScope scope(stage_histogram(stages, HoleDetectionStage::Extract));
+    hole_data = extract_holes(image, components, is_small_image,
+                              skip_edge_detection, config);
+  }
 
   // --- Merge holes ---
-  auto merged_hole_data = merge_holes(hole_data, is_small_image, config);
-
-  // 构造特征数据
-  ImageSignalBus::FeatureData data;
-  // data.roll_id =
-  // "HOLE_" + std::to_string(frame.timestamp);
-  // 这里不需要直接写卷号而是在外部设置，外部可以获取服务器发送的卷号状态
-  // 这个是传输层的事情，所以我们算法层不需要关心这个
-
-  for (const auto& hole : merged_hole_data) {
-    float confidence =
-        static_cast<float>(hole.area) / (image.rows * image.cols);  // NOLINT
-    data.features.emplace_back(1, confidence);
+  std::vector<HoleInfo> merged_hole_data;
+  {
+    LatencyScope scope(stage_histogram(stages, HoleDetectionStage::Merge));
+    merged_hole_data = merge_holes(hole_data, is_small_image, config);
   }
 
-  std::fill(data.special_images.begin(), data.special_images.end(), 0.0f);
-  for (size_t i = 0;
-       i < std::min(merged_hole_data.size(), static_cast<size_t>(10));
-       ++i) {  // NOLINT
-    if (i * 2 + 1 < data.special_images.size()) {
-      data.special_images[i * 2] =
-          static_cast<float>(merged_hole_data[i].real_width);
-      data.special_images[i * 2 + 1] =
-          static_cast<float>(merged_hole_data[i].real_height);
+  {
+    LatencyScope scope(stage_histogram(stages, HoleDetectionStage::Emit));
+    // 构造特征数据
+    ImageSignalBus::FeatureData data;
+    // data.roll_id =
+    // "HOLE_" + std::to_string(frame.timestamp);
+    // 这里不需要直接写卷号而是在外部设置，外部可以获取服务器发送的卷号状态
+    // 这个是传输层的事情，所以我们算法层不需要关心这个
+    // 每帧都发出一条结果（没有孔洞时特征为空），下游按采集序号重排
+    if (frame) {
+      data.camera_id = frame->meta.cameraId;
+      data.sequence = frame->meta.sequence;
+      data.stream_id = frame->meta.stream_id;
+    }
+
+    for (const auto& hole : merged_hole_data) {
+      float confidence =
+          static_cast<float>(hole.area) / (image.rows * image.cols);  // NOLINT
+      data.features.emplace_back(1, confidence);
+    }
+
+    // 有孔洞时附上来源帧，上报可以带图片；帧不由共享指针持有时拿到空
+    if (frame && !data.features.empty()) {
+      data.frame = frame->weak_from_this().lock();
     }
-  }
 
-  // 直接调用 emit_feature
-  if (algo_ptr) {
-    algo_ptr->emit_feature("hole_features", data);
+    std::fill(data.special_images.begin(), data.special_images.end(), 0.0f);
+    for (size_t i = 0;
+         i < std::min(merged_hole_data.size(), static_cast<size_t>(10));
+         ++i) {  // NOLINT
+      if (i * 2 + 1 < data.special_images.size()) {
+        data.special_images[i * 2] =
+            static_cast<float>(merged_hole_data[i].real_width);
+        data.special_images[i * 2 + 1] =
+            static_cast<float>(merged_hole_data[i].real_height);
+      }
+    }
+
+    // 按 initialize() 时取到的句柄发送，不再每帧按名查找
+    if (algo_ptr) {
+      algo_ptr->emit_feature(features, data);
+    }
   }
 
   // 如果是视频帧处理，则不需要保存结果图像
@@ -893,22 +888,10 @@ static void process_single_image_impl(const Mat& processed_image,
     // --- Save results ---
     save_results(result_image, contour_visualization, bbox_visualization,
                  image_path, output_dir);
-
-    // --- Timing & output ---
-    HOLE_DETECTION_TIMING_END(total, "  Total time:         ");
-
-    HOLE_DETECTION_LOG("Image: " << fs::path(image_path).filename().string()
-                                 << endl);
-    HOLE_DETECTION_LOG("  Timing breakdown:" << endl);
-    HOLE_DETECTION_LOG("  Total time:         " << total_ms << " ms" << endl);
-  } else {
-    // 视频帧处理情况，仅输出基本统计信息
-    HOLE_DETECTION_TIMING_ONLY(total);
-
-    HOLE_DETECTION_LOG("Video frame processed: " << merged_hole_data.size()
-                                                 << " holes detected" << endl);
-    HOLE_DETECTION_LOG("  Processing time: " << total_ms << " ms" << endl);
   }
+
+  LOG_DEBUG("HoleDetection frame processed: {} holes detected",
+            merged_hole_data.size());
 }
 
 // 从文件路径加载图像并处理的接口
@@ -916,42 +899,119 @@ static void process_single_image(const std::string& image_path,
                                  const std::string& output_dir,
                                  const HoleDetection::Config& config,
                                  const PartitionConfig& parsed_params,
-                                 AlgoBase* algo_ptr) noexcept {
-  HOLE_DETECTION_TIMING_START(load);
+                                 AlgoBase* algo_ptr,
+                                 ImageSignalBus::FeatureSignal features,
+                                 LatencyHistogram* stages) noexcept {
   Mat image = imread(image_path, IMREAD_GRAYSCALE);
-  HOLE_DETECTION_TIMING_END(load, "  Loading image:    ");
 
   if (image.empty()) {
     cerr << "Warning: Unable to load image '" << image_path << "'" << endl;
     return;
   }
 
-  process_single_image_impl(image, image_path, output_dir, config,
-                            parsed_params, algo_ptr);
-}
-
-// 从Mat对象处理图像的接口（用于视频帧处理）
-static void process_single_image(const Mat& frame,
-                                 const HoleDetection::Config& config,
-                                 const PartitionConfig& parsed_params,
-                                 AlgoBase* algo_ptr) noexcept {
-  std::string dummy_path = "";
-  std::string dummy_output_dir = "";
-  process_single_image_impl(frame, dummy_path, dummy_output_dir, config,
-                            parsed_params, algo_ptr);
+  Mat processed;
+  {
+    LatencyScope scope(stage_histogram(stages, HoleDetectionStage::Preprocess));
+    processed = preprocess_for_hole_detection(image);
+  }
+  process_single_image_impl(processed, image_path, output_dir, config,
+                            parsed_params, algo_ptr, features, stages,
+                            nullptr);
 }
 
 // 新增：从CapturedFrame处理图像的接口，这是process()函数实际调用的版本
 static void process_single_image(const CapturedFrame& frame,
                                  const HoleDetection::Config& config,
                                  const PartitionConfig& parsed_params,
-                                 AlgoBase* algo_ptr) noexcept {
+                                 AlgoBase* algo_ptr,
+                                 ImageSignalBus::FeatureSignal features,
+                                 LatencyHistogram* stages) noexcept {
   std::string dummy_path = "";
   std::string dummy_output_dir = "";
-  Mat image = CapturedFrame2Mat(frame);
-  process_single_image_impl(image, dummy_path, dummy_output_dir, config,
-                            parsed_params, algo_ptr);
+  // 灰度和裁剪结果缓存在帧上，同一帧上的其它算法直接复用
+  std::shared_ptr<const Mat> image;
+  {
+    LatencyScope scope(stage_histogram(stages, HoleDetectionStage::Preprocess));
+    image = frame_content_gray(frame);
+  }
+  process_single_image_impl(*image, dummy_path, dummy_output_dir, config,
+                            parsed_params, algo_ptr, features, stages,
+                            &frame);
+}
+
+// ==================== STAGE LATENCY ====================
+// 自动输出各阶段耗时的间隔
+constexpr int64_t kLatencyLogIntervalNs = 60LL * 1000 * 1000 * 1000;
+
+static const char* stage_name(HoleDetectionStage stage) noexcept {
+  switch (stage) {
+    case HoleDetectionStage::Preprocess:
+      return "preprocess";
+    case HoleDetectionStage::Threshold:
+      return "threshold";
+    case HoleDetectionStage::Components:
+      return "components";
+    case HoleDetectionStage::Extract:
+      return "extract";
+    case HoleDetectionStage::Merge:
+      return "merge";
+    case HoleDetectionStage::Emit:
+      return "emit";
+    case HoleDetectionStage::Total:
+      return "total";
+    default:
+      return "unknown";
+  }
+}
+// =======================================================
+
+// ==================== STREAMING ====================
+// 发出已闭合的孔洞：面积和左右边缘过滤与按帧检测一致，
+// 上下方向在条带中是连续的，不做边缘过滤，也不再跨孔洞合并
+static void emit_stream_holes(const std::vector<StreamingComponent>& closed,
+                              int width, int block_rows,
+                              const HoleDetection::Config& config,
+                              AlgoBase* algo_ptr,
+                              ImageSignalBus::FeatureSignal features) {
+  const bool skip_edge_detection = width < 1000;
+  const double frame_pixels =
+      static_cast<double>(width) * std::max(1, block_rows);
+
+  ImageSignalBus::FeatureData data;
+  std::fill(data.special_images.begin(), data.special_images.end(), 0.0f);
+  size_t emitted = 0;
+  for (const auto& comp : closed) {
+    if (comp.area < config.min_defect_area) {
+      continue;
+    }
+    if (!skip_edge_detection &&
+        (comp.left < config.edge_margin ||
+         comp.right + 1 > width - config.edge_margin)) {
+      continue;
+    }
+
+    data.features.emplace_back(
+        1, static_cast<float>(static_cast<double>(comp.area) / frame_pixels));
+    if (emitted * 2 + 1 < data.special_images.size()) {
+      const int w = comp.right - comp.left + 1;
+      const int64_t h = comp.bottom - comp.top + 1;
+      data.special_images[emitted * 2] =
+          config.enable_real_world_calculation
+              ? static_cast<float>(w * config.pixel_to_mm_width)
+              : -1.0f;
+      data.special_images[emitted * 2 + 1] =
+          config.enable_real_world_calculation
+              ? static_cast<float>(h * config.pixel_to_mm_height)
+              : -1.0f;
+    }
+    ++emitted;
+  }
+
+  if (!data.features.empty() && algo_ptr) {
+    algo_ptr->emit_feature(features, data);
+  }
 }
+// =======================================================
 
 void HoleDetection::parse_partition_params() {
   std::stringstream ss(config_.partition_params);
@@ -1008,6 +1068,21 @@ HoleDetection::HoleDetection() {
          config_.partition_params = value;
          parse_partition_params();
        }},
+      {"tiling_mode",
+       [this](const std::string& value) {
+         std::unique_lock lock(config_mutex_);
+         config_.tiling_mode = value;
+       }},
+      {"tile_count",
+       [this](const std::string& value) {
+         std::unique_lock lock(config_mutex_);
+         config_.tile_count = std::stoi(value);
+       }},
+      {"streaming",
+       [this](const std::string& value) {
+         std::unique_lock lock(config_mutex_);
+         config_.streaming = std::stoi(value) != 0;
+       }},
   };
 }
 
@@ -1015,6 +1090,8 @@ HoleDetection::HoleDetection(const Config& cfg) : config_(cfg) {
   parse_partition_params();  // 初始化时解析
 }
 
+HoleDetection::~HoleDetection() = default;
+
 void HoleDetection::update_config(const Config& new_cfg) {
   std::unique_lock lock(config_mutex_);
   config_ = new_cfg;
@@ -1037,21 +1114,135 @@ void HoleDetection::process(const CapturedFrame& frame) {
     local_parsed_params = parsed_params_;  // 使用解析后的结构体
   }
 
-  double pixel_per_mm = local_config.enable_real_world_calculation
-                            ? local_config.pixel_per_mm
-                            : -1;
-  if (pixel_per_mm > 0) {
-    HOLE_DETECTION_LOG("Using calibration parameters: "
-                       << fixed << setprecision(2) << pixel_per_mm
-                       << " pixels/mm" << endl);
+  if (local_config.streaming) {
+    process_rows(*frame_gray(frame));
+    return;
   }
 
-  HOLE_DETECTION_TIMING_START(total);
-  // 直接处理CapturedFrame，不再需要保存结果到文件
-  process_single_image(CapturedFrame2Mat(frame), local_config,
-                       local_parsed_params, this);
+  {
+    LatencyScope scope(
+        stage_histogram(stage_latency_.data(), HoleDetectionStage::Total));
+    // 直接处理CapturedFrame，不再需要保存结果到文件
+    process_single_image(frame, local_config, local_parsed_params, this,
+                         hole_features_, stage_latency_.data());
+  }
 
-  HOLE_DETECTION_TIMING_END(total, "Total time: ");
+  // 按固定间隔把各阶段耗时写入日志，只有一个线程会抢到这次输出
+  const int64_t now_ns =
+      duration_cast<nanoseconds>(steady_clock::now().time_since_epoch())
+          .count();
+  int64_t last_ns = last_latency_log_ns_.load(std::memory_order_relaxed);
+  if (last_ns == 0) {
+    last_latency_log_ns_.compare_exchange_strong(last_ns, now_ns,
+                                                 std::memory_order_relaxed);
+  } else if (now_ns - last_ns >= kLatencyLogIntervalNs &&
+             last_latency_log_ns_.compare_exchange_strong(
+                 last_ns, now_ns, std::memory_order_relaxed)) {
+    log_stage_latency();
+  }
+}
+
+void HoleDetection::process_rows(const cv::Mat& rows) {
+  if (rows.empty()) {
+    return;
+  }
+
+  Mat gray;
+  if (rows.channels() == 3) {
+    cvtColor(rows, gray, COLOR_BGR2GRAY);
+  } else {
+    gray = rows;
+  }
+
+  Config local_config;
+  PartitionConfig local_parsed_params;
+  {
+    std::shared_lock lock(config_mutex_);
+    local_config = config_;
+    local_parsed_params = parsed_params_;
+  }
+
+  std::vector<StreamingComponent> closed;
+  auto collect = [&closed](const StreamingComponent& comp) {
+    closed.push_back(comp);
+  };
+
+  // 串行化整个行块，保证孔洞按条带顺序发出
+  std::lock_guard lock(stream_mutex_);
+  if (!stream_) {
+    stream_ = std::make_unique<StreamingHoleLabeler>();
+  }
+  if (gray.cols != stream_source_cols_) {
+    if (stream_source_cols_ >= 0) {
+      stream_->finish(collect);
+      emit_stream_holes(closed, stream_->width(), stream_block_rows_,
+                        local_config, this, hole_features_);
+      closed.clear();
+    }
+    // 条带开始时锁定裁剪范围，规则与按帧检测一致
+    Range cols = content_columns(gray);
+    stream_source_cols_ = gray.cols;
+    stream_x_begin_ = cols.start;
+    stream_->reset(cols.size(),
+                   make_partition_bands(cols.size(), local_parsed_params));
+  } else {
+    stream_->set_bands(
+        make_partition_bands(stream_->width(), local_parsed_params));
+  }
+
+  stream_block_rows_ = gray.rows;
+  {
+    // 流式路径里阈值和行程标记在同一遍扫描里完成，计入连通域阶段
+    LatencyScope scope(stage_histogram(stage_latency_.data(),
+                                       HoleDetectionStage::Components));
+    stream_->push_rows(
+        gray.colRange(stream_x_begin_, stream_x_begin_ + stream_->width()),
+        collect);
+  }
+  LatencyScope scope(
+      stage_histogram(stage_latency_.data(), HoleDetectionStage::Emit));
+  emit_stream_holes(closed, stream_->width(), stream_block_rows_, local_config,
+                    this, hole_features_);
+}
+
+void HoleDetection::end_stream() {
+  Config local_config;
+  {
+    std::shared_lock lock(config_mutex_);
+    local_config = config_;
+  }
+
+  std::vector<StreamingComponent> closed;
+  std::lock_guard lock(stream_mutex_);
+  if (!stream_ || stream_source_cols_ < 0) {
+    return;
+  }
+  stream_->finish(
+      [&closed](const StreamingComponent& comp) { closed.push_back(comp); });
+  emit_stream_holes(closed, stream_->width(), stream_block_rows_, local_config,
+                    this, hole_features_);
+  stream_source_cols_ = -1;
+}
+
+std::vector<StageLatency> HoleDetection::get_stage_latency() const {
+  std::vector<StageLatency> result;
+  result.reserve(stage_latency_.size());
+  for (size_t i = 0; i < stage_latency_.size(); ++i) {
+    result.push_back({stage_name(static_cast<HoleDetectionStage>(i)),
+                      stage_latency_[i].snapshot()});
+  }
+  return result;
+}
+
+void HoleDetection::log_stage_latency() const {
+  for (const auto& stage : get_stage_latency()) {
+    if (stage.latency.count == 0) {
+      continue;
+    }
+    LOG_INFO("HoleDetection {:<10} n={} p50={:.3f}ms p99={:.3f}ms max={:.3f}ms",
+             stage.stage, stage.latency.count, stage.latency.p50_ns / 1e6,
+             stage.latency.p99_ns / 1e6, stage.latency.max_ns / 1e6);
+  }
 }
 
 std::vector<AlgoParamInfo> HoleDetection::get_parameter_info() const {
@@ -1080,12 +1271,23 @@ std::vector<AlgoParamInfo> HoleDetection::get_parameter_info() const {
            "分区配置（left_ratio,mid_ratio,right_ratio,left_thresh,mid_thresh,"
            "right_thresh）",
            "0.3,0.4,0.3,20,23,20",
-           local_config.partition_params}};  // 直接返回字符串
+           local_config.partition_params},  // 直接返回字符串
+          {"tiling_mode", "string", "分块并行模式（none/vertical/horizontal）",
+           "none", local_config.tiling_mode},
+          {"tile_count", "int", "分块数（0 表示按线程数）", "0",
+           std::to_string(local_config.tile_count)},
+          {"streaming", "bool", "流式行块检测（线扫条带连续行块）", "0",
+           local_config.streaming ? "1" : "0"}};
+}
+
+void HoleDetection::on_initialized() {
+  hole_features_ = feature_signal("hole_features");
 }
 
 std::vector<AlgoSignalInfo> HoleDetection::get_signal_info() const {
   return {{"raw", "原始灰度图像"},
           {"preprocessed", "预处理后图像（裁剪+去噪）"},
           {"binary", "二值化结果（分区阈值）"},
-          {"defect_map", "缺陷标注图（含合并孔洞）"}};
+          {"defect_map", "缺陷标注图（含合并孔洞）"},
+          {"hole_features", "针孔特征数据", AlgoSignalKind::Feature}};
 }
@@ -0,0 +1,180 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: HoleMerge.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/HoleMerge.hpp"
+//
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+
+namespace algo {
+
+namespace {
+
+inline int floor_div(int value, int divisor) noexcept {
+  return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+// 网格单元坐标打包成一个 64 位键
+inline int64_t cell_key(int cx, int cy) noexcept {
+  return (static_cast<int64_t>(cx) << 32) ^ static_cast<uint32_t>(cy);
+}
+
+inline int64_t squared_distance(const cv::Point& a,
+                                const cv::Point& b) noexcept {
+  const int64_t dx = static_cast<int64_t>(a.x) - b.x;
+  const int64_t dy = static_cast<int64_t>(a.y) - b.y;
+  return dx * dx + dy * dy;
+}
+
+HoleInfo build_merged_hole(const std::vector<HoleInfo>& holes,
+                           const std::vector<size_t>& close_indices,
+                           const config::HoleDetectionConfig& config) {
+  double total_area = 0;
+  double total_cx = 0, total_cy = 0;
+  // 计算边界框
+  int min_x = INT_MAX, min_y = INT_MAX;
+  int max_x = INT_MIN, max_y = INT_MIN;
+
+  for (size_t idx : close_indices) {
+    total_area += holes[idx].area;
+    total_cx += holes[idx].center.x * holes[idx].area;
+    total_cy += holes[idx].center.y * holes[idx].area;
+
+    // 更新边界框
+    min_x = std::min(min_x, holes[idx].center.x - holes[idx].width / 2);
+    min_y = std::min(min_y, holes[idx].center.y - holes[idx].height / 2);
+    max_x = std::max(max_x, holes[idx].center.x + holes[idx].width / 2);
+    max_y = std::max(max_y, holes[idx].center.y + holes[idx].height / 2);
+  }
+  int avg_cx = static_cast<int>(std::round(total_cx / total_area));
+  int avg_cy = static_cast<int>(std::round(total_cy / total_area));
+  double equiv_diam = 2.0 * std::sqrt(total_area / CV_PI);
+
+  // 计算合并后的宽度和高度
+  int merged_width = max_x - min_x;
+  int merged_height = max_y - min_y;
+
+  HoleInfo merged_hole;
+  merged_hole.center = cv::Point(avg_cx, avg_cy);
+  merged_hole.pixel_diameter = equiv_diam;
+  merged_hole.area = static_cast<int>(total_area);
+  merged_hole.width = merged_width;    // 设置合并后的宽度
+  merged_hole.height = merged_height;  // 设置合并后的高度
+  merged_hole.merged = true;
+  merged_hole.merged_count = static_cast<int>(close_indices.size());
+  merged_hole.top_y = min_y;     // 设置上边界Y坐标
+  merged_hole.bottom_y = max_y;  // 设置下边界Y坐标
+
+  // 计算实际尺寸
+  if (config.enable_real_world_calculation) {
+    merged_hole.real_width = merged_width * config.pixel_to_mm_width;  // NOLINT
+    merged_hole.real_height =
+        merged_height * config.pixel_to_mm_height;  // NOLINT
+    merged_hole.real_area =
+        total_area * config.pixel_to_mm_width * config.pixel_to_mm_height;
+    for (size_t idx : close_indices) {
+      if (holes[idx].real_diameter > 0) {
+        merged_hole.real_diameter =
+            holes[idx].real_diameter * (total_area / holes[idx].area);
+        break;
+      }
+    }
+  }
+  return merged_hole;
+}
+
+}  // namespace
+
+std::vector<HoleInfo> merge_close_holes(
+    const std::vector<HoleInfo>& holes, int distance_threshold,
+    const config::HoleDetectionConfig& config) {
+  if (holes.size() <= 1) {
+    return holes;
+  }
+
+  // 单元边长取合并阈值，阈值范围内的邻居只可能落在周围 3x3 个单元里
+  const int cell = std::max(1, distance_threshold);
+  const int64_t limit =
+      static_cast<int64_t>(distance_threshold) * distance_threshold;
+  std::unordered_map<int64_t, std::vector<size_t>> grid;
+  grid.reserve(holes.size());
+  for (size_t i = 0; i < holes.size(); ++i) {
+    grid[cell_key(floor_div(holes[i].center.x, cell),
+                  floor_div(holes[i].center.y, cell))]
+        .push_back(i);
+  }
+
+  std::vector<bool> merged(holes.size(), false);
+  std::vector<HoleInfo> merged_holes;
+  std::vector<size_t> close_indices;
+
+  for (size_t i = 0; i < holes.size(); ++i) {
+    if (merged[i]) {
+      continue;
+    }
+
+    close_indices.clear();
+    if (distance_threshold >= 0) {
+      const int gx = floor_div(holes[i].center.x, cell);
+      const int gy = floor_div(holes[i].center.y, cell);
+      for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+          auto it = grid.find(cell_key(gx + dx, gy + dy));
+          if (it == grid.end()) {
+            continue;
+          }
+          for (size_t j : it->second) {
+            if (!merged[j] &&
+                squared_distance(holes[i].center, holes[j].center) <= limit) {
+              close_indices.push_back(j);
+            }
+          }
+        }
+      }
+      // 保持与逐对扫描相同的下标顺序，面积累加和 real_diameter 取值才一致
+      std::sort(close_indices.begin(), close_indices.end());
+      for (size_t j : close_indices) {
+        merged[j] = true;
+      }
+    }
+
+    if (close_indices.size() == 1) {
+      merged_holes.push_back(holes[close_indices[0]]);
+    } else {
+      merged_holes.push_back(build_merged_hole(holes, close_indices, config));
+    }
+  }
+
+  for (size_t i = 0; i < merged_holes.size(); ++i) {
+    merged_holes[i].index = static_cast<int>(i + 1);
+  }
+  return merged_holes;
+}
+
+}  // namespace algo
@@ -0,0 +1,147 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: LatencyHistogram.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/LatencyHistogram.hpp"
+//
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <new>
+
+namespace algo {
+
+namespace {
+
+// 线程序号在首次记录时分配，所有直方图共用
+unsigned thread_slot() noexcept {
+  static std::atomic<unsigned> next_slot{0};
+  thread_local const unsigned slot =
+      next_slot.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+
+}  // namespace
+
+LatencyHistogram::~LatencyHistogram() {
+  for (auto& shard : shards_) {
+    delete shard.load(std::memory_order_acquire);
+  }
+}
+
+int LatencyHistogram::bucket_index(uint64_t value_ns) noexcept {
+  if (value_ns < static_cast<uint64_t>(kSubBuckets)) {
+    return static_cast<int>(value_ns);
+  }
+  int exponent = std::bit_width(value_ns) - 1;
+  if (exponent > kMaxExponent) {
+    return kBuckets - 1;
+  }
+  int sub = static_cast<int>(value_ns >> (exponent - kSubBucketBits)) -
+            kSubBuckets;
+  return kSubBuckets + (exponent - kSubBucketBits) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucket_value(int index) noexcept {
+  if (index < kSubBuckets) {
+    return static_cast<uint64_t>(index);
+  }
+  int exponent = (index - kSubBuckets) / kSubBuckets + kSubBucketBits;
+  int sub = (index - kSubBuckets) % kSubBuckets;
+  int shift = exponent - kSubBucketBits;
+  uint64_t lower = static_cast<uint64_t>(kSubBuckets + sub) << shift;
+  return lower + ((uint64_t{1} << shift) >> 1);
+}
+
+LatencyHistogram::Shard* LatencyHistogram::local_shard() noexcept {
+  auto& slot = shards_[thread_slot() % kMaxShards];
+  Shard* shard = slot.load(std::memory_order_acquire);
+  if (shard) {
+    return shard;
+  }
+  Shard* fresh = new (std::nothrow) Shard();
+  if (!fresh) {
+    return nullptr;
+  }
+  if (slot.compare_exchange_strong(shard, fresh, std::memory_order_acq_rel)) {
+    return fresh;
+  }
+  // 同一分片被其他线程抢先分配
+  delete fresh;
+  return shard;
+}
+
+void LatencyHistogram::record(uint64_t value_ns) noexcept {
+  Shard* shard = local_shard();
+  if (!shard) {
+    return;
+  }
+  shard->counts[bucket_index(value_ns)].fetch_add(1, std::memory_order_relaxed);
+  uint64_t current = shard->max.load(std::memory_order_relaxed);
+  while (value_ns > current &&
+         !shard->max.compare_exchange_weak(current, value_ns,
+                                           std::memory_order_relaxed)) {
+  }
+}
+
+LatencySnapshot LatencyHistogram::snapshot() const {
+  std::array<uint64_t, kBuckets> counts{};
+  LatencySnapshot result;
+  for (const auto& slot : shards_) {
+    const Shard* shard = slot.load(std::memory_order_acquire);
+    if (!shard) {
+      continue;
+    }
+    for (int i = 0; i < kBuckets; ++i) {
+      counts[i] += shard->counts[i].load(std::memory_order_relaxed);
+    }
+    result.max_ns =
+        std::max(result.max_ns, shard->max.load(std::memory_order_relaxed));
+  }
+  for (uint64_t c : counts) {
+    result.count += c;
+  }
+  if (result.count == 0) {
+    return result;
+  }
+
+  auto percentile = [&](double q) {
+    auto target = static_cast<uint64_t>(std::ceil(q * result.count));
+    target = std::clamp<uint64_t>(target, 1, result.count);
+    uint64_t seen = 0;
+    for (int i = 0; i < kBuckets; ++i) {
+      seen += counts[i];
+      if (seen >= target) {
+        return std::min(bucket_value(i), result.max_ns);
+      }
+    }
+    return result.max_ns;
+  };
+  result.p50_ns = percentile(0.50);
+  result.p99_ns = percentile(0.99);
+  return result;
+}
+
+}  // namespace algo
@@ -0,0 +1,168 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: PartitionThreshold.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/PartitionThreshold.hpp"
+//
+#include <algorithm>
+#include <cstring>
+
+// for opencv
+#include <opencv2/core/hal/intrin.hpp>
+#include <opencv2/core/utility.hpp>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <immintrin.h>
+#define CFP_PARTITION_THRESHOLD_AVX2 1
+#endif
+
+namespace algo {
+
+namespace {
+
+using SpanKernel = void (*)(const uchar*, uchar*, int, int);
+
+struct KernelEntry {
+  SpanKernel fn;
+  const char* name;
+};
+
+void threshold_span_scalar(const uchar* src, uchar* dst, int n, int thresh) {
+  for (int x = 0; x < n; ++x) {
+    dst[x] = src[x] > thresh ? 255 : 0;
+  }
+}
+
+void threshold_span_simd(const uchar* src, uchar* dst, int n, int thresh) {
+  int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+  const int lanes = cv::VTraits<cv::v_uint8>::vlanes();
+  const cv::v_uint8 vthresh = cv::vx_setall_u8(static_cast<uchar>(thresh));
+  for (; x <= n - lanes; x += lanes) {
+    cv::v_store(dst + x, cv::v_gt(cv::vx_load(src + x), vthresh));
+  }
+#endif
+  threshold_span_scalar(src + x, dst + x, n - x, thresh);
+}
+
+#if CFP_PARTITION_THRESHOLD_AVX2
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+void threshold_span_avx2(const uchar* src, uchar* dst, int n, int thresh) {
+  // 无符号比较 x > t 等价于 max(x, t + 1) == x，结果掩码正好是 0/255
+  const __m256i vthresh = _mm256_set1_epi8(static_cast<char>(thresh + 1));
+  int x = 0;
+  for (; x <= n - 32; x += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + x));
+    __m256i mask = _mm256_cmpeq_epi8(_mm256_max_epu8(v, vthresh), v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + x), mask);
+  }
+  threshold_span_simd(src + x, dst + x, n - x, thresh);
+}
+#endif
+
+KernelEntry select_kernel() {
+#if CFP_PARTITION_THRESHOLD_AVX2
+  if (cv::checkHardwareSupport(CV_CPU_AVX2)) {
+    return {threshold_span_avx2, "avx2"};
+  }
+#endif
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+  return {threshold_span_simd, "simd"};
+#else
+  return {threshold_span_scalar, "scalar"};
+#endif
+}
+
+const KernelEntry& kernel() {
+  static const KernelEntry entry = select_kernel();
+  return entry;
+}
+
+// 按 cv::threshold(THRESH_BINARY) 对越界阈值的处理：全白或全黑
+void threshold_span(const uchar* src, uchar* dst, int n, int thresh) {
+  if (n <= 0) {
+    return;
+  }
+  if (thresh < 0) {
+    std::memset(dst, 255, n);
+  } else if (thresh >= 255) {
+    std::memset(dst, 0, n);
+  } else {
+    kernel().fn(src, dst, n, thresh);
+  }
+}
+
+}  // namespace
+
+PartitionBands make_partition_bands(int width, const PartitionConfig& params) {
+  PartitionBands bands;
+  int left_end = static_cast<int>(width * params.left_ratio);
+  int mid_end =
+      static_cast<int>(width * (params.left_ratio + params.mid_ratio));
+  // 右区覆盖 mid_end 之后，中区覆盖 [left_end, mid_end)，其余归左区
+  bands.mid_end = std::clamp(mid_end, 0, width);
+  bands.left_end = std::clamp(std::min(left_end, mid_end), 0, width);
+  bands.left_thresh = params.left_thresh;
+  bands.mid_thresh = params.mid_thresh;
+  bands.right_thresh = params.right_thresh;
+  return bands;
+}
+
+void threshold_partitioned_row(const uchar* src, uchar* dst, int x_begin,
+                               int x_end, const PartitionBands& bands) {
+  const int cuts[4] = {x_begin, std::clamp(bands.left_end, x_begin, x_end),
+                       std::clamp(bands.mid_end, x_begin, x_end), x_end};
+  const int thresh[3] = {bands.left_thresh, bands.mid_thresh,
+                         bands.right_thresh};
+  for (int k = 0; k < 3; ++k) {
+    threshold_span(src + cuts[k], dst + (cuts[k] - x_begin),
+                   cuts[k + 1] - cuts[k], thresh[k]);
+  }
+}
+
+cv::Mat threshold_partitioned(const cv::Mat& image,
+                              const PartitionBands& bands) {
+  CV_Assert(image.type() == CV_8UC1);
+  cv::Mat binary(image.size(), CV_8UC1);
+  const int cols = image.cols;
+  // 每个线程分几块连续行，避免逐行调度
+  const double stripes = std::max(1, cv::getNumThreads()) * 4.0;
+  cv::parallel_for_(
+      cv::Range(0, image.rows),
+      [&](const cv::Range& range) {
+        for (int r = range.start; r < range.end; ++r) {
+          threshold_partitioned_row(image.ptr<uchar>(r), binary.ptr<uchar>(r),
+                                    0, cols, bands);
+        }
+      },
+      stripes);
+  return binary;
+}
+
+const char* partition_threshold_kernel_name() { return kernel().name; }
+
+}  // namespace algo
@@ -0,0 +1,175 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: StreamingHoleLabeler.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "algo/StreamingHoleLabeler.hpp"
+//
+#include <algorithm>
+#include <numeric>
+
+namespace algo {
+
+void StreamingHoleLabeler::reset(int width, const PartitionBands& bands) {
+  width_ = width;
+  row_ = 0;
+  bands_ = bands;
+  binary_row_.assign(width, 0);
+  prev_runs_.clear();
+  cur_runs_.clear();
+  parent_.clear();
+  comps_.clear();
+}
+
+int StreamingHoleLabeler::find(int label) noexcept {
+  while (parent_[label] != label) {
+    parent_[label] = parent_[parent_[label]];
+    label = parent_[label];
+  }
+  return label;
+}
+
+int StreamingHoleLabeler::unite(int a, int b) noexcept {
+  a = find(a);
+  b = find(b);
+  if (a == b) {
+    return a;
+  }
+  if (a > b) {
+    std::swap(a, b);
+  }
+  StreamingComponent& dst = comps_[a];
+  const StreamingComponent& src = comps_[b];
+  dst.area += src.area;
+  dst.sum_x += src.sum_x;
+  dst.sum_y += src.sum_y;
+  dst.left = std::min(dst.left, src.left);
+  dst.right = std::max(dst.right, src.right);
+  dst.top = std::min(dst.top, src.top);
+  dst.bottom = std::max(dst.bottom, src.bottom);
+  parent_[b] = a;
+  return a;
+}
+
+int StreamingHoleLabeler::new_component() {
+  int label = static_cast<int>(parent_.size());
+  parent_.push_back(label);
+  StreamingComponent comp;
+  comp.top = row_;
+  comp.bottom = row_;
+  comps_.push_back(comp);
+  return label;
+}
+
+void StreamingHoleLabeler::push_rows(const cv::Mat& rows,
+                                     const ClosedCallback& on_closed) {
+  CV_Assert(rows.type() == CV_8UC1 && rows.cols == width_);
+  for (int r = 0; r < rows.rows; ++r) {
+    push_row(rows.ptr<uchar>(r), on_closed);
+  }
+}
+
+void StreamingHoleLabeler::push_row(const uchar* src,
+                                    const ClosedCallback& on_closed) {
+  threshold_partitioned_row(src, binary_row_.data(), 0, width_, bands_);
+
+  cur_runs_.clear();
+  for (int x = 0; x < width_;) {
+    if (binary_row_[x] == 0) {
+      ++x;
+      continue;
+    }
+    int begin = x;
+    while (x < width_ && binary_row_[x] != 0) {
+      ++x;
+    }
+    cur_runs_.push_back({begin, x - 1, -1});
+  }
+
+  // 与上一行的行程做 8 邻接匹配，行程按列有序，双指针即可
+  size_t p = 0;
+  for (Run& run : cur_runs_) {
+    while (p < prev_runs_.size() && prev_runs_[p].end + 1 < run.begin) {
+      ++p;
+    }
+    for (size_t q = p;
+         q < prev_runs_.size() && prev_runs_[q].begin <= run.end + 1; ++q) {
+      run.label = run.label < 0 ? find(prev_runs_[q].label)
+                                : unite(run.label, prev_runs_[q].label);
+    }
+    if (run.label < 0) {
+      run.label = new_component();
+    }
+
+    StreamingComponent& comp = comps_[find(run.label)];
+    const int64_t len = run.end - run.begin + 1;
+    comp.area += len;
+    comp.sum_x += (static_cast<int64_t>(run.begin) + run.end) * len / 2;
+    comp.sum_y += row_ * len;
+    comp.left = std::min(comp.left, run.begin);
+    comp.right = std::max(comp.right, run.end);
+    comp.bottom = row_;
+  }
+
+  // 压缩编号：当前行仍有行程的连通域保留，上一行出现过但本行消失的即闭合
+  remap_.assign(parent_.size(), -1);
+  next_comps_.clear();
+  for (Run& run : cur_runs_) {
+    int root = find(run.label);
+    if (remap_[root] < 0) {
+      remap_[root] = static_cast<int>(next_comps_.size());
+      next_comps_.push_back(comps_[root]);
+    }
+    run.label = remap_[root];
+  }
+  for (const Run& run : prev_runs_) {
+    int root = find(run.label);
+    if (remap_[root] == -1) {
+      remap_[root] = -2;
+      if (on_closed) {
+        on_closed(comps_[root]);
+      }
+    }
+  }
+
+  comps_.swap(next_comps_);
+  parent_.resize(comps_.size());
+  std::iota(parent_.begin(), parent_.end(), 0);
+  prev_runs_.swap(cur_runs_);
+  ++row_;
+}
+
+void StreamingHoleLabeler::finish(const ClosedCallback& on_closed) {
+  // 行程标签在每行结束时已压缩成连通域下标
+  for (const StreamingComponent& comp : comps_) {
+    if (on_closed) {
+      on_closed(comp);
+    }
+  }
+  prev_runs_.clear();
+  parent_.clear();
+  comps_.clear();
+}
+
+}  // namespace algo
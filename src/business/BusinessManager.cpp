@@ -28,24 +28,47 @@
 #include "business/BusinessManager.hpp"
 
 #include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
 #include <memory>
+#include <span>
 #include <string>
+#include <system_error>
 #include <utility>
 #include <vector>
 
+#include "asio/co_spawn.hpp"
+#include "asio/detached.hpp"
+#include "asio/read.hpp"
+#include "asio/redirect_error.hpp"
+#include "asio/steady_timer.hpp"
+#include "asio/use_awaitable.hpp"
 #include "protocol/AsioTcpTransport.hpp"
 #include "protocol/LegacyCodec.hpp"
+#include "protocol/ReconnectingTransport.hpp"
 
 namespace business {
 
+namespace {
+// accept 出错（如文件描述符耗尽）后等待一会再重试，避免空转占满 CPU
+constexpr auto kAcceptRetryDelay = std::chrono::milliseconds(100);
+}  // namespace
+
 BusinessManager::BusinessManager(asio::io_context& io_ctx,
                                  const std::string& local_ip,
                                  const std::string& main_server_ip,
-                                 const std::string& backup_server_ip)
+                                 const std::string& backup_server_ip,
+                                 const protocol::ReconnectConfig& reconnect,
+                                 const std::string& spill_dir,
+                                 const protocol::FanoutConfig& fanout)
     : io_ctx_(io_ctx),
       main_server_ip_(main_server_ip),
-      backup_server_ip_(backup_server_ip) {
+      backup_server_ip_(backup_server_ip),
+      reconnect_(reconnect),
+      spill_dir_(spill_dir),
+      fanout_(fanout) {
   size_t last_dot = local_ip.find_last_of('.');
   machine_id_ = (last_dot != std::string::npos) ? local_ip.substr(last_dot + 1)
                                                 : "unknown";
@@ -54,6 +77,20 @@ BusinessManager::BusinessManager(asio::io_context& io_ctx,
   redis_ = std::make_unique<redis::RedisClient>(io_ctx_);
 }
 
+std::unique_ptr<protocol::ITransportAdapter> BusinessManager::make_transport(
+    const std::string& name) {
+  // 服务器断开时自动重连，期间的上报暂存后按顺序补发
+  auto config = reconnect_;
+  if (!spill_dir_.empty()) {
+    std::error_code ec;
+    std::filesystem::create_directories(spill_dir_, ec);
+    config.spill_path =
+        (std::filesystem::path(spill_dir_) / (name + ".spill")).string();
+  }
+  return std::make_unique<protocol::ReconnectingTransport>(
+      io_ctx_, std::make_unique<protocol::AsioTcpTransport>(io_ctx_), config);
+}
+
 void BusinessManager::start() {
   redis_->connect(redis_host_);
   if (is_master_) {
@@ -68,76 +105,18 @@ void BusinessManager::start_master() {
   start_listening_7000();
   start_listening_19800();
 
-  // 2. 创建主服务器 19300 上报会话
-  auto report_codec = std::make_unique<protocol::LegacyCodec>();
-  auto report_transport = std::make_unique<protocol::AsioTcpTransport>(io_ctx_);
-  report_session_ = std::make_shared<protocol::ProtocolSession>(
-      std::move(report_codec), nullptr, std::move(report_transport));
-  report_session_->async_connect(
-      main_server_ip_, 19300, [](std::error_code ec) {
-        if (ec) {
-          std::cerr << "Main server 19300 connect failed: " << ec.message()
-                    << "\n";
-        } else {
-          std::cout << "Main server 19300 connected successfully\n";
-        }
-      });
-
-  // 3. 创建备份服务器 19300 上报会话（如果配置了备份服务器IP）
-  if (!backup_server_ip_.empty()) {
-    auto backup_report_codec = std::make_unique<protocol::LegacyCodec>();
-    auto backup_report_transport =
-        std::make_unique<protocol::AsioTcpTransport>(io_ctx_);
-    backup_report_session_ = std::make_shared<protocol::ProtocolSession>(
-        std::move(backup_report_codec), nullptr,
-        std::move(backup_report_transport));
-    backup_report_session_->async_connect(
-        backup_server_ip_, 19300, [](std::error_code ec) {
-          if (ec) {
-            std::cerr << "Backup server 19300 connect failed: " << ec.message()
-                      << "\n";
-          } else {
-            std::cout << "Backup server 19300 connected successfully\n";
-          }
-        });
-  }
-
-  // 4. 创建主服务器 19700 遥测会话
-  auto telemetry_codec = std::make_unique<protocol::LegacyCodec>();
-  auto telemetry_transport =
-      std::make_unique<protocol::AsioTcpTransport>(io_ctx_);
-  telemetry_session_ = std::make_shared<protocol::ProtocolSession>(
-      std::move(telemetry_codec), std::move(telemetry_transport), nullptr);
-  telemetry_session_->async_connect(
-      main_server_ip_, 19700, [](std::error_code ec) {
-        if (ec) {
-          std::cerr << "Main server 19700 connect failed: " << ec.message()
-                    << "\n";
-        } else {
-          std::cout << "Main server 19700 connected successfully\n";
-        }
-      });
+  // 2. 创建 19300 上报会话，主备服务器共用一次编码
+  create_report_fanout();
 
-  // 5. 创建备份服务器 19700 遥测会话（如果配置了备份服务器IP）
+  // 3. 创建 19700 遥测会话，主备服务器共用一次编码
+  telemetry_fanout_ = std::make_shared<protocol::FanoutSession>(
+      std::make_unique<protocol::LegacyCodec>(), fanout_);
+  add_destination(*telemetry_fanout_, false, 19700);
   if (!backup_server_ip_.empty()) {
-    auto backup_telemetry_codec = std::make_unique<protocol::LegacyCodec>();
-    auto backup_telemetry_transport =
-        std::make_unique<protocol::AsioTcpTransport>(io_ctx_);
-    backup_telemetry_session_ = std::make_shared<protocol::ProtocolSession>(
-        std::move(backup_telemetry_codec),
-        std::move(backup_telemetry_transport), nullptr);
-    backup_telemetry_session_->async_connect(
-        backup_server_ip_, 19700, [](std::error_code ec) {
-          if (ec) {
-            std::cerr << "Backup server 19700 connect failed: " << ec.message()
-                      << "\n";
-          } else {
-            std::cout << "Backup server 19700 connected successfully\n";
-          }
-        });
+    add_destination(*telemetry_fanout_, true, 19700);
   }
 
-  // 6. 订阅所有遥测数据
+  // 4. 订阅所有遥测数据
   redis_->psubscribe("telemetry/*", [this](const std::string& channel,
                                            const std::string& msg) {
     std::string machine_id = channel.substr(11);  // "telemetry/102" -> "102"
@@ -154,126 +133,129 @@ void BusinessManager::start_worker() {
     }
   });
 
-  // 2. 创建主服务器 19300 上报会话
-  auto report_codec = std::make_unique<protocol::LegacyCodec>();
-  auto report_transport = std::make_unique<protocol::AsioTcpTransport>(io_ctx_);
-  report_session_ = std::make_shared<protocol::ProtocolSession>(
-      std::move(report_codec), nullptr, std::move(report_transport));
-  report_session_->async_connect(
-      main_server_ip_, 19300, [](std::error_code ec) {
+  // 2. 创建 19300 上报会话，主备服务器共用一次编码
+  create_report_fanout();
+}
+
+void BusinessManager::create_report_fanout() {
+  report_fanout_ = std::make_shared<protocol::FanoutSession>(
+      std::make_unique<protocol::LegacyCodec>(), fanout_);
+  add_destination(*report_fanout_, false, 19300);
+  if (!backup_server_ip_.empty()) {
+    add_destination(*report_fanout_, true, 19300);
+  }
+}
+
+void BusinessManager::add_destination(protocol::FanoutSession& fanout,
+                                      bool backup, uint16_t port) {
+  const std::string& ip = backup ? backup_server_ip_ : main_server_ip_;
+  const std::string port_name = std::to_string(port);
+  // 名称用于发送回调里的日志
+  const std::string label =
+      (backup ? "Backup server " : "Main server ") + port_name;
+  auto index = fanout.add_destination(
+      label, make_transport(port_name + (backup ? "_backup" : "_main")));
+  asio::co_spawn(
+      io_ctx_,
+      [&fanout, index, ip, port, label]() -> asio::awaitable<void> {
+        auto ec = co_await fanout.co_connect(index, ip, port);
         if (ec) {
-          std::cerr << "Main server 19300 connect failed: " << ec.message()
-                    << "\n";
+          std::cerr << label << " connect failed: " << ec.message() << "\n";
         } else {
-          std::cout << "Main server 19300 connected successfully\n";
+          std::cout << label << " connected successfully\n";
         }
-      });
+      },
+      asio::detached);
+}
 
-  // 3. 创建备份服务器 19300 上报会话（如果配置了备份服务器IP）
-  if (!backup_server_ip_.empty()) {
-    auto backup_report_codec = std::make_unique<protocol::LegacyCodec>();
-    auto backup_report_transport =
-        std::make_unique<protocol::AsioTcpTransport>(io_ctx_);
-    backup_report_session_ = std::make_shared<protocol::ProtocolSession>(
-        std::move(backup_report_codec), nullptr,
-        std::move(backup_report_transport));
-    backup_report_session_->async_connect(
-        backup_server_ip_, 19300, [](std::error_code ec) {
-          if (ec) {
-            std::cerr << "Backup server 19300 connect failed: " << ec.message()
-                      << "\n";
-          } else {
-            std::cout << "Backup server 19300 connected successfully\n";
-          }
-        });
+std::unique_ptr<asio::ip::tcp::acceptor> BusinessManager::open_acceptor(
+    uint16_t port) {
+  auto acceptor = std::make_unique<asio::ip::tcp::acceptor>(io_ctx_);
+  asio::ip::tcp::endpoint endpoint(asio::ip::tcp::v4(), port);
+  acceptor->open(endpoint.protocol());
+  acceptor->set_option(asio::ip::tcp::acceptor::reuse_address(true));
+  acceptor->bind(endpoint);
+  acceptor->listen();
+  return acceptor;
+}
+
+asio::awaitable<void> BusinessManager::accept_loop(
+    asio::ip::tcp::acceptor& acceptor, ConnectionHandler handler) {
+  while (acceptor.is_open()) {
+    std::error_code ec;
+    auto socket = co_await acceptor.async_accept(
+        asio::redirect_error(asio::use_awaitable, ec));
+    if (ec == asio::error::operation_aborted) {
+      break;
+    }
+    if (ec) {
+      asio::steady_timer retry(io_ctx_, kAcceptRetryDelay);
+      co_await retry.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+      continue;
+    }
+    // socket 移入连接协程的帧里，不再单独分配
+    asio::co_spawn(io_ctx_, (this->*handler)(std::move(socket)),
+                   asio::detached);
   }
 }
 
 void BusinessManager::start_listening_7000() {
-  acceptor_7000_ = std::make_unique<asio::ip::tcp::acceptor>(io_ctx_);
-  asio::ip::tcp::endpoint endpoint(asio::ip::tcp::v4(), 7000);
-  acceptor_7000_->open(endpoint.protocol());
-  acceptor_7000_->set_option(asio::ip::tcp::acceptor::reuse_address(true));
-  acceptor_7000_->bind(endpoint);
-  acceptor_7000_->listen();
-
-  auto socket = std::make_shared<asio::ip::tcp::socket>(io_ctx_);
-  acceptor_7000_->async_accept(*socket,
-                               [this, socket](const std::error_code& ec) {
-                                 if (!ec) {
-                                   handle_7000_connection(socket);
-                                 }
-                                 if (acceptor_7000_->is_open()) {
-                                   start_listening_7000();
-                                 }
-                               });
+  acceptor_7000_ = open_acceptor(7000);
+  asio::co_spawn(io_ctx_,
+                 accept_loop(*acceptor_7000_,
+                             &BusinessManager::handle_7000_connection),
+                 asio::detached);
 }
 
-void BusinessManager::handle_7000_connection(
-    std::shared_ptr<asio::ip::tcp::socket> socket) {
-  auto buffer = std::make_shared<std::vector<uint8_t>>(73);
-  asio::async_read(
-      *socket, asio::buffer(*buffer),
-      [this, socket, buffer](const std::error_code& ec,
-                             std::size_t bytes_transferred) {
-        if (!ec && bytes_transferred == 73 && (*buffer)[0] == 'O') {
-          // 这里需要一个临时的 codec 来解码
-          // TODO(cmx) 后续升级成GRPC的时候需要替换这里面
-          protocol::LegacyCodec temp_codec;
-          auto config = temp_codec.decode_config(*buffer);
-          if (config) {
-            redis_->publish("control/start", config->roll_id);
-          }
-        }
-      });
+asio::awaitable<void> BusinessManager::handle_7000_connection(
+    asio::ip::tcp::socket socket) {
+  // 接收缓冲区在协程帧里
+  std::array<uint8_t, 73> buffer;
+  std::error_code ec;
+  const size_t bytes_transferred = co_await asio::async_read(
+      socket, asio::buffer(buffer),
+      asio::redirect_error(asio::use_awaitable, ec));
+  if (!ec && bytes_transferred == 73 && buffer[0] == 'O') {
+    // 这里需要一个临时的 codec 来解码
+    // TODO(cmx) 后续升级成GRPC的时候需要替换这里面
+    protocol::LegacyCodec temp_codec;
+    auto config = temp_codec.decode_config(buffer);
+    if (config) {
+      redis_->publish("control/start", config->roll_id);
+    }
+  }
 }
 
 void BusinessManager::start_listening_19800() {
-  acceptor_19800_ = std::make_unique<asio::ip::tcp::acceptor>(io_ctx_);
-  asio::ip::tcp::endpoint endpoint(asio::ip::tcp::v4(), 19800);
-  acceptor_19800_->open(endpoint.protocol());
-  acceptor_19800_->set_option(asio::ip::tcp::acceptor::reuse_address(true));
-  acceptor_19800_->bind(endpoint);
-  acceptor_19800_->listen();
-
-  auto socket = std::make_shared<asio::ip::tcp::socket>(io_ctx_);
-  acceptor_19800_->async_accept(*socket,
-                                [this, socket](const std::error_code& ec) {
-                                  if (!ec) {
-                                    handle_19800_connection(socket);
-                                  }
-                                  if (acceptor_19800_->is_open()) {
-                                    start_listening_19800();
-                                  }
-                                });
+  acceptor_19800_ = open_acceptor(19800);
+  asio::co_spawn(io_ctx_,
+                 accept_loop(*acceptor_19800_,
+                             &BusinessManager::handle_19800_connection),
+                 asio::detached);
 }
 
-void BusinessManager::handle_19800_connection(
-    std::shared_ptr<asio::ip::tcp::socket> socket) {
-  // 读取完整数据（长度可变）
-  auto buffer = std::make_shared<std::vector<uint8_t>>(1024);  // 最大长度
-
-  asio::async_read(*socket, asio::buffer(*buffer),
-                   [this, socket, buffer](const std::error_code& ec,
-                                          std::size_t bytes_transferred) {
-                     if (!ec && bytes_transferred > 0) {
-                       // 数据格式：'O' + 72卷号 + ... + 分割定位参数
-                       std::vector<uint8_t> full_data(bytes_transferred);
-                       std::memcpy(full_data.data(), buffer->data(),
-                                   bytes_transferred);
-
-                       // 使用 LegacyCodec 解码为 ServerConfig
-                       // TODO(cmx) 未来升级GRPC需要手动替换
-                       protocol::LegacyCodec temp_codec;
-                       auto config = temp_codec.decode_config(full_data);
-                       if (config) {
-                         // 应用配置到算法
-                         // TODO(cmx)
-                         // 未来要实现从这里到算法层的通知以改变配置，目前我提供了多种方案
-                         // apply_config_to_algorithms(*config);
-                       }
-                     }
-                   });
+asio::awaitable<void> BusinessManager::handle_19800_connection(
+    asio::ip::tcp::socket socket) {
+  // 读取完整数据（长度可变，最大 1024 字节，对端发完即关闭）
+  std::array<uint8_t, 1024> buffer;
+  std::error_code ec;
+  const size_t bytes_transferred = co_await asio::async_read(
+      socket, asio::buffer(buffer),
+      asio::redirect_error(asio::use_awaitable, ec));
+  if ((!ec || ec == asio::error::eof) && bytes_transferred > 0) {
+    // 数据格式：'O' + 72卷号 + ... + 分割定位参数
+    // 使用 LegacyCodec 直接在接收缓冲区上解码为 ServerConfig
+    // TODO(cmx) 未来升级GRPC需要手动替换
+    protocol::LegacyCodec temp_codec;
+    auto config = temp_codec.decode_config(
+        std::span<const uint8_t>(buffer.data(), bytes_transferred));
+    if (config) {
+      // 应用配置到算法
+      // TODO(cmx)
+      // 未来要实现从这里到算法层的通知以改变配置，目前我提供了多种方案
+      // apply_config_to_algorithms(*config);
+    }
+  }
 }
 
 void BusinessManager::update_telemetry(float width, float length, float speed,
@@ -292,7 +274,7 @@ void BusinessManager::aggregate_telemetry(const std::string& machine_id,
 }
 
 void BusinessManager::send_aggregated_telemetry() {
-  if (!telemetry_session_ || !is_master()) {
+  if (!telemetry_fanout_ || !is_master()) {
     return;
   }
 
@@ -387,24 +369,14 @@ void BusinessManager::send_aggregated_telemetry() {
   telemetry.speed = avg_speed;    // 平均速度
   telemetry.status_bits = 0;      // 状态位可按需聚合
 
-  // 发送到主服务器 19700
-  telemetry_session_->async_send_telemetry(telemetry, [](std::error_code ec) {
-    if (ec) {
-      std::cerr << "Main server 19700 telemetry send failed: " << ec.message()
-                << "\n";
-    }
-  });
-
-  // 发送到备份服务器 19700（如果存在）
-  if (backup_telemetry_session_) {
-    backup_telemetry_session_->async_send_telemetry(
-        telemetry, [](std::error_code ec) {
-          if (ec) {
-            std::cerr << "Backup server 19700 telemetry send failed: "
-                      << ec.message() << "\n";
-          }
-        });
-  }
+  // 编码一次，发送到主备服务器 19700
+  telemetry_fanout_->async_send_telemetry(
+      telemetry, [](const std::string& destination, std::error_code ec) {
+        if (ec) {
+          std::cerr << destination << " telemetry send failed: "
+                    << ec.message() << "\n";
+        }
+      });
 }
 
 void BusinessManager::set_start_callback(StartCallback callback) {
@@ -36,6 +36,7 @@
 #include "cameras/Dvp/DvpCameraBuilder.hpp"
 #include "cameras/EventHandlerRegistry.hpp"
 #include "cameras/Ikap/IkapCameraBuilder.hpp"
+#include "cameras/Replay/FileReplayCameraCapture.hpp"
 #include "config/GlobalConfig.hpp"
 #include "logging/CaponLogging.hpp"
 #include "utils/magic_enum.hpp"
@@ -212,6 +213,13 @@ std::unique_ptr<CameraCapture> create_camera_typed(
 
     return builder.build();
 
+  } else if constexpr (std::is_same_v<ConfigT, ReplayConfig>) {
+    if (brand != CameraBrand::Replay) {
+      throw std::invalid_argument("ReplayConfig used with non-Replay brand");
+    }
+    // 回放相机没有 SDK 事件，event_specs 忽略
+    return std::make_unique<FileReplayCameraCapture>(identifier, config);
+
   } else {
     static_assert(sizeof(ConfigT) == 0, "Unsupported ConfigT type");
     return nullptr;
@@ -225,6 +233,9 @@ template std::unique_ptr<CameraCapture> create_camera_typed<DvpConfig>(
 template std::unique_ptr<CameraCapture> create_camera_typed<IkapConfig>(
     const CameraBrand&, const std::string&, const IkapConfig&,
     const std::vector<std::string>& event_specs);
+template std::unique_ptr<CameraCapture> create_camera_typed<ReplayConfig>(
+    const CameraBrand&, const std::string&, const ReplayConfig&,
+    const std::vector<std::string>& event_specs);
 
 // ==============================
 // 从配置创建多相机
@@ -259,6 +270,8 @@ std::vector<std::shared_ptr<CameraCapture>> create_cameras_from_config(
         auto ptr = create_camera_typed(CameraBrand::DVP, camera_entries[i].id,
                                        cfg, camera_entries[i].event_specs);
         if (ptr) {
+          ptr->set_pipeline_config(camera_entries[i].pipeline);
+          ptr->set_execution_config(camera_entries[i].execution);
           cameras.emplace_back(std::move(ptr));
         }
 
@@ -284,11 +297,34 @@ std::vector<std::shared_ptr<CameraCapture>> create_cameras_from_config(
         auto ptr = create_camera_typed(CameraBrand::IKap, camera_entries[i].id,
                                        cfg, camera_entries[i].event_specs);
         if (ptr) {
+          ptr->set_pipeline_config(camera_entries[i].pipeline);
+          ptr->set_execution_config(camera_entries[i].execution);
           cameras.emplace_back(std::move(ptr));
         } else {
           // throw std::runtime_error("Failed to create camera [" +
           //                          camera_entries[i].id + "]");
         }
+
+      } else if (camera_entries[i].brand == CameraBrand::Replay) {
+        ReplayConfig cfg;
+        static_cast<CameraConfig&>(cfg) = camera_entries[i].config;
+
+        cfg.source_path = sec.toString("replay_source");
+        cfg.loop = sec["replay_loop"].String().empty()
+                       ? true
+                       : sec.toInt("replay_loop") != 0;
+        cfg.preload = sec["replay_preload"].String().empty()
+                          ? true
+                          : sec.toInt("replay_preload") != 0;
+
+        auto ptr =
+            create_camera_typed(CameraBrand::Replay, camera_entries[i].id, cfg,
+                                camera_entries[i].event_specs);
+        if (ptr) {
+          ptr->set_pipeline_config(camera_entries[i].pipeline);
+          ptr->set_execution_config(camera_entries[i].execution);
+          cameras.emplace_back(std::move(ptr));
+        }
       }
     } catch (const std::exception& e) {
       std::cerr << "Failed to create camera [" << camera_entries[i].id
@@ -469,7 +469,7 @@ DvpCameraBuilder& DvpCameraBuilder::triggerDelay(double us) {
 }
 
 DvpCameraBuilder& DvpCameraBuilder::onFrame(const FrameProcessor& proc) {
-  config_.frame_processors.push_back(proc);
+  config_.frame_processors.push_back(proc.clone());
   return *this;
 }
 
@@ -799,7 +799,7 @@ std::unique_ptr<DvpCameraCapture> DvpCameraBuilder::build() {
 
   // 注册帧处理器（我们只使用最后一个）
   if (!config_.frame_processors.empty()) {
-    capture->add_frame_processor(config_.frame_processors.back());
+    capture->add_frame_processor(*config_.frame_processors.back());
   }
 
   // 注册事件处理器
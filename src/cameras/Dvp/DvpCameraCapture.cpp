@@ -28,13 +28,29 @@
 
 #include <DVPCamera.h>
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <utility>
 
 #include "cameras/FrameProcessor.hpp"  //NOLINT
 #include "config/CameraConfig.hpp"
 #include "dvpParam.h"
 
-DvpCameraCapture::DvpCameraCapture(dvpHandle handle) : handle_(handle) {
+namespace {
+// 原始图像队列的上限，超过后丢弃最旧的帧
+constexpr size_t kMaxRawFrames = 200;
+}  // namespace
+
+DvpCameraCapture::DvpCameraCapture(dvpHandle handle)
+    : handle_(handle),
+      pipeline_(
+          [this](FramePipeline::Task task) {
+            workers_.submit(std::move(task));
+          },
+          [this](const std::shared_ptr<CapturedFrame>& frame) {
+            handle_frame(frame);
+          }) {
   if (handle_) {
     // 初始化配置
     config_ = std::make_shared<DvpConfig>();
@@ -60,7 +76,9 @@ bool DvpCameraCapture::start(const FrameProcessor& processor) {
     return false;
   }
 
-  user_processor_ = processor;
+  user_processor_.store(processor.clone());
+  prewarm_frame_pool();
+  pipeline_.start();
   running_ = true;
 
   dvpStatus status = dvpStart(handle_);
@@ -83,6 +101,8 @@ bool DvpCameraCapture::start() {
     return false;
   }
 
+  prewarm_frame_pool();
+  pipeline_.start();
   running_ = true;
 
   dvpStatus status = dvpStart(handle_);
@@ -99,6 +119,7 @@ void DvpCameraCapture::stop() {
     running_ = false;
     dvpStop(handle_);
   }
+  pipeline_.stop();
   protocol::FrontendStatus status = get_status();
   status.capture = false;
   update_status(status);
@@ -122,7 +143,16 @@ void DvpCameraCapture::register_event_handler(DvpEventType event,
   event_manager_->register_handler(event, handler);
 }
 void DvpCameraCapture::add_frame_processor(const FrameProcessor& processor) {
-  user_processor_ = processor;
+  user_processor_.store(processor.clone());
+}
+void DvpCameraCapture::set_pipeline_config(const FramePipelineConfig& config) {
+  pipeline_.set_config(config);
+}
+void DvpCameraCapture::set_execution_config(const ExecutionConfig& config) {
+  workers_.configure(config);
+}
+FramePipelineStats DvpCameraCapture::get_pipeline_stats() const {
+  return pipeline_.stats();
 }
 DvpEventManager* DvpCameraCapture::get_event_manager() const {
   return event_manager_.get();
@@ -132,12 +162,7 @@ int DvpCameraCapture::OnFrameCallback([[maybe_unused]] dvpHandle handle,
                                       dvpStreamEvent event, void* context,
                                       dvpFrame* frame, void* buffer) {
   auto* capture = static_cast<DvpCameraCapture*>(context);
-  // TODO(cmx) 检查文件读写状态(示例：如果队列超过200帧了，则标记 file_io 错误)
-  [[unlikely]] if (capture->frame_queue_.size_approx() > 200) {
-    protocol::FrontendStatus status = capture->get_status();
-    status.file_io = false;
-    capture->update_status(status);
-  } else if (capture && capture->running_) {
+  if (capture && capture->running_) {
     capture->process_frame(*frame, buffer);
   }
   return 0;
@@ -145,33 +170,61 @@ int DvpCameraCapture::OnFrameCallback([[maybe_unused]] dvpHandle handle,
 
 void DvpCameraCapture::process_frame(const dvpFrame& frame,
                                      const void* buffer) {
-  CapturedFrame captured_frame;
-  captured_frame.meta.iWidth = frame.iWidth;
-  captured_frame.meta.iHeight = frame.iHeight;
-  captured_frame.meta.format = frame.format;
-  captured_frame.meta.fExposure = frame.fExposure;
-  captured_frame.meta.uTimestamp = frame.uTimestamp;
-  captured_frame.meta.fGain = frame.fAGain;
-  captured_frame.meta.iPixelFormat =
+  // 稳态下从池中取到的帧已经是正确尺寸，这里只有一次拷贝
+  auto captured = frame_pool_.acquire(frame.uBytes);
+  captured->meta.iWidth = frame.iWidth;
+  captured->meta.iHeight = frame.iHeight;
+  captured->meta.format = frame.format;
+  captured->meta.fExposure = frame.fExposure;
+  captured->meta.uTimestamp = frame.uTimestamp;
+  captured->meta.fGain = frame.fAGain;
+  captured->meta.iPixelFormat =
       frame.format;  // 临时映射，实际应从frame中获取具体的像素格式
-  captured_frame.meta.cameraId =
-      "DVP_Camera";  // 从实际的相机句柄中获取ID会更好
-  captured_frame.meta.bitDepth = frame.format & 0xFF;  // 从格式中提取位深信息
-  captured_frame.meta.frameRate = 0.0;  // 从相机配置中获取实际帧率
-  captured_frame.data.assign(
-      static_cast<const uint8_t*>(buffer),
-      static_cast<const uint8_t*>(buffer) + frame.uBytes);
-
-  // 在线程池中处理帧
-  thread_pool_.detach_task([this, captured_frame]() {
-    user_processor_.process(captured_frame);
+  captured->meta.cameraId = "DVP_Camera";  // 从实际的相机句柄中获取ID会更好
+  captured->meta.bitDepth = frame.format & 0xFF;  // 从格式中提取位深信息
+  captured->meta.frameRate = 0.0;  // 从相机配置中获取实际帧率
+  std::memcpy(captured->data.data(), buffer, frame.uBytes);
+
+  // 原始图像队列只在打开预览时填充，消费跟不上时丢弃最旧的帧
+  if (frame_queue_enabled_.load(std::memory_order_relaxed)) {
+    frame_queue_.enqueue(captured);
+    [[unlikely]] if (frame_queue_.size_approx() > kMaxRawFrames) {
+      std::shared_ptr<CapturedFrame> oldest;
+      frame_queue_.try_dequeue(oldest);
+    }
+  }
+
+  // 交给有界流水线，算法跟不上时按溢出策略丢帧或反压
+  pipeline_.push(std::move(captured));
+}
+
+void DvpCameraCapture::handle_frame(
+    const std::shared_ptr<CapturedFrame>& frame) {
+  if (auto processor = user_processor_.load()) {
+    processor->process_shared(frame);
+  }
 #ifdef SAVE_RESULT_IMAGE_QUEUE
-    result_queue_.enqueue(captured_frame);
+  result_queue_.enqueue(frame);
 #endif
-  });
-  // 提交算法处理之后把原始图像放到队列里面
-  auto captured = std::make_shared<CapturedFrame>(captured_frame);
-  frame_queue_.enqueue(captured);
+}
+
+void DvpCameraCapture::prewarm_frame_pool() {
+  size_t frame_bytes = 0;
+  size_t count = 0;
+  {
+    std::shared_lock<std::shared_mutex> lock(config_mutex_);
+    if (config_->roi_w <= 0 || config_->roi_h <= 0) {
+      return;
+    }
+    // 单色 1 字节/像素，彩色按 BGR24 估算
+    const size_t bytes_per_pixel = config_->mono_state ? 1 : 3;
+    frame_bytes = static_cast<size_t>(config_->roi_w) *
+                  static_cast<size_t>(config_->roi_h) * bytes_per_pixel;
+    count = static_cast<size_t>(std::max(config_->buffer_queue_size, 1));
+  }
+  // 在处理线程上首次写入，缓冲区落在处理线程所在的 NUMA 节点
+  workers_.pool()->run_local(
+      [&]() { frame_pool_.reserve(frame_bytes, count); });
 }
 
 void DvpCameraCapture::update_camera_params() {
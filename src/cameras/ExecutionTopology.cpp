@@ -0,0 +1,205 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ExecutionTopology.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/ExecutionTopology.hpp"
+//
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "logging/CaponLogging.hpp"
+
+std::vector<int> parse_cpu_list(const std::string& text) {
+  std::vector<int> cpus;
+  std::istringstream iss(text);
+  std::string item;
+  while (std::getline(iss, item, ',')) {
+    item.erase(std::remove(item.begin(), item.end(), ' '), item.end());
+    if (item.empty()) {
+      continue;
+    }
+    try {
+      size_t dash = item.find('-');
+      int first = std::stoi(item.substr(0, dash));
+      int last = dash == std::string::npos ? first
+                                           : std::stoi(item.substr(dash + 1));
+      if (first < 0 || last < first) {
+        throw std::invalid_argument(item);
+      }
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpus.push_back(cpu);
+      }
+    } catch (const std::exception&) {
+      throw std::invalid_argument("invalid cpu list: " + text);
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+std::vector<int> numa_node_cpus(int node) {
+  if (node < 0) {
+    return {};
+  }
+#ifdef _WIN32
+  GROUP_AFFINITY affinity{};
+  if (!GetNumaNodeProcessorMaskEx(static_cast<USHORT>(node), &affinity)) {
+    return {};
+  }
+  std::vector<int> cpus;
+  for (int bit = 0; bit < 64; ++bit) {
+    if (affinity.Mask & (KAFFINITY{1} << bit)) {
+      cpus.push_back(affinity.Group * 64 + bit);
+    }
+  }
+  return cpus;
+#elif defined(__linux__)
+  std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) +
+                     "/cpulist");
+  std::string list;
+  if (!file || !std::getline(file, list)) {
+    return {};
+  }
+  try {
+    return parse_cpu_list(list);
+  } catch (const std::exception&) {
+    return {};
+  }
+#else
+  return {};
+#endif
+}
+
+bool pin_current_thread(const std::vector<int>& cpus) {
+  if (cpus.empty()) {
+    return false;
+  }
+#ifdef _WIN32
+  // 只支持第一个处理器组（64 个逻辑 CPU 以内）
+  DWORD_PTR mask = 0;
+  for (int cpu : cpus) {
+    if (cpu < 64) {
+      mask |= DWORD_PTR{1} << cpu;
+    }
+  }
+  return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+ExecutionTopology& ExecutionTopology::instance() {
+  static ExecutionTopology topology;
+  return topology;
+}
+
+std::shared_ptr<WorkerPool> ExecutionTopology::acquire(
+    const ExecutionConfig& config) {
+  std::vector<int> cpus = parse_cpu_list(config.cpus);
+  if (cpus.empty() && config.numa_node >= 0) {
+    cpus = numa_node_cpus(config.numa_node);
+    if (cpus.empty()) {
+      LOG_WARN("NUMA node {} not found, pool {} is not pinned",
+               config.numa_node, config.pool);
+    }
+  }
+  size_t threads = config.threads;
+  if (threads == 0) {
+    threads = cpus.empty()
+                  ? std::max<size_t>(std::thread::hardware_concurrency(), 1)
+                  : cpus.size();
+  }
+
+  std::lock_guard lock(mutex_);
+  if (auto pool = pools_[config.pool].lock()) {
+    const bool explicit_config = config.threads > 0 || !cpus.empty();
+    if (explicit_config &&
+        (pool->thread_count() != threads || pool->cpus() != cpus)) {
+      LOG_WARN("Worker pool {} already exists with {} threads, ignoring the "
+               "conflicting config",
+               config.pool, pool->thread_count());
+    }
+    return pool;
+  }
+
+  auto pool = std::make_shared<WorkerPool>(config.pool, threads, cpus);
+  pools_[config.pool] = pool;
+  LOG_INFO("Worker pool {} created: {} threads, {} pinned cpus", config.pool,
+           threads, cpus.size());
+  return pool;
+}
+
+namespace {
+
+LaneOptions lane_options(const ExecutionConfig& config) {
+  LaneOptions options;
+  options.priority = config.priority;
+  options.weight = config.weight;
+  options.ordered = config.ordered;
+  return options;
+}
+
+}  // namespace
+
+void ExecutionBinding::configure(const ExecutionConfig& config) {
+  auto pool = ExecutionTopology::instance().acquire(config);
+  lane_.store(pool->create_lane(config.lane, lane_options(config)));
+}
+
+std::shared_ptr<WorkerPool::Lane> ExecutionBinding::lane() {
+  auto lane = lane_.load();
+  if (lane) {
+    return lane;
+  }
+  const ExecutionConfig config;
+  auto fallback = ExecutionTopology::instance().acquire(config)->create_lane(
+      config.lane, lane_options(config));
+  // 并发首次提交时以先写入的为准，多建的通道随 fallback 释放
+  if (lane_.compare_exchange_strong(lane, fallback)) {
+    return fallback;
+  }
+  return lane;
+}
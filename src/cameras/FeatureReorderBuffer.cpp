@@ -0,0 +1,419 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FeatureReorderBuffer.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/FeatureReorderBuffer.hpp"
+//
+#include <algorithm>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "logging/CaponLogging.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using FeatureData = ImageSignalBus::FeatureData;
+
+struct HeldResult {
+  bool filled = false;
+  uint64_t sequence = 0;
+  Clock::time_point arrived;
+  FeatureData data;
+};
+
+// 窗口按序号空间划分：流水线编号在前，同一流水线内再按相机区分
+using WindowKey = std::pair<uint64_t, std::string>;
+
+struct ReadyResult {
+  FeatureData data;
+};
+
+/**
+ * @brief 单个相机的重排窗口
+ *
+ * 暂存的结果按 sequence & mask 落在固定槽位上，窗口内的序号互不冲突。
+ * 起点确定前（anchored == false）窗口以暂存的最小序号为基准，
+ * 确定后以 next 为基准。
+ */
+struct CameraWindow {
+  explicit CameraWindow(size_t capacity)
+      : slots(capacity), mask(capacity - 1) {}
+
+  HeldResult& slot(uint64_t sequence) { return slots[sequence & mask]; }
+  uint64_t capacity() const { return slots.size(); }
+
+  std::vector<HeldResult> slots;
+  uint64_t mask;
+  bool anchored = false;
+  uint64_t next = 0;      // 起点确定后，下一个应放出的序号
+  uint64_t low = 0;       // 起点确定前，暂存结果的最小序号
+  uint64_t high = 0;      // 起点确定前，暂存结果的最大序号
+  uint64_t max_seen = 0;  // 到达过的最大序号
+  size_t held = 0;
+  // 暂存结果最早到达时间的下界，未到超时不必扫描窗口
+  Clock::time_point oldest;
+};
+
+}  // namespace
+
+struct FeatureReorderBuffer::Impl {
+  Impl(Handler result_handler, const FeatureReorderConfig& cfg)
+      : config(cfg),
+        capacity(std::bit_ceil(std::max<size_t>(cfg.window, 2))),
+        handler(std::move(result_handler)) {}
+
+  CameraWindow& window_for(const FeatureData& data) {
+    WindowKey key{data.stream_id, data.camera_id};
+    auto it = windows.find(key);
+    if (it == windows.end()) {
+      it = windows.try_emplace(std::move(key), capacity).first;
+    }
+    return it->second;
+  }
+
+  void release(CameraWindow& window, HeldResult& slot, Clock::time_point now) {
+    hold_latency.record(now - slot.arrived);
+    ready.push_back(ReadyResult{std::move(slot.data)});
+    slot.filled = false;
+    --window.held;
+    ++released;
+  }
+
+  // 不经过窗口直接放出
+  void release_now(FeatureData&& data) {
+    hold_latency.record(Clock::duration::zero());
+    ready.push_back(ReadyResult{std::move(data)});
+    ++released;
+  }
+
+  // 放出从 next 开始连续到达的结果
+  void release_contiguous(CameraWindow& window, Clock::time_point now) {
+    while (window.held > 0) {
+      auto& slot = window.slot(window.next);
+      if (!slot.filled || slot.sequence != window.next) {
+        return;
+      }
+      release(window, slot, now);
+      ++window.next;
+    }
+  }
+
+  // 把 next 推进到 target，途中到达的结果按序放出，缺口计为跳过
+  void advance_to(CameraWindow& window, uint64_t target,
+                  Clock::time_point now) {
+    while (window.next < target) {
+      auto& slot = window.slot(window.next);
+      if (slot.filled && slot.sequence == window.next) {
+        release(window, slot, now);
+      } else if (window.held == 0) {
+        skipped += target - window.next;
+        window.next = target;
+        return;
+      } else {
+        ++skipped;
+      }
+      ++window.next;
+    }
+  }
+
+  void anchor(CameraWindow& window) {
+    window.anchored = true;
+    window.next = window.low;
+  }
+
+  void insert(CameraWindow& window, FeatureData&& data, uint64_t sequence,
+              Clock::time_point now) {
+    auto& slot = window.slot(sequence);
+    slot.filled = true;
+    slot.sequence = sequence;
+    slot.arrived = now;
+    slot.data = std::move(data);
+    if (window.held++ == 0) {
+      window.oldest = now;
+    }
+  }
+
+  void accept(FeatureData&& data, Clock::time_point now) {
+    const uint64_t sequence = data.sequence;
+    if (sequence == 0) {
+      ++unsequenced;
+      release_now(std::move(data));
+      return;
+    }
+
+    auto& window = window_for(data);
+    if (sequence < window.max_seen) {
+      ++reordered;
+    }
+    window.max_seen = std::max(window.max_seen, sequence);
+
+    if (!window.anchored) {
+      if (window.held == 0) {
+        window.low = window.high = sequence;
+        insert(window, std::move(data), sequence, now);
+        return;
+      }
+      const uint64_t low = std::min(window.low, sequence);
+      const uint64_t high = std::max(window.high, sequence);
+      if (high - low < window.capacity()) {
+        auto& slot = window.slot(sequence);
+        if (slot.filled && slot.sequence == sequence) {
+          ++late;  // 重复的序号
+          return;
+        }
+        window.low = low;
+        window.high = high;
+        insert(window, std::move(data), sequence, now);
+        return;
+      }
+      // 跨度超过窗口时确定起点。新结果最早则它就是起点，直接放出，
+      // 否则以已暂存的最小序号为起点，按已确定起点的规则处理
+      if (sequence < window.low) {
+        window.anchored = true;
+        window.next = sequence + 1;
+        release_now(std::move(data));
+        if (window.high - window.next >= window.capacity()) {
+          advance_to(window, window.high - window.capacity() + 1, now);
+        }
+        release_contiguous(window, now);
+        return;
+      }
+      anchor(window);
+    }
+
+    if (sequence < window.next) {
+      // 落后一个窗口以上，视为相机重新编号（如相机对象被重新创建）
+      if (window.next - sequence >= window.capacity()) {
+        flush_window(window, now);
+        window.anchored = false;
+        window.max_seen = sequence;
+        window.low = window.high = sequence;
+        insert(window, std::move(data), sequence, now);
+        return;
+      }
+      ++late;
+      return;
+    }
+    if (sequence - window.next >= window.capacity()) {
+      advance_to(window, sequence - window.capacity() + 1, now);
+    }
+    auto& slot = window.slot(sequence);
+    if (slot.filled && slot.sequence == sequence) {
+      ++late;
+      return;
+    }
+    insert(window, std::move(data), sequence, now);
+    release_contiguous(window, now);
+  }
+
+  // 缺口等待超时则跳到下一个暂存的结果
+  void expire(CameraWindow& window, Clock::time_point now) {
+    if (window.held == 0 || now - window.oldest < config.timeout) {
+      return;
+    }
+    if (!window.anchored) {
+      anchor(window);
+      release_contiguous(window, now);
+    }
+    while (window.held > 0) {
+      uint64_t first = 0;
+      auto oldest = Clock::time_point::max();
+      for (uint64_t seq = window.next; seq < window.next + window.capacity();
+           ++seq) {
+        const auto& slot = window.slot(seq);
+        if (slot.filled && slot.sequence == seq) {
+          first = first == 0 ? seq : first;
+          oldest = std::min(oldest, slot.arrived);
+        }
+      }
+      if (now - oldest < config.timeout) {
+        window.oldest = oldest;
+        return;
+      }
+      advance_to(window, first, now);
+      release_contiguous(window, now);
+    }
+  }
+
+  void flush_window(CameraWindow& window, Clock::time_point now) {
+    if (window.held == 0) {
+      return;
+    }
+    if (!window.anchored) {
+      anchor(window);
+    }
+    while (window.held > 0) {
+      release_contiguous(window, now);
+      if (window.held > 0) {
+        ++skipped;
+        ++window.next;
+      }
+    }
+  }
+
+  void expire_all(Clock::time_point now) {
+    for (auto& [key, window] : windows) {
+      expire(window, now);
+    }
+  }
+
+  // 同一时刻只有一个线程调用回调；其他线程放出的结果追加到 ready，
+  // 由正在投递的线程接着投递，因此回调顺序与放出顺序一致
+  void deliver(std::unique_lock<std::mutex>& lock) {
+    if (delivering) {
+      return;
+    }
+    delivering = true;
+    while (!ready.empty()) {
+      ReadyResult result = std::move(ready.front());
+      ready.pop_front();
+      lock.unlock();
+      invoke(result.data);
+      lock.lock();
+    }
+    delivering = false;
+  }
+
+  void invoke(const FeatureData& data) {
+    if (!handler) {
+      return;
+    }
+    try {
+      handler(data);
+    } catch (const std::exception& e) {
+      LOG_ERROR("FeatureReorderBuffer handler failed: {}", e.what());
+    } catch (...) {
+      LOG_ERROR("FeatureReorderBuffer handler failed with unknown exception");
+    }
+  }
+
+  void watchdog_loop() {
+    const auto period = std::max<Clock::duration>(config.timeout / 2,
+                                                  std::chrono::milliseconds(1));
+    std::unique_lock lock(watchdog_mutex);
+    while (!stopping) {
+      watchdog_cv.wait_for(lock, period, [this]() { return stopping; });
+      if (stopping) {
+        return;
+      }
+      lock.unlock();
+      {
+        std::unique_lock state(mutex);
+        expire_all(Clock::now());
+        deliver(state);
+      }
+      lock.lock();
+    }
+  }
+
+  FeatureReorderConfig config;
+  size_t capacity;
+  Handler handler;
+
+  mutable std::mutex mutex;
+  std::map<WindowKey, CameraWindow> windows;
+  std::deque<ReadyResult> ready;
+  bool delivering = false;
+
+  uint64_t released = 0;
+  uint64_t reordered = 0;
+  uint64_t skipped = 0;
+  uint64_t late = 0;
+  uint64_t unsequenced = 0;
+  algo::LatencyHistogram hold_latency;
+
+  std::mutex watchdog_mutex;
+  std::condition_variable watchdog_cv;
+  bool stopping = false;
+  std::thread watchdog;
+};
+
+FeatureReorderBuffer::FeatureReorderBuffer(Handler handler,
+                                           const FeatureReorderConfig& config)
+    : impl_(std::make_unique<Impl>(std::move(handler), config)) {
+  if (impl_->config.watchdog) {
+    impl_->watchdog = std::thread([impl = impl_.get()]() {
+      impl->watchdog_loop();
+    });
+  }
+}
+
+FeatureReorderBuffer::~FeatureReorderBuffer() {
+  {
+    std::lock_guard lock(impl_->watchdog_mutex);
+    impl_->stopping = true;
+  }
+  impl_->watchdog_cv.notify_all();
+  if (impl_->watchdog.joinable()) {
+    impl_->watchdog.join();
+  }
+}
+
+void FeatureReorderBuffer::push(FeatureData data) {
+  const auto now = Clock::now();
+  std::unique_lock lock(impl_->mutex);
+  impl_->accept(std::move(data), now);
+  impl_->expire_all(now);
+  impl_->deliver(lock);
+}
+
+void FeatureReorderBuffer::poll() {
+  std::unique_lock lock(impl_->mutex);
+  impl_->expire_all(Clock::now());
+  impl_->deliver(lock);
+}
+
+void FeatureReorderBuffer::flush() {
+  const auto now = Clock::now();
+  std::unique_lock lock(impl_->mutex);
+  for (auto& [key, window] : impl_->windows) {
+    impl_->flush_window(window, now);
+  }
+  impl_->deliver(lock);
+}
+
+FeatureReorderStats FeatureReorderBuffer::stats() const {
+  FeatureReorderStats stats;
+  std::lock_guard lock(impl_->mutex);
+  stats.released = impl_->released;
+  stats.reordered = impl_->reordered;
+  stats.skipped = impl_->skipped;
+  stats.late = impl_->late;
+  stats.unsequenced = impl_->unsequenced;
+  for (const auto& [key, window] : impl_->windows) {
+    stats.pending += window.held;
+  }
+  stats.hold_latency = impl_->hold_latency.snapshot();
+  return stats;
+}
@@ -0,0 +1,227 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FramePipeline.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/FramePipeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#include "logging/CaponLogging.hpp"
+
+namespace {
+
+uint64_t next_stream_id() {
+  static std::atomic<uint64_t> counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+}  // namespace
+
+FramePipeline::FramePipeline(Executor executor, Handler handler,
+                             const FramePipelineConfig& config)
+    : executor_(std::move(executor)),
+      handler_(std::move(handler)),
+      config_(config),
+      stream_id_(next_stream_id()) {
+  config_.capacity = std::max<size_t>(config_.capacity, 1);
+  config_.sample_interval = std::max<size_t>(config_.sample_interval, 1);
+  ring_.resize(config_.capacity);
+}
+
+FramePipeline::~FramePipeline() { stop(); }
+
+bool FramePipeline::push(std::shared_ptr<CapturedFrame> frame) {
+  if (!frame) {
+    return false;
+  }
+
+  // 被挤掉的帧放到锁外释放，归还帧池时不占用流水线锁
+  std::shared_ptr<CapturedFrame> evicted;
+  bool spawn_worker = false;
+  {
+    std::unique_lock lock(mutex_);
+    if (stopped_) {
+      return false;
+    }
+
+    if (config_.policy == FrameOverflowPolicy::SampleEveryN &&
+        (sample_counter_++ % config_.sample_interval) != 0) {
+      ++stats_.dropped;
+      return false;
+    }
+
+    if (size_ >= ring_.size()) {
+      switch (config_.policy) {
+        case FrameOverflowPolicy::DropNewest:
+          ++stats_.dropped;
+          return false;
+        case FrameOverflowPolicy::Block:
+          not_full_.wait(lock,
+                         [this]() { return stopped_ || size_ < ring_.size(); });
+          if (stopped_) {
+            return false;
+          }
+          break;
+        case FrameOverflowPolicy::DropOldest:
+        case FrameOverflowPolicy::SampleEveryN:
+          evicted = pop_front_locked();
+          ++stats_.dropped;
+          break;
+      }
+    }
+
+    ring_[(head_ + size_) % ring_.size()] = std::move(frame);
+    ++size_;
+    ++stats_.enqueued;
+    stats_.high_water = std::max(stats_.high_water, size_);
+
+    if (active_workers_ < effective_max_in_flight()) {
+      ++active_workers_;
+      spawn_worker = true;
+    }
+  }
+
+  if (spawn_worker) {
+    executor_([this]() { drain(); });
+  }
+  return true;
+}
+
+void FramePipeline::drain() {
+  std::shared_ptr<CapturedFrame> frame;
+  {
+    std::lock_guard lock(mutex_);
+    if (stopped_ || size_ == 0) {
+      --active_workers_;
+      idle_.notify_all();
+      return;
+    }
+    frame = pop_front_locked();
+    frame->meta.sequence = ++sequence_;
+    frame->meta.stream_id = stream_id_;
+  }
+  not_full_.notify_one();
+
+  try {
+    handler_(frame);
+  } catch (const std::exception& e) {
+    LOG_ERROR("Frame pipeline handler threw: {}", e.what());
+  } catch (...) {
+    LOG_ERROR("Frame pipeline handler threw an unknown exception");
+  }
+
+  bool more = false;
+  {
+    std::lock_guard lock(mutex_);
+    ++stats_.processed;
+    frame.reset();
+    more = !stopped_ && size_ > 0;
+    if (!more) {
+      --active_workers_;
+      idle_.notify_all();
+    }
+  }
+  // 每个任务只处理一帧，剩下的重新提交，共享线程池按通道调度其他相机
+  if (more) {
+    executor_([this]() { drain(); });
+  }
+}
+
+std::shared_ptr<CapturedFrame> FramePipeline::pop_front_locked() {
+  auto frame = std::move(ring_[head_]);
+  head_ = (head_ + 1) % ring_.size();
+  --size_;
+  return frame;
+}
+
+size_t FramePipeline::effective_max_in_flight() const {
+  if (config_.max_in_flight > 0) {
+    return config_.max_in_flight;
+  }
+  return std::max<unsigned>(std::thread::hardware_concurrency(), 1);
+}
+
+void FramePipeline::set_config(const FramePipelineConfig& config) {
+  std::vector<std::shared_ptr<CapturedFrame>> evicted;
+  {
+    std::lock_guard lock(mutex_);
+    FramePipelineConfig new_config = config;
+    new_config.capacity = std::max<size_t>(new_config.capacity, 1);
+    new_config.sample_interval =
+        std::max<size_t>(new_config.sample_interval, 1);
+
+    if (new_config.capacity != ring_.size()) {
+      while (size_ > new_config.capacity) {
+        evicted.push_back(pop_front_locked());
+        ++stats_.dropped;
+      }
+      std::vector<std::shared_ptr<CapturedFrame>> ring(new_config.capacity);
+      for (size_t i = 0; i < size_; ++i) {
+        ring[i] = std::move(ring_[(head_ + i) % ring_.size()]);
+      }
+      ring_ = std::move(ring);
+      head_ = 0;
+    }
+    config_ = new_config;
+  }
+  not_full_.notify_all();
+}
+
+FramePipelineConfig FramePipeline::get_config() const {
+  std::lock_guard lock(mutex_);
+  return config_;
+}
+
+FramePipelineStats FramePipeline::stats() const {
+  std::lock_guard lock(mutex_);
+  FramePipelineStats stats = stats_;
+  stats.depth = size_;
+  return stats;
+}
+
+void FramePipeline::start() {
+  std::lock_guard lock(mutex_);
+  stopped_ = false;
+}
+
+void FramePipeline::stop() {
+  std::vector<std::shared_ptr<CapturedFrame>> discarded;
+  {
+    std::unique_lock lock(mutex_);
+    stopped_ = true;
+    discarded.reserve(size_);
+    while (size_ > 0) {
+      discarded.push_back(pop_front_locked());
+      ++stats_.dropped;
+    }
+    not_full_.notify_all();
+    idle_.wait(lock, [this]() { return active_workers_ == 0; });
+  }
+}
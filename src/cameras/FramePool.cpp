@@ -0,0 +1,209 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FramePool.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/FramePool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace detail {
+
+// shared_ptr 控制块的最大复用尺寸，超过的直接走全局分配
+constexpr size_t kControlBlockSize = 128;
+
+struct FramePoolState {
+  explicit FramePoolState(size_t max_cached) : max_cached_per_size(max_cached) {}
+
+  ~FramePoolState() {
+    for (void* block : free_blocks) {
+      ::operator delete(block);
+    }
+  }
+
+  void recycle(CapturedFrame* frame) {
+    // 原地重建帧对象：enable_shared_from_this 里的弱引用指向本帧的控制块，
+    // 而控制块持有池状态，不清掉的话池中的帧和池状态互相引用，永远不会释放
+    std::vector<uint8_t> data = std::move(frame->data);
+    frame->~CapturedFrame();
+    ::new (frame) CapturedFrame();
+    frame->data = std::move(data);
+    std::unique_ptr<CapturedFrame> owned(frame);
+    {
+      std::lock_guard lock(mutex);
+      auto& bucket = free_frames[owned->data.size()];
+      if (bucket.size() < max_cached_per_size) {
+        bucket.push_back(std::move(owned));
+      }
+    }
+    // 池已满时 owned 在锁外释放
+  }
+
+  void* allocate_block(size_t bytes) {
+    if (bytes <= kControlBlockSize) {
+      std::lock_guard lock(mutex);
+      if (!free_blocks.empty()) {
+        void* block = free_blocks.back();
+        free_blocks.pop_back();
+        return block;
+      }
+      return ::operator new(kControlBlockSize);
+    }
+    return ::operator new(bytes);
+  }
+
+  void deallocate_block(void* block, size_t bytes) {
+    if (bytes <= kControlBlockSize) {
+      std::lock_guard lock(mutex);
+      free_blocks.push_back(block);
+      return;
+    }
+    ::operator delete(block);
+  }
+
+  mutable std::mutex mutex;
+  size_t max_cached_per_size;
+  std::unordered_map<size_t, std::vector<std::unique_ptr<CapturedFrame>>>
+      free_frames;
+  std::vector<void*> free_blocks;
+  std::atomic<uint64_t> hits{0};
+  std::atomic<uint64_t> misses{0};
+};
+
+// 帧归还器：最后一个引用释放时把帧放回池中
+struct FrameRecycler {
+  std::shared_ptr<FramePoolState> state;
+  void operator()(CapturedFrame* frame) const { state->recycle(frame); }
+};
+
+// 控制块分配器：复用 shared_ptr 控制块，避免每帧一次小对象分配
+template <typename T>
+struct ControlBlockAllocator {
+  using value_type = T;
+
+  explicit ControlBlockAllocator(std::shared_ptr<FramePoolState> s)
+      : state(std::move(s)) {}
+  template <typename U>
+  ControlBlockAllocator(const ControlBlockAllocator<U>& other)  // NOLINT
+      : state(other.state) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(state->allocate_block(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) { state->deallocate_block(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const ControlBlockAllocator<U>& other) const {
+    return state == other.state;
+  }
+
+  std::shared_ptr<FramePoolState> state;
+};
+
+}  // namespace detail
+
+FrameBufferPool::FrameBufferPool(size_t max_cached_per_size)
+    : state_(std::make_shared<detail::FramePoolState>(max_cached_per_size)) {}
+
+void FrameBufferPool::reserve(size_t bytes, size_t count) {
+  if (bytes == 0) {
+    return;
+  }
+
+  size_t to_create = 0;
+  {
+    std::lock_guard lock(state_->mutex);
+    size_t cached = state_->free_frames[bytes].size();
+    count = std::min(count, state_->max_cached_per_size);
+    if (cached >= count) {
+      return;
+    }
+    to_create = count - cached;
+    for (size_t i = 0; i < to_create; ++i) {
+      // 顺带预热控制块，保证首批帧也不需要额外分配
+      state_->free_blocks.push_back(
+          ::operator new(detail::kControlBlockSize));
+    }
+  }
+
+  // 大块内存在锁外分配
+  std::vector<std::unique_ptr<CapturedFrame>> frames;
+  frames.reserve(to_create);
+  for (size_t i = 0; i < to_create; ++i) {
+    auto frame = std::make_unique<CapturedFrame>();
+    frame->data.resize(bytes);
+    frames.push_back(std::move(frame));
+  }
+
+  std::lock_guard lock(state_->mutex);
+  auto& bucket = state_->free_frames[bytes];
+  for (auto& frame : frames) {
+    if (bucket.size() >= state_->max_cached_per_size) {
+      break;
+    }
+    bucket.push_back(std::move(frame));
+  }
+}
+
+std::shared_ptr<CapturedFrame> FrameBufferPool::acquire(size_t bytes) {
+  std::unique_ptr<CapturedFrame> frame;
+  {
+    std::lock_guard lock(state_->mutex);
+    auto it = state_->free_frames.find(bytes);
+    if (it != state_->free_frames.end() && !it->second.empty()) {
+      frame = std::move(it->second.back());
+      it->second.pop_back();
+    }
+  }
+
+  if (frame) {
+    state_->hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    state_->misses.fetch_add(1, std::memory_order_relaxed);
+    frame = std::make_unique<CapturedFrame>();
+    frame->data.resize(bytes);
+  }
+
+  return std::shared_ptr<CapturedFrame>(
+      frame.release(), detail::FrameRecycler{state_},
+      detail::ControlBlockAllocator<CapturedFrame>(state_));
+}
+
+size_t FrameBufferPool::cached_count(size_t bytes) const {
+  std::lock_guard lock(state_->mutex);
+  auto it = state_->free_frames.find(bytes);
+  return it == state_->free_frames.end() ? 0 : it->second.size();
+}
+
+FrameBufferPool::Stats FrameBufferPool::stats() const {
+  return {state_->hits.load(std::memory_order_relaxed),
+          state_->misses.load(std::memory_order_relaxed)};
+}
@@ -0,0 +1,369 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameSynchronizer.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/FrameSynchronizer.hpp"
+//
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "logging/CaponLogging.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief 有界多生产者多消费者环形队列（每个槽位带序号，无锁）
+ *
+ * 同一相机的流水线可能在多个线程上同时处理帧，因此生产端需要支持并发。
+ */
+template <typename T>
+class MpmcRing {
+ public:
+  explicit MpmcRing(size_t capacity)
+      : cells_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+        mask_(cells_.size() - 1) {
+    for (size_t i = 0; i < cells_.size(); ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  size_t capacity() const noexcept { return cells_.size(); }
+
+  bool try_push(T&& value) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff =
+          static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // 队列已满
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool try_pop(T& out) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true) {
+      cell = &cells_[pos & mask_];
+      const size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq) -
+                        static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (head_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // 队列为空
+      } else {
+        pos = head_.load(std::memory_order_relaxed);
+      }
+    }
+    out = std::move(cell->value);
+    cell->value = T{};
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence{0};
+    T value{};
+  };
+
+  std::vector<Cell> cells_;
+  const size_t mask_;
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+struct PendingFrame {
+  std::shared_ptr<const CapturedFrame> frame;
+  uint64_t key = 0;
+  Clock::time_point arrival{};
+};
+
+struct CameraLane {
+  explicit CameraLane(size_t capacity) : ring(capacity) {}
+
+  MpmcRing<PendingFrame> ring;
+  // 以下只由持有匹配权的线程访问，按键值升序
+  std::deque<PendingFrame> pending;
+};
+
+}  // namespace
+
+struct FrameSynchronizer::Impl {
+  Impl(size_t num_cams, SetHandler set_handler, const FrameSyncConfig& cfg,
+       KeyFunc key_func)
+      : config(cfg), key(std::move(key_func)), handler(std::move(set_handler)) {
+    if (!key) {
+      key = [](const CapturedFrame& frame) { return frame.meta.uTimestamp; };
+    }
+    lanes.reserve(num_cams);
+    for (size_t i = 0; i < num_cams; ++i) {
+      lanes.push_back(std::make_unique<CameraLane>(config.ring_capacity));
+    }
+  }
+
+  // 同一时刻只有一个线程执行 match()；取不到匹配权的线程留下 retry 标记，
+  // 持有者退出前会看到标记并再匹配一轮，因此不会漏掉新入队的帧。
+  // 两个标记依赖顺序一致性，不能放宽内存序
+  void run_matcher() {
+    while (true) {
+      if (busy.exchange(true)) {
+        retry.store(true);
+        if (busy.load()) {
+          return;
+        }
+        continue;
+      }
+      retry.store(false);
+      match(Clock::now());
+      busy.store(false);
+      if (!retry.load()) {
+        return;
+      }
+    }
+  }
+
+  void drain_rings() {
+    PendingFrame incoming;
+    for (auto& lane : lanes) {
+      while (lane->ring.try_pop(incoming)) {
+        // 所属的组已经发出或丢弃，迟到的帧直接丢弃
+        if (has_last_key && incoming.key <= last_key + config.tolerance) {
+          dropped_frames.fetch_add(1, std::memory_order_relaxed);
+          continue;
+        }
+        // 多线程处理同一相机时可能乱序到达，这里按键值插入
+        auto pos = lane->pending.end();
+        while (pos != lane->pending.begin() &&
+               std::prev(pos)->key > incoming.key) {
+          --pos;
+        }
+        lane->pending.insert(pos, std::move(incoming));
+      }
+    }
+  }
+
+  void match(Clock::time_point now) {
+    drain_rings();
+    while (true) {
+      bool any = false;
+      bool overflow = false;
+      uint64_t ref = UINT64_MAX;
+      for (const auto& lane : lanes) {
+        if (!lane->pending.empty()) {
+          any = true;
+          ref = std::min(ref, lane->pending.front().key);
+        }
+        overflow |= lane->pending.size() > config.ring_capacity;
+      }
+      if (!any) {
+        return;
+      }
+
+      const uint64_t window_end = ref + config.tolerance;
+      size_t present = 0;
+      size_t waiting = 0;
+      Clock::time_point oldest = Clock::time_point::max();
+      for (const auto& lane : lanes) {
+        if (lane->pending.empty()) {
+          ++waiting;
+        } else if (lane->pending.front().key <= window_end) {
+          ++present;
+          oldest = std::min(oldest, lane->pending.front().arrival);
+        }
+      }
+
+      const bool complete = present == lanes.size();
+      // 缺失的相机都已送来更晚的帧，按顺序到达时这一组不可能再凑齐
+      const bool hopeless = config.in_order && waiting == 0;
+      // 某个相机积压超过上限时不再等待，最早的一组按超时处理
+      const bool expired = overflow || now - oldest >= config.timeout;
+      if (!complete && !hopeless && !expired) {
+        return;
+      }
+      emit(ref, window_end, complete, now, oldest);
+    }
+  }
+
+  void emit(uint64_t ref, uint64_t window_end, bool complete,
+            Clock::time_point now, Clock::time_point oldest) {
+    SyncedFrameSet set;
+    set.frames.resize(lanes.size());
+    set.key = ref;
+    set.partial = !complete;
+    uint64_t max_key = ref;
+    size_t present = 0;
+    for (size_t i = 0; i < lanes.size(); ++i) {
+      auto& pending = lanes[i]->pending;
+      if (!pending.empty() && pending.front().key <= window_end) {
+        max_key = std::max(max_key, pending.front().key);
+        set.frames[i] = std::move(pending.front().frame);
+        pending.pop_front();
+        ++present;
+      }
+    }
+    set.skew = max_key - ref;
+    last_key = ref;
+    has_last_key = true;
+
+    if (!complete && (config.timeout_policy ==
+                          SyncTimeoutPolicy::DropIncomplete ||
+                      present < config.min_cameras)) {
+      dropped_sets.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    (complete ? complete_sets : partial_sets)
+        .fetch_add(1, std::memory_order_relaxed);
+    skew.record(set.skew);
+    fusion_latency.record(now - oldest);
+    if (!handler) {
+      return;
+    }
+    try {
+      handler(set);
+    } catch (const std::exception& e) {
+      LOG_ERROR("FrameSynchronizer handler failed: {}", e.what());
+    } catch (...) {
+      LOG_ERROR("FrameSynchronizer handler failed with unknown exception");
+    }
+  }
+
+  void watchdog_loop() {
+    const auto period = std::max<Clock::duration>(config.timeout / 2,
+                                                  std::chrono::milliseconds(1));
+    std::unique_lock lock(watchdog_mutex);
+    while (!stopping) {
+      watchdog_cv.wait_for(lock, period, [this]() { return stopping; });
+      if (stopping) {
+        return;
+      }
+      lock.unlock();
+      run_matcher();
+      lock.lock();
+    }
+  }
+
+  FrameSyncConfig config;
+  KeyFunc key;
+  SetHandler handler;
+  std::vector<std::unique_ptr<CameraLane>> lanes;
+
+  std::atomic<bool> busy{false};
+  std::atomic<bool> retry{false};
+
+  // 只由持有匹配权的线程访问
+  bool has_last_key = false;
+  uint64_t last_key = 0;
+
+  std::atomic<uint64_t> complete_sets{0};
+  std::atomic<uint64_t> partial_sets{0};
+  std::atomic<uint64_t> dropped_sets{0};
+  std::atomic<uint64_t> dropped_frames{0};
+  algo::LatencyHistogram skew;
+  algo::LatencyHistogram fusion_latency;
+
+  std::mutex watchdog_mutex;
+  std::condition_variable watchdog_cv;
+  bool stopping = false;
+  std::thread watchdog;
+};
+
+FrameSynchronizer::FrameSynchronizer(size_t num_cams, SetHandler handler,
+                                     const FrameSyncConfig& config,
+                                     KeyFunc key)
+    : impl_(std::make_unique<Impl>(num_cams, std::move(handler), config,
+                                   std::move(key))) {
+  if (impl_->config.watchdog && num_cams > 0) {
+    impl_->watchdog = std::thread([impl = impl_.get()]() {
+      impl->watchdog_loop();
+    });
+  }
+}
+
+FrameSynchronizer::~FrameSynchronizer() {
+  {
+    std::lock_guard lock(impl_->watchdog_mutex);
+    impl_->stopping = true;
+  }
+  impl_->watchdog_cv.notify_all();
+  if (impl_->watchdog.joinable()) {
+    impl_->watchdog.join();
+  }
+}
+
+void FrameSynchronizer::push(size_t cam_index,
+                             std::shared_ptr<const CapturedFrame> frame) {
+  if (!frame || cam_index >= impl_->lanes.size()) {
+    return;
+  }
+  PendingFrame pending{frame, impl_->key(*frame), Clock::now()};
+  if (!impl_->lanes[cam_index]->ring.try_push(std::move(pending))) {
+    impl_->dropped_frames.fetch_add(1, std::memory_order_relaxed);
+  }
+  impl_->run_matcher();
+}
+
+void FrameSynchronizer::poll() { impl_->run_matcher(); }
+
+FrameSyncStats FrameSynchronizer::stats() const {
+  FrameSyncStats stats;
+  stats.complete_sets = impl_->complete_sets.load(std::memory_order_relaxed);
+  stats.partial_sets = impl_->partial_sets.load(std::memory_order_relaxed);
+  stats.dropped_sets = impl_->dropped_sets.load(std::memory_order_relaxed);
+  stats.dropped_frames = impl_->dropped_frames.load(std::memory_order_relaxed);
+  stats.skew = impl_->skew.snapshot();
+  stats.fusion_latency = impl_->fusion_latency.snapshot();
+  return stats;
+}
+
+size_t FrameSynchronizer::camera_count() const { return impl_->lanes.size(); }
@@ -241,7 +241,7 @@ IkapCameraBuilder& IkapCameraBuilder::linkTimeout(uint32_t timeout) {
 }
 
 IkapCameraBuilder& IkapCameraBuilder::onFrame(const FrameProcessor& proc) {
-  config_.frame_processors.push_back(proc);
+  config_.frame_processors.push_back(proc.clone());
   return *this;
 }
 
@@ -481,7 +481,7 @@ std::unique_ptr<IkapCameraCapture> IkapCameraBuilder::build() {
 
   // 注册帧处理器
   if (!config_.frame_processors.empty()) {
-    capture->start(config_.frame_processors.back());
+    capture->start(*config_.frame_processors.back());
   } else {
     capture->start();
   }
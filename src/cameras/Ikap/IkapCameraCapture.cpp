@@ -26,14 +26,32 @@
 
 #include "cameras/IKap/IkapCameraCapture.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 #include "IKapC.h"
 #include "cameras/Ikap/IkapConfig.hpp"
 #include "protocol/messages.hpp"
 
-IkapCameraCapture::IkapCameraCapture(ITKDEVICE handle) : handle_(handle) {
+namespace {
+// 原始图像队列的上限，超过后丢弃最旧的帧
+constexpr size_t kMaxRawFrames = 200;
+}  // namespace
+
+IkapCameraCapture::IkapCameraCapture(ITKDEVICE handle)
+    : handle_(handle),
+      pipeline_(
+          [this](FramePipeline::Task task) {
+            workers_.submit(std::move(task));
+          },
+          [this](const std::shared_ptr<CapturedFrame>& frame) {
+            if (auto processor = user_processor_.load()) {
+              processor->process_shared(frame);
+            }
+          }) {
   if (handle_) {
     config_ = std::make_shared<IkapConfig>();  // 初始化为IkapConfig
     event_manager_ = std::make_unique<IkapEventManager>(handle_);
@@ -69,6 +87,9 @@ bool IkapCameraCapture::start() {
     return false;
   }
 
+  prewarm_frame_pool();
+  pipeline_.start();
+
   uint32_t stream_count = 0;
   if (ItkDevGetStreamCount(handle_, &stream_count) != ITKSTATUS_OK ||
       stream_count == 0) {
@@ -121,7 +142,7 @@ bool IkapCameraCapture::start() {
 }
 
 bool IkapCameraCapture::start(const FrameProcessor& processor) {
-  user_processor_ = processor;
+  user_processor_.store(processor.clone());
 
   return start();
 }
@@ -142,6 +163,7 @@ void IkapCameraCapture::stop() {
     ItkDevFreeStream(stream_handle_);
     stream_handle_ = nullptr;
   }
+  pipeline_.stop();
 
   auto status = get_status();
   status.capture = false;
@@ -229,8 +251,8 @@ void IkapCameraCapture::process_frame(ITKBUFFER buffer) {
     return;
   }
 
-  auto captured = std::make_shared<CapturedFrame>();
-  captured->data.resize(info.ImageSize);
+  // 稳态下从池中取到的帧已经是正确尺寸，这里只有一次拷贝
+  auto captured = frame_pool_.acquire(info.ImageSize);
   std::memcpy(captured->data.data(), info.ImageAddress, info.ImageSize);
 
   captured->meta.iWidth = static_cast<int>(info.ImageWidth);
@@ -240,9 +262,36 @@ void IkapCameraCapture::process_frame(ITKBUFFER buffer) {
   captured->meta.uTimestamp = info.TimestampNs;
   captured->meta.cameraId = "IKAP_Camera";
 
-  frame_queue_.enqueue(captured);
-  thread_pool_.detach_task(
-      [this, captured]() { user_processor_.process(*captured); });
+  // 原始图像队列只在打开预览时填充，消费跟不上时丢弃最旧的帧
+  if (frame_queue_enabled_.load(std::memory_order_relaxed)) {
+    frame_queue_.enqueue(captured);
+    [[unlikely]] if (frame_queue_.size_approx() > kMaxRawFrames) {
+      std::shared_ptr<CapturedFrame> oldest;
+      frame_queue_.try_dequeue(oldest);
+    }
+  }
+
+  // 交给有界流水线，算法跟不上时按溢出策略丢帧或反压
+  pipeline_.push(std::move(captured));
+}
+
+void IkapCameraCapture::prewarm_frame_pool() {
+  size_t frame_bytes = 0;
+  size_t count = 0;
+  {
+    std::shared_lock lock(config_mutex_);
+    if (!config_ || config_->roi_w <= 0 || config_->roi_h <= 0) {
+      return;
+    }
+    // 线扫相机一般为单色输出，彩色按 BGR24 估算
+    const size_t bytes_per_pixel = config_->mono_state ? 1 : 3;
+    frame_bytes = static_cast<size_t>(config_->roi_w) *
+                  static_cast<size_t>(config_->roi_h) * bytes_per_pixel;
+    count = static_cast<size_t>(std::max(config_->buffer_queue_size, 1));
+  }
+  // 在处理线程上首次写入，缓冲区落在处理线程所在的 NUMA 节点
+  workers_.pool()->run_local(
+      [&]() { frame_pool_.reserve(frame_bytes, count); });
 }
 
 void IkapCameraCapture::register_event_handler(IkapEventType type,
@@ -251,5 +300,18 @@ void IkapCameraCapture::register_event_handler(IkapEventType type,
 }
 
 void IkapCameraCapture::add_frame_processor(const FrameProcessor& processor) {
-  user_processor_ = processor;
+  user_processor_.store(processor.clone());
+}
+
+void IkapCameraCapture::set_pipeline_config(
+    const FramePipelineConfig& config) {
+  pipeline_.set_config(config);
+}
+
+void IkapCameraCapture::set_execution_config(const ExecutionConfig& config) {
+  workers_.configure(config);
+}
+
+FramePipelineStats IkapCameraCapture::get_pipeline_stats() const {
+  return pipeline_.stats();
 }
@@ -49,53 +49,178 @@ ImageSignalBus& ImageSignalBus::instance(const std::string& ns) {
   return *it->second;
 }
 
-void ImageSignalBus::declare_signal(const std::string& signal_name) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  if (subscribers_.find(signal_name) == subscribers_.end()) {
-    subscribers_[signal_name] = std::vector<ImageCallback>();
-  }
+ImageSignalBus::ImageSignal ImageSignalBus::declare_signal(
+    const std::string& signal_name) {
+  return ImageSignal{subscribers_.resolve(signal_name)};
+}
+
+ImageSignalBus::FeatureSignal ImageSignalBus::declare_feature(
+    const std::string& name) {
+  return FeatureSignal{feature_subscribers_.resolve(name)};
+}
+
+ImageSignalBus::StatusSignal ImageSignalBus::declare_status(
+    const std::string& name) {
+  return StatusSignal{status_subscribers_.resolve(name)};
 }
 
 void ImageSignalBus::subscribe(const std::string& signal_name,
-                               ImageCallback callback) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  subscribers_[signal_name].push_back(std::move(callback));
+                               ImageCallback callback,
+                               ImageDelivery delivery) {
+  if (!callback) {
+    return;
+  }
+
+  ImageSubscriber subscriber;
+  if (delivery == ImageDelivery::PrivateCopy) {
+    subscriber.callback = [cb = std::move(callback)](const SharedImage& img) {
+      cb(img->clone());
+    };
+    subscriber.private_copy = true;
+  } else {
+    subscriber.callback = [cb = std::move(callback)](const SharedImage& img) {
+      cb(*img);
+    };
+  }
+  add_subscriber(signal_name, std::move(subscriber));
+}
+
+void ImageSignalBus::subscribe_shared(const std::string& signal_name,
+                                      SharedImageCallback callback) {
+  add_subscriber(signal_name, ImageSubscriber{std::move(callback)});
+}
+
+void ImageSignalBus::add_subscriber(const std::string& signal_name,
+                                    ImageSubscriber subscriber) {
+  // 先订阅后声明也可以，两者解析到同一个槽位
+  subscribers_.append(subscribers_.resolve(signal_name), std::move(subscriber));
+}
+
+std::shared_ptr<AsyncSubscription> ImageSignalBus::subscribe_async(
+    const std::string& signal_name, SharedImageCallback callback,
+    const AsyncDeliveryConfig& config) {
+  if (!callback) {
+    return nullptr;
+  }
+  auto queue = std::make_shared<AsyncDeliveryQueue<SharedImage>>(
+      std::move(callback), config);
+  subscribe_shared(signal_name,
+                   [queue](const SharedImage& img) { queue->push(img); });
+  return queue;
 }
 
 void ImageSignalBus::emit(const std::string& signal_name, const cv::Mat& img) {
+  if (auto index = subscribers_.find(signal_name)) {
+    emit(ImageSignal{*index}, img);
+  }
+}
+
+void ImageSignalBus::emit(const std::string& signal_name,
+                          const SharedImage& img) {
+  if (auto index = subscribers_.find(signal_name)) {
+    emit(ImageSignal{*index}, img);
+  }
+}
+
+void ImageSignalBus::emit(ImageSignal signal, const cv::Mat& img) {
   if (img.empty()) {
     return;
   }
 
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  auto it = subscribers_.find(signal_name);
-  if (it != subscribers_.end()) {
-    for (const auto& callback : it->second) {
-      if (callback) {
-        callback(img.clone());
-      }
+  // 没有订阅者时直接返回，避免无意义的拷贝
+  auto subscribers = subscribers_.load(signal.index);
+  if (!subscribers || subscribers->empty()) {
+    return;
+  }
+
+  // img 自己持有引用计数缓冲区时，所有订阅者共享即可
+  SharedImage view = std::make_shared<const cv::Mat>(img);
+  if (img.u) {
+    dispatch(subscribers, view);
+    return;
+  }
+
+  // img.u 为空说明 Mat 只是外部内存的视图，订阅者可能在帧释放后仍持有图像，
+  // 因此第一个可能持有图像的订阅者出现时才拷贝一次，之后共享这份拷贝；
+  // PrivateCopy 订阅者在回调里就拷完，直接从视图拷贝，不需要这份共享拷贝
+  SharedImage owned;
+  for (const auto& subscriber : *subscribers) {
+    if (!subscriber.callback) {
+      continue;
+    }
+    if (subscriber.private_copy) {
+      subscriber.callback(view);
+      continue;
+    }
+    if (!owned) {
+      owned = std::make_shared<const cv::Mat>(img.clone());
+    }
+    subscriber.callback(owned);
+  }
+}
+
+void ImageSignalBus::emit(ImageSignal signal, const SharedImage& img) {
+  if (!img || img->empty()) {
+    return;
+  }
+  dispatch(subscribers_.load(signal.index), img);
+}
+
+void ImageSignalBus::dispatch(
+    const SignalTable<ImageSubscriber>::Snapshot& subscribers,
+    const SharedImage& img) {
+  if (!subscribers) {
+    return;
+  }
+  for (const auto& subscriber : *subscribers) {
+    if (subscriber.callback) {
+      subscriber.callback(img);
     }
   }
 }
 
 void ImageSignalBus::subscribe_feature(const std::string& name,
                                        FeatureCallback cb) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  feature_subscribers_[name].push_back(std::move(cb));
+  feature_subscribers_.append(feature_subscribers_.resolve(name),
+                              std::move(cb));
 }
 
 void ImageSignalBus::subscribe_status(const std::string& name,
                                       StatusCallback cb) {
-  std::unique_lock<std::shared_mutex> lock(mutex_);
-  status_subscribers_[name].push_back(std::move(cb));
+  status_subscribers_.append(status_subscribers_.resolve(name), std::move(cb));
+}
+
+std::shared_ptr<AsyncSubscription> ImageSignalBus::subscribe_feature_async(
+    const std::string& name, FeatureCallback cb,
+    const AsyncDeliveryConfig& config) {
+  if (!cb) {
+    return nullptr;
+  }
+  auto queue =
+      std::make_shared<AsyncDeliveryQueue<FeatureData>>(std::move(cb), config);
+  subscribe_feature(name,
+                    [queue](const FeatureData& data) { queue->push(data); });
+  return queue;
 }
 
 void ImageSignalBus::emit_feature(const std::string& name,
                                   const FeatureData& data) {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  if (auto it = feature_subscribers_.find(name);
-      it != feature_subscribers_.end()) {
-    for (const auto& cb : it->second) {
+  if (auto index = feature_subscribers_.find(name)) {
+    emit_feature(FeatureSignal{*index}, data);
+  }
+}
+
+void ImageSignalBus::emit_status(const std::string& name,
+                                 const StatusData& data) {
+  if (auto index = status_subscribers_.find(name)) {
+    emit_status(StatusSignal{*index}, data);
+  }
+}
+
+void ImageSignalBus::emit_feature(FeatureSignal signal,
+                                  const FeatureData& data) {
+  if (auto subscribers = feature_subscribers_.load(signal.index)) {
+    for (const auto& cb : *subscribers) {
       if (cb) {
         cb(data);
       }
@@ -103,12 +228,9 @@ void ImageSignalBus::emit_feature(const std::string& name,
   }
 }
 
-void ImageSignalBus::emit_status(const std::string& name,
-                                 const StatusData& data) {
-  std::shared_lock<std::shared_mutex> lock(mutex_);
-  if (auto it = status_subscribers_.find(name);
-      it != status_subscribers_.end()) {
-    for (const auto& cb : it->second) {
+void ImageSignalBus::emit_status(StatusSignal signal, const StatusData& data) {
+  if (auto subscribers = status_subscribers_.load(signal.index)) {
+    for (const auto& cb : *subscribers) {
       if (cb) {
         cb(data);
       }
@@ -0,0 +1,324 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameRecorder.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/Recording/FrameRecorder.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "cameras/Recording/RecordingFormat.hpp"
+#include "logging/CaponLogging.hpp"
+
+namespace detail {
+
+// 未初始化的块缓冲，避免 std::vector::resize 对整块清零
+struct ChunkBuffer {
+  std::unique_ptr<uint8_t[]> bytes;
+  size_t capacity = 0;
+  size_t size = 0;
+  uint32_t frame_count = 0;
+};
+
+class FrameRecorderImpl {
+ public:
+  explicit FrameRecorderImpl(const FrameRecorderConfig& config)
+      : config_(config) {
+    config_.chunk_bytes = std::max<size_t>(config_.chunk_bytes, 1u << 20);
+    config_.max_pending_chunks = std::max<size_t>(config_.max_pending_chunks, 1);
+  }
+
+  ~FrameRecorderImpl() { close(); }
+
+  bool open();
+  void close();
+  bool is_open() const {
+    std::lock_guard lock(mutex_);
+    return open_;
+  }
+  void append(const CapturedFrame& frame);
+  FrameRecorderStats stats() const {
+    std::lock_guard lock(mutex_);
+    return stats_;
+  }
+
+ private:
+  ChunkBuffer take_chunk_locked(size_t min_capacity);
+  void seal_current_locked();
+  void writer_loop();
+  bool write_all(const uint8_t* data, size_t size);
+
+  FrameRecorderConfig config_;
+  std::FILE* file_ = nullptr;
+  std::thread writer_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable work_cv_;
+  ChunkBuffer current_;
+  std::deque<ChunkBuffer> pending_;
+  std::vector<ChunkBuffer> free_chunks_;
+  uint64_t next_chunk_offset_ = 0;  // current_ 落盘时的文件偏移
+  std::vector<recording::IndexEntry> index_;
+  bool open_ = false;
+  bool closing_ = false;
+  bool write_failed_ = false;
+  FrameRecorderStats stats_;
+};
+
+bool FrameRecorderImpl::open() {
+  std::lock_guard lock(mutex_);
+  if (open_) {
+    return true;
+  }
+  file_ = std::fopen(config_.path.c_str(), "wb");
+  if (!file_) {
+    LOG_ERROR("Failed to create recording file: {}", config_.path);
+    return false;
+  }
+  // 已经是整块写入，关闭 stdio 缓冲避免多一次拷贝
+  std::setvbuf(file_, nullptr, _IONBF, 0);
+
+  recording::FileHeader header{};
+  std::memcpy(header.magic, recording::kFileMagic, sizeof(header.magic));
+  header.version = recording::kFormatVersion;
+  header.header_bytes = sizeof(header);
+  if (!write_all(reinterpret_cast<const uint8_t*>(&header), sizeof(header))) {
+    std::fclose(file_);
+    file_ = nullptr;
+    return false;
+  }
+
+  next_chunk_offset_ = sizeof(header);
+  index_.clear();
+  pending_.clear();
+  stats_ = {};
+  stats_.bytes_written = sizeof(header);
+  write_failed_ = false;
+  closing_ = false;
+  current_ = take_chunk_locked(config_.chunk_bytes);
+  // 预分配全部块，稳态下不再申请内存
+  while (free_chunks_.size() < config_.max_pending_chunks) {
+    ChunkBuffer chunk;
+    chunk.bytes.reset(new uint8_t[config_.chunk_bytes]);
+    chunk.capacity = config_.chunk_bytes;
+    free_chunks_.push_back(std::move(chunk));
+  }
+  open_ = true;
+  writer_ = std::thread([this]() { writer_loop(); });
+  return true;
+}
+
+void FrameRecorderImpl::close() {
+  {
+    std::lock_guard lock(mutex_);
+    if (!open_) {
+      return;
+    }
+    if (current_.frame_count > 0) {
+      seal_current_locked();
+    }
+    closing_ = true;
+  }
+  work_cv_.notify_one();
+  writer_.join();
+
+  std::lock_guard lock(mutex_);
+  if (!write_failed_) {
+    recording::FileFooter footer{};
+    footer.index_offset = next_chunk_offset_;
+    footer.frame_count = index_.size();
+    std::memcpy(footer.magic, recording::kFooterMagic, sizeof(footer.magic));
+    const bool ok =
+        write_all(reinterpret_cast<const uint8_t*>(index_.data()),
+                  index_.size() * sizeof(recording::IndexEntry)) &&
+        write_all(reinterpret_cast<const uint8_t*>(&footer), sizeof(footer));
+    if (!ok) {
+      LOG_ERROR("Failed to write recording index: {}", config_.path);
+    }
+  }
+  std::fclose(file_);
+  file_ = nullptr;
+  open_ = false;
+  LOG_INFO("Recording {} closed: {} frames, {} dropped", config_.path,
+           stats_.frames_written, stats_.frames_dropped);
+}
+
+void FrameRecorderImpl::append(const CapturedFrame& frame) {
+  const std::string& camera_id = frame.meta.cameraId;
+  const size_t data_offset = recording::align_up(
+      sizeof(recording::FrameRecordHeader) + camera_id.size());
+  const size_t record_bytes =
+      data_offset + recording::align_up(frame.data.size());
+
+  std::lock_guard lock(mutex_);
+  if (!open_ || closing_ || write_failed_) {
+    ++stats_.frames_dropped;
+    return;
+  }
+
+  if (current_.size + record_bytes > current_.capacity) {
+    if (current_.frame_count > 0) {
+      // 写线程跟不上时丢弃新帧，不阻塞调用线程
+      if (pending_.size() >= config_.max_pending_chunks) {
+        ++stats_.frames_dropped;
+        return;
+      }
+      seal_current_locked();
+    }
+    if (current_.size + record_bytes > current_.capacity) {
+      // 单帧超过块大小，为它单独申请一块
+      free_chunks_.push_back(std::move(current_));
+      current_ =
+          take_chunk_locked(sizeof(recording::ChunkHeader) + record_bytes);
+    }
+  }
+
+  uint8_t* dst = current_.bytes.get() + current_.size;
+  recording::FrameRecordHeader header{};
+  header.magic = recording::kRecordMagic;
+  header.camera_id_bytes = static_cast<uint32_t>(camera_id.size());
+  header.width = frame.meta.iWidth;
+  header.height = frame.meta.iHeight;
+  header.format = frame.meta.format;
+  header.pixel_format = frame.meta.iPixelFormat;
+  header.bit_depth = frame.meta.bitDepth;
+  header.exposure_us = frame.meta.fExposure;
+  header.gain = frame.meta.fGain;
+  header.frame_rate = frame.meta.frameRate;
+  header.timestamp = frame.meta.uTimestamp;
+  header.data_offset = data_offset;
+  header.data_bytes = frame.data.size();
+
+  // 只清零填充字节，图像数据直接覆盖
+  std::memcpy(dst, &header, sizeof(header));
+  std::memcpy(dst + sizeof(header), camera_id.data(), camera_id.size());
+  const size_t id_end = sizeof(header) + camera_id.size();
+  std::memset(dst + id_end, 0, data_offset - id_end);
+  if (!frame.data.empty()) {
+    std::memcpy(dst + data_offset, frame.data.data(), frame.data.size());
+  }
+  const size_t data_end = data_offset + frame.data.size();
+  std::memset(dst + data_end, 0, record_bytes - data_end);
+
+  index_.push_back({next_chunk_offset_ + current_.size, frame.meta.uTimestamp});
+  current_.size += record_bytes;
+  ++current_.frame_count;
+  ++stats_.frames_written;
+}
+
+ChunkBuffer FrameRecorderImpl::take_chunk_locked(size_t min_capacity) {
+  ChunkBuffer chunk;
+  auto it = std::find_if(free_chunks_.begin(), free_chunks_.end(),
+                         [min_capacity](const ChunkBuffer& c) {
+                           return c.capacity >= min_capacity;
+                         });
+  if (it != free_chunks_.end()) {
+    chunk = std::move(*it);
+    free_chunks_.erase(it);
+  } else {
+    const size_t capacity = std::max(min_capacity, config_.chunk_bytes);
+    chunk.bytes.reset(new uint8_t[capacity]);
+    chunk.capacity = capacity;
+  }
+  chunk.size = sizeof(recording::ChunkHeader);
+  chunk.frame_count = 0;
+  return chunk;
+}
+
+void FrameRecorderImpl::seal_current_locked() {
+  recording::ChunkHeader header{};
+  header.magic = recording::kChunkMagic;
+  header.frame_count = current_.frame_count;
+  header.payload_bytes = current_.size - sizeof(header);
+  std::memcpy(current_.bytes.get(), &header, sizeof(header));
+
+  next_chunk_offset_ += current_.size;
+  pending_.push_back(std::move(current_));
+  current_ = take_chunk_locked(config_.chunk_bytes);
+  work_cv_.notify_one();
+}
+
+void FrameRecorderImpl::writer_loop() {
+  std::unique_lock lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [this]() { return closing_ || !pending_.empty(); });
+    if (pending_.empty()) {
+      return;
+    }
+    ChunkBuffer chunk = std::move(pending_.front());
+    pending_.pop_front();
+
+    const bool failed = write_failed_;
+    lock.unlock();
+    const bool ok = !failed && write_all(chunk.bytes.get(), chunk.size);
+    lock.lock();
+
+    if (ok) {
+      stats_.bytes_written += chunk.size;
+    } else if (!write_failed_) {
+      write_failed_ = true;
+      LOG_ERROR("Recording write failed, stop recording: {}", config_.path);
+    }
+    // 超大块用完即释放，只回收标准大小的块
+    if (chunk.capacity == config_.chunk_bytes) {
+      free_chunks_.push_back(std::move(chunk));
+    }
+  }
+}
+
+bool FrameRecorderImpl::write_all(const uint8_t* data, size_t size) {
+  return size == 0 || std::fwrite(data, 1, size, file_) == size;
+}
+
+}  // namespace detail
+
+FrameRecorder::FrameRecorder(const FrameRecorderConfig& config)
+    : impl_(std::make_shared<detail::FrameRecorderImpl>(config)) {}
+
+FrameRecorder::~FrameRecorder() = default;
+
+bool FrameRecorder::open() { return impl_->open(); }
+
+void FrameRecorder::close() { impl_->close(); }
+
+bool FrameRecorder::is_open() const { return impl_->is_open(); }
+
+void FrameRecorder::process(const CapturedFrame& frame) {
+  impl_->append(frame);
+}
+
+std::shared_ptr<FrameProcessor> FrameRecorder::clone() const {
+  return std::make_shared<FrameRecorder>(*this);
+}
+
+FrameRecorderStats FrameRecorder::stats() const { return impl_->stats(); }
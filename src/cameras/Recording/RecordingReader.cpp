@@ -0,0 +1,256 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: RecordingReader.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/Recording/RecordingReader.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <string>
+
+#include "logging/CaponLogging.hpp"
+
+using recording::ChunkHeader;
+using recording::FileFooter;
+using recording::FileHeader;
+using recording::FrameRecordHeader;
+using recording::IndexEntry;
+
+RecordingReader::~RecordingReader() { close(); }
+
+bool RecordingReader::open(const std::string& path) {
+  close();
+
+#ifdef _WIN32
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    LOG_ERROR("Failed to open recording: {}", path);
+    return false;
+  }
+  LARGE_INTEGER size{};
+  GetFileSizeEx(file, &size);
+  file_size_ = static_cast<size_t>(size.QuadPart);
+  HANDLE mapping =
+      file_size_ > 0
+          ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)
+          : nullptr;
+  if (!mapping) {
+    CloseHandle(file);
+    LOG_ERROR("Failed to map recording: {}", path);
+    return false;
+  }
+  base_ = static_cast<const uint8_t*>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  file_handle_ = file;
+  mapping_handle_ = mapping;
+#else
+  fd_ = ::open(path.c_str(), O_RDONLY);
+  if (fd_ < 0) {
+    LOG_ERROR("Failed to open recording: {}", path);
+    return false;
+  }
+  struct stat st {};
+  if (fstat(fd_, &st) != 0 || st.st_size <= 0) {
+    ::close(fd_);
+    fd_ = -1;
+    LOG_ERROR("Failed to stat recording: {}", path);
+    return false;
+  }
+  file_size_ = static_cast<size_t>(st.st_size);
+  void* addr = mmap(nullptr, file_size_, PROT_READ, MAP_SHARED, fd_, 0);
+  if (addr == MAP_FAILED) {
+    ::close(fd_);
+    fd_ = -1;
+    LOG_ERROR("Failed to map recording: {}", path);
+    return false;
+  }
+  // 回放基本是顺序访问，提示内核预读
+  madvise(addr, file_size_, MADV_SEQUENTIAL);
+  base_ = static_cast<const uint8_t*>(addr);
+#endif
+
+  if (!base_) {
+    close();
+    return false;
+  }
+
+  FileHeader header{};
+  if (file_size_ < sizeof(header)) {
+    LOG_ERROR("Recording too small: {}", path);
+    close();
+    return false;
+  }
+  std::memcpy(&header, base_, sizeof(header));
+  if (std::memcmp(header.magic, recording::kFileMagic, sizeof(header.magic)) !=
+          0 ||
+      header.version != recording::kFormatVersion) {
+    LOG_ERROR("Not a CFP recording or unsupported version: {}", path);
+    close();
+    return false;
+  }
+
+  has_footer_index_ = load_footer_index();
+  if (!has_footer_index_) {
+    LOG_WARN("Recording {} has no index, rebuilding by scan", path);
+    rebuild_index();
+  }
+  return true;
+}
+
+void RecordingReader::close() {
+#ifdef _WIN32
+  if (base_) {
+    UnmapViewOfFile(base_);
+  }
+  if (mapping_handle_) {
+    CloseHandle(static_cast<HANDLE>(mapping_handle_));
+    mapping_handle_ = nullptr;
+  }
+  if (file_handle_) {
+    CloseHandle(static_cast<HANDLE>(file_handle_));
+    file_handle_ = nullptr;
+  }
+#else
+  if (base_) {
+    munmap(const_cast<uint8_t*>(base_), file_size_);
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+#endif
+  base_ = nullptr;
+  file_size_ = 0;
+  index_.clear();
+  has_footer_index_ = false;
+}
+
+bool RecordingReader::load_footer_index() {
+  if (file_size_ < sizeof(FileHeader) + sizeof(FileFooter)) {
+    return false;
+  }
+  FileFooter footer{};
+  std::memcpy(&footer, base_ + file_size_ - sizeof(footer), sizeof(footer));
+  if (std::memcmp(footer.magic, recording::kFooterMagic,
+                  sizeof(footer.magic)) != 0) {
+    return false;
+  }
+  if (footer.frame_count > file_size_ / sizeof(IndexEntry) ||
+      footer.index_offset < sizeof(FileHeader)) {
+    return false;
+  }
+  const uint64_t index_bytes = footer.frame_count * sizeof(IndexEntry);
+  if (footer.index_offset + index_bytes + sizeof(footer) != file_size_) {
+    return false;
+  }
+  index_.resize(footer.frame_count);
+  std::memcpy(index_.data(), base_ + footer.index_offset, index_bytes);
+
+  // 索引来自文件本身，逐条按扫描路径的规则校验，有一条不对就整体改为扫描
+  for (const IndexEntry& entry : index_) {
+    if (entry.record_offset < sizeof(FileHeader) ||
+        !record_in_bounds(entry.record_offset, footer.index_offset)) {
+      index_.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool RecordingReader::record_in_bounds(uint64_t offset, uint64_t end) const {
+  if (end > file_size_ || offset > end ||
+      end - offset < sizeof(FrameRecordHeader)) {
+    return false;
+  }
+  FrameRecordHeader header{};
+  std::memcpy(&header, base_ + offset, sizeof(header));
+  const uint64_t available = end - offset;
+  return header.magic == recording::kRecordMagic &&
+         header.data_offset >= sizeof(header) + header.camera_id_bytes &&
+         header.data_offset <= available &&
+         header.data_bytes <= available - header.data_offset;
+}
+
+void RecordingReader::rebuild_index() {
+  index_.clear();
+  uint64_t offset = sizeof(FileHeader);
+  while (offset + sizeof(ChunkHeader) <= file_size_) {
+    ChunkHeader chunk{};
+    std::memcpy(&chunk, base_ + offset, sizeof(chunk));
+    if (chunk.magic != recording::kChunkMagic ||
+        chunk.payload_bytes > file_size_ - offset - sizeof(chunk)) {
+      break;  // 截断或损坏的尾块
+    }
+    const uint64_t chunk_end = offset + sizeof(chunk) + chunk.payload_bytes;
+
+    uint64_t record = offset + sizeof(chunk);
+    for (uint32_t i = 0; i < chunk.frame_count && record < chunk_end; ++i) {
+      if (!record_in_bounds(record, chunk_end)) {
+        break;
+      }
+      FrameRecordHeader header{};
+      std::memcpy(&header, base_ + record, sizeof(header));
+      index_.push_back({record, header.timestamp});
+      record += header.data_offset + recording::align_up(header.data_bytes);
+    }
+    offset = chunk_end;
+  }
+}
+
+RecordedFrameView RecordingReader::frame(size_t index) const {
+  RecordedFrameView view;
+  if (index >= index_.size()) {
+    return view;
+  }
+  const uint8_t* record = base_ + index_[index].record_offset;
+  FrameRecordHeader header{};
+  std::memcpy(&header, record, sizeof(header));
+
+  view.meta.iWidth = header.width;
+  view.meta.iHeight = header.height;
+  view.meta.format = header.format;
+  view.meta.iPixelFormat = header.pixel_format;
+  view.meta.bitDepth = header.bit_depth;
+  view.meta.fExposure = header.exposure_us;
+  view.meta.fGain = header.gain;
+  view.meta.frameRate = header.frame_rate;
+  view.meta.uTimestamp = header.timestamp;
+  view.meta.cameraId.assign(
+      reinterpret_cast<const char*>(record + sizeof(header)),
+      header.camera_id_bytes);
+  view.data = record + header.data_offset;
+  view.size = static_cast<size_t>(header.data_bytes);
+  return view;
+}
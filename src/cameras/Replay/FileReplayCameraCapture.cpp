@@ -0,0 +1,466 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FileReplayCameraCapture.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/Replay/FileReplayCameraCapture.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <filesystem>  //NOLINT
+#include <memory>
+#include <opencv2/imgcodecs.hpp>
+#include <string>
+#include <utility>
+
+#include "logging/CaponLogging.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+// 原始图像队列的上限，超过后丢弃最旧的帧
+constexpr size_t kMaxRawFrames = 200;
+
+std::string lower_extension(const fs::path& path) {
+  std::string ext = path.extension().string();
+  std::transform(ext.begin(), ext.end(), ext.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return ext;
+}
+
+bool is_image_file(const fs::path& path) {
+  static const char* kExtensions[] = {".jpg", ".jpeg", ".png",
+                                      ".bmp", ".tif",  ".tiff"};
+  const std::string ext = lower_extension(path);
+  return std::any_of(std::begin(kExtensions), std::end(kExtensions),
+                     [&ext](const char* e) { return ext == e; });
+}
+
+bool is_raw_file(const fs::path& path) {
+  const std::string ext = lower_extension(path);
+  return ext == ".raw" || ext == ".bin";
+}
+
+bool is_recording_file(const fs::path& path) {
+  return lower_extension(path) == ".cfpr";
+}
+}  // namespace
+
+FileReplayCameraCapture::FileReplayCameraCapture(std::string camera_id,
+                                                 const ReplayConfig& config)
+    : camera_id_(std::move(camera_id)),
+      config_(std::make_shared<ReplayConfig>(config)),
+      pipeline_(
+          [this](FramePipeline::Task task) {
+            workers_.submit(std::move(task));
+          },
+          [this](const std::shared_ptr<CapturedFrame>& frame) {
+            if (auto processor = user_processor_.load()) {
+              processor->process_shared(frame);
+            }
+          }) {}
+
+FileReplayCameraCapture::~FileReplayCameraCapture() { stop(); }
+
+bool FileReplayCameraCapture::start(const FrameProcessor& processor) {
+  user_processor_.store(processor.clone());
+  return start();
+}
+
+bool FileReplayCameraCapture::start() {
+  if (running_.load()) {
+    return false;
+  }
+  // 非循环回放结束后线程已退出，但仍需回收
+  if (replay_thread_.joinable()) {
+    replay_thread_.join();
+  }
+  if (!open_source()) {
+    return false;
+  }
+
+  const size_t bytes = frame_bytes_hint();
+  if (bytes > 0) {
+    size_t count = 0;
+    {
+      std::shared_lock lock(config_mutex_);
+      count = static_cast<size_t>(std::max(config_->buffer_queue_size, 1));
+    }
+    // 在处理线程上首次写入，缓冲区落在处理线程所在的 NUMA 节点
+    workers_.pool()->run_local([&]() { frame_pool_.reserve(bytes, count); });
+  }
+
+  pipeline_.start();
+  finished_.store(false);
+  running_.store(true);
+  replay_thread_ = std::thread([this]() { replay_loop(); });
+
+  protocol::FrontendStatus initial_status{};
+  initial_status.self_check = true;
+  initial_status.capture = true;
+  initial_status.file_io = true;
+  update_status(initial_status);
+  return true;
+}
+
+void FileReplayCameraCapture::stop() {
+  running_.store(false);
+  if (replay_thread_.joinable()) {
+    replay_thread_.join();
+  }
+  pipeline_.stop();
+  raw_stream_.close();
+  recording_.close();
+
+  auto status = get_status();
+  status.capture = false;
+  update_status(status);
+}
+
+bool FileReplayCameraCapture::open_source() {
+  ReplayConfig cfg = get_config();
+  image_files_.clear();
+  preloaded_.clear();
+  raw_stream_.close();
+  recording_.close();
+  raw_frame_bytes_ = 0;
+  next_index_ = 0;
+
+  std::error_code ec;
+  const fs::path source(cfg.source_path);
+  if (cfg.source_path.empty() || !fs::exists(source, ec)) {
+    LOG_ERROR("Replay source not found: {}", cfg.source_path);
+    return false;
+  }
+
+  if (fs::is_directory(source, ec)) {
+    for (const auto& entry : fs::directory_iterator(source, ec)) {
+      if (entry.is_regular_file() && is_image_file(entry.path())) {
+        image_files_.push_back(entry.path().string());
+      }
+    }
+    std::sort(image_files_.begin(), image_files_.end());
+  } else if (is_recording_file(source)) {
+    if (!recording_.open(cfg.source_path) || recording_.size() == 0) {
+      LOG_ERROR("No frames in replay recording: {}", cfg.source_path);
+      recording_.close();
+      return false;
+    }
+    LOG_INFO("Replay camera {} opened recording {} ({} frames)", camera_id_,
+             cfg.source_path, recording_.size());
+    return true;
+  } else if (is_raw_file(source)) {
+    const size_t channels = cfg.mono_state ? 1 : 3;
+    raw_frame_bytes_ = static_cast<size_t>(std::max(cfg.roi_w, 0)) *
+                       static_cast<size_t>(std::max(cfg.roi_h, 0)) * channels;
+    if (raw_frame_bytes_ == 0) {
+      LOG_ERROR("Raw replay requires roi_w/roi_h: {}", cfg.source_path);
+      return false;
+    }
+    raw_stream_.open(source, std::ios::binary);
+    if (!raw_stream_) {
+      LOG_ERROR("Failed to open raw replay file: {}", cfg.source_path);
+      return false;
+    }
+    return true;
+  } else {
+    image_files_.push_back(source.string());
+  }
+
+  if (image_files_.empty()) {
+    LOG_ERROR("No images found in replay source: {}", cfg.source_path);
+    return false;
+  }
+
+  if (cfg.preload) {
+    const int flags = cfg.mono_state ? cv::IMREAD_GRAYSCALE : cv::IMREAD_COLOR;
+    preloaded_.reserve(image_files_.size());
+    for (const auto& file : image_files_) {
+      cv::Mat img = cv::imread(file, flags);
+      if (img.empty()) {
+        LOG_WARN("Skipping unreadable replay image: {}", file);
+        continue;
+      }
+      DecodedImage decoded;
+      decoded.width = img.cols;
+      decoded.height = img.rows;
+      decoded.type = img.type();
+      decoded.data.assign(img.datastart, img.dataend);
+      if (!img.isContinuous()) {
+        cv::Mat continuous = img.clone();
+        decoded.data.assign(continuous.datastart, continuous.dataend);
+      }
+      preloaded_.push_back(std::move(decoded));
+    }
+    if (preloaded_.empty()) {
+      LOG_ERROR("No decodable images in replay source: {}", cfg.source_path);
+      return false;
+    }
+  }
+  LOG_INFO("Replay camera {} loaded {} images from {}", camera_id_,
+           image_files_.size(), cfg.source_path);
+  return true;
+}
+
+size_t FileReplayCameraCapture::frame_bytes_hint() const {
+  if (raw_frame_bytes_ > 0) {
+    return raw_frame_bytes_;
+  }
+  if (recording_.is_open()) {
+    return recording_.frame(0).size;
+  }
+  if (!preloaded_.empty()) {
+    return preloaded_.front().data.size();
+  }
+  return 0;
+}
+
+void FileReplayCameraCapture::replay_loop() {
+  using clock = std::chrono::steady_clock;
+  // 回放参数在 start() 时确定，运行中修改配置到下次启动才生效
+  const ReplayConfig cfg = get_config();
+  const double fps =
+      cfg.acquisition_frame_rate_enable ? cfg.acquisition_frame_rate : 0.0;
+  const size_t bytes = frame_bytes_hint();
+  const auto started = clock::now();
+  auto next_deadline = started;
+
+  while (running_.load()) {
+    auto frame = frame_pool_.acquire(bytes);
+    if (!next_frame(cfg, *frame)) {
+      finished_.store(true);
+      break;
+    }
+
+    const auto now = clock::now();
+    // 录制文件保留原始时间戳和相机 ID，便于逐帧比对
+    if (!recording_.is_open()) {
+      frame->meta.uTimestamp = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(now - started)
+              .count());
+      frame->meta.frameRate = fps;
+      frame->meta.cameraId = camera_id_;
+    }
+    frames_emitted_.fetch_add(1, std::memory_order_relaxed);
+    emit_frame(std::move(frame));
+
+    // 按固定节拍回放，处理慢于节拍时不追帧
+    if (fps > 0.0) {
+      next_deadline += std::chrono::duration_cast<clock::duration>(
+          std::chrono::duration<double>(1.0 / fps));
+      if (next_deadline < now) {
+        next_deadline = now;
+      }
+      std::this_thread::sleep_until(next_deadline);
+    }
+  }
+
+  running_.store(false);
+  auto status = get_status();
+  status.capture = false;
+  update_status(status);
+}
+
+bool FileReplayCameraCapture::next_frame(const ReplayConfig& cfg,
+                                         CapturedFrame& frame) {
+  if (recording_.is_open()) {
+    if (next_index_ >= recording_.size()) {
+      if (!cfg.loop) {
+        return false;
+      }
+      next_index_ = 0;
+    }
+    return read_recording(frame);
+  }
+
+  if (raw_frame_bytes_ > 0) {
+    if (read_raw(cfg, frame)) {
+      return true;
+    }
+    if (!cfg.loop) {
+      return false;
+    }
+    raw_stream_.clear();
+    raw_stream_.seekg(0);
+    return read_raw(cfg, frame);
+  }
+
+  const size_t count =
+      cfg.preload ? preloaded_.size() : image_files_.size();
+  // 非预加载时可能遇到无法解码的文件，最多跳过一整轮
+  for (size_t attempts = 0; attempts < count; ++attempts) {
+    if (next_index_ >= count) {
+      if (!cfg.loop) {
+        return false;
+      }
+      next_index_ = 0;
+    }
+    if (read_image(cfg, next_index_++, frame)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FileReplayCameraCapture::read_image(const ReplayConfig& cfg,
+                                         size_t index, CapturedFrame& frame) {
+  cv::Mat decoded_mat;
+  const uint8_t* src = nullptr;
+  size_t bytes = 0;
+  int width = 0;
+  int height = 0;
+  int type = 0;
+
+  if (cfg.preload) {
+    const DecodedImage& img = preloaded_[index];
+    src = img.data.data();
+    bytes = img.data.size();
+    width = img.width;
+    height = img.height;
+    type = img.type;
+  } else {
+    const int flags = cfg.mono_state ? cv::IMREAD_GRAYSCALE : cv::IMREAD_COLOR;
+    decoded_mat = cv::imread(image_files_[index], flags);
+    if (decoded_mat.empty()) {
+      LOG_WARN("Skipping unreadable replay image: {}", image_files_[index]);
+      return false;
+    }
+    if (!decoded_mat.isContinuous()) {
+      decoded_mat = decoded_mat.clone();
+    }
+    src = decoded_mat.data;
+    bytes = decoded_mat.total() * decoded_mat.elemSize();
+    width = decoded_mat.cols;
+    height = decoded_mat.rows;
+    type = decoded_mat.type();
+  }
+
+  // 和相机回调一样只拷贝一次到帧缓冲
+  frame.data.resize(bytes);
+  std::memcpy(frame.data.data(), src, bytes);
+  frame.meta.iWidth = width;
+  frame.meta.iHeight = height;
+  frame.meta.format = type;
+  frame.meta.iPixelFormat = type;
+  frame.meta.bitDepth = 8;
+  frame.meta.fExposure = cfg.exposure_us;
+  frame.meta.fGain = cfg.gain;
+  return true;
+}
+
+bool FileReplayCameraCapture::read_raw(const ReplayConfig& cfg,
+                                       CapturedFrame& frame) {
+  frame.data.resize(raw_frame_bytes_);
+  raw_stream_.read(reinterpret_cast<char*>(frame.data.data()),
+                   static_cast<std::streamsize>(raw_frame_bytes_));
+  if (static_cast<size_t>(raw_stream_.gcount()) != raw_frame_bytes_) {
+    return false;
+  }
+  frame.meta.iWidth = cfg.roi_w;
+  frame.meta.iHeight = cfg.roi_h;
+  frame.meta.format = cfg.mono_state ? CV_8UC1 : CV_8UC3;
+  frame.meta.iPixelFormat = frame.meta.format;
+  frame.meta.bitDepth = 8;
+  frame.meta.fExposure = cfg.exposure_us;
+  frame.meta.fGain = cfg.gain;
+  return true;
+}
+
+bool FileReplayCameraCapture::read_recording(CapturedFrame& frame) {
+  RecordedFrameView view = recording_.frame(next_index_++);
+  // 从映射区直接拷贝到帧缓冲，和相机回调一样只有一次拷贝
+  frame.data.resize(view.size);
+  if (view.size > 0) {
+    std::memcpy(frame.data.data(), view.data, view.size);
+  }
+  frame.meta = std::move(view.meta);
+  return true;
+}
+
+void FileReplayCameraCapture::emit_frame(std::shared_ptr<CapturedFrame> frame) {
+  // 原始图像队列只在打开预览时填充，消费跟不上时丢弃最旧的帧
+  if (frame_queue_enabled_.load(std::memory_order_relaxed)) {
+    frame_queue_.enqueue(frame);
+    [[unlikely]] if (frame_queue_.size_approx() > kMaxRawFrames) {
+      std::shared_ptr<CapturedFrame> oldest;
+      frame_queue_.try_dequeue(oldest);
+    }
+  }
+  pipeline_.push(std::move(frame));
+}
+
+void FileReplayCameraCapture::set_config(const CameraConfig& cfg) {
+  std::unique_lock lock(config_mutex_);
+  static_cast<CameraConfig&>(*config_) = cfg;
+}
+
+void FileReplayCameraCapture::set_config(const ReplayConfig& cfg) {
+  std::unique_lock lock(config_mutex_);
+  *config_ = cfg;
+}
+
+ReplayConfig FileReplayCameraCapture::get_config() const {
+  std::shared_lock lock(config_mutex_);
+  return *config_;
+}
+
+void FileReplayCameraCapture::set_roi(int x, int y, int width, int height) {
+  std::unique_lock lock(config_mutex_);
+  config_->roi_x = x;
+  config_->roi_y = y;
+  config_->roi_w = width;
+  config_->roi_h = height;
+}
+
+void FileReplayCameraCapture::add_frame_processor(
+    const FrameProcessor& processor) {
+  user_processor_.store(processor.clone());
+}
+
+void FileReplayCameraCapture::set_pipeline_config(
+    const FramePipelineConfig& config) {
+  pipeline_.set_config(config);
+}
+
+void FileReplayCameraCapture::set_execution_config(
+    const ExecutionConfig& config) {
+  workers_.configure(config);
+}
+
+FramePipelineStats FileReplayCameraCapture::get_pipeline_stats() const {
+  return pipeline_.stats();
+}
+
+protocol::FrontendStatus FileReplayCameraCapture::get_status() const {
+  std::shared_lock lock(status_mutex_);
+  return current_status_;
+}
+
+void FileReplayCameraCapture::update_status(
+    const protocol::FrontendStatus& new_status) {
+  std::unique_lock lock(status_mutex_);
+  current_status_ = new_status;
+}
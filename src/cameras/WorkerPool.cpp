@@ -0,0 +1,354 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: WorkerPool.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "cameras/WorkerPool.hpp"
+//
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <exception>
+#include <future>
+#include <utility>
+
+#include "cameras/ExecutionTopology.hpp"
+#include "logging/CaponLogging.hpp"
+
+namespace detail {
+
+struct LaneState {
+  std::string name;
+  LaneOptions options;
+  size_t home = 0;  // 归属的工作线程
+
+  std::mutex mutex;
+  std::deque<WorkerPool::Task> queue;
+  bool running = false;  // ordered 通道是否有任务在执行
+  bool retired = false;  // 句柄已释放，排空后从池中移除
+
+  // 以下在锁外读取，用于挑选通道
+  std::atomic<size_t> ready{0};        // 当前可以取走的任务数
+  std::atomic<uint64_t> vtime{0};      // 步长调度的虚拟时间
+  std::atomic<uint64_t> executed{0};
+  std::atomic<uint64_t> stolen{0};
+};
+
+}  // namespace detail
+
+namespace {
+
+// 权重为 1 的通道每执行一个任务前进的虚拟时间
+constexpr uint64_t kStride = 1 << 16;
+
+// 当前线程所属的池，非工作线程为空
+thread_local const WorkerPool* current_pool = nullptr;
+
+}  // namespace
+
+WorkerPool::Lane::Lane(std::shared_ptr<WorkerPool> pool,
+                       std::shared_ptr<detail::LaneState> state)
+    : pool_(std::move(pool)), state_(std::move(state)) {}
+
+WorkerPool::Lane::~Lane() {
+  pool_->retire(state_);
+  if (pool_->on_worker_thread()) {
+    // 这可能是池的最后一个引用，池要等本任务结束并 join 全部工作线程，
+    // 不能在这里析构，转交给独立线程释放
+    std::thread([pool = std::move(pool_)]() mutable { pool.reset(); })
+        .detach();
+  }
+}
+
+void WorkerPool::Lane::submit(Task task) {
+  pool_->enqueue(*state_, std::move(task));
+}
+
+const std::string& WorkerPool::Lane::name() const { return state_->name; }
+
+WorkerPool::WorkerPool(std::string name, size_t threads, std::vector<int> cpus)
+    : name_(std::move(name)),
+      threads_(std::max<size_t>(threads, 1)),
+      cpus_(std::move(cpus)) {
+  default_lane_ = make_lane_state("default", {});
+  lanes_.store(std::make_shared<const LaneList>(LaneList{default_lane_}));
+
+  workers_.reserve(threads_);
+  for (size_t i = 0; i < threads_; ++i) {
+    workers_.emplace_back([this, i]() {
+      if (!cpus_.empty() && !pin_current_thread({cpus_[i % cpus_.size()]})) {
+        LOG_WARN("Worker pool {} failed to pin thread to cpu {}", name_,
+                 cpus_[i % cpus_.size()]);
+      }
+      current_pool = this;
+      worker_loop(i);
+    });
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  assert(!on_worker_thread() &&
+         "WorkerPool released its last reference on its own worker thread");
+  {
+    std::unique_lock lock(sleep_mutex_);
+    idle_.wait(lock, [this]() { return pending_.load() == 0; });
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::shared_ptr<detail::LaneState> WorkerPool::make_lane_state(
+    std::string name, const LaneOptions& options) {
+  auto lane = std::make_shared<detail::LaneState>();
+  const size_t id = next_lane_id_++;
+  lane->name = name.empty() ? "lane" + std::to_string(id) : std::move(name);
+  lane->options = options;
+  lane->options.weight = std::max<uint32_t>(options.weight, 1);
+  lane->home = id % threads_;
+  return lane;
+}
+
+std::shared_ptr<WorkerPool::Lane> WorkerPool::create_lane(
+    std::string name, const LaneOptions& options) {
+  std::lock_guard lock(lanes_mutex_);
+  auto state = make_lane_state(std::move(name), options);
+  auto lanes = std::make_shared<LaneList>(*lanes_.load());
+  lanes->push_back(state);
+  lanes_.store(std::move(lanes));
+  return std::shared_ptr<Lane>(new Lane(shared_from_this(), std::move(state)));
+}
+
+void WorkerPool::retire(const std::shared_ptr<detail::LaneState>& lane) {
+  // 剩余的任务仍在原通道按原来的顺序执行，排空后再移除
+  bool drained = false;
+  {
+    std::lock_guard lock(lane->mutex);
+    lane->retired = true;
+    drained = lane->queue.empty() && !lane->running;
+  }
+  if (drained) {
+    remove_lane(lane.get());
+  }
+}
+
+void WorkerPool::remove_lane(const detail::LaneState* lane) {
+  std::lock_guard lock(lanes_mutex_);
+  auto lanes = std::make_shared<LaneList>(*lanes_.load());
+  lanes->erase(std::remove_if(lanes->begin(), lanes->end(),
+                              [lane](const auto& item) {
+                                return item.get() == lane;
+                              }),
+               lanes->end());
+  lanes_.store(std::move(lanes));
+}
+
+void WorkerPool::submit(Task task) { enqueue(*default_lane_, std::move(task)); }
+
+void WorkerPool::enqueue(detail::LaneState& lane, Task task) {
+  size_t added = 0;
+  pending_.fetch_add(1);
+  {
+    std::lock_guard lock(lane.mutex);
+    // 空闲后重新有任务的通道从当前虚拟时间开始，不能拿攒下的额度独占线程
+    if (lane.queue.empty() && !lane.running) {
+      lane.vtime.store(std::max(lane.vtime.load(std::memory_order_relaxed),
+                                virtual_clock_.load(std::memory_order_relaxed)),
+                       std::memory_order_relaxed);
+    }
+    lane.queue.push_back(std::move(task));
+    if (!lane.options.ordered) {
+      added = 1;
+    } else if (!lane.running && lane.queue.size() == 1) {
+      added = 1;
+    }
+    lane.ready.fetch_add(added);
+  }
+  publish_ready(added);
+}
+
+void WorkerPool::publish_ready(size_t count) {
+  if (count == 0) {
+    return;
+  }
+  ready_.fetch_add(count);
+  // 与 worker_loop 中先登记 sleepers_ 再检查 ready_ 配对，不会丢失唤醒
+  if (sleepers_.load() > 0) {
+    { std::lock_guard lock(sleep_mutex_); }
+    if (count == 1) {
+      wake_.notify_one();
+    } else {
+      wake_.notify_all();
+    }
+  }
+}
+
+bool WorkerPool::run_one(size_t worker) {
+  auto lanes = lanes_.load();
+  detail::LaneState* best = nullptr;
+  bool best_home = false;
+  for (const auto& lane : *lanes) {
+    if (lane->ready.load(std::memory_order_relaxed) == 0) {
+      continue;
+    }
+    const bool home = lane->home == worker;
+    if (best == nullptr) {
+      best = lane.get();
+      best_home = home;
+      continue;
+    }
+    if (lane->options.priority != best->options.priority) {
+      if (lane->options.priority > best->options.priority) {
+        best = lane.get();
+        best_home = home;
+      }
+      continue;
+    }
+    if (home != best_home) {
+      if (home) {
+        best = lane.get();
+        best_home = true;
+      }
+      continue;
+    }
+    if (lane->vtime.load(std::memory_order_relaxed) <
+        best->vtime.load(std::memory_order_relaxed)) {
+      best = lane.get();
+    }
+  }
+  if (best == nullptr) {
+    return false;
+  }
+
+  Task task;
+  {
+    std::lock_guard lock(best->mutex);
+    if (best->ready.load(std::memory_order_relaxed) == 0) {
+      return true;  // 被其他线程抢先取走，重新挑选
+    }
+    task = std::move(best->queue.front());
+    best->queue.pop_front();
+    best->ready.fetch_sub(1);
+    ready_.fetch_sub(1);
+    if (best->options.ordered) {
+      best->running = true;
+    }
+    const uint64_t vtime =
+        best->vtime.load(std::memory_order_relaxed) +
+        kStride / best->options.weight;
+    best->vtime.store(vtime, std::memory_order_relaxed);
+    virtual_clock_.store(vtime, std::memory_order_relaxed);
+  }
+  best->executed.fetch_add(1, std::memory_order_relaxed);
+  if (!best_home) {
+    best->stolen.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  try {
+    task();
+  } catch (const std::exception& e) {
+    LOG_ERROR("Worker pool {} task threw: {}", name_, e.what());
+  } catch (...) {
+    LOG_ERROR("Worker pool {} task threw an unknown exception", name_);
+  }
+  task = nullptr;
+
+  size_t added = 0;
+  bool drained = false;
+  {
+    std::lock_guard lock(best->mutex);
+    if (best->options.ordered) {
+      best->running = false;
+      if (!best->queue.empty()) {
+        added = 1;
+        best->ready.fetch_add(1);
+      }
+    }
+    drained = best->retired && best->queue.empty() && !best->running;
+  }
+  publish_ready(added);
+  if (drained) {
+    remove_lane(best);
+  }
+
+  if (pending_.fetch_sub(1) == 1) {
+    std::lock_guard lock(sleep_mutex_);
+    idle_.notify_all();
+  }
+  return true;
+}
+
+void WorkerPool::worker_loop(size_t worker) {
+  while (true) {
+    if (run_one(worker)) {
+      continue;
+    }
+    std::unique_lock lock(sleep_mutex_);
+    sleepers_.fetch_add(1);
+    wake_.wait(lock, [this]() { return stopping_ || ready_.load() > 0; });
+    sleepers_.fetch_sub(1);
+    if (stopping_ && ready_.load() == 0) {
+      return;
+    }
+  }
+}
+
+bool WorkerPool::on_worker_thread() const { return current_pool == this; }
+
+void WorkerPool::run_local(const std::function<void()>& fn) {
+  std::promise<void> done;
+  auto future = done.get_future();
+  submit([&fn, &done]() {
+    try {
+      fn();
+      done.set_value();
+    } catch (...) {
+      done.set_exception(std::current_exception());
+    }
+  });
+  future.get();
+}
+
+std::vector<LaneStats> WorkerPool::lane_stats() const {
+  auto lanes = lanes_.load();
+  std::vector<LaneStats> stats;
+  stats.reserve(lanes->size());
+  for (const auto& lane : *lanes) {
+    LaneStats item;
+    item.name = lane->name;
+    item.priority = lane->options.priority;
+    item.weight = lane->options.weight;
+    item.ordered = lane->options.ordered;
+    item.executed = lane->executed.load(std::memory_order_relaxed);
+    item.stolen = lane->stolen.load(std::memory_order_relaxed);
+    {
+      std::lock_guard lock(lane->mutex);
+      item.queued = lane->queue.size();
+    }
+    stats.push_back(std::move(item));
+  }
+  return stats;
+}
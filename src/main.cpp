@@ -31,6 +31,7 @@
 #define _WIN32_WINNT 0x0601
 #endif
 
+#include <chrono>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -39,14 +40,18 @@
 // 必须先包含 asio
 // #include "asio.hpp"
 #include "asio/io_context.hpp"
-#include "protocol/ProtocolSession.hpp"
+#include "protocol/FanoutSession.hpp"
+#include "protocol/ReconnectingTransport.hpp"
+#include "protocol/ReportImageEncoder.hpp"
 
 // 其他头文件
 #include "algo/AlgoBase.hpp"
+#include "algo/AlgoGraph.hpp"
 #include "algo/HoleDetection.hpp"
 #include "business/BusinessManager.hpp"
 #include "cameras/CameraFactory.hpp"
 #include "cameras/EventHandlers.hpp"
+#include "cameras/FeatureReorderBuffer.hpp"
 #include "cameras/ImageSignalBus.hpp"
 #include "config/ConfigManager.hpp"
 #include "logging/LoggingConfigManager.hpp"
@@ -75,16 +80,26 @@ int main() {
 
     // 创建业务管理器（它会自动创建所有需要的会话）
     std::string local_ip = utils::get_local_ip();
+    protocol::ReconnectConfig reconnect;
+    reconnect.initial_backoff =
+        std::chrono::milliseconds(global_config.report.reconnect_initial_ms);
+    reconnect.max_backoff =
+        std::chrono::milliseconds(global_config.report.reconnect_max_ms);
+    reconnect.max_queued_messages = global_config.report.offline_queue;
+    reconnect.max_queued_bytes =
+        global_config.report.offline_queue_mb * 1024 * 1024;
+    // 主备服务器各自排队，备份服务器慢时不拖累主服务器
+    protocol::FanoutConfig fanout;
+    fanout.max_queued_messages = global_config.report.destination_queue;
+    fanout.max_in_flight = global_config.report.destination_in_flight;
     business::BusinessManager business_mgr(
         main_io_ctx, local_ip, "192.1.53.9",
-        "192.1.53.10");  // 主服务器和备份服务器IP
+        "192.1.53.10",  // 主服务器和备份服务器IP
+        reconnect, global_config.report.offline_spill_dir, fanout);
     business_mgr.start();
 
-    // 从 BusinessManager 获取主服务器和备份服务器的会话
-    auto report_session = business_mgr.get_report_session();
-    auto backup_report_session =
-        business_mgr
-            .get_backup_report_session();  // 可能为空，如果未配置备份服务器
+    // 从 BusinessManager 获取上报会话，一次编码同时发往主服务器和备份服务器
+    auto report_fanout = business_mgr.get_report_fanout();
 
     // 初始配置管理器 (可以在运行时从配置文件直接动态更新算法)
     auto& config_manager = config::ConfigManager::instance();
@@ -101,13 +116,14 @@ int main() {
 
     // 未来这里的算法取决于配置文件，从里面读取并且创建
     auto holeDetection = config_manager.create_algorithm<algo::HoleDetection>();
-    algo::AlgoAdapter adapter(holeDetection);  // 栈上对象，持有 shared_ptr
-    // AlgoAdapter
+    // 每帧要跑的算法组成一张图，互不依赖的算法并行执行；拷贝共享同一张图
+    algo::AlgoGraph algo_graph(global_config.algo_graph.threads);
+    algo_graph.add_algorithm(holeDetection);
 
     // 延迟启动算法的lambda,可以做到开始信号来了之后在绑定
-    auto start_camera_algo = [cameras, adapter]() {
+    auto start_camera_algo = [cameras, algo_graph]() {
       for (const auto& cam : cameras) {
-        cam->add_frame_processor(adapter);
+        cam->add_frame_processor(algo_graph);
       }
     };
 
@@ -117,72 +133,71 @@ int main() {
           start_camera_algo();
         });
 
+    // 有缺陷时上报可以带上来源帧的图片：raw 直接引用帧缓冲区，
+    // jpeg/png 在独立线程池上压缩，回调仍按提交顺序执行
+    protocol::ReportImageConfig image_config;
+    image_config.format =
+        protocol::parse_report_image_format(global_config.report.image_format);
+    image_config.jpeg_quality = global_config.report.jpeg_quality;
+    image_config.png_compression = global_config.report.png_compression;
+    image_config.max_pending = global_config.report.image_queue;
+    image_config.execution.threads = global_config.report.exec_threads;
+    image_config.execution.cpus = global_config.report.exec_cpus;
+    auto report_images =
+        std::make_shared<protocol::ReportImageEncoder>(image_config);
+
     // 特征数据回调 - 同时发送到主服务器和备份服务器
-    ImageSignalBus::instance().subscribe_feature(
-        "hole_features", [report_session, backup_report_session,
-                          &cameras](const ImageSignalBus::FeatureData& data) {
-          if (!report_session || !cameras.empty()) {
+    // 各帧在线程池上并行处理，结果先按采集序号重排，保证缺陷与帧、
+    // 卷位置一一对应；放出的结果依次发送
+    auto feature_reorder = std::make_shared<FeatureReorderBuffer>(
+        [report_fanout,
+         report_images](const ImageSignalBus::FeatureData& data) {
+          if (!report_fanout) {
             return;
           }
 
-          std::shared_ptr<CapturedFrame> frame;
-          // TODO(cmx) 目前是单相机，就直接用第一个相机采集发送了
-          if (cameras[0]->get_frame_queue().try_dequeue(frame) && frame) {
-            protocol::FeatureReport report;
-            report.roll_id = data.roll_id;
-            report.features = data.features;
-            report.special_images = data.special_images;
-            // 从业务逻辑上看貌似是不需要整个的原始图像信息的?
-            // report.image_data = frame->data;
-
-            // 发送到主服务器
-            report_session->async_send_features(report, [](std::error_code ec) {
-              if (ec) {
-                LOG_ERROR("Feature send to main server failed: {}",
-                          ec.message());
-              }
-            });
-
-            // 发送到备份服务器（如果存在）
-            if (backup_report_session) {
-              backup_report_session->async_send_features(
-                  report, [](std::error_code ec) {
-                    if (ec) {
-                      LOG_ERROR("Feature send to backup server failed: {}",
-                                ec.message());
-                    }
-                  });
-            }
-          }
+          auto report = std::make_shared<protocol::FeatureReport>();
+          report->roll_id = data.roll_id;
+          report->features = data.features;
+          report->special_images = data.special_images;
+
+          // 只编码一次，主备服务器发送的是同一份报文和图片缓冲区
+          report_images->submit(
+              data.frame, [report_fanout, report](auto image) {
+                report->image = std::move(image);
+                report_fanout->async_send_features(
+                    report,
+                    [](const std::string& destination, std::error_code ec) {
+                      if (ec) {
+                        LOG_ERROR("Feature send to {} failed: {}",
+                                  destination, ec.message());
+                      }
+                    });
+              });
+        });
+
+    // 在独立的投递线程上执行，不占用算法线程，特征一条都不丢
+    ImageSignalBus::instance().subscribe_feature_async(
+        "hole_features",
+        [feature_reorder](const ImageSignalBus::FeatureData& data) {
+          feature_reorder->push(data);
         });
 
     // 遥测数据由 BusinessManager 自动处理
     // 不需要手动创建 telemetry_thread
 
     // 状态发送线程，同时发送给主服务器和备份服务器
-    std::thread status_thread([report_session, backup_report_session,
-                               &cameras]() {
+    std::thread status_thread([report_fanout, &cameras]() {
       while (true) {
         if (cameras[0]) {
           auto status = cameras[0]->get_status();
-
-          // 发送到主服务器
-          report_session->async_send_status(status, [](std::error_code ec) {
-            if (ec) {
-              LOG_ERROR("Status send to main server failed: {}", ec.message());
-            }
-          });
-
-          // 发送到备份服务器（如果存在）
-          if (backup_report_session) {
-            backup_report_session->async_send_status(
-                status, [](std::error_code ec) {
-                  if (ec) {
-                    LOG_ERROR("Status send to backup server failed: {}",
-                              ec.message());
-                  }
-                });
-          }
+          report_fanout->async_send_status(
+              status, [](const std::string& destination, std::error_code ec) {
+                if (ec) {
+                  LOG_ERROR("Status send to {} failed: {}", destination,
+                            ec.message());
+                }
+              });
         }
         std::this_thread::sleep_for(std::chrono::seconds(1));
       }
@@ -203,6 +218,8 @@ int main() {
     if (cameras[0]) {
       cameras[0]->stop();
     }
+    // 停止检测后不再等待缺口，暂存的结果全部发出
+    feature_reorder->flush();
     main_guard.reset();
     backup_guard.reset();
     main_io_ctx.stop();
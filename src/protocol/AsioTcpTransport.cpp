@@ -27,10 +27,20 @@
 // Copyright (c) 2025 caomengxuan666
 #include "protocol/AsioTcpTransport.hpp"
 
+#include <algorithm>
+#include <deque>
 #include <memory>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
 #include "asio.hpp"
 
 namespace protocol {
@@ -48,11 +58,40 @@ void AsioTcpTransport::async_connect(
   asio::async_connect(socket_, endpoints,
                       [this, callback](const asio::error_code& ec,
                                        const asio::ip::tcp::endpoint&) {
+                        if (!ec) {
+                          on_connected();
+                        }
                         is_connected_ = !ec;
                         callback(ec);
                       });
 }
 
+asio::awaitable<std::error_code> AsioTcpTransport::co_connect(std::string ip,
+                                                              uint16_t port) {
+  std::error_code ec;
+  asio::ip::tcp::resolver resolver(io_ctx_);
+  auto endpoints = co_await resolver.async_resolve(
+      ip, std::to_string(port), asio::redirect_error(asio::use_awaitable, ec));
+  if (!ec) {
+    co_await asio::async_connect(socket_, endpoints,
+                                 asio::redirect_error(asio::use_awaitable, ec));
+  }
+  if (!ec) {
+    on_connected();
+  }
+  is_connected_ = !ec;
+  co_return ec;
+}
+
+void AsioTcpTransport::on_connected() {
+  // 重连时复用同一个对象，丢掉上一条连接的残留状态
+  reader_.reset();
+  corked_ = false;
+  // 发送队列自己合并报文，不需要 Nagle 再延迟
+  asio::error_code option_ec;
+  socket_.set_option(asio::ip::tcp::no_delay(true), option_ec);
+}
+
 void AsioTcpTransport::async_send(std::span<const uint8_t> data,
                                   SendCallback callback) {
   if (!is_connected_) {
@@ -60,13 +99,186 @@ void AsioTcpTransport::async_send(std::span<const uint8_t> data,
     return;
   }
 
-  auto buffer =
-      std::make_shared<std::vector<uint8_t>>(data.begin(), data.end());
-  asio::async_write(
-      socket_, asio::buffer(*buffer),
-      [callback, buffer](const asio::error_code& ec, std::size_t) {
-        callback(ec);
-      });  // 异步发送数据
+  // 调用方的数据在返回后可能失效，拷贝到复用的发送缓冲区
+  auto buffer = send_buffers_.acquire(data.size());
+  std::copy(data.begin(), data.end(), buffer->begin());
+  async_send_buffer(std::move(buffer), std::move(callback));
+}
+
+void AsioTcpTransport::async_send_buffer(SharedBuffer data,
+                                         SendCallback callback,
+                                         MessageClass message_class) {
+  if (!is_connected_) {
+    callback(asio::error::not_connected);
+    return;
+  }
+
+  // 队列持有缓冲区引用，写完后缓冲区归还所属的池
+  const size_t bytes = data->size();
+  enqueue({std::move(data), nullptr, std::move(callback), message_class,
+           bytes});
+}
+
+void AsioTcpTransport::async_send_gather(
+    std::shared_ptr<const GatherMessage> message, SendCallback callback,
+    MessageClass message_class) {
+  if (!is_connected_) {
+    callback(asio::error::not_connected);
+    return;
+  }
+
+  const size_t bytes = message->size();
+  enqueue({nullptr, std::move(message), std::move(callback), message_class,
+           bytes});
+}
+
+AsioTcpTransport::SendStats AsioTcpTransport::send_stats() const {
+  std::lock_guard lock(send_mutex_);
+  return send_stats_;
+}
+
+void AsioTcpTransport::enqueue(OutboundMessage message) {
+  {
+    std::lock_guard lock(send_mutex_);
+    send_queue_.push_back(std::move(message));
+    send_stats_.queue_depth++;
+    send_stats_.max_queue_depth =
+        std::max(send_stats_.max_queue_depth, send_stats_.queue_depth);
+    if (writing_) {
+      // 正在写的批次完成后会接着取走
+      return;
+    }
+    writing_ = true;
+  }
+  // 写操作都从 io 线程发起，与接收、close() 串行
+  asio::post(io_ctx_, [this]() { start_write(); });
+}
+
+void AsioTcpTransport::start_write() {
+  size_t batch_bytes = 0;
+  bool bulk = false;
+  {
+    std::lock_guard lock(send_mutex_);
+    // 按到达顺序取报文，小报文合并，大报文单独成批
+    while (!send_queue_.empty() && in_flight_.size() < kMaxBatchMessages) {
+      auto& next = send_queue_.front();
+      if (!in_flight_.empty() && batch_bytes + next.bytes > kMaxBatchBytes) {
+        break;
+      }
+      batch_bytes += next.bytes;
+      bulk = bulk || next.message_class == MessageClass::Bulk;
+      in_flight_.push_back(std::move(next));
+      send_queue_.pop_front();
+    }
+    if (in_flight_.empty()) {
+      writing_ = false;
+      return;
+    }
+  }
+
+  write_buffers_.clear();
+  for (const auto& message : in_flight_) {
+    if (message.buffer) {
+      write_buffers_.push_back(asio::buffer(*message.buffer));
+      continue;
+    }
+    for (size_t i = 0; i < message.gather->count; ++i) {
+      const auto& segment = message.gather->segments[i];
+      write_buffers_.push_back(asio::buffer(segment.data(), segment.size()));
+    }
+  }
+  write_index_ = 0;
+  batch_bytes_ = batch_bytes;
+  batch_syscalls_ = 0;
+
+  // 大块数据要分多次系统调用写出，cork 住避免每次末尾都发出一个小包
+  set_cork(bulk && batch_bytes > kMaxBatchBytes);
+  write_some();
+}
+
+void AsioTcpTransport::write_some() {
+  // span 只引用 write_buffers_，写操作里不拷贝缓冲区序列
+  const std::span<const asio::const_buffer> pending(
+      write_buffers_.data() + write_index_,
+      write_buffers_.size() - write_index_);
+  socket_.async_write_some(
+      pending, [this](const asio::error_code& ec, std::size_t bytes) {
+        ++batch_syscalls_;
+        if (ec) {
+          finish_write(ec);
+          return;
+        }
+
+        // 跳过已经写完的段，剩余部分接着写
+        while (write_index_ < write_buffers_.size() &&
+               bytes >= write_buffers_[write_index_].size()) {
+          bytes -= write_buffers_[write_index_].size();
+          ++write_index_;
+        }
+        if (write_index_ == write_buffers_.size()) {
+          finish_write({});
+          return;
+        }
+        write_buffers_[write_index_] += bytes;
+        write_some();
+      });
+}
+
+void AsioTcpTransport::finish_write(const std::error_code& ec) {
+  set_cork(false);  // 取消 cork 时内核立即推出尾部不满一段的数据
+
+  std::deque<OutboundMessage> failed;
+  {
+    std::lock_guard lock(send_mutex_);
+    send_stats_.messages += in_flight_.size();
+    send_stats_.batches++;
+    send_stats_.syscalls += batch_syscalls_;
+    send_stats_.bytes += ec ? 0 : batch_bytes_;
+    send_stats_.queue_depth -= in_flight_.size();
+    if (ec) {
+      // 连接已经出错，排队的报文也不会再写出
+      failed.swap(send_queue_);
+      send_stats_.queue_depth -= failed.size();
+    }
+  }
+
+  // 回调期间 writing_ 仍为 true，新报文只排队，不会另起一个写批次
+  for (auto& message : in_flight_) {
+    if (message.callback) {
+      message.callback(ec);
+    }
+  }
+  in_flight_.clear();
+  for (auto& message : failed) {
+    if (message.callback) {
+      message.callback(ec);
+    }
+  }
+
+  {
+    std::lock_guard lock(send_mutex_);
+    if (send_queue_.empty()) {
+      writing_ = false;
+      return;
+    }
+  }
+  start_write();
+}
+
+void AsioTcpTransport::set_cork(bool enabled) {
+#ifdef __linux__
+  if (corked_ == enabled || !socket_.is_open()) {
+    return;
+  }
+  const int value = enabled ? 1 : 0;
+  if (::setsockopt(socket_.native_handle(), IPPROTO_TCP, TCP_CORK, &value,
+                   sizeof(value)) == 0) {
+    corked_ = enabled;
+  }
+#else
+  // 没有 TCP_CORK 的平台只依靠合并写
+  (void)enabled;
+#endif
 }
 
 void AsioTcpTransport::async_receive(ReceiveCallback callback) {
@@ -74,32 +286,16 @@ void AsioTcpTransport::async_receive(ReceiveCallback callback) {
     callback(asio::error::not_connected, {});
     return;
   }
+  receive_one(std::move(callback), true);
+}
 
-  if (state_ == ReceiveState::WaitingForStartSignal) {
-    // 第一次：接收开始信号 (1字节)
-    async_read_exact(1,
-                     [this, callback](const asio::error_code& ec, auto data) {
-                       if (ec) {
-                         callback(ec, {});
-                         return;
-                       }
-
-                       char start_signal = data[0];
-                       if (start_signal == 'F') {
-                         state_ = ReceiveState::ReceivingFeatureData;
-                         receive_feature_data(callback);
-                       } else if (start_signal == 'T') {
-                         state_ = ReceiveState::ReceivingStatusData;
-                         receive_status_data(callback);
-                       } else {
-                         callback(asio::error::invalid_argument, {});
-                       }
-                     });
-  } else if (state_ == ReceiveState::ReceivingFeatureData) {
-    receive_feature_data(callback);
-  } else if (state_ == ReceiveState::ReceivingStatusData) {
-    receive_status_data(callback);
+void AsioTcpTransport::async_receive_frames(FrameCallback callback) {
+  if (!is_connected_) {
+    callback(asio::error::not_connected, {});
+    return;
   }
+  frame_callback_ = std::move(callback);
+  dispatch_frames();
 }
 
 void AsioTcpTransport::close() {
@@ -113,75 +309,99 @@ void AsioTcpTransport::close() {
   }
 }
 
-void AsioTcpTransport::async_read_exact(
-    size_t size,
-    std::function<void(std::error_code, std::span<const uint8_t>)> handler) {
-  if (!is_connected_) {
-    handler(asio::error::not_connected, {});
+void AsioTcpTransport::dispatch_frames() {
+  // 一次读到的报文全部交出后才发起下一次读
+  std::span<const uint8_t> frame;
+  FrameReader::Status status;
+  while ((status = reader_.next(frame)) == FrameReader::Status::Complete) {
+    frame_callback_({}, frame);
+  }
+  if (status == FrameReader::Status::Invalid) {
+    // 数据流已经错位，丢弃缓冲的数据后停止接收
+    reader_.reset();
+    auto callback = std::move(frame_callback_);
+    callback(asio::error::invalid_argument, {});
     return;
   }
 
-  auto buffer = std::make_shared<std::vector<uint8_t>>(size);
-  asio::async_read(
-      socket_, asio::buffer(*buffer),
-      [handler, buffer](const asio::error_code& ec, std::size_t) {
+  auto space = reader_.prepare();
+  socket_.async_read_some(
+      asio::buffer(space.data(), space.size()),
+      [this](const asio::error_code& ec, std::size_t bytes) {
         if (ec) {
-          handler(ec, {});
-        } else {
-          handler(ec, std::span<const uint8_t>(buffer->data(), buffer->size()));
+          auto callback = std::move(frame_callback_);
+          callback(ec, {});
+          return;
         }
+        reader_.commit(bytes);
+        dispatch_frames();
       });
 }
 
-void AsioTcpTransport::receive_feature_data(ReceiveCallback callback) {
-  async_read_exact(
-      72 + 4, [this, callback](const asio::error_code& ec, auto header) {
+void AsioTcpTransport::receive_one(ReceiveCallback callback, bool deferred) {
+  std::span<const uint8_t> frame;
+  switch (reader_.next(frame)) {
+    case FrameReader::Status::Complete: {
+      std::vector<uint8_t> data(frame.begin(), frame.end());
+      if (deferred) {
+        // 之前一次读到的报文放到下一轮事件循环交出，回调里接着接收时不递归
+        asio::post(io_ctx_, [callback = std::move(callback),
+                             data = std::move(data)]() mutable {
+          callback({}, std::move(data));
+        });
+      } else {
+        callback({}, std::move(data));
+      }
+      return;
+    }
+    case FrameReader::Status::Invalid:
+      reader_.reset();
+      callback(asio::error::invalid_argument, {});
+      return;
+    case FrameReader::Status::NeedMore:
+      break;
+  }
+
+  auto space = reader_.prepare();
+  socket_.async_read_some(
+      asio::buffer(space.data(), space.size()),
+      [this, callback = std::move(callback)](const asio::error_code& ec,
+                                             std::size_t bytes) mutable {
         if (ec) {
           callback(ec, {});
           return;
         }
-
-        int32_t num_features;
-        std::memcpy(&num_features, header.data() + 72, 4);
-
-        size_t remaining = 20 * 4 + num_features * 8 + 4;
-        async_read_exact(remaining, [this, callback, num_features](
-                                        const asio::error_code& ec, auto body) {
-          if (ec) {
-            callback(ec, {});
-            return;
-          }
-
-          int32_t img_len;
-          std::memcpy(&img_len, body.data() + 20 * 4 + num_features * 8, 4);
-
-          async_read_exact(img_len, [callback, body](const asio::error_code& ec,
-                                                     auto img_data) {
-            if (ec) {
-              callback(ec, {});
-              return;
-            }
-            std::vector<uint8_t> full_data(1 + 72 + 4 + body.size() +
-                                           img_data.size());
-            full_data[0] = 'F';
-            // 实际应该拼接所有数据
-            callback({}, full_data);
-          });
-        });
+        reader_.commit(bytes);
+        receive_one(std::move(callback), false);
       });
 }
 
-void AsioTcpTransport::receive_status_data(ReceiveCallback callback) {
-  async_read_exact(4, [callback](const asio::error_code& ec, auto status_data) {
+asio::awaitable<std::error_code> AsioTcpTransport::co_receive_frame(
+    std::span<const uint8_t>& frame, std::vector<uint8_t>& /*storage*/) {
+  if (!is_connected_) {
+    co_return asio::error::not_connected;
+  }
+  for (;;) {
+    switch (reader_.next(frame)) {
+      case FrameReader::Status::Complete:
+        co_return std::error_code{};
+      case FrameReader::Status::Invalid:
+        reader_.reset();
+        co_return asio::error::invalid_argument;
+      case FrameReader::Status::NeedMore:
+        break;
+    }
+
+    std::error_code ec;
+    auto space = reader_.prepare();
+    const size_t bytes = co_await socket_.async_read_some(
+        asio::buffer(space.data(), space.size()),
+        asio::redirect_error(asio::use_awaitable, ec));
     if (ec) {
-      callback(ec, {});
-      return;
+      co_return ec;
     }
-    std::vector<uint8_t> full_data(5);
-    full_data[0] = 'T';
-    std::memcpy(full_data.data() + 1, status_data.data(), 4);
-    callback({}, full_data);
-  });
+    reader_.commit(bytes);
+  }
 }
 
 }  // namespace protocol
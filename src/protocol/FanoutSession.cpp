@@ -0,0 +1,279 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FanoutSession.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "protocol/FanoutSession.hpp"
+//
+#include <algorithm>
+#include <utility>
+
+#include "protocol/Awaitable.hpp"
+
+namespace protocol {
+
+FanoutSession::FanoutSession(std::unique_ptr<ICodec> codec,
+                             const FanoutConfig& config)
+    : codec_(std::move(codec)), config_(config) {
+  config_.max_in_flight = std::max<size_t>(config_.max_in_flight, 1);
+  config_.max_queued_messages =
+      std::max<size_t>(config_.max_queued_messages, 1);
+}
+
+FanoutSession::~FanoutSession() {
+  close();
+  // 传输层析构时可能回调在途的报文，先于目的地的其余成员释放
+  for (auto& destination : destinations_) {
+    destination->transport.reset();
+  }
+}
+
+size_t FanoutSession::add_destination(
+    const std::string& name, std::unique_ptr<ITransportAdapter> transport) {
+  auto destination = std::make_unique<Destination>();
+  destination->name = name;
+  destination->stats.name = name;
+  destination->transport = std::move(transport);
+  destinations_.push_back(std::move(destination));
+  return destinations_.size() - 1;
+}
+
+void FanoutSession::async_connect(
+    size_t destination, const std::string& ip, uint16_t port,
+    std::function<void(std::error_code)> callback) {
+  destinations_.at(destination)
+      ->transport->async_connect(ip, port, std::move(callback));
+}
+
+asio::awaitable<std::error_code> FanoutSession::co_connect(size_t destination,
+                                                           std::string ip,
+                                                           uint16_t port) {
+  co_return co_await destinations_.at(destination)->transport->co_connect(
+      std::move(ip), port);
+}
+
+void FanoutSession::async_send_features(const FeatureReport& report,
+                                        SendCallback callback) {
+  if (report.image) {
+    // 只拷贝特征列表等小字段，图片仍引用原来的缓冲区
+    async_send_features(std::make_shared<const FeatureReport>(report),
+                        std::move(callback));
+    return;
+  }
+  auto buffer = send_buffers_.acquire(codec_->encoded_features_size(report));
+  codec_->encode_features_to(report, *buffer);
+  const size_t bytes = buffer->size();
+  fan_out({std::move(buffer), nullptr, MessageClass::Bulk, bytes,
+           std::move(callback)});
+}
+
+void FanoutSession::async_send_features(
+    std::shared_ptr<const FeatureReport> report, SendCallback callback) {
+  auto message = std::make_shared<GatherMessage>();
+  message->count = codec_->encode_features_gather(*report, message->scratch,
+                                                  message->segments);
+  if (message->count == 0) {
+    // 编解码器不支持分段编码
+    auto buffer =
+        send_buffers_.acquire(codec_->encoded_features_size(*report));
+    codec_->encode_features_to(*report, *buffer);
+    const size_t bytes = buffer->size();
+    fan_out({std::move(buffer), nullptr, MessageClass::Bulk, bytes,
+             std::move(callback)});
+    return;
+  }
+  message->keepalive = std::move(report);
+  const size_t bytes = message->size();
+  fan_out({nullptr, std::move(message), MessageClass::Bulk, bytes,
+           std::move(callback)});
+}
+
+void FanoutSession::async_send_status(const FrontendStatus& status,
+                                      SendCallback callback) {
+  auto buffer = send_buffers_.acquire(codec_->encoded_status_size(status));
+  codec_->encode_status_to(status, *buffer);
+  const size_t bytes = buffer->size();
+  fan_out({std::move(buffer), nullptr, MessageClass::Control, bytes,
+           std::move(callback)});
+}
+
+void FanoutSession::async_send_telemetry(const TelemetryData& telemetry,
+                                         SendCallback callback) {
+  // 与 ProtocolSession 相同，19700 遥测借用 ServerConfig 编码
+  ServerConfig config;
+  config.roll_id = telemetry.roll_id;
+  config.head_length = telemetry.length;
+
+  auto buffer = send_buffers_.acquire(codec_->encoded_config_size(config));
+  codec_->encode_config_to(config, *buffer);
+  const size_t bytes = buffer->size();
+  fan_out({std::move(buffer), nullptr, MessageClass::Control, bytes,
+           std::move(callback)});
+}
+
+void FanoutSession::fan_out(Queued message) {
+  for (auto& destination : destinations_) {
+    std::vector<SendCallback> dropped;
+    bool closed = false;
+    {
+      std::lock_guard lock(destination->mutex);
+      closed = destination->closed;
+      if (!closed) {
+        // 只丢本目的地最旧的报文，其他目的地不受影响
+        while (!destination->queue.empty() &&
+               (destination->queue.size() >= config_.max_queued_messages ||
+                destination->queued_bytes + message.bytes >
+                    config_.max_queued_bytes)) {
+          auto& oldest = destination->queue.front();
+          destination->queued_bytes -= oldest.bytes;
+          dropped.push_back(std::move(oldest.callback));
+          destination->queue.pop_front();
+          ++destination->stats.dropped;
+        }
+        // 共享编码结果，每个目的地只多一份引用
+        destination->queue.push_back(message);
+        destination->queued_bytes += message.bytes;
+        destination->stats.peak_queued = std::max(
+            destination->stats.peak_queued, destination->queue.size());
+      }
+    }
+    if (closed) {
+      if (message.callback) {
+        message.callback(destination->name,
+                         std::make_error_code(std::errc::not_connected));
+      }
+      continue;
+    }
+    for (auto& callback : dropped) {
+      if (callback) {
+        callback(destination->name,
+                 std::make_error_code(std::errc::no_buffer_space));
+      }
+    }
+    pump(*destination);
+  }
+}
+
+void FanoutSession::pump(Destination& destination) {
+  std::unique_lock lock(destination.mutex);
+  if (destination.pumping) {
+    // 正在交付的线程会继续取队列，这里不插队
+    return;
+  }
+  destination.pumping = true;
+  while (!destination.closed && !destination.queue.empty() &&
+         destination.in_flight < config_.max_in_flight) {
+    Queued queued = std::move(destination.queue.front());
+    destination.queue.pop_front();
+    destination.queued_bytes -= queued.bytes;
+    ++destination.in_flight;
+    lock.unlock();
+
+    // 传输层可能同步回调（如断线时），回调里再次 pump 会直接返回
+    auto released = std::make_shared<bool>(false);
+    auto on_complete = [this, &destination, released,
+                        callback = std::move(queued.callback)](
+                           std::error_code ec) mutable {
+      on_sent(destination, released, std::move(callback), ec);
+    };
+    auto on_buffered = [this, &destination, released]() {
+      {
+        std::lock_guard lock(destination.mutex);
+        if (release(destination, *released)) {
+          ++destination.stats.buffered;
+        }
+      }
+      pump(destination);
+    };
+    destination.transport->async_send_tracked(
+        std::move(queued.buffer), std::move(queued.gather),
+        std::move(on_complete), std::move(on_buffered),
+        queued.message_class);
+    lock.lock();
+  }
+  destination.pumping = false;
+}
+
+bool FanoutSession::release(Destination& destination, bool& released) {
+  if (released) {
+    return false;
+  }
+  released = true;
+  --destination.in_flight;
+  return true;
+}
+
+void FanoutSession::on_sent(Destination& destination,
+                            const std::shared_ptr<bool>& released,
+                            SendCallback callback, std::error_code ec) {
+  {
+    std::lock_guard lock(destination.mutex);
+    release(destination, *released);
+    if (ec) {
+      ++destination.stats.failed;
+    } else {
+      ++destination.stats.sent;
+    }
+  }
+  if (callback) {
+    callback(destination.name, ec);
+  }
+  pump(destination);
+}
+
+void FanoutSession::close() {
+  for (auto& destination : destinations_) {
+    std::deque<Queued> aborted;
+    {
+      std::lock_guard lock(destination->mutex);
+      if (destination->closed) {
+        continue;
+      }
+      destination->closed = true;
+      aborted.swap(destination->queue);
+      destination->queued_bytes = 0;
+    }
+    for (auto& queued : aborted) {
+      if (queued.callback) {
+        queued.callback(destination->name,
+                        std::make_error_code(std::errc::operation_canceled));
+      }
+    }
+    if (destination->transport) {
+      destination->transport->close();
+    }
+  }
+}
+
+FanoutSession::DestinationStats FanoutSession::stats(
+    size_t destination) const {
+  const auto& target = *destinations_.at(destination);
+  std::lock_guard lock(target.mutex);
+  DestinationStats stats = target.stats;
+  stats.queued = target.queue.size();
+  stats.in_flight = target.in_flight;
+  return stats;
+}
+
+}  // namespace protocol
@@ -0,0 +1,148 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameReader.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "protocol/FrameReader.hpp"
+//
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace protocol {
+
+namespace {
+
+// 'F' + 卷号(72) + 特征个数(4) + 20个特殊图片(80) + 特征(n*8) + 图片长度(4)
+// + 图片；'T' + 状态(4)
+constexpr size_t kFeatureCountOffset = 1 + 72;
+constexpr size_t kFeaturesOffset = kFeatureCountOffset + 4 + 20 * 4;
+constexpr size_t kStatusFrameBytes = 1 + 4;
+
+int32_t read_int32(std::span<const uint8_t> data, size_t offset) {
+  int32_t value;
+  std::memcpy(&value, data.data() + offset, sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+FrameReader::FrameReader(size_t initial_capacity, size_t max_frame_bytes)
+    : capacity_(std::max(initial_capacity, kMinRead)),
+      max_frame_bytes_(max_frame_bytes) {
+  buffer_.reset(new uint8_t[capacity_]);
+}
+
+std::span<uint8_t> FrameReader::prepare() {
+  // 至少要能放下开头这条报文缺的部分，空间允许时多读一些
+  const size_t required =
+      pending_frame_ > buffered() ? pending_frame_ - buffered() : 1;
+  reserve(required, std::max(required, kMinRead));
+  return {buffer_.get() + end_, capacity_ - end_};
+}
+
+void FrameReader::commit(size_t bytes) {
+  end_ = std::min(end_ + bytes, capacity_);
+}
+
+FrameReader::Status FrameReader::next(std::span<const uint8_t>& frame) {
+  frame = {};
+  const std::span<const uint8_t> data(buffer_.get() + begin_, buffered());
+  const size_t bytes = frame_size(data);
+  if (bytes == kInvalidFrame || bytes > max_frame_bytes_) {
+    return Status::Invalid;
+  }
+  if (data.size() < bytes) {
+    pending_frame_ = bytes;
+    return Status::NeedMore;
+  }
+
+  frame = data.first(bytes);
+  begin_ += bytes;
+  pending_frame_ = 0;
+  return Status::Complete;
+}
+
+void FrameReader::reset() {
+  begin_ = 0;
+  end_ = 0;
+  pending_frame_ = 0;
+}
+
+size_t FrameReader::frame_size(std::span<const uint8_t> data) {
+  if (data.empty()) {
+    return 1;
+  }
+  if (data[0] == 'T') {
+    return kStatusFrameBytes;
+  }
+  if (data[0] != 'F') {
+    return kInvalidFrame;
+  }
+
+  if (data.size() < kFeatureCountOffset + 4) {
+    return kFeatureCountOffset + 4;
+  }
+  const int32_t features = read_int32(data, kFeatureCountOffset);
+  if (features < 0) {
+    return kInvalidFrame;
+  }
+
+  const size_t image_length_offset =
+      kFeaturesOffset + static_cast<size_t>(features) * 8;
+  if (data.size() < image_length_offset + 4) {
+    return image_length_offset + 4;
+  }
+  const int32_t image_bytes = read_int32(data, image_length_offset);
+  if (image_bytes < 0) {
+    return kInvalidFrame;
+  }
+  return image_length_offset + 4 + static_cast<size_t>(image_bytes);
+}
+
+void FrameReader::reserve(size_t required, size_t preferred) {
+  if (begin_ == end_) {
+    begin_ = 0;
+    end_ = 0;
+  }
+  if (capacity_ - end_ >= preferred) {
+    return;
+  }
+
+  // 先把未交出的数据移到开头，仍然放不下才扩容
+  const size_t live = buffered();
+  if (capacity_ - live >= required) {
+    std::memmove(buffer_.get(), buffer_.get() + begin_, live);
+  } else {
+    const size_t capacity = std::max(capacity_ * 2, live + preferred);
+    std::unique_ptr<uint8_t[]> grown(new uint8_t[capacity]);
+    std::memcpy(grown.get(), buffer_.get() + begin_, live);
+    buffer_ = std::move(grown);
+    capacity_ = capacity;
+  }
+  begin_ = 0;
+  end_ = live;
+}
+
+}  // namespace protocol
@@ -29,7 +29,11 @@
 
 #include <winsock2.h>
 
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #pragma comment(lib, "ws2_32.lib")
@@ -45,97 +49,138 @@ inline uint8_t* float_to_big_endian(float f, uint8_t* buf) noexcept {
   return buf;
 }
 
-std::vector<uint8_t> LegacyCodec::encode_config(const ServerConfig& config) {
-  std::vector<uint8_t> buffer;
-  buffer.reserve(72 + 20 + 5 + 5 + 5 + 4 + 4 + 80 + 4 + 64 + 4 + 64 + 4);
+namespace {
+
+// 只统计编码后的字节数
+class SizeCounter {
+ public:
+  void byte(uint8_t) noexcept { ++size_; }
+  void bytes(const void*, size_t n) noexcept { size_ += n; }
+  void padded(const std::string&, size_t width) noexcept { size_ += width; }
+  size_t size() const noexcept { return size_; }
+
+ private:
+  size_t size_ = 0;
+};
+
+// 顺序写入已按 SizeCounter 确认过长度的缓冲区
+class ByteWriter {
+ public:
+  explicit ByteWriter(uint8_t* out) noexcept : out_(out) {}
+
+  void byte(uint8_t b) noexcept { out_[size_++] = b; }
+  void bytes(const void* data, size_t n) noexcept {
+    if (n > 0) {
+      std::memcpy(out_ + size_, data, n);
+    }
+    size_ += n;
+  }
+  // 定长字符串字段：超长截断，不足补空格
+  void padded(const std::string& s, size_t width) noexcept {
+    const size_t n = std::min(s.size(), width);
+    std::memcpy(out_ + size_, s.data(), n);
+    std::memset(out_ + size_ + n, ' ', width - n);
+    size_ += width;
+  }
+  size_t size() const noexcept { return size_; }
+
+ private:
+  uint8_t* out_;
+  size_t size_ = 0;
+};
+
+// 按本机字节序写入定长字段，与老协议一致
+template <typename Sink, typename T>
+void put(Sink& sink, const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  sink.bytes(&value, sizeof(T));
+}
 
-  // 开始信号 'O'
-  buffer.push_back('O');
+template <typename Sink>
+void write_config(Sink& sink, const ServerConfig& config) {
+  sink.byte('O');                        // 开始信号 'O'
+  sink.padded(config.roll_id, 72);       // 卷号 (72字节)
+  sink.padded(config.brand, 20);         // 牌号 (20字节)
+  sink.padded(config.thickness_str, 5);  // 厚度 (5字节字符串)
+  // 最小缺陷长度、最小缺陷面积 (各5字节)
+  sink.padded(config.min_defect_length_str, 5);
+  sink.padded(config.min_defect_area_str, 5);
+  put(sink, config.head_length);  // 料头长度 (4字节 float)
+
+  // 可选字段（按协议顺序），前一个字段缺失时后面的都不发送
+  if (!config.material_type) return;
+  put(sink, *config.material_type);
+  if (!config.segmentation_params) return;
+  put(sink, *config.segmentation_params);  // 80字节
+  if (!config.upper_surface_id) return;
+  put(sink, *config.upper_surface_id);
+  if (!config.upper_large_params) return;
+  put(sink, *config.upper_large_params);  // 64字节
+  if (!config.lower_surface_id) return;
+  put(sink, *config.lower_surface_id);
+  if (!config.lower_large_params) return;
+  put(sink, *config.lower_large_params);  // 64字节
+  if (!config.cutting_count) return;
+  put(sink, *config.cutting_count);
+}
 
-  // 卷号 (72字节)
-  std::string padded_roll = config.roll_id;
-  padded_roll.resize(72, ' ');
-  buffer.insert(buffer.end(), padded_roll.begin(), padded_roll.end());
+// pair<int32_t, float> 在所有目标平台上都是紧凑的 8 字节（索引在前），
+// 与线上每个特征的布局一致，特征列表整体拷贝
+static_assert(sizeof(std::pair<int32_t, float>) == 8);
+
+template <typename Sink>
+void write_features(Sink& sink, const FeatureReport& report) {
+  sink.byte('F');                   // 'F' 开始信号
+  sink.padded(report.roll_id, 72);  // 卷号 (72字节)
+  put(sink, static_cast<int32_t>(report.features.size()));  // 特征个数
+  put(sink, report.special_images);  // 20个特殊图片 (20 * 4字节)
+  sink.bytes(report.features.data(), report.features.size() * 8);
+  // 图片长度 + 数据
+  const auto image = report.image_bytes();
+  put(sink, static_cast<int32_t>(image.size()));
+  sink.bytes(image.data(), image.size());
+}
 
-  // 牌号 (20字节)
-  std::string padded_brand = config.brand;
-  padded_brand.resize(20, ' ');
-  buffer.insert(buffer.end(), padded_brand.begin(), padded_brand.end());
+template <typename Sink>
+void write_status(Sink& sink, const FrontendStatus& status) {
+  sink.byte('T');
+  put(sink, static_cast<uint32_t>(::htonl(status.to_uint32())));
+}
 
-  // 厚度 (5字节字符串)
-  std::string thickness_str = config.thickness_str;
-  thickness_str.resize(5, ' ');
-  buffer.insert(buffer.end(), thickness_str.begin(), thickness_str.end());
+// 先确认长度再写入，out 不够大时什么也不写
+template <typename Message, typename WriteFunc>
+size_t encode_into(const Message& message, std::span<uint8_t> out,
+                   WriteFunc write) {
+  SizeCounter counter;
+  write(counter, message);
+  if (counter.size() > out.size()) {
+    return 0;
+  }
+  ByteWriter writer(out.data());
+  write(writer, message);
+  return writer.size();
+}
 
-  // 最小缺陷长度 (5字节)
-  std::string min_len_str = config.min_defect_length_str;
-  min_len_str.resize(5, ' ');
-  buffer.insert(buffer.end(), min_len_str.begin(), min_len_str.end());
+}  // namespace
 
-  // 最小缺陷面积 (5字节)
-  std::string min_area_str = config.min_defect_area_str;
-  min_area_str.resize(5, ' ');
-  buffer.insert(buffer.end(), min_area_str.begin(), min_area_str.end());
-  // NOLINTBEGIN
-  //  料头长度 (4字节 float)
-  float head_length = config.head_length;
-  buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&head_length),
-                reinterpret_cast<uint8_t*>(&head_length) + 4);
-
-  // 可选字段（按协议顺序）
-  if (config.material_type) {
-    int32_t mat_type = *config.material_type;
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&mat_type),
-                  reinterpret_cast<uint8_t*>(&mat_type) + 4);
-
-    if (config.segmentation_params) {
-      buffer.insert(
-          buffer.end(),
-          reinterpret_cast<const uint8_t*>(config.segmentation_params->data()),
-          reinterpret_cast<const uint8_t*>(config.segmentation_params->data()) +
-              80);
-
-      if (config.upper_surface_id) {
-        int32_t id = *config.upper_surface_id;
-        buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&id),
-                      reinterpret_cast<uint8_t*>(&id) + 4);
-
-        if (config.upper_large_params) {
-          buffer.insert(buffer.end(),
-                        reinterpret_cast<const uint8_t*>(
-                            config.upper_large_params->data()),
-                        reinterpret_cast<const uint8_t*>(
-                            config.upper_large_params->data()) +
-                            64);
-
-          if (config.lower_surface_id) {
-            int32_t id2 = *config.lower_surface_id;
-            buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&id2),
-                          reinterpret_cast<uint8_t*>(&id2) + 4);
-
-            if (config.lower_large_params) {
-              buffer.insert(buffer.end(),
-                            reinterpret_cast<const uint8_t*>(
-                                config.lower_large_params->data()),
-                            reinterpret_cast<const uint8_t*>(
-                                config.lower_large_params->data()) +
-                                64);
-
-              if (config.cutting_count) {
-                int32_t cnt = *config.cutting_count;
-                buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&cnt),
-                              reinterpret_cast<uint8_t*>(&cnt) + 4);
-              }
-            }
-          }
-        }
-      }
-    }
-  }
-  // NOLINTEND
+std::vector<uint8_t> LegacyCodec::encode_config(const ServerConfig& config) {
+  std::vector<uint8_t> buffer(encoded_config_size(config));
+  encode_config_to(config, buffer);
   return buffer;
 }
 
+size_t LegacyCodec::encoded_config_size(const ServerConfig& config) {
+  SizeCounter counter;
+  write_config(counter, config);
+  return counter.size();
+}
+
+size_t LegacyCodec::encode_config_to(const ServerConfig& config,
+                                     std::span<uint8_t> out) {
+  return encode_into(config, out,
+                     [](auto& sink, const auto& c) { write_config(sink, c); });
+}
+
 std::optional<ServerConfig> LegacyCodec::decode_config(
     std::span<const uint8_t> data) {
   if (data.empty() || data[0] != 'O') {
@@ -256,46 +301,56 @@ void LegacyCodec::parse_optional_fields(std::span<const uint8_t> data,
 }
 
 std::vector<uint8_t> LegacyCodec::encode_features(const FeatureReport& report) {
-  std::vector<uint8_t> buffer;
-  buffer.reserve(1 + 72 + 4 + 20 * 4 + report.features.size() * 8 + 4 +
-                 report.image_data.size());
+  std::vector<uint8_t> buffer(encoded_features_size(report));
+  encode_features_to(report, buffer);
+  return buffer;
+}
 
-  // 'F' 开始信号
-  buffer.push_back('F');
+size_t LegacyCodec::encoded_features_size(const FeatureReport& report) {
+  SizeCounter counter;
+  write_features(counter, report);
+  return counter.size();
+}
 
-  // 卷号 (72字节)
-  std::string padded_roll = report.roll_id;
-  padded_roll.resize(72, ' ');
-  buffer.insert(buffer.end(), padded_roll.begin(), padded_roll.end());
+size_t LegacyCodec::encode_features_to(const FeatureReport& report,
+                                       std::span<uint8_t> out) {
+  return encode_into(report, out, [](auto& sink, const auto& r) {
+    write_features(sink, r);
+  });
+}
 
-  // 特征个数 (4字节)
-  // NOLINTBEGIN
-  int32_t num_features = static_cast<int32_t>(report.features.size());
-  buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&num_features),
-                reinterpret_cast<uint8_t*>(&num_features) + 4);
-
-  // 20个特殊图片 (20 * 4字节)
-  for (float f : report.special_images) {
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&f),
-                  reinterpret_cast<uint8_t*>(&f) + 4);
+size_t LegacyCodec::encode_features_gather(
+    const FeatureReport& report, std::span<uint8_t> scratch,
+    std::span<std::span<const uint8_t>> segments) {
+  // 报文头：'F' + 卷号 + 特征个数 + 20个特殊图片；图片长度单独一段
+  constexpr size_t kHeaderBytes = 1 + 72 + 4 + 80;
+  constexpr size_t kImageLengthBytes = 4;
+  if (scratch.size() < kHeaderBytes + kImageLengthBytes ||
+      segments.size() < 4) {
+    return 0;
   }
 
-  // 特征列表
-  for (const auto& feat : report.features) {
-    buffer.insert(buffer.end(), reinterpret_cast<const uint8_t*>(&feat.first),
-                  reinterpret_cast<const uint8_t*>(&feat.first) + 4);
-    buffer.insert(buffer.end(), reinterpret_cast<const uint8_t*>(&feat.second),
-                  reinterpret_cast<const uint8_t*>(&feat.second) + 4);
+  ByteWriter writer(scratch.data());
+  writer.byte('F');
+  writer.padded(report.roll_id, 72);
+  put(writer, static_cast<int32_t>(report.features.size()));
+  put(writer, report.special_images);
+  const auto image = report.image_bytes();
+  put(writer, static_cast<int32_t>(image.size()));
+
+  using Segment = std::span<const uint8_t>;
+  const Segment header = scratch.first(kHeaderBytes);
+  const Segment features(
+      reinterpret_cast<const uint8_t*>(report.features.data()),  // NOLINT
+      report.features.size() * 8);
+  const Segment image_length = scratch.subspan(kHeaderBytes, kImageLengthBytes);
+  size_t count = 0;
+  for (const Segment& segment : {header, features, image_length, image}) {
+    if (!segment.empty()) {
+      segments[count++] = segment;
+    }
   }
-
-  // 图片长度 + 数据
-  int32_t img_len = static_cast<int32_t>(report.image_data.size());
-  buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&img_len),
-                reinterpret_cast<uint8_t*>(&img_len) + 4);
-  buffer.insert(buffer.end(), report.image_data.begin(),
-                report.image_data.end());
-  // NOLINTEND
-  return buffer;
+  return count;
 }
 
 std::optional<FeatureReport> LegacyCodec::decode_features(
@@ -351,17 +406,22 @@ std::optional<FeatureReport> LegacyCodec::decode_features(
 }
 
 std::vector<uint8_t> LegacyCodec::encode_status(const FrontendStatus& status) {
-  std::vector<uint8_t> buffer;
-  // 提前预留5字节（1个'T' + 4字节uint32），避免内存重分配
-  buffer.reserve(5);
-  buffer.push_back('T');
+  std::vector<uint8_t> buffer(encoded_status_size(status));
+  encode_status_to(status, buffer);
+  return buffer;
+}
 
-  uint32_t status_big_endian = ::htonl(status.to_uint32());
+size_t LegacyCodec::encoded_status_size(const FrontendStatus& status) {
+  SizeCounter counter;
+  write_status(counter, status);
+  return counter.size();
+}
 
-  buffer.insert(buffer.end(),
-                reinterpret_cast<uint8_t*>(&status_big_endian),       // NOLINT
-                reinterpret_cast<uint8_t*>(&status_big_endian) + 4);  // NOLINT
-  return buffer;
+size_t LegacyCodec::encode_status_to(const FrontendStatus& status,
+                                     std::span<uint8_t> out) {
+  return encode_into(status, out, [](auto& sink, const auto& st) {
+    write_status(sink, st);
+  });
 }
 
 std::optional<FrontendStatus> LegacyCodec::decode_status(
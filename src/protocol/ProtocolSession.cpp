@@ -27,10 +27,16 @@
 // Copyright (c) 2025 caomengxuan666
 #include "protocol/ProtocolSession.hpp"
 
+#include <array>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <system_error>
 #include <utility>
+#include <vector>
+
+#include "protocol/Awaitable.hpp"
 
 namespace protocol {
 
@@ -45,13 +51,44 @@ ProtocolSession::ProtocolSession(
 void ProtocolSession::async_connect(
     const std::string& ip, uint16_t port,
     std::function<void(std::error_code)> callback) {
-  config_transport_->async_connect(
-      ip, port, [this, callback](std::error_code ec) {
-        if (ec) {
-          std::cerr << "Connect failed: " << ec.message() << std::endl;
-        }
-        callback(ec);
-      });
+  // 上报会话和遥测会话各只有一条传输层，连上已有的全部后回调一次
+  std::vector<ITransportAdapter*> transports;
+  for (auto* transport : {config_transport_.get(), report_transport_.get()}) {
+    if (transport) {
+      transports.push_back(transport);
+    }
+  }
+  if (transports.empty()) {
+    callback(std::make_error_code(std::errc::not_connected));
+    return;
+  }
+  struct State {
+    std::mutex mutex;
+    size_t remaining;
+    std::error_code first_error;
+  };
+  auto state = std::make_shared<State>();
+  state->remaining = transports.size();
+  for (auto* transport : transports) {
+    transport->async_connect(
+        ip, port, [state, callback](std::error_code ec) {
+          if (ec) {
+            std::cerr << "Connect failed: " << ec.message() << std::endl;
+          }
+          std::error_code result;
+          {
+            std::lock_guard lock(state->mutex);
+            if (ec && !state->first_error) {
+              state->first_error = ec;
+            }
+            if (--state->remaining > 0) {
+              return;
+            }
+            result = state->first_error;
+          }
+          callback(result);
+        });
+  }
 }
 
 void ProtocolSession::async_receive_features(FeaturesCallback callback) {
@@ -90,14 +127,56 @@ void ProtocolSession::async_receive_status(StatusCallback callback) {
 
 void ProtocolSession::async_send_features(const FeatureReport& report,
                                           SendCallback callback) {
-  auto data = codec_->encode_features(report);
-  report_transport_->async_send(data, callback);
+  if (report.image) {
+    // 只拷贝特征列表等小字段，图片仍引用原来的缓冲区
+    async_send_features(std::make_shared<const FeatureReport>(report),
+                        std::move(callback));
+    return;
+  }
+  auto buffer = send_buffers_.acquire(codec_->encoded_features_size(report));
+  codec_->encode_features_to(report, *buffer);
+  report_transport_->async_send_buffer(std::move(buffer), std::move(callback));
+}
+
+void ProtocolSession::async_send_features(
+    std::shared_ptr<const FeatureReport> report, SendCallback callback) {
+  ITransportAdapter::SharedBuffer buffer;
+  std::shared_ptr<const GatherMessage> gather;
+  encode_features(std::move(report), buffer, gather);
+  if (gather) {
+    report_transport_->async_send_gather(std::move(gather),
+                                         std::move(callback));
+  } else {
+    report_transport_->async_send_buffer(std::move(buffer),
+                                         std::move(callback));
+  }
+}
+
+void ProtocolSession::encode_features(
+    std::shared_ptr<const FeatureReport> report,
+    ITransportAdapter::SharedBuffer& buffer,
+    std::shared_ptr<const GatherMessage>& gather) {
+  auto message = std::make_shared<GatherMessage>();
+  message->count = codec_->encode_features_gather(*report, message->scratch,
+                                                  message->segments);
+  if (message->count == 0) {
+    // 编解码器不支持分段编码
+    auto encoded =
+        send_buffers_.acquire(codec_->encoded_features_size(*report));
+    codec_->encode_features_to(*report, *encoded);
+    buffer = std::move(encoded);
+    return;
+  }
+  message->keepalive = std::move(report);
+  gather = std::move(message);
 }
 
 void ProtocolSession::async_send_status(const FrontendStatus& status,
                                         SendCallback callback) {
-  auto data = codec_->encode_status(status);
-  report_transport_->async_send(data, callback);
+  auto buffer = send_buffers_.acquire(codec_->encoded_status_size(status));
+  codec_->encode_status_to(status, *buffer);
+  report_transport_->async_send_buffer(std::move(buffer), std::move(callback),
+                                       MessageClass::Control);
 }
 
 void ProtocolSession::async_send_telemetry(const TelemetryData& telemetry,
@@ -108,10 +187,105 @@ void ProtocolSession::async_send_telemetry(const TelemetryData& telemetry,
   config.head_length = telemetry.length;  // 复用 head_length 字段存储料长
 
   // 编码使用 ICodec 接口
-  auto data = codec_->encode_config(config);
+  auto buffer = send_buffers_.acquire(codec_->encoded_config_size(config));
+  codec_->encode_config_to(config, *buffer);
 
   // 通过 config_transport_ 发送到 19700
-  config_transport_->async_send(data, callback);
+  config_transport_->async_send_buffer(std::move(buffer), std::move(callback),
+                                       MessageClass::Control);
+}
+
+asio::awaitable<std::error_code> ProtocolSession::co_connect(std::string ip,
+                                                             uint16_t port) {
+  // 与 async_connect() 相同，连上会话已有的全部传输层
+  const std::array<ITransportAdapter*, 2> transports{config_transport_.get(),
+                                                     report_transport_.get()};
+  for (auto* transport : transports) {
+    if (!transport) {
+      continue;
+    }
+    // 传输层自己决定怎么等待连接，见 ITransportAdapter::co_connect
+    auto ec = co_await transport->co_connect(ip, port);
+    if (ec) {
+      std::cerr << "Connect failed: " << ec.message() << std::endl;
+      co_return ec;
+    }
+  }
+  if (!config_transport_ && !report_transport_) {
+    co_return std::make_error_code(std::errc::not_connected);
+  }
+  co_return std::error_code{};
+}
+
+asio::awaitable<std::error_code> ProtocolSession::co_send_features(
+    std::shared_ptr<const FeatureReport> report) {
+  ITransportAdapter::SharedBuffer buffer;
+  std::shared_ptr<const GatherMessage> gather;
+  encode_features(std::move(report), buffer, gather);
+  if (gather) {
+    co_return co_await co_send_gather(*report_transport_, std::move(gather));
+  }
+  co_return co_await co_send_buffer(*report_transport_, std::move(buffer));
+}
+
+asio::awaitable<std::error_code> ProtocolSession::co_send_status(
+    FrontendStatus status) {
+  auto buffer = send_buffers_.acquire(codec_->encoded_status_size(status));
+  codec_->encode_status_to(status, *buffer);
+  co_return co_await co_send_buffer(*report_transport_, std::move(buffer),
+                                    MessageClass::Control);
+}
+
+asio::awaitable<std::error_code> ProtocolSession::co_send_telemetry(
+    TelemetryData telemetry) {
+  ServerConfig config;
+  config.roll_id = telemetry.roll_id;
+  config.head_length = telemetry.length;  // 复用 head_length 字段存储料长
+
+  auto buffer = send_buffers_.acquire(codec_->encoded_config_size(config));
+  codec_->encode_config_to(config, *buffer);
+  co_return co_await co_send_buffer(*config_transport_, std::move(buffer),
+                                    MessageClass::Control);
+}
+
+asio::awaitable<std::error_code> ProtocolSession::co_receive_frame(
+    std::span<const uint8_t>& frame, std::vector<uint8_t>& storage) {
+  co_return co_await report_transport_->co_receive_frame(frame, storage);
+}
+
+asio::awaitable<std::error_code> ProtocolSession::co_receive_features(
+    std::shared_ptr<FeatureReport>& report) {
+  report.reset();
+  std::span<const uint8_t> frame;
+  std::vector<uint8_t> storage;
+  auto ec = co_await co_receive_frame(frame, storage);
+  if (ec) {
+    co_return ec;
+  }
+  // 解码在报文所在的缓冲区上进行，下一次接收前完成
+  auto decoded = codec_->decode_features(frame);
+  if (!decoded) {
+    co_return std::make_error_code(std::errc::bad_message);
+  }
+  report = std::make_shared<FeatureReport>(std::move(*decoded));
+  co_return std::error_code{};
+}
+
+asio::awaitable<std::error_code> ProtocolSession::co_receive_status(
+    std::shared_ptr<FrontendStatus>& status) {
+  status.reset();
+  std::span<const uint8_t> frame;
+  std::vector<uint8_t> storage;
+  auto ec = co_await co_receive_frame(frame, storage);
+  if (ec) {
+    co_return ec;
+  }
+  auto decoded = codec_->decode_status(frame);
+  if (!decoded) {
+    co_return std::make_error_code(std::errc::bad_message);
+  }
+  status = std::make_shared<FrontendStatus>(*decoded);
+  co_return std::error_code{};
 }
 
 }  // namespace protocol
@@ -0,0 +1,723 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReconnectingTransport.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "protocol/ReconnectingTransport.hpp"
+//
+#include <algorithm>
+#include <filesystem>
+#include <iterator>
+#include <system_error>
+#include <utility>
+
+#include "logging/CaponLogging.hpp"
+
+namespace protocol {
+
+namespace {
+
+using SendCallback = ITransportAdapter::SendCallback;
+using SharedBuffer = ITransportAdapter::SharedBuffer;
+
+// 溢写文件里每条报文的头：长度 + 报文类别
+constexpr size_t kSpillHeaderSize = sizeof(uint32_t) + sizeof(uint8_t);
+// 每批从溢写文件读回的报文上限，写完这一批再读下一批
+constexpr size_t kSpillBatchMessages = 256;
+
+SharedBuffer flatten(const GatherMessage& message) {
+  auto buffer = std::make_shared<std::vector<uint8_t>>();
+  buffer->reserve(message.size());
+  for (size_t i = 0; i < message.count; ++i) {
+    buffer->insert(buffer->end(), message.segments[i].begin(),
+                   message.segments[i].end());
+  }
+  return buffer;
+}
+
+void run(std::vector<std::pair<SendCallback, std::error_code>>& completions) {
+  for (auto& [callback, ec] : completions) {
+    if (callback) {
+      callback(ec);
+    }
+  }
+  completions.clear();
+}
+
+}  // namespace
+
+ReconnectingTransport::ReconnectingTransport(
+    asio::io_context& io_ctx, std::unique_ptr<ITransportAdapter> inner,
+    const ReconnectConfig& config)
+    : io_ctx_(io_ctx),
+      inner_(std::move(inner)),
+      config_(config),
+      timer_(io_ctx),
+      random_(std::random_device{}()) {
+  config_.initial_backoff =
+      std::max(config_.initial_backoff, std::chrono::milliseconds(1));
+  config_.max_backoff = std::max(config_.max_backoff, config_.initial_backoff);
+  config_.max_queued_messages =
+      std::max<size_t>(config_.max_queued_messages, 1);
+  recover_spill();
+}
+
+ReconnectingTransport::~ReconnectingTransport() {
+  // 析构时 io_context 已不再运行，不能再投递引用 this 的任务
+  abort_pending();
+  timer_.cancel();
+}
+
+void ReconnectingTransport::async_connect(
+    const std::string& ip, uint16_t port,
+    std::function<void(std::error_code)> callback) {
+  {
+    std::lock_guard lock(mutex_);
+    ip_ = ip;
+    port_ = port;
+    connect_callback_ = std::move(callback);
+    closed_ = false;
+  }
+  start_connect();
+}
+
+void ReconnectingTransport::async_send(std::span<const uint8_t> data,
+                                       SendCallback callback) {
+  send({std::make_shared<std::vector<uint8_t>>(data.begin(), data.end()),
+        nullptr, std::move(callback), MessageClass::Bulk});
+}
+
+void ReconnectingTransport::async_send_buffer(SharedBuffer data,
+                                              SendCallback callback,
+                                              MessageClass message_class) {
+  send({std::move(data), nullptr, std::move(callback), message_class});
+}
+
+void ReconnectingTransport::async_send_gather(
+    std::shared_ptr<const GatherMessage> message, SendCallback callback,
+    MessageClass message_class) {
+  send({nullptr, std::move(message), std::move(callback), message_class});
+}
+
+void ReconnectingTransport::async_send_tracked(
+    SharedBuffer data, std::shared_ptr<const GatherMessage> message,
+    SendCallback callback, BufferedCallback on_buffered,
+    MessageClass message_class) {
+  send({std::move(data), std::move(message), std::move(callback),
+        message_class, false, std::move(on_buffered)});
+}
+
+void ReconnectingTransport::send(Pending pending) {
+  const bool control = pending.message_class == MessageClass::Control;
+  std::vector<Completion> completions;
+  bool online = false;
+  uint64_t generation = 0;
+  {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      completions.emplace_back(std::move(pending.callback),
+                               asio::error::not_connected);
+    } else if (connected_ && (!replaying_ || control)) {
+      // 只有 Bulk 报文需要排在重放之后，Control 报文连上即直发
+      online = true;
+      generation = generation_;
+    } else if (control) {
+      completions.emplace_back(std::move(pending.callback),
+                               asio::error::not_connected);
+    }
+  }
+  if (online) {
+    send_online(std::move(pending), generation);
+    return;
+  }
+  BufferedCallback on_buffered;
+  bool buffered = false;
+  if (completions.empty()) {
+    // 分段报文引用着帧数据，暂存前拷贝成一块，拷贝放在锁外
+    if (pending.gather) {
+      pending.buffer = flatten(*pending.gather);
+      pending.gather.reset();
+    }
+    on_buffered = std::move(pending.on_buffered);
+    pending.on_buffered = nullptr;
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      completions.emplace_back(std::move(pending.callback),
+                               asio::error::not_connected);
+    } else if (connected_ && !replaying_) {
+      // 拷贝期间已经重连并重放完，仍然走队列之外的直发会插到前面，
+      // 这里补一次重放保证顺序
+      replaying_ = true;
+      generation = generation_;
+      online = true;
+      buffered = enqueue_locked(std::move(pending), completions);
+    } else {
+      buffered = enqueue_locked(std::move(pending), completions);
+    }
+  }
+  run(completions);
+  if (buffered && on_buffered) {
+    on_buffered();
+  }
+  if (online) {
+    replay(generation);
+  }
+}
+
+bool ReconnectingTransport::enqueue_locked(
+    Pending pending, std::vector<Completion>& completions) {
+  // 已经开始溢写时新报文也排到溢写文件末尾，保证重放顺序
+  if (spilling_locked()) {
+    spill_later_locked(std::move(pending));
+    return true;
+  }
+  const size_t bytes = pending.buffer->size();
+  auto full = [&] {
+    return queue_.size() + retry_.size() >= config_.max_queued_messages ||
+           queued_bytes_ + bytes > config_.max_queued_bytes;
+  };
+  if (full() && !config_.spill_path.empty()) {
+    spill_later_locked(std::move(pending));
+    return true;
+  }
+  while (full() && !queue_.empty()) {
+    auto& oldest = queue_.front();
+    queued_bytes_ -= oldest.buffer->size();
+    completions.emplace_back(std::move(oldest.callback),
+                             std::make_error_code(std::errc::no_buffer_space));
+    queue_.pop_front();
+    ++stats_.dropped;
+  }
+  if (full()) {
+    // 单条报文就超过上限，或者全被回退的报文占满
+    completions.emplace_back(std::move(pending.callback),
+                             std::make_error_code(std::errc::no_buffer_space));
+    ++stats_.dropped;
+    return false;
+  }
+  queued_bytes_ += bytes;
+  queue_.push_back(std::move(pending));
+  return true;
+}
+
+bool ReconnectingTransport::spilling_locked() const {
+  return spill_pending_ > 0 || spill_writing_ > 0 || !spill_backlog_.empty();
+}
+
+void ReconnectingTransport::spill_later_locked(Pending pending) {
+  spill_backlog_.push_back(std::move(pending));
+  if (spill_flush_posted_) {
+    return;
+  }
+  spill_flush_posted_ = true;
+  asio::post(io_ctx_, [this, alive = std::weak_ptr<bool>(alive_)] {
+    if (alive.lock()) {
+      flush_spill();
+    }
+  });
+}
+
+void ReconnectingTransport::flush_spill() {
+  std::vector<Completion> completions;
+  {
+    std::lock_guard io_lock(spill_io_mutex_);
+    write_spill_backlog(completions);
+  }
+  run(completions);
+}
+
+void ReconnectingTransport::write_spill_backlog(
+    std::vector<Completion>& completions) {
+  std::deque<Pending> backlog;
+  {
+    std::lock_guard lock(mutex_);
+    backlog.swap(spill_backlog_);
+    spill_writing_ = backlog.size();
+    spill_flush_posted_ = false;
+  }
+  if (backlog.empty()) {
+    return;
+  }
+  // 写失败后这一批剩下的也不再写，文件里的顺序不会被打乱
+  std::error_code ec;
+  uint64_t written = 0;
+  for (auto& pending : backlog) {
+    if (!ec && !write_spill(pending)) {
+      ec = std::make_error_code(std::errc::io_error);
+    }
+    if (!ec) {
+      ++written;
+    }
+    completions.emplace_back(std::move(pending.callback), ec);
+  }
+  if (spill_out_.is_open()) {
+    spill_out_.flush();
+  }
+  std::lock_guard lock(mutex_);
+  spill_writing_ = 0;
+  spill_pending_ += written;
+  stats_.spilled += written;
+  stats_.dropped += backlog.size() - written;
+}
+
+bool ReconnectingTransport::write_spill(const Pending& pending) {
+  if (!spill_out_.is_open()) {
+    spill_out_.open(config_.spill_path, std::ios::binary | std::ios::app);
+    if (!spill_out_) {
+      LOG_ERROR("Failed to open spill file {}", config_.spill_path);
+      spill_out_.close();
+      return false;
+    }
+  }
+  const auto length = static_cast<uint32_t>(pending.buffer->size());
+  const auto message_class = static_cast<uint8_t>(pending.message_class);
+  spill_out_.write(reinterpret_cast<const char*>(&length), sizeof(length));
+  spill_out_.write(reinterpret_cast<const char*>(&message_class),
+                   sizeof(message_class));
+  spill_out_.write(reinterpret_cast<const char*>(pending.buffer->data()),
+                   static_cast<std::streamsize>(length));
+  if (!spill_out_) {
+    LOG_ERROR("Failed to write spill file {}", config_.spill_path);
+    spill_out_.close();
+    return false;
+  }
+  return true;
+}
+
+void ReconnectingTransport::read_spill_batch() {
+  uint64_t available = 0;
+  size_t budget = 0;
+  {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      return;
+    }
+    available = spill_pending_;
+    budget = config_.max_queued_bytes -
+             std::min(queued_bytes_, config_.max_queued_bytes);
+  }
+  if (available == 0) {
+    return;
+  }
+  if (!spill_in_.is_open()) {
+    spill_in_.open(config_.spill_path, std::ios::binary);
+  }
+  // 上一批可能读到了文件末尾，之后又有追加
+  spill_in_.clear();
+  std::deque<Pending> batch;
+  size_t bytes = 0;
+  bool truncated = false;
+  while (batch.size() < available && batch.size() < kSpillBatchMessages &&
+         bytes < budget) {
+    uint32_t length = 0;
+    uint8_t message_class = 0;
+    spill_in_.read(reinterpret_cast<char*>(&length), sizeof(length));
+    spill_in_.read(reinterpret_cast<char*>(&message_class),
+                   sizeof(message_class));
+    auto buffer = std::make_shared<std::vector<uint8_t>>(length);
+    spill_in_.read(reinterpret_cast<char*>(buffer->data()),
+                   static_cast<std::streamsize>(length));
+    if (!spill_in_) {
+      truncated = true;
+      break;
+    }
+    bytes += length;
+    batch.push_back({std::move(buffer), nullptr, nullptr,
+                     static_cast<MessageClass>(message_class)});
+  }
+
+  bool drained = false;
+  {
+    std::lock_guard lock(mutex_);
+    if (truncated) {
+      LOG_ERROR("Spill file {} is truncated, discarding {} messages",
+                config_.spill_path, spill_pending_ - batch.size());
+      spill_pending_ = 0;
+    } else {
+      spill_pending_ -= batch.size();
+    }
+    drained = spill_pending_ == 0;
+    queued_bytes_ += bytes;
+    std::move(batch.begin(), batch.end(), std::back_inserter(queue_));
+  }
+  // 持有 spill_io_mutex_，此时不会有并发的写入；之后的溢写重新建文件
+  if (drained) {
+    discard_spill();
+  }
+}
+
+void ReconnectingTransport::load_spill(uint64_t generation) {
+  std::vector<Completion> completions;
+  {
+    std::lock_guard io_lock(spill_io_mutex_);
+    // 还在待写队列里的报文先落盘，再按文件顺序读回
+    write_spill_backlog(completions);
+    read_spill_batch();
+  }
+  run(completions);
+  replay(generation);
+}
+
+void ReconnectingTransport::recover_spill() {
+  if (config_.spill_path.empty()) {
+    return;
+  }
+  // 上次运行没来得及重放的报文，连上后接着发
+  std::error_code ec;
+  const auto file_size = std::filesystem::file_size(config_.spill_path, ec);
+  if (ec) {
+    return;
+  }
+  std::ifstream in(config_.spill_path, std::ios::binary);
+  uint64_t messages = 0;
+  uintmax_t valid_bytes = 0;
+  uint32_t length = 0;
+  while (valid_bytes + kSpillHeaderSize <= file_size &&
+         in.seekg(static_cast<std::streamoff>(valid_bytes)) &&
+         in.read(reinterpret_cast<char*>(&length), sizeof(length)) &&
+         valid_bytes + kSpillHeaderSize + length <= file_size) {
+    valid_bytes += kSpillHeaderSize + length;
+    ++messages;
+  }
+  in.close();
+
+  if (messages == 0) {
+    std::filesystem::remove(config_.spill_path, ec);
+    return;
+  }
+  // 截掉写了一半的最后一条
+  std::filesystem::resize_file(config_.spill_path, valid_bytes, ec);
+  spill_pending_ = messages;
+  LOG_INFO("Recovered {} spilled messages from {}", messages,
+           config_.spill_path);
+}
+
+void ReconnectingTransport::discard_spill() {
+  spill_in_.close();
+  spill_out_.close();
+  std::error_code ec;
+  std::filesystem::remove(config_.spill_path, ec);
+}
+
+void ReconnectingTransport::send_online(Pending pending,
+                                        uint64_t generation) {
+  auto buffer = pending.buffer;
+  auto gather = pending.gather;
+  const auto message_class = pending.message_class;
+  auto callback = [this, generation, pending = std::move(pending)](
+                      std::error_code ec) mutable {
+    on_send_result(ec, std::move(pending), generation);
+  };
+  if (gather) {
+    inner_->async_send_gather(std::move(gather), std::move(callback),
+                              message_class);
+  } else {
+    inner_->async_send_buffer(std::move(buffer), std::move(callback),
+                              message_class);
+  }
+}
+
+void ReconnectingTransport::on_send_result(const std::error_code& ec,
+                                           Pending pending,
+                                           uint64_t generation) {
+  if (!ec) {
+    if (pending.callback) {
+      pending.callback(ec);
+    }
+    if (pending.resume_replay) {
+      replay(generation);
+    }
+    return;
+  }
+
+  std::vector<Completion> completions;
+  BufferedCallback on_buffered;
+  bool resend = false;
+  uint64_t current = 0;
+  {
+    std::lock_guard lock(mutex_);
+    if (closed_ || pending.message_class == MessageClass::Control) {
+      completions.emplace_back(std::move(pending.callback), ec);
+    } else {
+      // 写失败的报文比断线后新进队列的旧，放进 retry_ 优先重发
+      if (pending.gather) {
+        pending.buffer = flatten(*pending.gather);
+        pending.gather.reset();
+      }
+      pending.resume_replay = false;
+      on_buffered = std::move(pending.on_buffered);
+      pending.on_buffered = nullptr;
+      queued_bytes_ += pending.buffer->size();
+      retry_.push_back(std::move(pending));
+      // 旧连接的失败回调迟到，新连接已经重放完，需要再补一次
+      if (connected_ && generation_ != generation && !replaying_) {
+        replaying_ = true;
+        resend = true;
+        current = generation_;
+      }
+    }
+  }
+  run(completions);
+  if (on_buffered) {
+    on_buffered();
+  }
+  on_connection_lost(generation);
+  if (resend) {
+    replay(current);
+  }
+}
+
+void ReconnectingTransport::start_connect() {
+  std::string ip;
+  uint16_t port = 0;
+  {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      return;
+    }
+    ip = ip_;
+    port = port_;
+  }
+  inner_->async_connect(ip, port, [this, ip, port](std::error_code ec) {
+    if (ec) {
+      LOG_WARN("Connect to {}:{} failed: {}", ip, port, ec.message());
+      finish_first_connect(ec);
+      schedule_reconnect();
+      return;
+    }
+    on_connected();
+  });
+}
+
+void ReconnectingTransport::on_connected() {
+  uint64_t generation = 0;
+  {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      return;
+    }
+    connected_ = true;
+    replaying_ = true;
+    attempts_ = 0;
+    generation = ++generation_;
+    ++stats_.connects;
+    LOG_INFO("Connected to {}:{}, replaying {} queued and {} spilled messages",
+             ip_, port_, retry_.size() + queue_.size(), spill_pending_);
+  }
+  finish_first_connect({});
+  start_health_check(generation);
+  replay(generation);
+}
+
+void ReconnectingTransport::on_connection_lost(uint64_t generation) {
+  {
+    std::lock_guard lock(mutex_);
+    if (!connected_ || generation_ != generation) {
+      return;
+    }
+    connected_ = false;
+    replaying_ = false;
+    ++stats_.disconnects;
+    LOG_WARN("Connection to {}:{} lost, reconnecting", ip_, port_);
+  }
+  inner_->close();
+  schedule_reconnect();
+}
+
+void ReconnectingTransport::finish_first_connect(const std::error_code& ec) {
+  // 只有 async_connect() 之后的第一次结果回调，后台重连不再通知
+  std::function<void(std::error_code)> callback;
+  {
+    std::lock_guard lock(mutex_);
+    callback = std::move(connect_callback_);
+    connect_callback_ = nullptr;
+  }
+  if (callback) {
+    callback(ec);
+  }
+}
+
+void ReconnectingTransport::schedule_reconnect() {
+  std::chrono::milliseconds delay{0};
+  {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+      return;
+    }
+    const auto shift = std::min<uint32_t>(attempts_++, 20);
+    const auto backoff = std::min(
+        config_.initial_backoff * (int64_t{1} << shift), config_.max_backoff);
+    // 在 [backoff/2, backoff] 内随机
+    std::uniform_int_distribution<int64_t> jitter(0, backoff.count() / 2);
+    delay = backoff - std::chrono::milliseconds(jitter(random_));
+  }
+  asio::post(io_ctx_, [this, delay, alive = std::weak_ptr<bool>(alive_)] {
+    if (!alive.lock()) {
+      return;
+    }
+    timer_.expires_after(delay);
+    timer_.async_wait([this, alive](const asio::error_code& ec) {
+      if (!ec && alive.lock()) {
+        start_connect();
+      }
+    });
+  });
+}
+
+void ReconnectingTransport::replay(uint64_t generation) {
+  std::deque<Pending> batch;
+  {
+    std::lock_guard lock(mutex_);
+    if (!connected_ || generation_ != generation) {
+      return;
+    }
+    if (retry_.empty() && queue_.empty()) {
+      if (spilling_locked()) {
+        // 溢写文件在 io 线程上分批读回，读完接着重放
+        asio::post(io_ctx_, [this, generation,
+                             alive = std::weak_ptr<bool>(alive_)] {
+          if (alive.lock()) {
+            load_spill(generation);
+          }
+        });
+      } else {
+        replaying_ = false;
+      }
+      return;
+    }
+    batch.swap(retry_);
+    std::move(queue_.begin(), queue_.end(), std::back_inserter(batch));
+    queue_.clear();
+    queued_bytes_ = 0;
+    stats_.replayed += batch.size();
+  }
+  // 批次最后一条写完后再取下一批，溢写文件不会一次全读进内存
+  batch.back().resume_replay = true;
+  for (auto& pending : batch) {
+    send_online(std::move(pending), generation);
+  }
+}
+
+void ReconnectingTransport::start_health_check(uint64_t generation) {
+  if (!config_.health_check) {
+    return;
+  }
+  inner_->async_receive_frames(
+      [this, generation](std::error_code ec, std::span<const uint8_t> frame) {
+        if (ec) {
+          on_connection_lost(generation);
+          return;
+        }
+        on_frame(frame);
+      });
+}
+
+void ReconnectingTransport::on_frame(std::span<const uint8_t> frame) {
+  FrameCallback frame_callback;
+  ReceiveCallback receive_callback;
+  {
+    std::lock_guard lock(mutex_);
+    frame_callback = frame_callback_;
+    receive_callback = std::move(receive_callback_);
+    receive_callback_ = nullptr;
+  }
+  if (frame_callback) {
+    frame_callback({}, frame);
+  }
+  if (receive_callback) {
+    receive_callback({}, std::vector<uint8_t>(frame.begin(), frame.end()));
+  }
+}
+
+void ReconnectingTransport::async_receive(ReceiveCallback callback) {
+  if (!config_.health_check) {
+    inner_->async_receive(std::move(callback));
+    return;
+  }
+  // 接收由健康检查持续进行，这里只登记回调，断线重连期间一直有效
+  std::lock_guard lock(mutex_);
+  receive_callback_ = std::move(callback);
+}
+
+void ReconnectingTransport::async_receive_frames(FrameCallback callback) {
+  if (!config_.health_check) {
+    inner_->async_receive_frames(std::move(callback));
+    return;
+  }
+  std::lock_guard lock(mutex_);
+  frame_callback_ = std::move(callback);
+}
+
+void ReconnectingTransport::close() {
+  if (!abort_pending()) {
+    return;
+  }
+  asio::post(io_ctx_, [this, alive = std::weak_ptr<bool>(alive_)] {
+    if (alive.lock()) {
+      timer_.cancel();
+    }
+  });
+  inner_->close();
+}
+
+bool ReconnectingTransport::abort_pending() {
+  std::vector<Completion> completions;
+  {
+    std::lock_guard io_lock(spill_io_mutex_);
+    {
+      std::lock_guard lock(mutex_);
+      if (closed_) {
+        return false;
+      }
+      closed_ = true;
+      connected_ = false;
+      for (auto* queue : {&retry_, &queue_}) {
+        for (auto& pending : *queue) {
+          completions.emplace_back(std::move(pending.callback),
+                                   asio::error::operation_aborted);
+        }
+        queue->clear();
+      }
+      queued_bytes_ = 0;
+    }
+    // 已交给溢写的报文同步写完。溢写文件保留，下次启动后继续重放；
+    // 读位置也保留，重新连接时从上次读到的地方接着读
+    write_spill_backlog(completions);
+    spill_out_.close();
+  }
+  run(completions);
+  return true;
+}
+
+ReconnectingTransport::Stats ReconnectingTransport::stats() const {
+  std::lock_guard lock(mutex_);
+  Stats stats = stats_;
+  stats.queued = retry_.size() + queue_.size();
+  stats.queued_bytes = queued_bytes_;
+  stats.spill_pending = spill_pending_;
+  stats.connected = connected_;
+  return stats;
+}
+
+}  // namespace protocol
@@ -0,0 +1,256 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReportImageEncoder.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "protocol/ReportImageEncoder.hpp"
+//
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include <opencv2/imgcodecs.hpp>
+
+#include "algo/FrameProducts.hpp"
+#include "cameras/ExecutionTopology.hpp"
+#include "logging/CaponLogging.hpp"
+
+namespace protocol {
+
+ReportImageFormat parse_report_image_format(const std::string& name) {
+  std::string lower = name;
+  std::transform(lower.begin(), lower.end(), lower.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  if (lower.empty() || lower == "none") {
+    return ReportImageFormat::None;
+  }
+  if (lower == "raw") {
+    return ReportImageFormat::Raw;
+  }
+  if (lower == "jpeg" || lower == "jpg") {
+    return ReportImageFormat::Jpeg;
+  }
+  if (lower == "png") {
+    return ReportImageFormat::Png;
+  }
+  throw std::invalid_argument("unknown report image format: " + name);
+}
+
+namespace {
+
+struct Job {
+  ReportImageEncoder::Callback callback;
+  ReportImageEncoder::SharedImage image;
+  bool done = false;
+};
+
+}  // namespace
+
+struct ReportImageEncoder::Impl {
+  explicit Impl(const ReportImageConfig& cfg) : config(cfg) {
+    if (config.format == ReportImageFormat::Jpeg ||
+        config.format == ReportImageFormat::Png) {
+      ExecutionConfig execution = config.execution;
+      if (execution.lane.empty()) {
+        execution.lane = "report_image";
+      }
+      workers.configure(execution);
+    }
+  }
+
+  // 压缩或裁剪，失败时返回空
+  SharedImage encode(const CapturedFrame& frame, const cv::Rect& roi) const {
+    cv::Mat image = algo::frame_view(frame);
+    if (roi.area() > 0) {
+      image = image(roi & cv::Rect(0, 0, image.cols, image.rows));
+    }
+    if (image.empty()) {
+      return nullptr;
+    }
+
+    auto out = std::make_shared<std::vector<uint8_t>>();
+    if (config.format == ReportImageFormat::Raw) {
+      // 只有裁剪时才会走到这里，逐行拷贝裁剪区域
+      const size_t row_bytes = image.cols * image.elemSize();
+      out->resize(row_bytes * image.rows);
+      for (int y = 0; y < image.rows; ++y) {
+        std::copy_n(image.ptr<uint8_t>(y), row_bytes,
+                    out->data() + row_bytes * y);
+      }
+      return out;
+    }
+
+    const bool jpeg = config.format == ReportImageFormat::Jpeg;
+    const std::vector<int> params =
+        jpeg ? std::vector<int>{cv::IMWRITE_JPEG_QUALITY, config.jpeg_quality}
+             : std::vector<int>{cv::IMWRITE_PNG_COMPRESSION,
+                                config.png_compression};
+    if (!cv::imencode(jpeg ? ".jpg" : ".png", image, *out, params)) {
+      return nullptr;
+    }
+    return out;
+  }
+
+  void run(Job* job, std::shared_ptr<const CapturedFrame> frame,
+           cv::Rect roi) {
+    SharedImage image;
+    const auto start = std::chrono::steady_clock::now();
+    try {
+      image = encode(*frame, roi);
+    } catch (const std::exception& e) {
+      LOG_ERROR("Report image encoding failed: {}", e.what());
+    }
+    encode_latency.record(std::chrono::steady_clock::now() - start);
+    frame.reset();
+
+    std::unique_lock lock(mutex);
+    ++(image ? encoded : failed);
+    job->image = std::move(image);
+    job->done = true;
+    --encoding;
+    deliver(lock);
+    --active_tasks;
+    idle.notify_all();
+  }
+
+  // 按提交顺序回调，同一时刻只有一个线程在回调
+  void deliver(std::unique_lock<std::mutex>& lock) {
+    if (delivering) {
+      return;
+    }
+    delivering = true;
+    while (!jobs.empty() && jobs.front()->done) {
+      auto job = std::move(jobs.front());
+      jobs.pop_front();
+      lock.unlock();
+      if (job->callback) {
+        try {
+          job->callback(std::move(job->image));
+        } catch (const std::exception& e) {
+          LOG_ERROR("Report image callback failed: {}", e.what());
+        } catch (...) {
+          LOG_ERROR("Report image callback failed with unknown exception");
+        }
+      }
+      lock.lock();
+    }
+    delivering = false;
+    idle.notify_all();
+  }
+
+  ReportImageConfig config;
+  ExecutionBinding workers;
+
+  mutable std::mutex mutex;
+  std::condition_variable idle;
+  std::deque<std::unique_ptr<Job>> jobs;
+  bool delivering = false;
+  size_t encoding = 0;      // 排队和正在压缩的帧数
+  size_t active_tasks = 0;  // 还在访问 Impl 的压缩任务数
+
+  uint64_t shared = 0;
+  uint64_t encoded = 0;
+  uint64_t dropped = 0;
+  uint64_t failed = 0;
+  algo::LatencyHistogram encode_latency;
+};
+
+ReportImageEncoder::ReportImageEncoder(const ReportImageConfig& config)
+    : impl_(std::make_unique<Impl>(config)) {}
+
+ReportImageEncoder::~ReportImageEncoder() {
+  std::unique_lock lock(impl_->mutex);
+  impl_->idle.wait(lock, [this]() {
+    return impl_->jobs.empty() && impl_->active_tasks == 0 &&
+           !impl_->delivering;
+  });
+}
+
+void ReportImageEncoder::submit(std::shared_ptr<const CapturedFrame> frame,
+                                Callback callback, const cv::Rect& roi) {
+  const auto format = impl_->config.format;
+  auto job = std::make_unique<Job>();
+  job->callback = std::move(callback);
+
+  std::unique_lock lock(impl_->mutex);
+  if (!frame || format == ReportImageFormat::None) {
+    job->done = true;
+  } else if (format == ReportImageFormat::Raw && roi.area() <= 0) {
+    job->image = share_frame_data(std::move(frame));
+    job->done = true;
+    ++impl_->shared;
+  } else if (impl_->encoding >= impl_->config.max_pending) {
+    job->done = true;
+    ++impl_->dropped;
+  }
+
+  Job* pending = job.get();
+  impl_->jobs.push_back(std::move(job));
+  if (pending->done) {
+    impl_->deliver(lock);
+    return;
+  }
+
+  ++impl_->encoding;
+  ++impl_->active_tasks;
+  lock.unlock();
+  if (format == ReportImageFormat::Raw) {
+    // 裁剪只是少量拷贝，直接在调用线程完成
+    impl_->run(pending, std::move(frame), roi);
+    return;
+  }
+  impl_->workers.submit(
+      [impl = impl_.get(), pending, frame = std::move(frame), roi]() mutable {
+        impl->run(pending, std::move(frame), roi);
+      });
+}
+
+ReportImageEncoder::Stats ReportImageEncoder::stats() const {
+  Stats stats;
+  std::lock_guard lock(impl_->mutex);
+  stats.shared = impl_->shared;
+  stats.encoded = impl_->encoded;
+  stats.dropped = impl_->dropped;
+  stats.failed = impl_->failed;
+  stats.pending = impl_->jobs.size();
+  stats.encode_latency = impl_->encode_latency.snapshot();
+  return stats;
+}
+
+ReportImageEncoder::SharedImage ReportImageEncoder::share_frame_data(
+    std::shared_ptr<const CapturedFrame> frame) {
+  if (!frame) {
+    return nullptr;
+  }
+  const auto* data = &frame->data;
+  return SharedImage(std::move(frame), data);
+}
+
+}  // namespace protocol
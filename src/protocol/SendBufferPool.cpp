@@ -0,0 +1,163 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: SendBufferPool.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "protocol/SendBufferPool.hpp"
+//
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+
+namespace protocol {
+namespace detail {
+
+// shared_ptr 控制块的最大复用尺寸，超过的直接走全局分配
+constexpr size_t kControlBlockSize = 128;
+
+struct SendBufferPoolState {
+  explicit SendBufferPoolState(size_t max) : max_cached(max) {
+    free_buffers.reserve(max_cached);
+  }
+
+  ~SendBufferPoolState() {
+    for (void* block : free_blocks) {
+      ::operator delete(block);
+    }
+  }
+
+  void recycle(std::vector<uint8_t>* buffer) {
+    std::unique_ptr<std::vector<uint8_t>> owned(buffer);
+    {
+      std::lock_guard lock(mutex);
+      if (free_buffers.size() < max_cached) {
+        free_buffers.push_back(std::move(owned));
+      }
+    }
+    // 池已满时 owned 在锁外释放
+  }
+
+  void* allocate_block(size_t bytes) {
+    if (bytes <= kControlBlockSize) {
+      std::lock_guard lock(mutex);
+      if (!free_blocks.empty()) {
+        void* block = free_blocks.back();
+        free_blocks.pop_back();
+        return block;
+      }
+      return ::operator new(kControlBlockSize);
+    }
+    return ::operator new(bytes);
+  }
+
+  void deallocate_block(void* block, size_t bytes) {
+    if (bytes <= kControlBlockSize) {
+      std::lock_guard lock(mutex);
+      free_blocks.push_back(block);
+      return;
+    }
+    ::operator delete(block);
+  }
+
+  mutable std::mutex mutex;
+  size_t max_cached;
+  std::vector<std::unique_ptr<std::vector<uint8_t>>> free_buffers;
+  std::vector<void*> free_blocks;
+  std::atomic<uint64_t> hits{0};
+  std::atomic<uint64_t> misses{0};
+};
+
+// 缓冲区归还器：最后一个引用释放时把缓冲区放回池中
+struct BufferRecycler {
+  std::shared_ptr<SendBufferPoolState> state;
+  void operator()(std::vector<uint8_t>* buffer) const {
+    state->recycle(buffer);
+  }
+};
+
+// 控制块分配器：复用 shared_ptr 控制块，避免每条报文一次小对象分配
+template <typename T>
+struct ControlBlockAllocator {
+  using value_type = T;
+
+  explicit ControlBlockAllocator(std::shared_ptr<SendBufferPoolState> s)
+      : state(std::move(s)) {}
+  template <typename U>
+  ControlBlockAllocator(const ControlBlockAllocator<U>& other)  // NOLINT
+      : state(other.state) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(state->allocate_block(n * sizeof(T)));
+  }
+  void deallocate(T* p, size_t n) { state->deallocate_block(p, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const ControlBlockAllocator<U>& other) const {
+    return state == other.state;
+  }
+
+  std::shared_ptr<SendBufferPoolState> state;
+};
+
+}  // namespace detail
+
+SendBufferPool::SendBufferPool(size_t max_cached)
+    : state_(std::make_shared<detail::SendBufferPoolState>(max_cached)) {}
+
+SendBufferPool::Buffer SendBufferPool::acquire(size_t bytes) {
+  std::unique_ptr<std::vector<uint8_t>> buffer;
+  {
+    std::lock_guard lock(state_->mutex);
+    if (!state_->free_buffers.empty()) {
+      buffer = std::move(state_->free_buffers.back());
+      state_->free_buffers.pop_back();
+    }
+  }
+
+  if (buffer && buffer->capacity() >= bytes) {
+    state_->hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    state_->misses.fetch_add(1, std::memory_order_relaxed);
+    if (!buffer) {
+      buffer = std::make_unique<std::vector<uint8_t>>();
+    }
+  }
+  buffer->resize(bytes);
+
+  return Buffer(buffer.release(), detail::BufferRecycler{state_},
+                detail::ControlBlockAllocator<std::vector<uint8_t>>(state_));
+}
+
+size_t SendBufferPool::cached_count() const {
+  std::lock_guard lock(state_->mutex);
+  return state_->free_buffers.size();
+}
+
+SendBufferPool::Stats SendBufferPool::stats() const {
+  return {state_->hits.load(std::memory_order_relaxed),
+          state_->misses.load(std::memory_order_relaxed)};
+}
+
+}  // namespace protocol
@@ -0,0 +1,50 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: TransportAdapter.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include "protocol/TransportAdapter.hpp"
+
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "protocol/Awaitable.hpp"
+
+namespace protocol {
+
+asio::awaitable<std::error_code> ITransportAdapter::co_connect(std::string ip,
+                                                               uint16_t port) {
+  co_return co_await protocol::co_connect(*this, std::move(ip), port);
+}
+
+asio::awaitable<std::error_code> ITransportAdapter::co_receive_frame(
+    std::span<const uint8_t>& frame, std::vector<uint8_t>& storage) {
+  auto ec = co_await co_receive(*this, storage);
+  frame = storage;
+  co_return ec;
+}
+
+}  // namespace protocol
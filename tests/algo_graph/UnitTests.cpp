@@ -0,0 +1,127 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: UnitTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "algo/AlgoGraph.hpp"
+
+namespace {
+
+CapturedFrame make_frame(int value) {
+  CapturedFrame frame;
+  frame.meta.iWidth = 4;
+  frame.meta.iHeight = 1;
+  frame.data.assign(4, static_cast<uint8_t>(value));
+  return frame;
+}
+
+}  // namespace
+
+// 两个互不依赖的节点同时执行，并读到上游放进帧缓存的同一份中间结果
+TEST(AlgoGraphTests, IndependentNodesShareIntermediate) {
+  algo::AlgoGraph graph(4);
+  std::atomic<int> computed{0};
+  auto prepare = graph.add_stage("prepare", [&](const CapturedFrame& frame) {
+    frame.derived.get_or_compute<int>("sum", [&]() {
+      ++computed;
+      return frame.data[0] * 4;
+    });
+  });
+
+  std::atomic<int> running{0};
+  std::atomic<bool> overlapped{false};
+  std::atomic<int> sums{0};
+  auto consumer = [&](const CapturedFrame& frame) {
+    ++running;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (running.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    overlapped = overlapped || running.load() == 2;
+    sums += *frame.derived.find<int>("sum");
+  };
+  graph.add_stage("left", consumer, {prepare});
+  graph.add_stage("right", consumer, {prepare});
+
+  CapturedFrame frame = make_frame(5);
+  graph.process(frame);
+
+  EXPECT_TRUE(overlapped.load());
+  EXPECT_EQ(computed.load(), 1);
+  EXPECT_EQ(sums.load(), 40);
+
+  auto timing = graph.get_node_timing();
+  ASSERT_EQ(timing.size(), 3u);
+  EXPECT_EQ(timing[1].name, "left");
+  for (const auto& node : timing) {
+    EXPECT_EQ(node.latency.count, 1u) << node.name;
+  }
+}
+
+// 节点失败时下游本帧跳过，其它分支照常执行
+TEST(AlgoGraphTests, FailedNodeSkipsDependents) {
+  algo::AlgoGraph graph(2);
+  std::atomic<int> downstream{0};
+  std::atomic<int> sibling{0};
+  auto failing = graph.add_stage("failing", [](const CapturedFrame&) {
+    throw std::runtime_error("boom");
+  });
+  graph.add_stage("downstream",
+                  [&](const CapturedFrame&) { ++downstream; }, {failing});
+  graph.add_stage("sibling", [&](const CapturedFrame&) { ++sibling; });
+
+  CapturedFrame frame = make_frame(1);
+  graph.process(frame);
+
+  EXPECT_EQ(downstream.load(), 0);
+  EXPECT_EQ(sibling.load(), 1);
+  auto timing = graph.get_node_timing();
+  EXPECT_EQ(timing[0].failures, 1u);
+  EXPECT_EQ(timing[1].skipped, 1u);
+
+  EXPECT_THROW(graph.add_stage("bad", [](const CapturedFrame&) {}, {7}),
+               std::invalid_argument);
+}
+
+// 相机按基类引用接收处理器，clone() 必须保留派生类型
+TEST(AlgoGraphTests, CloneKeepsDerivedProcessor) {
+  algo::AlgoGraph graph(1);
+  std::atomic<int> calls{0};
+  graph.add_stage("count", [&](const CapturedFrame&) { ++calls; });
+
+  const FrameProcessor& base = graph;
+  std::shared_ptr<FrameProcessor> stored = base.clone();
+  stored->process(make_frame(0));
+  EXPECT_EQ(calls.load(), 1);
+}
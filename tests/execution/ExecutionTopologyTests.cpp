@@ -0,0 +1,72 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ExecutionTopologyTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "cameras/ExecutionTopology.hpp"
+
+TEST(ExecutionTopologyTests, ParseCpuList) {
+  EXPECT_EQ(parse_cpu_list("0-3, 8,2"), (std::vector<int>{0, 1, 2, 3, 8}));
+  EXPECT_TRUE(parse_cpu_list("").empty());
+  EXPECT_THROW(parse_cpu_list("3-1"), std::invalid_argument);
+  EXPECT_THROW(parse_cpu_list("a"), std::invalid_argument);
+}
+
+TEST(ExecutionTopologyTests, SamePoolNameSharesWorkers) {
+  ExecutionConfig config;
+  config.pool = "test_shared";
+  config.threads = 2;
+  auto first = ExecutionTopology::instance().acquire(config);
+  auto second = ExecutionTopology::instance().acquire(config);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first->thread_count(), 2u);
+
+  config.pool = "test_isolated";
+  auto isolated = ExecutionTopology::instance().acquire(config);
+  EXPECT_NE(first, isolated);
+
+  std::atomic<int> ran{0};
+  first->run_local([&]() { ++ran; });
+  EXPECT_EQ(ran.load(), 1);
+}
+
+TEST(ExecutionTopologyTests, BindingFallsBackToSharedPool) {
+  ExecutionBinding binding;
+  auto pool = binding.pool();
+  ASSERT_NE(pool, nullptr);
+  EXPECT_EQ(pool->name(), "shared");
+  EXPECT_EQ(binding.pool(), pool);
+
+  ExecutionConfig config;
+  config.pool = "test_binding";
+  config.threads = 1;
+  binding.configure(config);
+  EXPECT_EQ(binding.pool()->name(), "test_binding");
+}
@@ -0,0 +1,179 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: WorkerPoolTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cameras/WorkerPool.hpp"
+
+namespace {
+
+// 让唯一的工作线程停在一个任务上，期间提交的任务按调度顺序排队
+struct Gate {
+  std::promise<void> opened;
+  std::shared_future<void> wait = opened.get_future().share();
+
+  void block(WorkerPool& pool) {
+    std::promise<void> entered;
+    auto ready = entered.get_future();
+    pool.submit([this, &entered]() {
+      entered.set_value();
+      wait.wait();
+    });
+    ready.wait();
+  }
+  void open() { opened.set_value(); }
+};
+
+}  // namespace
+
+TEST(WorkerPoolTests, OrderedLaneRunsSerially) {
+  auto pool = std::make_shared<WorkerPool>("test_ordered", 4,
+                                           std::vector<int>{});
+  LaneOptions options;
+  options.ordered = true;
+  auto lane = pool->create_lane("cam", options);
+
+  std::vector<int> seen;
+  std::atomic<int> running{0};
+  std::atomic<bool> overlapped{false};
+  for (int i = 0; i < 200; ++i) {
+    lane->submit([&, i]() {
+      if (running.fetch_add(1) != 0) {
+        overlapped = true;
+      }
+      seen.push_back(i);
+      running.fetch_sub(1);
+    });
+  }
+  lane.reset();
+  pool.reset();  // 析构时执行完所有任务
+
+  EXPECT_FALSE(overlapped.load());
+  ASSERT_EQ(seen.size(), 200u);
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(seen[i], i);
+  }
+}
+
+TEST(WorkerPoolTests, HigherPriorityAndWeightScheduledFirst) {
+  auto pool = std::make_shared<WorkerPool>("test_priority", 1,
+                                           std::vector<int>{});
+  LaneOptions heavy;
+  heavy.weight = 3;
+  LaneOptions urgent;
+  urgent.priority = 1;
+  auto light_lane = pool->create_lane("light");
+  auto heavy_lane = pool->create_lane("heavy", heavy);
+  auto urgent_lane = pool->create_lane("urgent", urgent);
+
+  std::mutex mutex;
+  std::string order;
+  auto record = [&](char c) {
+    return [&, c]() {
+      std::lock_guard lock(mutex);
+      order.push_back(c);
+    };
+  };
+
+  Gate gate;
+  gate.block(*pool);
+  for (int i = 0; i < 6; ++i) {
+    light_lane->submit(record('l'));
+    heavy_lane->submit(record('h'));
+  }
+  urgent_lane->submit(record('u'));
+  gate.open();
+  light_lane.reset();
+  heavy_lane.reset();
+  urgent_lane.reset();
+  pool.reset();
+
+  ASSERT_EQ(order.size(), 13u);
+  EXPECT_EQ(order[0], 'u');
+  // 前 8 个普通任务里权重 3 的通道占 6 个
+  EXPECT_EQ(std::count(order.begin() + 1, order.begin() + 9, 'h'), 6);
+}
+
+TEST(WorkerPoolTests, IdleWorkersStealBacklog) {
+  auto pool = std::make_shared<WorkerPool>("test_steal", 4,
+                                           std::vector<int>{});
+  auto lane = pool->create_lane("busy");
+
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::atomic<int> started{0};
+  for (int i = 0; i < 4; ++i) {
+    lane->submit([&]() {
+      started.fetch_add(1);
+      released.wait();
+    });
+  }
+  // 一个通道的任务同时占满 4 个工作线程，说明其余线程都在窃取
+  while (started.load() < 4) {
+    std::this_thread::yield();
+  }
+  release.set_value();
+  pool->run_local([]() {});
+
+  auto stats = pool->lane_stats();
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats[1].name, "busy");
+  EXPECT_EQ(stats[1].executed, 4u);
+  EXPECT_EQ(stats[1].stolen, 3u);
+}
+
+// 任务里释放最后一个通道句柄：池改由独立线程析构，不会在工作线程上 join 自己
+TEST(WorkerPoolTests, LaneReleasedInsideTask) {
+  std::weak_ptr<WorkerPool> weak;
+  std::promise<void> ran;
+  auto done = ran.get_future();
+  {
+    auto pool = std::make_shared<WorkerPool>("test_release", 2,
+                                             std::vector<int>{});
+    weak = pool;
+    std::shared_ptr<WorkerPool::Lane> lane = pool->create_lane("owner");
+    auto* raw = lane.get();
+    raw->submit([lane = std::move(lane), &ran]() mutable {
+      lane.reset();
+      ran.set_value();
+    });
+  }
+  ASSERT_EQ(done.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  for (int i = 0; i < 500 && !weak.expired(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_TRUE(weak.expired());
+}
@@ -0,0 +1,233 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FeatureReorderBufferTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cameras/FeatureReorderBuffer.hpp"
+
+namespace {
+
+constexpr std::chrono::milliseconds kShortTimeout{20};
+
+ImageSignalBus::FeatureData make_result(const std::string& camera,
+                                        uint64_t sequence) {
+  ImageSignalBus::FeatureData data;
+  data.camera_id = camera;
+  data.sequence = sequence;
+  data.features.emplace_back(1, static_cast<float>(sequence));
+  return data;
+}
+
+// 记录放出顺序，结果按相机分开
+struct Released {
+  std::mutex mutex;
+  std::map<std::string, std::vector<uint64_t>> sequences;
+
+  FeatureReorderBuffer::Handler handler() {
+    return [this](const ImageSignalBus::FeatureData& data) {
+      std::lock_guard lock(mutex);
+      sequences[data.camera_id].push_back(data.sequence);
+    };
+  }
+};
+
+// 关闭后台检查，超时只在 push/poll 时判断，测试结果确定
+FeatureReorderConfig make_config(size_t window) {
+  FeatureReorderConfig config;
+  config.window = window;
+  config.timeout = kShortTimeout;
+  config.watchdog = false;
+  return config;
+}
+
+// 送入第一个结果并等它作为起点放出
+void anchor(FeatureReorderBuffer& buffer, const std::string& camera,
+            uint64_t sequence) {
+  buffer.push(make_result(camera, sequence));
+  std::this_thread::sleep_for(kShortTimeout * 2);
+  buffer.poll();
+}
+
+}  // namespace
+
+TEST(FeatureReorderBufferTests, ReleasesOutOfOrderResultsInCaptureOrder) {
+  Released released;
+  FeatureReorderBuffer buffer(released.handler(), make_config(16));
+  anchor(buffer, "cam0", 1);
+
+  buffer.push(make_result("cam0", 4));
+  buffer.push(make_result("cam0", 3));
+  EXPECT_EQ(released.sequences["cam0"], (std::vector<uint64_t>{1}));
+  buffer.push(make_result("cam0", 2));
+  EXPECT_EQ(released.sequences["cam0"], (std::vector<uint64_t>{1, 2, 3, 4}));
+
+  // 没有采集序号的结果不参与排序
+  buffer.push(make_result("cam0", 0));
+  EXPECT_EQ(released.sequences["cam0"].back(), 0u);
+
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.released, 5u);
+  EXPECT_EQ(stats.reordered, 2u);
+  EXPECT_EQ(stats.unsequenced, 1u);
+  EXPECT_EQ(stats.pending, 0u);
+}
+
+TEST(FeatureReorderBufferTests, GapIsSkippedAfterTimeoutAndLateResultDropped) {
+  Released released;
+  FeatureReorderBuffer buffer(released.handler(), make_config(16));
+  anchor(buffer, "cam0", 1);
+
+  buffer.push(make_result("cam0", 3));
+  EXPECT_EQ(buffer.stats().pending, 1u);
+  std::this_thread::sleep_for(kShortTimeout * 2);
+  buffer.poll();
+  EXPECT_EQ(released.sequences["cam0"], (std::vector<uint64_t>{1, 3}));
+
+  buffer.push(make_result("cam0", 2));
+  EXPECT_EQ(released.sequences["cam0"], (std::vector<uint64_t>{1, 3}));
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.skipped, 1u);
+  EXPECT_EQ(stats.late, 1u);
+}
+
+TEST(FeatureReorderBufferTests, FullWindowStopsWaitingForGap) {
+  Released released;
+  FeatureReorderConfig config = make_config(4);
+  config.timeout = std::chrono::seconds(60);
+  FeatureReorderBuffer buffer(released.handler(), config);
+
+  // 首个结果暂存到超时才作为起点，这里靠窗口溢出确定起点
+  for (uint64_t seq : {2, 3, 5}) {
+    buffer.push(make_result("cam0", seq));
+  }
+  EXPECT_TRUE(released.sequences["cam0"].empty());
+  buffer.push(make_result("cam0", 6));
+  EXPECT_EQ(released.sequences["cam0"], (std::vector<uint64_t>{2, 3}));
+  buffer.push(make_result("cam0", 7));
+  EXPECT_EQ(released.sequences["cam0"], (std::vector<uint64_t>{2, 3}));
+  buffer.push(make_result("cam0", 8));
+  EXPECT_EQ(released.sequences["cam0"],
+            (std::vector<uint64_t>{2, 3, 5, 6, 7, 8}));
+  EXPECT_EQ(buffer.stats().skipped, 1u);
+
+  // 停止时不再等待缺口
+  buffer.push(make_result("cam0", 10));
+  buffer.flush();
+  EXPECT_EQ(released.sequences["cam0"].back(), 10u);
+  EXPECT_EQ(buffer.stats().pending, 0u);
+}
+
+TEST(FeatureReorderBufferTests, ConcurrentProducersKeepPerCameraOrder) {
+  constexpr uint64_t kResults = 2000;
+  constexpr int kThreads = 4;
+  const std::vector<std::string> cameras = {"cam0", "cam1"};
+
+  Released released;
+  FeatureReorderConfig config;
+  // 各线程进度不一，窗口覆盖全部序号，只验证顺序
+  config.window = kResults * 2;
+  config.timeout = std::chrono::seconds(5);
+  FeatureReorderBuffer buffer(released.handler(), config);
+  for (const auto& camera : cameras) {
+    buffer.push(make_result(camera, 1));
+  }
+  buffer.flush();
+
+  // 每个线程负责一部分序号，局部打乱后推送，模拟并行处理的乱序完成
+  std::vector<std::thread> producers;
+  for (int t = 0; t < kThreads; ++t) {
+    producers.emplace_back([&, t]() {
+      std::vector<std::pair<std::string, uint64_t>> work;
+      for (uint64_t seq = 2 + t; seq <= kResults; seq += kThreads) {
+        for (const auto& camera : cameras) {
+          work.emplace_back(camera, seq);
+        }
+      }
+      std::mt19937 rng(t);
+      for (size_t i = 0; i + 8 <= work.size(); i += 8) {
+        std::shuffle(work.begin() + i, work.begin() + i + 8, rng);
+      }
+      for (const auto& [camera, seq] : work) {
+        buffer.push(make_result(camera, seq));
+      }
+    });
+  }
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.skipped, 0u);
+  EXPECT_EQ(stats.late, 0u);
+  EXPECT_EQ(stats.pending, 0u);
+  for (const auto& camera : cameras) {
+    const auto& sequences = released.sequences[camera];
+    ASSERT_EQ(sequences.size(), kResults);
+    for (uint64_t i = 0; i < kResults; ++i) {
+      EXPECT_EQ(sequences[i], i + 1);
+    }
+  }
+}
+
+// 两台相机上报同一个 camera_id（如驱动写死的 ID），按流水线编号各自排序
+TEST(FeatureReorderBufferTests, StreamsSharingCameraIdKeepSeparateWindows) {
+  std::map<uint64_t, std::vector<uint64_t>> sequences;
+  FeatureReorderBuffer buffer(
+      [&sequences](const ImageSignalBus::FeatureData& data) {
+        sequences[data.stream_id].push_back(data.sequence);
+      },
+      make_config(16));
+  auto push = [&buffer](uint64_t stream, uint64_t sequence) {
+    auto data = make_result("DVP_Camera", sequence);
+    data.stream_id = stream;
+    buffer.push(std::move(data));
+  };
+
+  push(1, 1);
+  push(2, 1);
+  std::this_thread::sleep_for(kShortTimeout * 2);
+  buffer.poll();
+
+  push(1, 3);
+  push(2, 2);
+  push(1, 2);
+  push(2, 3);
+
+  EXPECT_EQ(sequences[1], (std::vector<uint64_t>{1, 2, 3}));
+  EXPECT_EQ(sequences[2], (std::vector<uint64_t>{1, 2, 3}));
+  const auto stats = buffer.stats();
+  EXPECT_EQ(stats.late, 0u);
+  EXPECT_EQ(stats.skipped, 0u);
+}
@@ -0,0 +1,120 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameDerivedCacheTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cameras/FrameDerivedCache.hpp"
+#include "cameras/FrameProcessor.hpp"
+
+// 多个线程同时请求同一个键，只计算一次，所有线程拿到同一份结果
+TEST(FrameDerivedCacheTests, ConcurrentRequestsComputeOnce) {
+  FrameDerivedCache cache;
+  std::atomic<int> computed{0};
+  std::atomic<bool> go{false};
+
+  constexpr int kThreads = 8;
+  std::vector<std::shared_ptr<const int>> results(kThreads);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      while (!go.load()) {
+        std::this_thread::yield();
+      }
+      results[i] = cache.get_or_compute<int>("value", [&computed]() {
+        ++computed;
+        // 拉长计算时间，让其余线程都进入等待
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return 42;
+      });
+    });
+  }
+  go.store(true);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(computed.load(), 1);
+  for (const auto& result : results) {
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result.get(), results[0].get());
+    EXPECT_EQ(*result, 42);
+  }
+}
+
+// 计算抛异常时不缓存，下次请求重新计算
+TEST(FrameDerivedCacheTests, FailedComputeIsRetried) {
+  FrameDerivedCache cache;
+  EXPECT_THROW(cache.get_or_compute<int>(
+                   "value", []() -> int { throw std::runtime_error("boom"); }),
+               std::runtime_error);
+  EXPECT_FALSE(cache.find<int>("value"));
+
+  auto value = cache.get_or_compute<int>("value", []() { return 7; });
+  ASSERT_TRUE(value);
+  EXPECT_EQ(*value, 7);
+}
+
+// 同一个键以不同类型请求时返回空，find() 不触发计算
+TEST(FrameDerivedCacheTests, TypeMismatchAndFind) {
+  FrameDerivedCache cache;
+  EXPECT_FALSE(cache.find<int>("value"));
+
+  cache.put<int>("value", std::make_shared<const int>(3));
+  EXPECT_FALSE(cache.get_or_compute<double>("value", []() { return 1.0; }));
+  EXPECT_FALSE(cache.find<double>("value"));
+  ASSERT_TRUE(cache.find<int>("value"));
+  EXPECT_EQ(*cache.find<int>("value"), 3);
+
+  // 键已存在时 put() 保留原值
+  cache.put<int>("value", std::make_shared<const int>(4));
+  EXPECT_EQ(*cache.find<int>("value"), 3);
+}
+
+// 缓存随帧释放；拷贝帧时不复制缓存，赋值时旧缓存失效
+TEST(FrameDerivedCacheTests, LifetimeFollowsFrame) {
+  std::weak_ptr<const int> cached;
+  {
+    auto frame = std::make_shared<CapturedFrame>();
+    cached = frame->derived.get_or_compute<int>("value", []() { return 1; });
+    EXPECT_FALSE(cached.expired());
+
+    CapturedFrame copy = *frame;
+    EXPECT_FALSE(copy.derived.find<int>("value"));
+
+    copy.derived.put<int>("other", std::make_shared<const int>(2));
+    copy = *frame;
+    EXPECT_FALSE(copy.derived.find<int>("other"));
+  }
+  EXPECT_TRUE(cached.expired());
+}
@@ -0,0 +1,205 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FramePipelineTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "cameras/FramePipeline.hpp"
+
+namespace {
+
+// 延迟执行器：任务先攒起来，由测试手动运行，便于构造积压场景
+struct DeferredExecutor {
+  std::vector<FramePipeline::Task> tasks;
+
+  FramePipeline::Executor executor() {
+    return [this](FramePipeline::Task task) { tasks.push_back(std::move(task)); };
+  }
+
+  // 流水线每个任务处理一帧后重新提交，运行到没有新任务为止
+  void run_all() {
+    while (!tasks.empty()) {
+      auto pending = std::move(tasks);
+      tasks.clear();
+      for (auto& task : pending) {
+        task();
+      }
+    }
+  }
+};
+
+std::shared_ptr<CapturedFrame> make_frame(int id) {
+  auto frame = std::make_shared<CapturedFrame>();
+  frame->meta.iWidth = id;
+  return frame;
+}
+
+FramePipelineConfig make_config(FrameOverflowPolicy policy, size_t capacity) {
+  FramePipelineConfig config;
+  config.capacity = capacity;
+  config.max_in_flight = 1;
+  config.policy = policy;
+  return config;
+}
+
+}  // namespace
+
+// 队列满时丢弃最旧的帧，处理的是最新的几帧
+TEST(FramePipelineTests, DropOldestKeepsNewestFrames) {
+  DeferredExecutor exec;
+  std::vector<int> seen;
+  FramePipeline pipeline(
+      exec.executor(),
+      [&seen](const std::shared_ptr<CapturedFrame>& f) {
+        seen.push_back(f->meta.iWidth);
+      },
+      make_config(FrameOverflowPolicy::DropOldest, 2));
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(pipeline.push(make_frame(i)));
+  }
+  exec.run_all();
+
+  EXPECT_EQ(seen, (std::vector<int>{3, 4}));
+  auto stats = pipeline.stats();
+  EXPECT_EQ(stats.enqueued, 5u);
+  EXPECT_EQ(stats.dropped, 3u);
+  EXPECT_EQ(stats.processed, 2u);
+  EXPECT_EQ(stats.depth, 0u);
+  EXPECT_EQ(stats.high_water, 2u);
+}
+
+// 队列满时拒绝新帧，已排队的帧全部处理
+TEST(FramePipelineTests, DropNewestRejectsIncomingFrames) {
+  DeferredExecutor exec;
+  std::vector<int> seen;
+  FramePipeline pipeline(
+      exec.executor(),
+      [&seen](const std::shared_ptr<CapturedFrame>& f) {
+        seen.push_back(f->meta.iWidth);
+      },
+      make_config(FrameOverflowPolicy::DropNewest, 2));
+
+  EXPECT_TRUE(pipeline.push(make_frame(0)));
+  EXPECT_TRUE(pipeline.push(make_frame(1)));
+  EXPECT_FALSE(pipeline.push(make_frame(2)));
+  exec.run_all();
+
+  EXPECT_EQ(seen, (std::vector<int>{0, 1}));
+  auto stats = pipeline.stats();
+  EXPECT_EQ(stats.enqueued, 2u);
+  EXPECT_EQ(stats.dropped, 1u);
+  EXPECT_EQ(stats.processed, 2u);
+}
+
+// 抽帧策略每 N 帧只处理 1 帧
+TEST(FramePipelineTests, SampleEveryNthFrame) {
+  DeferredExecutor exec;
+  std::vector<int> seen;
+  auto config = make_config(FrameOverflowPolicy::SampleEveryN, 16);
+  config.sample_interval = 3;
+  FramePipeline pipeline(
+      exec.executor(),
+      [&seen](const std::shared_ptr<CapturedFrame>& f) {
+        seen.push_back(f->meta.iWidth);
+      },
+      config);
+
+  for (int i = 0; i < 9; ++i) {
+    pipeline.push(make_frame(i));
+  }
+  exec.run_all();
+
+  EXPECT_EQ(seen, (std::vector<int>{0, 3, 6}));
+  EXPECT_EQ(pipeline.stats().dropped, 6u);
+}
+
+// 序号在出队时分配，被丢弃的帧不占序号，下游重排不会等待缺口
+TEST(FramePipelineTests, SequenceSkipsDroppedFrames) {
+  DeferredExecutor exec;
+  std::vector<uint64_t> sequences;
+  std::vector<int> seen;
+  FramePipeline pipeline(
+      exec.executor(),
+      [&](const std::shared_ptr<CapturedFrame>& f) {
+        sequences.push_back(f->meta.sequence);
+        seen.push_back(f->meta.iWidth);
+      },
+      make_config(FrameOverflowPolicy::DropOldest, 2));
+
+  for (int i = 0; i < 5; ++i) {
+    pipeline.push(make_frame(i));
+  }
+  exec.run_all();
+  pipeline.push(make_frame(5));
+  exec.run_all();
+
+  EXPECT_EQ(seen, (std::vector<int>{3, 4, 5}));
+  EXPECT_EQ(sequences, (std::vector<uint64_t>{1, 2, 3}));
+}
+
+// 运行时缩小容量保留最新的帧
+TEST(FramePipelineTests, ShrinkKeepsNewestFrames) {
+  DeferredExecutor exec;
+  std::vector<int> seen;
+  FramePipeline pipeline(
+      exec.executor(),
+      [&seen](const std::shared_ptr<CapturedFrame>& f) {
+        seen.push_back(f->meta.iWidth);
+      },
+      make_config(FrameOverflowPolicy::DropOldest, 4));
+
+  for (int i = 0; i < 4; ++i) {
+    pipeline.push(make_frame(i));
+  }
+  pipeline.set_config(make_config(FrameOverflowPolicy::DropOldest, 2));
+  exec.run_all();
+
+  EXPECT_EQ(seen, (std::vector<int>{2, 3}));
+  EXPECT_EQ(pipeline.stats().dropped, 2u);
+}
+
+// 停止后不再接收新帧，重新 start 后恢复
+TEST(FramePipelineTests, StopRejectsUntilRestarted) {
+  DeferredExecutor exec;
+  int processed = 0;
+  FramePipeline pipeline(
+      exec.executor(),
+      [&processed](const std::shared_ptr<CapturedFrame>&) { ++processed; },
+      make_config(FrameOverflowPolicy::DropOldest, 4));
+
+  pipeline.push(make_frame(0));
+  exec.run_all();
+  pipeline.stop();
+  EXPECT_FALSE(pipeline.push(make_frame(1)));
+
+  pipeline.start();
+  EXPECT_TRUE(pipeline.push(make_frame(2)));
+  exec.run_all();
+  EXPECT_EQ(processed, 2);
+}
@@ -0,0 +1,84 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FramePoolTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "cameras/FramePool.hpp"
+
+// 帧释放后缓冲区回到池中并被复用
+TEST(FrameBufferPoolTests, ReleasedFrameIsReused) {
+  FrameBufferPool pool(4);
+  auto frame = pool.acquire(1024);
+  ASSERT_EQ(frame->data.size(), 1024u);
+  const uint8_t* buffer = frame->data.data();
+  frame->meta.iWidth = 32;
+
+  frame.reset();
+  EXPECT_EQ(pool.cached_count(1024), 1u);
+
+  auto again = pool.acquire(1024);
+  EXPECT_EQ(again->data.data(), buffer);
+  EXPECT_EQ(again->meta.iWidth, 0);  // 元信息已清空
+  EXPECT_EQ(pool.stats().hits, 1u);
+  EXPECT_EQ(pool.stats().misses, 1u);
+}
+
+// 预分配后首帧即可命中
+TEST(FrameBufferPoolTests, ReserveWarmsBucket) {
+  FrameBufferPool pool(8);
+  pool.reserve(4096, 3);
+  EXPECT_EQ(pool.cached_count(4096), 3u);
+
+  auto frame = pool.acquire(4096);
+  EXPECT_EQ(pool.stats().misses, 0u);
+  EXPECT_EQ(pool.cached_count(4096), 2u);
+}
+
+// 不同尺寸分桶，超过上限的帧直接释放
+TEST(FrameBufferPoolTests, BucketsAreBoundedPerSize) {
+  FrameBufferPool pool(1);
+  auto a = pool.acquire(16);
+  auto b = pool.acquire(16);
+  auto c = pool.acquire(32);
+  a.reset();
+  b.reset();
+  c.reset();
+  EXPECT_EQ(pool.cached_count(16), 1u);
+  EXPECT_EQ(pool.cached_count(32), 1u);
+}
+
+// 池先析构时，未归还的帧仍然有效
+TEST(FrameBufferPoolTests, FrameOutlivesPool) {
+  std::shared_ptr<CapturedFrame> frame;
+  {
+    FrameBufferPool pool;
+    frame = pool.acquire(64);
+  }
+  frame->data[0] = 1;
+  EXPECT_EQ(frame->data.size(), 64u);
+}
@@ -0,0 +1,121 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameProductsTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include <opencv2/core.hpp>
+
+#include "algo/FrameProducts.hpp"
+#include "cameras/FramePool.hpp"
+
+namespace {
+
+void fill_mono(CapturedFrame& frame, int width, int height) {
+  frame.data.assign(static_cast<size_t>(width) * height, 0);
+  for (size_t i = 0; i < frame.data.size(); ++i) {
+    frame.data[i] = static_cast<uint8_t>(i % 251);
+  }
+  frame.meta.iWidth = width;
+  frame.meta.iHeight = height;
+}
+
+}  // namespace
+
+// 单通道帧的灰度图直接引用帧缓冲区，重复请求拿到同一份结果
+TEST(FrameProductsTests, MonoGrayIsSharedView) {
+  CapturedFrame frame;
+  fill_mono(frame, 64, 32);
+
+  auto gray = algo::frame_gray(frame);
+  ASSERT_TRUE(gray);
+  EXPECT_EQ(gray->data, frame.data.data());
+  EXPECT_EQ(gray->cols, 64);
+  EXPECT_EQ(gray->rows, 32);
+  EXPECT_EQ(algo::frame_gray(frame).get(), gray.get());
+
+  // 内容区域是灰度图的视图，小图不裁剪
+  auto content = algo::frame_content_gray(frame);
+  ASSERT_TRUE(content);
+  EXPECT_EQ(content->data, gray->data);
+  EXPECT_EQ(content->cols, 64);
+
+  auto histogram = algo::frame_histogram(frame);
+  ASSERT_TRUE(histogram);
+  uint64_t total = 0;
+  for (uint32_t count : *histogram) {
+    total += count;
+  }
+  EXPECT_EQ(total, frame.data.size());
+  EXPECT_EQ(algo::frame_histogram(frame).get(), histogram.get());
+}
+
+// 拷贝出的帧不带缓存，派生数据按新缓冲区重新计算
+TEST(FrameProductsTests, CopiedFrameRecomputes) {
+  CapturedFrame frame;
+  fill_mono(frame, 16, 16);
+  auto gray = algo::frame_gray(frame);
+
+  CapturedFrame copy = frame;
+  auto copy_gray = algo::frame_gray(copy);
+  ASSERT_TRUE(copy_gray);
+  EXPECT_NE(copy_gray.get(), gray.get());
+  EXPECT_EQ(copy_gray->data, copy.data.data());
+}
+
+// 派生数据随帧释放，调用方只持有弱引用时不会延长其生命周期
+TEST(FrameProductsTests, ProductsReleasedWithFrame) {
+  std::weak_ptr<const cv::Mat> gray;
+  std::weak_ptr<const algo::GrayHistogram> histogram;
+  {
+    auto frame = std::make_shared<CapturedFrame>();
+    fill_mono(*frame, 16, 16);
+    gray = algo::frame_gray(*frame);
+    histogram = algo::frame_histogram(*frame);
+    EXPECT_FALSE(gray.expired());
+    EXPECT_FALSE(histogram.expired());
+  }
+  EXPECT_TRUE(gray.expired());
+  EXPECT_TRUE(histogram.expired());
+}
+
+// 池化帧归还时清空派生数据，再次取出的帧重新计算
+TEST(FrameProductsTests, PooledFrameDropsProductsOnRecycle) {
+  FrameBufferPool pool(1);
+  std::weak_ptr<const cv::Mat> gray;
+  {
+    auto frame = pool.acquire(16 * 16);
+    fill_mono(*frame, 16, 16);
+    gray = algo::frame_gray(*frame);
+    EXPECT_FALSE(gray.expired());
+  }
+  EXPECT_TRUE(gray.expired());
+
+  auto frame = pool.acquire(16 * 16);
+  EXPECT_EQ(pool.stats().hits, 1u);
+  EXPECT_FALSE(frame->derived.find<cv::Mat>("gray"));
+}
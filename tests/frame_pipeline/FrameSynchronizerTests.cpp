@@ -0,0 +1,160 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameSynchronizerTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "cameras/FrameSynchronizer.hpp"
+#include "cameras/MultiCameraCoordinator.hpp"
+
+namespace {
+
+constexpr std::chrono::milliseconds kShortTimeout{20};
+
+std::shared_ptr<CapturedFrame> make_frame(uint64_t timestamp) {
+  auto frame = std::make_shared<CapturedFrame>();
+  frame->meta.uTimestamp = timestamp;
+  return frame;
+}
+
+// 关闭后台检查，超时只在 push/poll 时判断，测试结果确定
+FrameSyncConfig make_config(SyncTimeoutPolicy policy,
+                            std::chrono::milliseconds timeout) {
+  FrameSyncConfig config;
+  config.tolerance = 100;
+  config.timeout = timeout;
+  config.timeout_policy = policy;
+  config.watchdog = false;
+  config.in_order = true;
+  return config;
+}
+
+}  // namespace
+
+TEST(FrameSynchronizerTests, MatchesWithinToleranceWithoutCopy) {
+  std::vector<SyncedFrameSet> sets;
+  FrameSynchronizer sync(
+      2, [&](const SyncedFrameSet& set) { sets.push_back(set); },
+      make_config(SyncTimeoutPolicy::EmitPartial, std::chrono::hours(1)));
+
+  auto a0 = make_frame(1000);
+  auto a1 = make_frame(2000);
+  sync.push(0, a0);
+  sync.push(0, a1);
+  EXPECT_TRUE(sets.empty());
+  sync.push(1, make_frame(1050));
+  sync.push(1, make_frame(2030));
+
+  ASSERT_EQ(sets.size(), 2u);
+  EXPECT_EQ(sets[0].frames[0].get(), a0.get());
+  EXPECT_EQ(sets[0].key, 1000u);
+  EXPECT_EQ(sets[0].skew, 50u);
+  EXPECT_FALSE(sets[0].partial);
+  EXPECT_EQ(sets[1].frames[0].get(), a1.get());
+  EXPECT_EQ(sets[1].skew, 30u);
+
+  auto stats = sync.stats();
+  EXPECT_EQ(stats.complete_sets, 2u);
+  EXPECT_EQ(stats.skew.count, 2u);
+}
+
+TEST(FrameSynchronizerTests, MissingCameraEmitsPartialSet) {
+  std::vector<SyncedFrameSet> sets;
+  FrameSynchronizer sync(
+      2, [&](const SyncedFrameSet& set) { sets.push_back(set); },
+      make_config(SyncTimeoutPolicy::EmitPartial, kShortTimeout));
+
+  // 相机 1 直接送来下一组的帧，第一组不可能再凑齐
+  sync.push(0, make_frame(1000));
+  sync.push(1, make_frame(2000));
+  ASSERT_EQ(sets.size(), 1u);
+  EXPECT_TRUE(sets[0].partial);
+  EXPECT_NE(sets[0].frames[0], nullptr);
+  EXPECT_EQ(sets[0].frames[1], nullptr);
+
+  // 只有一个相机到达的一组超时后发出
+  sync.poll();
+  EXPECT_EQ(sets.size(), 1u);
+  std::this_thread::sleep_for(kShortTimeout * 2);
+  sync.poll();
+  ASSERT_EQ(sets.size(), 2u);
+  EXPECT_EQ(sets[1].key, 2000u);
+  EXPECT_EQ(sync.stats().partial_sets, 2u);
+}
+
+TEST(FrameSynchronizerTests, DropPolicyCountsDroppedSetsAndLateFrames) {
+  size_t delivered = 0;
+  FrameSynchronizer sync(
+      2, [&](const SyncedFrameSet&) { ++delivered; },
+      make_config(SyncTimeoutPolicy::DropIncomplete, kShortTimeout));
+
+  sync.push(0, make_frame(1000));
+  std::this_thread::sleep_for(kShortTimeout * 2);
+  sync.poll();
+  // 所属的组已经丢弃，迟到的帧不再参与匹配
+  sync.push(1, make_frame(1020));
+  sync.push(0, make_frame(2000));
+  sync.push(1, make_frame(2010));
+
+  auto stats = sync.stats();
+  EXPECT_EQ(delivered, 1u);
+  EXPECT_EQ(stats.complete_sets, 1u);
+  EXPECT_EQ(stats.dropped_sets, 1u);
+  EXPECT_EQ(stats.dropped_frames, 1u);
+}
+
+TEST(MultiCameraCoordinatorTests, FusesSyncedFramesForDownstream) {
+  std::vector<uint64_t> fused_keys;
+  MultiCameraCoordinator coordinator(
+      2,
+      [](const SyncedFrameSet& set) {
+        CapturedFrame fused;
+        fused.meta.uTimestamp = set.key;
+        return fused;
+      },
+      make_config(SyncTimeoutPolicy::EmitPartial, std::chrono::hours(1)));
+  coordinator.set_downstream_processor(
+      std::make_unique<FunctionFrameProcessor<
+          std::function<void(const CapturedFrame&)>>>(
+          [&](const CapturedFrame& frame) {
+            fused_keys.push_back(frame.meta.uTimestamp);
+          }));
+
+  // 相机按基类保存处理器，复制后仍需送到同一个同步器
+  std::shared_ptr<FrameProcessor> cam0 = coordinator[0].clone();
+  std::shared_ptr<FrameProcessor> cam1 = coordinator[1].clone();
+  cam0->process_shared(make_frame(500));
+  cam1->process(*make_frame(520));
+
+  ASSERT_EQ(fused_keys.size(), 1u);
+  EXPECT_EQ(fused_keys[0], 500u);
+  EXPECT_EQ(coordinator.stats().complete_sets, 1u);
+}
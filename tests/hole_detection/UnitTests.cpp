@@ -23,3 +23,245 @@
  *  - Username: Administrator
  *  - CopyrightYear: 2026
  */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <opencv2/imgproc.hpp>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "algo/FrameProducts.hpp"
+#include "algo/HoleDetection.hpp"
+#include "algo/HoleMerge.hpp"
+#include "algo/PartitionThreshold.hpp"
+#include "algo/StreamingHoleLabeler.hpp"
+#include "cameras/ImageSignalBus.hpp"
+
+namespace {
+
+algo::HoleDetection::Config make_config(const std::string& tiling_mode,
+                                        int tile_count) {
+  algo::HoleDetection::Config cfg;
+  cfg.pixel_per_mm = 50.0f;
+  cfg.enable_real_world_calculation = true;
+  cfg.min_defect_area = 1;
+  cfg.edge_margin = 10;
+  cfg.merge_distance_threshold = 20;
+  cfg.pixel_to_mm_width = 0.05586f;
+  cfg.pixel_to_mm_height = 0.061f;
+  cfg.partition_params = "0.3 0.4 0.3 20 23 20";
+  cfg.tiling_mode = tiling_mode;
+  cfg.tile_count = tile_count;
+  return cfg;
+}
+
+// 暗背景上随机撒亮斑，其中一部分横跨分块接缝
+CapturedFrame make_frame() {
+  cv::Mat image(1200, 3000, CV_8UC3, cv::Scalar::all(0));
+  cv::RNG rng(20260101);
+  for (int i = 0; i < 400; ++i) {
+    cv::Point center(rng.uniform(20, image.cols - 20),
+                     rng.uniform(20, image.rows - 20));
+    int radius = rng.uniform(1, 8);
+    cv::circle(image, center, radius, cv::Scalar::all(rng.uniform(21, 255)),
+               -1);
+  }
+  for (int seam = 375; seam < image.cols; seam += 375) {
+    cv::line(image, cv::Point(seam - 4, 100), cv::Point(seam + 4, 140),
+             cv::Scalar::all(200), 2);
+  }
+  cv::line(image, cv::Point(500, 598), cv::Point(540, 602),
+           cv::Scalar::all(200), 1);
+
+  CapturedFrame frame;
+  frame.meta.iWidth = image.cols;
+  frame.meta.iHeight = image.rows;
+  frame.data.assign(image.data, image.data + image.total() * 3);
+  return frame;
+}
+
+// HoleDetection 通过默认总线发出特征，订阅一次并记录最近一次结果
+ImageSignalBus::FeatureData& latest_features() {
+  static ImageSignalBus::FeatureData latest{};
+  static const bool subscribed = [] {
+    ImageSignalBus::instance().subscribe_feature(
+        "hole_features",
+        [](const ImageSignalBus::FeatureData& data) { latest = data; });
+    return true;
+  }();
+  (void)subscribed;
+  return latest;
+}
+
+ImageSignalBus::FeatureData run(const algo::HoleDetection::Config& cfg,
+                                const CapturedFrame& frame) {
+  auto& latest = latest_features();
+  latest = ImageSignalBus::FeatureData{};
+  algo::HoleDetection detector(cfg);
+  detector.initialize();
+  detector.process(frame);
+  return latest;
+}
+
+}  // namespace
+
+// 分块标记的结果必须与整图单次标记逐项一致
+TEST(HoleDetectionTests, TiledLabelingMatchesSinglePass) {
+  CapturedFrame frame = make_frame();
+  auto baseline = run(make_config("none", 0), frame);
+  ASSERT_FALSE(baseline.features.empty());
+
+  for (const char* mode : {"vertical", "horizontal"}) {
+    for (int tiles : {2, 3, 8}) {
+      auto tiled = run(make_config(mode, tiles), frame);
+      EXPECT_EQ(tiled.features, baseline.features) << mode << " x" << tiles;
+      EXPECT_EQ(tiled.special_images, baseline.special_images)
+          << mode << " x" << tiles;
+    }
+  }
+}
+
+// 融合行内核与三段依次 cv::threshold 的结果一致，包括越界阈值和非对齐宽度
+TEST(HoleDetectionTests, FusedPartitionThresholdMatchesOpenCV) {
+  cv::Mat image(37, 1013, CV_8UC1);
+  cv::randu(image, 0, 256);
+
+  for (int mid_thresh : {-1, 0, 23, 128, 254, 255, 300}) {
+    algo::PartitionConfig params;
+    params.mid_thresh = mid_thresh;
+    algo::PartitionBands bands =
+        algo::make_partition_bands(image.cols, params);
+
+    cv::Mat expected(image.size(), CV_8UC1);
+    const int cols[4] = {0, bands.left_end, bands.mid_end, image.cols};
+    const int thresh[3] = {params.left_thresh, params.mid_thresh,
+                           params.right_thresh};
+    for (int k = 0; k < 3; ++k) {
+      cv::Mat dst = expected.colRange(cols[k], cols[k + 1]);
+      cv::threshold(image.colRange(cols[k], cols[k + 1]), dst, thresh[k], 255,
+                    cv::THRESH_BINARY);
+    }
+
+    cv::Mat fused = algo::threshold_partitioned(image, bands);
+    EXPECT_EQ(cv::countNonZero(fused != expected), 0) << mid_thresh;
+  }
+}
+
+// 合并以种子为中心，不做传递闭包：链状分布的孔洞不会被一次并成一组
+TEST(HoleDetectionTests, MergeCloseHolesUsesSeedRadius) {
+  std::vector<algo::HoleInfo> holes(3);
+  for (int i = 0; i < 3; ++i) {
+    holes[i].index = i + 1;
+    holes[i].center = cv::Point(100 + 15 * i, 200);
+    holes[i].pixel_diameter = 2.0;
+    holes[i].area = 4;
+    holes[i].width = 2;
+    holes[i].height = 2;
+    holes[i].top_y = 199;
+    holes[i].bottom_y = 201;
+  }
+
+  auto merged = algo::merge_close_holes(holes, 20, make_config("none", 0));
+  ASSERT_EQ(merged.size(), 2u);
+  EXPECT_TRUE(merged[0].merged);
+  EXPECT_EQ(merged[0].merged_count, 2);
+  EXPECT_EQ(merged[0].area, 8);
+  EXPECT_EQ(merged[1].center, cv::Point(130, 200));
+  EXPECT_EQ(merged[1].index, 2);
+}
+
+// 按任意行块切分喂入，闭合的连通域与整幅图一次标记的结果相同
+TEST(HoleDetectionTests, StreamingLabelerMatchesWholeImage) {
+  cv::Mat image(240, 640, CV_8UC1);
+  cv::randu(image, 0, 40);
+  cv::line(image, cv::Point(30, 10), cv::Point(600, 230), cv::Scalar(255), 2);
+
+  algo::PartitionConfig params;
+  algo::PartitionBands bands = algo::make_partition_bands(image.cols, params);
+  cv::Mat binary = algo::threshold_partitioned(image, bands);
+
+  using Key = std::tuple<int64_t, int, int64_t, int, int64_t, int64_t>;
+  std::vector<Key> expected;
+  cv::Mat labels, stats, centroids;
+  int n = cv::connectedComponentsWithStats(binary, labels, stats, centroids, 8,
+                                           CV_32S);
+  for (int i = 1; i < n; ++i) {
+    int64_t area = stats.at<int>(i, cv::CC_STAT_AREA);
+    int left = stats.at<int>(i, cv::CC_STAT_LEFT);
+    int top = stats.at<int>(i, cv::CC_STAT_TOP);
+    expected.emplace_back(
+        area, left, static_cast<int64_t>(top),
+        left + stats.at<int>(i, cv::CC_STAT_WIDTH) - 1,
+        std::llround(centroids.at<double>(i, 0) * area),
+        std::llround(centroids.at<double>(i, 1) * area));
+  }
+  std::sort(expected.begin(), expected.end());
+
+  for (int block : {1, 7, 64, 240}) {
+    std::vector<Key> closed;
+    auto collect = [&closed](const algo::StreamingComponent& comp) {
+      closed.emplace_back(comp.area, comp.left, comp.top, comp.right,
+                          comp.sum_x, comp.sum_y);
+    };
+    algo::StreamingHoleLabeler labeler;
+    labeler.reset(image.cols, bands);
+    for (int r = 0; r < image.rows; r += block) {
+      labeler.push_rows(image.rowRange(r, std::min(image.rows, r + block)),
+                        collect);
+    }
+    labeler.finish(collect);
+    EXPECT_EQ(labeler.open_components(), 0u);
+
+    std::sort(closed.begin(), closed.end());
+    EXPECT_EQ(closed, expected) << "block " << block;
+  }
+}
+
+// 每处理一帧，各阶段直方图都各记录一次
+TEST(HoleDetectionTests, StageLatencyRecordedPerFrame) {
+  CapturedFrame frame = make_frame();
+  algo::HoleDetection detector(make_config("none", 0));
+  detector.initialize();
+  detector.process(frame);
+  detector.process(frame);
+
+  auto stages = detector.get_stage_latency();
+  ASSERT_EQ(stages.size(),
+            static_cast<size_t>(algo::HoleDetectionStage::Count));
+  for (const auto& stage : stages) {
+    EXPECT_EQ(stage.latency.count, 2u) << stage.stage;
+    EXPECT_LE(stage.latency.p50_ns, stage.latency.max_ns) << stage.stage;
+    EXPECT_LE(stage.latency.p99_ns, stage.latency.max_ns) << stage.stage;
+  }
+  EXPECT_GT(stages.back().latency.max_ns, 0u);
+}
+
+// 派生数据每帧只算一次，裁剪图是灰度图的视图，随帧复制时不带缓存
+TEST(HoleDetectionTests, FrameProductsComputedOncePerFrame) {
+  CapturedFrame frame = make_frame();
+  auto gray = algo::frame_gray(frame);
+  ASSERT_EQ(gray->type(), CV_8UC1);
+  EXPECT_EQ(gray.get(), algo::frame_gray(frame).get());
+
+  auto content = algo::frame_content_gray(frame);
+  EXPECT_EQ(content->rows, frame.height());
+  EXPECT_GE(content->data, gray->data);
+  EXPECT_LT(content->data, gray->data + gray->cols);
+
+  auto half = algo::frame_pyramid(frame, 1);
+  EXPECT_EQ(half->cols, (content->cols + 1) / 2);
+  EXPECT_EQ(half.get(), algo::frame_pyramid(frame, 1).get());
+
+  auto hist = algo::frame_histogram(frame);
+  uint64_t total = 0;
+  for (uint32_t count : *hist) {
+    total += count;
+  }
+  EXPECT_EQ(total, content->total());
+
+  CapturedFrame copy = frame;
+  EXPECT_EQ(copy.derived.find<cv::Mat>("gray"), nullptr);
+}
@@ -67,7 +67,7 @@ class TestDvpCamera : public DvpCameraCapture {
     if (!mock_camera_) return false;
 
     // 存储回调
-    processor_ = std::make_shared<FrameProcessor>(processor);
+    processor_ = processor.clone();
 
     // 注册回调到 Mock 相机
     mock_camera_->registerFrameCallback(processor_);
@@ -94,7 +94,7 @@ class TestDvpCamera : public DvpCameraCapture {
   }
 
   void register_frame_callback(const FrameProcessor& proc) {
-    processor_ = std::make_shared<FrameProcessor>(proc);
+    processor_ = proc.clone();
     if (mock_camera_) {
       mock_camera_->registerFrameCallback(processor_);
     }
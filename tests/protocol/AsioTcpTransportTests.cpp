@@ -0,0 +1,135 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: AsioTcpTransportTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "asio.hpp"
+#include "protocol/AsioTcpTransport.hpp"
+#include "protocol/FrameReader.hpp"
+#include "protocol/LegacyCodec.hpp"
+
+using namespace protocol;
+
+TEST(AsioTcpTransportTests, ConcurrentSendsArriveAsWholeFrames) {
+  constexpr int kThreads = 4;
+  constexpr int kMessagesPerThread = 500;
+
+  asio::io_context io_ctx;
+  auto guard = asio::make_work_guard(io_ctx);
+  asio::ip::tcp::acceptor acceptor(
+      io_ctx, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  const uint16_t port = acceptor.local_endpoint().port();
+
+  // 对端直接读原始字节流，逐条校验报文
+  auto peer = std::async(std::launch::async, [&acceptor]() {
+    LegacyCodec codec;
+    FrameReader reader;
+    auto socket = acceptor.accept();
+    int statuses = 0;
+    int reports = 0;
+    while (statuses + reports < kThreads * kMessagesPerThread) {
+      auto space = reader.prepare();
+      reader.commit(socket.read_some(asio::buffer(space.data(), space.size())));
+      std::span<const uint8_t> frame;
+      FrameReader::Status status;
+      while ((status = reader.next(frame)) == FrameReader::Status::Complete) {
+        if (frame[0] == 'T') {
+          statuses += codec.decode_status(frame).has_value();
+        } else {
+          auto report = codec.decode_features(frame);
+          reports += report && report->features.size() == 3;
+        }
+      }
+      if (status == FrameReader::Status::Invalid) {
+        break;
+      }
+    }
+    return statuses + reports;
+  });
+
+  std::thread io_thread([&io_ctx]() { io_ctx.run(); });
+  AsioTcpTransport transport(io_ctx);
+  std::promise<std::error_code> connected;
+  transport.async_connect("127.0.0.1", port, [&](std::error_code ec) {
+    connected.set_value(ec);
+  });
+  ASSERT_FALSE(connected.get_future().get());
+
+  // 多个线程同时发送状态报文和带分段的特征上报
+  std::atomic<int> completed{0};
+  std::vector<std::thread> senders;
+  for (int t = 0; t < kThreads; ++t) {
+    senders.emplace_back([&transport, &completed]() {
+      LegacyCodec codec;
+      FeatureReport report;
+      report.roll_id = "ROLL";
+      report.features.assign(3, {1, 0.5f});
+      auto keepalive = std::make_shared<FeatureReport>(report);
+      for (int i = 0; i < kMessagesPerThread; ++i) {
+        auto done = [&completed](std::error_code ec) {
+          completed += ec ? 0 : 1;
+        };
+        if (i % 2 == 0) {
+          FrontendStatus status;
+          status.capture = true;
+          auto buffer = std::make_shared<const std::vector<uint8_t>>(
+              codec.encode_status(status));
+          transport.async_send_buffer(buffer, done, MessageClass::Control);
+        } else {
+          auto message = std::make_shared<GatherMessage>();
+          message->count = codec.encode_features_gather(
+              *keepalive, message->scratch, message->segments);
+          message->keepalive = keepalive;
+          transport.async_send_gather(message, done);
+        }
+      }
+    });
+  }
+  for (auto& sender : senders) {
+    sender.join();
+  }
+
+  EXPECT_EQ(peer.get(), kThreads * kMessagesPerThread);
+  transport.close();
+  guard.reset();
+  io_thread.join();
+
+  EXPECT_EQ(completed.load(), kThreads * kMessagesPerThread);
+  const auto stats = transport.send_stats();
+  EXPECT_EQ(stats.messages, static_cast<uint64_t>(kThreads) *
+                                kMessagesPerThread);
+  EXPECT_EQ(stats.queue_depth, 0u);
+  EXPECT_LE(stats.batches, stats.messages);
+  EXPECT_GE(stats.syscalls, stats.batches);
+  EXPECT_GT(stats.bytes_per_syscall(), 0.0);
+}
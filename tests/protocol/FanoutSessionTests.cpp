@@ -0,0 +1,232 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FanoutSessionTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "asio/io_context.hpp"
+#include "protocol/FanoutSession.hpp"
+#include "protocol/LegacyCodec.hpp"
+#include "protocol/ReconnectingTransport.hpp"
+
+using namespace protocol;
+
+namespace {
+
+// 记录交给传输层的报文，写完成由测试手动触发
+struct FakeLink {
+  std::vector<const void*> sent;  // 每条报文的数据地址
+  std::vector<ITransportAdapter::SendCallback> pending;
+
+  void complete_all() {
+    auto callbacks = std::move(pending);
+    pending.clear();
+    for (auto& callback : callbacks) {
+      callback({});
+    }
+  }
+};
+
+class FakeTransport : public ITransportAdapter {
+ public:
+  explicit FakeTransport(FakeLink& link) : link_(link) {}
+
+  void async_connect(const std::string&, uint16_t,
+                     std::function<void(std::error_code)> callback) override {
+    callback({});
+  }
+  void async_send(std::span<const uint8_t> data,
+                  SendCallback callback) override {
+    link_.sent.push_back(data.data());
+    link_.pending.push_back(std::move(callback));
+  }
+  void async_send_buffer(SharedBuffer data, SendCallback callback,
+                         MessageClass) override {
+    link_.sent.push_back(data.get());
+    link_.pending.push_back(std::move(callback));
+  }
+  void async_send_gather(std::shared_ptr<const GatherMessage> message,
+                         SendCallback callback, MessageClass) override {
+    link_.sent.push_back(message.get());
+    link_.pending.push_back(std::move(callback));
+  }
+  void async_receive(ReceiveCallback callback) override {
+    callback(std::make_error_code(std::errc::operation_not_supported), {});
+  }
+  void close() override {}
+
+ private:
+  FakeLink& link_;
+};
+
+FeatureReport make_report() {
+  FeatureReport report;
+  report.roll_id = "ROLL-0042";
+  report.features = {{1, 0.5f}, {2, 1.5f}};
+  report.special_images.fill(0.0f);
+  return report;
+}
+
+}  // namespace
+
+TEST(FanoutSessionTests, EncodesOnceForAllDestinations) {
+  FakeLink main_link;
+  FakeLink backup_link;
+  FanoutSession session(std::make_unique<LegacyCodec>());
+  session.add_destination("main", std::make_unique<FakeTransport>(main_link));
+  session.add_destination("backup",
+                          std::make_unique<FakeTransport>(backup_link));
+
+  std::map<std::string, int> acked;
+  auto callback = [&](const std::string& destination, std::error_code ec) {
+    EXPECT_FALSE(ec);
+    ++acked[destination];
+  };
+  session.async_send_features(make_report(), callback);
+  auto shared = std::make_shared<FeatureReport>(make_report());
+  shared->image = std::make_shared<std::vector<uint8_t>>(1024, 7);
+  session.async_send_features(shared, callback);
+
+  // 两个目的地拿到的是同一份编码结果
+  ASSERT_EQ(main_link.sent.size(), 2u);
+  EXPECT_EQ(main_link.sent, backup_link.sent);
+
+  main_link.complete_all();
+  backup_link.complete_all();
+  EXPECT_EQ(acked["main"], 2);
+  EXPECT_EQ(acked["backup"], 2);
+  EXPECT_EQ(session.stats(0).sent, 2u);
+  EXPECT_EQ(session.stats(1).sent, 2u);
+}
+
+TEST(FanoutSessionTests, SlowDestinationDoesNotHoldBackOthers) {
+  FakeLink main_link;
+  FakeLink backup_link;
+  FanoutConfig config;
+  config.max_in_flight = 2;
+  config.max_queued_messages = 3;
+  FanoutSession session(std::make_unique<LegacyCodec>(), config);
+  session.add_destination("main", std::make_unique<FakeTransport>(main_link));
+  session.add_destination("backup",
+                          std::make_unique<FakeTransport>(backup_link));
+
+  std::map<std::string, std::vector<std::error_code>> results;
+  auto callback = [&](const std::string& destination, std::error_code ec) {
+    results[destination].push_back(ec);
+  };
+
+  // 主服务器每条都及时写完，备份服务器一直不完成
+  for (int i = 0; i < 10; ++i) {
+    session.async_send_status(FrontendStatus{}, callback);
+    main_link.complete_all();
+  }
+  EXPECT_EQ(main_link.sent.size(), 10u);
+  ASSERT_EQ(results["main"].size(), 10u);
+  for (const auto& ec : results["main"]) {
+    EXPECT_FALSE(ec);
+  }
+
+  // 备份服务器只有 2 条在途、3 条排队，其余丢弃最旧的
+  auto backup = session.stats(1);
+  EXPECT_EQ(backup.in_flight, 2u);
+  EXPECT_EQ(backup.queued, 3u);
+  EXPECT_EQ(backup.dropped, 5u);
+  EXPECT_EQ(session.stats(0).dropped, 0u);
+  ASSERT_EQ(results["backup"].size(), 5u);
+  for (const auto& ec : results["backup"]) {
+    EXPECT_EQ(ec, std::errc::no_buffer_space);
+  }
+
+  // 备份服务器恢复后按顺序发出排队的报文
+  while (!backup_link.pending.empty()) {
+    backup_link.complete_all();
+  }
+  EXPECT_EQ(backup_link.sent.size(), 5u);
+  EXPECT_EQ(session.stats(1).sent, 5u);
+  EXPECT_EQ(session.stats(1).queued, 0u);
+}
+
+// 断线时报文进入 ReconnectingTransport 的暂存队列即离开在途窗口，
+// 只由传输层一层缓冲，不会被本层的排队上限丢弃
+TEST(FanoutSessionTests, OfflineReportsBufferInReconnectingTransport) {
+  asio::io_context io_ctx;
+  FakeLink link;
+  FanoutConfig config;
+  config.max_in_flight = 2;
+  config.max_queued_messages = 2;
+  FanoutSession session(std::make_unique<LegacyCodec>(), config);
+  ReconnectConfig reconnect;
+  reconnect.health_check = false;
+  reconnect.max_queued_messages = 16;
+  session.add_destination(
+      "main", std::make_unique<ReconnectingTransport>(
+                  io_ctx, std::make_unique<FakeTransport>(link), reconnect));
+
+  std::vector<std::error_code> results;
+  auto callback = [&](const std::string&, std::error_code ec) {
+    results.push_back(ec);
+  };
+  for (int i = 0; i < 10; ++i) {
+    session.async_send_features(make_report(), callback);
+  }
+  auto stats = session.stats(0);
+  EXPECT_EQ(stats.buffered, 10u);
+  EXPECT_EQ(stats.dropped, 0u);
+  EXPECT_EQ(stats.in_flight, 0u);
+  EXPECT_EQ(stats.queued, 0u);
+  EXPECT_TRUE(results.empty());
+
+  // 连上后传输层按顺序重放，每条报文的回调只执行一次
+  session.async_connect(0, "127.0.0.1", 19300, [](std::error_code) {});
+  ASSERT_EQ(link.sent.size(), 10u);
+  link.complete_all();
+  ASSERT_EQ(results.size(), 10u);
+  for (const auto& ec : results) {
+    EXPECT_FALSE(ec);
+  }
+  EXPECT_EQ(session.stats(0).sent, 10u);
+
+  // 在线时仍由本层的在途窗口限流
+  for (int i = 0; i < 3; ++i) {
+    session.async_send_features(make_report(), callback);
+  }
+  stats = session.stats(0);
+  EXPECT_EQ(stats.in_flight, 2u);
+  EXPECT_EQ(stats.queued, 1u);
+  EXPECT_EQ(stats.buffered, 10u);
+  while (!link.pending.empty()) {
+    link.complete_all();
+  }
+  EXPECT_EQ(results.size(), 13u);
+  EXPECT_EQ(session.stats(0).in_flight, 0u);
+}
@@ -0,0 +1,141 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FrameReaderTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "protocol/FrameReader.hpp"
+#include "protocol/LegacyCodec.hpp"
+
+using namespace protocol;
+
+namespace {
+
+std::vector<uint8_t> make_stream(LegacyCodec& codec, size_t image_bytes) {
+  std::vector<uint8_t> stream;
+  for (int i = 0; i < 3; ++i) {
+    FeatureReport report;
+    report.roll_id = "ROLL";
+    report.features.assign(i * 5, {i, 0.25f});
+    report.image_data.assign(i == 1 ? image_bytes : 0, 0x33);
+    const auto data = codec.encode_features(report);
+    stream.insert(stream.end(), data.begin(), data.end());
+
+    FrontendStatus status;
+    status.capture = i % 2 == 0;
+    const auto status_data = codec.encode_status(status);
+    stream.insert(stream.end(), status_data.begin(), status_data.end());
+  }
+  return stream;
+}
+
+// 按 chunk 字节一段段喂入，收集交出的报文
+std::vector<std::vector<uint8_t>> feed(FrameReader& reader,
+                                       std::span<const uint8_t> stream,
+                                       size_t chunk) {
+  std::vector<std::vector<uint8_t>> frames;
+  size_t offset = 0;
+  while (offset < stream.size()) {
+    auto space = reader.prepare();
+    const size_t bytes =
+        std::min({chunk, space.size(), stream.size() - offset});
+    std::copy_n(stream.data() + offset, bytes, space.data());
+    reader.commit(bytes);
+    offset += bytes;
+
+    std::span<const uint8_t> frame;
+    while (reader.next(frame) == FrameReader::Status::Complete) {
+      frames.emplace_back(frame.begin(), frame.end());
+    }
+  }
+  return frames;
+}
+
+}  // namespace
+
+TEST(FrameReaderTests, SplitsStreamAtAnyChunkBoundary) {
+  LegacyCodec codec;
+  const auto stream = make_stream(codec, 300);
+
+  for (size_t chunk : {1, 3, 77, 158, 4096}) {
+    FrameReader reader;
+    const auto frames = feed(reader, stream, chunk);
+    ASSERT_EQ(frames.size(), 6u) << "chunk " << chunk;
+    EXPECT_EQ(reader.buffered(), 0u);
+
+    std::vector<uint8_t> joined;
+    for (const auto& frame : frames) {
+      joined.insert(joined.end(), frame.begin(), frame.end());
+    }
+    EXPECT_EQ(joined, stream);
+
+    auto report = codec.decode_features(frames[2]);
+    ASSERT_TRUE(report.has_value());
+    EXPECT_EQ(report->features.size(), 5u);
+    EXPECT_EQ(report->image_data.size(), 300u);
+    EXPECT_TRUE(codec.decode_status(frames[1]).has_value());
+  }
+}
+
+TEST(FrameReaderTests, GrowsOnlyForFramesLargerThanBuffer) {
+  LegacyCodec codec;
+  const auto stream = make_stream(codec, 200 * 1024);
+
+  FrameReader reader(FrameReader::kMinRead);
+  EXPECT_EQ(feed(reader, stream, 1 << 20).size(), 6u);
+  const size_t grown = reader.capacity();
+  EXPECT_GE(grown, 200u * 1024);
+
+  // 容量已经够用，再来一遍不会扩容
+  EXPECT_EQ(feed(reader, stream, 1 << 20).size(), 6u);
+  EXPECT_EQ(reader.capacity(), grown);
+}
+
+TEST(FrameReaderTests, RejectsUnknownOrOversizedFrames) {
+  FrameReader reader(FrameReader::kMinRead, 1024);
+  std::span<const uint8_t> frame;
+
+  auto space = reader.prepare();
+  space[0] = 'X';
+  reader.commit(1);
+  EXPECT_EQ(reader.next(frame), FrameReader::Status::Invalid);
+
+  // 声明的特征个数让报文超过上限
+  reader.reset();
+  LegacyCodec codec;
+  FeatureReport report;
+  report.features.assign(200, {1, 1.0f});
+  const auto data = codec.encode_features(report);
+  space = reader.prepare();
+  std::copy_n(data.begin(), 1 + 72 + 4, space.begin());
+  reader.commit(1 + 72 + 4);
+  EXPECT_EQ(reader.next(frame), FrameReader::Status::Invalid);
+  EXPECT_TRUE(frame.empty());
+}
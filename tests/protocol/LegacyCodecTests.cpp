@@ -0,0 +1,180 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: LegacyCodecTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "protocol/LegacyCodec.hpp"
+#include "protocol/SendBufferPool.hpp"
+#include "protocol/TransportAdapter.hpp"
+
+using namespace protocol;
+
+namespace {
+
+FeatureReport make_report(size_t features) {
+  FeatureReport report;
+  report.roll_id = "ROLL-0042";
+  for (size_t i = 0; i < features; ++i) {
+    report.features.emplace_back(static_cast<int32_t>(i % 7),
+                                 static_cast<float>(i) * 0.5f);
+  }
+  for (size_t i = 0; i < report.special_images.size(); ++i) {
+    report.special_images[i] = static_cast<float>(i);
+  }
+  report.image_data = {1, 2, 3, 4, 5};
+  return report;
+}
+
+template <typename T>
+T read_at(const std::vector<uint8_t>& data, size_t offset) {
+  T value;
+  std::memcpy(&value, data.data() + offset, sizeof(T));
+  return value;
+}
+
+}  // namespace
+
+TEST(LegacyCodecTests, FeatureReportLayoutAndRoundTrip) {
+  LegacyCodec codec;
+  const auto report = make_report(3);
+
+  const auto data = codec.encode_features(report);
+  ASSERT_EQ(data.size(), codec.encoded_features_size(report));
+  ASSERT_EQ(data.size(), 1u + 72 + 4 + 80 + 3 * 8 + 4 + 5);
+  EXPECT_EQ(data[0], 'F');
+  // 卷号按 72 字节补空格
+  EXPECT_EQ(std::string(data.begin() + 1, data.begin() + 10), "ROLL-0042");
+  EXPECT_EQ(data[10], ' ');
+  EXPECT_EQ(data[72], ' ');
+  EXPECT_EQ(read_at<int32_t>(data, 73), 3);
+  EXPECT_EQ(read_at<int32_t>(data, 157 + 8), 1);
+  EXPECT_EQ(read_at<float>(data, 157 + 12), 0.5f);
+  EXPECT_EQ(read_at<int32_t>(data, 157 + 24), 5);
+
+  auto decoded = codec.decode_features(data);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->roll_id, report.roll_id);
+  EXPECT_EQ(decoded->features, report.features);
+  EXPECT_EQ(decoded->special_images, report.special_images);
+  EXPECT_EQ(decoded->image_data, report.image_data);
+}
+
+TEST(LegacyCodecTests, EncodeToCallerBufferMatchesVectorEncoding) {
+  LegacyCodec codec;
+  const auto report = make_report(4096);
+  const auto expected = codec.encode_features(report);
+
+  std::vector<uint8_t> out(expected.size() + 16, 0xAB);
+  ASSERT_EQ(codec.encode_features_to(report, out), expected.size());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), out.begin()));
+  EXPECT_EQ(out[expected.size()], 0xAB);
+
+  // 缓冲区不够大时什么也不写
+  std::vector<uint8_t> small(expected.size() - 1, 0xCD);
+  EXPECT_EQ(codec.encode_features_to(report, small), 0u);
+  EXPECT_EQ(small[0], 0xCD);
+
+  FrontendStatus status;
+  status.capture = true;
+  std::vector<uint8_t> status_out(codec.encoded_status_size(status));
+  ASSERT_EQ(codec.encode_status_to(status, status_out), 5u);
+  EXPECT_EQ(status_out, codec.encode_status(status));
+}
+
+TEST(LegacyCodecTests, ConfigOptionalFieldsStopAtFirstMissing) {
+  LegacyCodec codec;
+  ServerConfig config;
+  config.roll_id = std::string(80, 'R');  // 超长截断到 72 字节
+  config.brand = "3003";
+  config.thickness_str = "0.3";
+  config.head_length = 12.5f;
+  config.material_type = 2;
+  config.upper_surface_id = 7;  // segmentation_params 缺失，不会被发送
+
+  const auto data = codec.encode_config(config);
+  EXPECT_EQ(data.size(), 1u + 72 + 20 + 5 + 5 + 5 + 4 + 4);
+  auto decoded = codec.decode_config(data);
+  ASSERT_TRUE(decoded.has_value());
+  EXPECT_EQ(decoded->roll_id, std::string(72, 'R'));
+  EXPECT_EQ(decoded->brand, "3003");
+  EXPECT_EQ(decoded->thickness_str, "0.3  ");
+  EXPECT_EQ(decoded->head_length, 12.5f);
+  EXPECT_EQ(decoded->material_type, 2);
+  EXPECT_FALSE(decoded->upper_surface_id.has_value());
+}
+
+TEST(LegacyCodecTests, GatherSegmentsReferenceReportStorage) {
+  LegacyCodec codec;
+  auto report = make_report(100);
+  report.image_data.clear();
+  auto image = std::make_shared<std::vector<uint8_t>>(4096, 0x5A);
+  report.image = image;
+  const auto expected = codec.encode_features(report);
+
+  GatherMessage message;
+  message.count =
+      codec.encode_features_gather(report, message.scratch, message.segments);
+  ASSERT_EQ(message.count, 4u);
+  EXPECT_EQ(message.size(), expected.size());
+
+  std::vector<uint8_t> joined;
+  for (size_t i = 0; i < message.count; ++i) {
+    joined.insert(joined.end(), message.segments[i].begin(),
+                  message.segments[i].end());
+  }
+  EXPECT_EQ(joined, expected);
+  // 特征列表和图片原地引用，不拷贝
+  EXPECT_EQ(message.segments[1].data(),
+            reinterpret_cast<const uint8_t*>(report.features.data()));
+  EXPECT_EQ(message.segments[3].data(), image->data());
+}
+
+TEST(SendBufferPoolTests, ReleasedBufferIsReused) {
+  SendBufferPool pool(4);
+  const uint8_t* storage = nullptr;
+  {
+    auto buffer = pool.acquire(4096);
+    EXPECT_EQ(buffer->size(), 4096u);
+    storage = buffer->data();
+  }
+  EXPECT_EQ(pool.cached_count(), 1u);
+
+  // 容量足够时复用同一块内存
+  auto buffer = pool.acquire(1024);
+  EXPECT_EQ(buffer->size(), 1024u);
+  EXPECT_EQ(buffer->data(), storage);
+  EXPECT_EQ(pool.cached_count(), 0u);
+
+  const auto stats = pool.stats();
+  EXPECT_EQ(stats.hits, 1u);
+  EXPECT_EQ(stats.misses, 1u);
+}
@@ -0,0 +1,182 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ProtocolSessionCoroutineTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "asio.hpp"
+#include "protocol/AsioTcpTransport.hpp"
+#include "protocol/FrameReader.hpp"
+#include "protocol/LegacyCodec.hpp"
+#include "protocol/ProtocolSession.hpp"
+
+using namespace protocol;
+
+namespace {
+
+std::shared_ptr<ProtocolSession> make_session(asio::io_context& io_ctx) {
+  return std::make_shared<ProtocolSession>(
+      std::make_unique<LegacyCodec>(), nullptr,
+      std::make_unique<AsioTcpTransport>(io_ctx));
+}
+
+}  // namespace
+
+TEST(ProtocolSessionCoroutineTests, SendsAndReceivesOverLoopback) {
+  constexpr int kReports = 20;
+
+  asio::io_context io_ctx;
+  asio::ip::tcp::acceptor acceptor(
+      io_ctx, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  const uint16_t port = acceptor.local_endpoint().port();
+
+  // 对端：接受连接后在同一个协程里逐条接收
+  int received = 0;
+  bool status_received = false;
+  asio::co_spawn(
+      io_ctx,
+      [&]() -> asio::awaitable<void> {
+        std::error_code ec;
+        auto socket = co_await acceptor.async_accept(
+            asio::redirect_error(asio::use_awaitable, ec));
+        EXPECT_FALSE(ec);
+
+        LegacyCodec codec;
+        FrameReader reader;
+        while (received < kReports || !status_received) {
+          auto space = reader.prepare();
+          const size_t bytes = co_await socket.async_read_some(
+              asio::buffer(space.data(), space.size()),
+              asio::redirect_error(asio::use_awaitable, ec));
+          if (ec) {
+            break;
+          }
+          reader.commit(bytes);
+          std::span<const uint8_t> frame;
+          while (reader.next(frame) == FrameReader::Status::Complete) {
+            if (frame[0] == 'T') {
+              status_received = codec.decode_status(frame).has_value();
+            } else if (auto report = codec.decode_features(frame)) {
+              EXPECT_EQ(report->roll_id.substr(0, 4), "ROLL");
+              ++received;
+            }
+          }
+        }
+      },
+      asio::detached);
+
+  // 发送端：连接、发送，全部以 co_await 串起来
+  std::error_code connect_result = std::make_error_code(std::errc::busy);
+  int sent = 0;
+  auto session = make_session(io_ctx);
+  asio::co_spawn(
+      io_ctx,
+      [&]() -> asio::awaitable<void> {
+        connect_result = co_await session->co_connect("127.0.0.1", port);
+        if (connect_result) {
+          co_return;
+        }
+        auto report = std::make_shared<FeatureReport>();
+        report->roll_id = "ROLL";
+        report->features.assign(3, {1, 0.5f});
+        for (int i = 0; i < kReports; ++i) {
+          auto ec = co_await session->co_send_features(report);
+          sent += ec ? 0 : 1;
+        }
+        FrontendStatus status;
+        status.capture = true;
+        auto ec = co_await session->co_send_status(status);
+        EXPECT_FALSE(ec);
+      },
+      asio::detached);
+
+  io_ctx.run_for(std::chrono::seconds(5));
+  EXPECT_FALSE(connect_result);
+  EXPECT_EQ(sent, kReports);
+  EXPECT_EQ(received, kReports);
+  EXPECT_TRUE(status_received);
+}
+
+TEST(ProtocolSessionCoroutineTests, ReceivesFeaturesFromTransportBuffer) {
+  asio::io_context io_ctx;
+  asio::ip::tcp::acceptor acceptor(
+      io_ctx, asio::ip::tcp::endpoint(asio::ip::address_v4::loopback(), 0));
+  const uint16_t port = acceptor.local_endpoint().port();
+
+  // 对端一次写出两条报文，接收端逐条取出
+  asio::co_spawn(
+      io_ctx,
+      [&]() -> asio::awaitable<void> {
+        auto socket = co_await acceptor.async_accept(asio::use_awaitable);
+        LegacyCodec codec;
+        FeatureReport report;
+        report.roll_id = "ROLL-A";
+        report.features.assign(2, {7, 1.5f});
+        auto data = codec.encode_features(report);
+        report.roll_id = "ROLL-B";
+        auto second = codec.encode_features(report);
+        data.insert(data.end(), second.begin(), second.end());
+        co_await asio::async_write(socket, asio::buffer(data),
+                                   asio::use_awaitable);
+      },
+      asio::detached);
+
+  std::vector<std::string> roll_ids;
+  auto session = make_session(io_ctx);
+  asio::co_spawn(
+      io_ctx,
+      [&]() -> asio::awaitable<void> {
+        auto ec = co_await session->co_connect("127.0.0.1", port);
+        if (ec) {
+          ADD_FAILURE() << ec.message();
+          co_return;
+        }
+        for (int i = 0; i < 2; ++i) {
+          std::shared_ptr<FeatureReport> report;
+          ec = co_await session->co_receive_features(report);
+          if (ec) {
+            ADD_FAILURE() << ec.message();
+            co_return;
+          }
+          if (!report) {
+            ADD_FAILURE() << "decoded report expected";
+            co_return;
+          }
+          roll_ids.push_back(report->roll_id.substr(0, 6));
+        }
+      },
+      asio::detached);
+
+  io_ctx.run_for(std::chrono::seconds(5));
+  EXPECT_EQ(roll_ids, (std::vector<std::string>{"ROLL-A", "ROLL-B"}));
+}
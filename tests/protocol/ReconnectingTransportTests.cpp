@@ -0,0 +1,386 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReconnectingTransportTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "asio.hpp"
+#include "protocol/ReconnectingTransport.hpp"
+
+using namespace protocol;
+
+namespace {
+
+// 模拟服务器：前 refuse 次连接被拒绝，记录收到的报文
+struct FakeServer {
+  int refuse = 0;
+  bool connected = false;
+  int connects = 0;
+  std::vector<std::vector<uint8_t>> received;
+  ITransportAdapter::FrameCallback receiver;
+
+  // 对端关闭连接
+  void drop() {
+    connected = false;
+    auto callback = std::move(receiver);
+    receiver = nullptr;
+    if (callback) {
+      callback(std::make_error_code(std::errc::connection_reset), {});
+    }
+  }
+};
+
+class FakeTransport : public ITransportAdapter {
+ public:
+  FakeTransport(asio::io_context& io_ctx, FakeServer& server)
+      : io_ctx_(io_ctx), server_(server) {}
+
+  void async_connect(const std::string&, uint16_t,
+                     std::function<void(std::error_code)> callback) override {
+    asio::post(io_ctx_, [this, callback] {
+      if (server_.refuse > 0) {
+        --server_.refuse;
+        callback(std::make_error_code(std::errc::connection_refused));
+        return;
+      }
+      server_.connected = true;
+      ++server_.connects;
+      callback({});
+    });
+  }
+  void async_send(std::span<const uint8_t> data,
+                  SendCallback callback) override {
+    async_send_buffer(
+        std::make_shared<std::vector<uint8_t>>(data.begin(), data.end()),
+        std::move(callback));
+  }
+  void async_send_buffer(
+      SharedBuffer data, SendCallback callback,
+      MessageClass message_class = MessageClass::Bulk) override {
+    asio::post(io_ctx_, [this, data, callback] {
+      if (!server_.connected) {
+        callback(std::make_error_code(std::errc::not_connected));
+        return;
+      }
+      server_.received.push_back(*data);
+      callback({});
+    });
+  }
+  void async_receive(ReceiveCallback callback) override {
+    callback(std::make_error_code(std::errc::operation_not_supported), {});
+  }
+  void async_receive_frames(FrameCallback callback) override {
+    server_.receiver = std::move(callback);
+  }
+  void close() override { server_.connected = false; }
+
+ private:
+  asio::io_context& io_ctx_;
+  FakeServer& server_;
+};
+
+// 回调尚未执行时的占位结果
+const std::error_code kNotYet =
+    std::make_error_code(std::errc::operation_in_progress);
+
+ReconnectConfig fast_config() {
+  ReconnectConfig config;
+  config.initial_backoff = std::chrono::milliseconds(1);
+  config.max_backoff = std::chrono::milliseconds(4);
+  return config;
+}
+
+ITransportAdapter::SharedBuffer message(uint8_t id) {
+  return std::make_shared<std::vector<uint8_t>>(16, id);
+}
+
+bool run_until(asio::io_context& io_ctx, const std::function<bool()>& done) {
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (!done() && std::chrono::steady_clock::now() < deadline) {
+    io_ctx.restart();
+    io_ctx.run_for(std::chrono::milliseconds(2));
+  }
+  return done();
+}
+
+std::vector<uint8_t> ids(const FakeServer& server) {
+  std::vector<uint8_t> result;
+  for (const auto& data : server.received) {
+    result.push_back(data.front());
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(ReconnectingTransportTests, ReplaysQueuedReportsInOrderAfterReconnect) {
+  asio::io_context io_ctx;
+  FakeServer server;
+  server.refuse = 3;
+  ReconnectingTransport transport(
+      io_ctx, std::make_unique<FakeTransport>(io_ctx, server), fast_config());
+
+  std::error_code connect_result = kNotYet;
+  transport.async_connect("127.0.0.1", 19300,
+                          [&](std::error_code ec) { connect_result = ec; });
+  // 第一次连接失败照常回调，之后在后台重连
+  ASSERT_TRUE(run_until(io_ctx, [&] { return connect_result != kNotYet; }));
+  EXPECT_EQ(connect_result, std::errc::connection_refused);
+
+  int acked = 0;
+  std::error_code control_result;
+  for (uint8_t id = 1; id <= 5; ++id) {
+    transport.async_send_buffer(message(id), [&](std::error_code ec) {
+      EXPECT_FALSE(ec);
+      ++acked;
+    });
+  }
+  // 断线时状态报文不暂存
+  transport.async_send_buffer(
+      message(99), [&](std::error_code ec) { control_result = ec; },
+      MessageClass::Control);
+  EXPECT_TRUE(control_result);
+
+  ASSERT_TRUE(run_until(io_ctx, [&] { return acked == 5; }));
+  EXPECT_EQ(ids(server), (std::vector<uint8_t>{1, 2, 3, 4, 5}));
+
+  // 对端断开后继续发送，不阻塞，重连后接着补发
+  server.drop();
+  for (uint8_t id = 6; id <= 8; ++id) {
+    transport.async_send_buffer(message(id),
+                                [&](std::error_code ec) { ++acked; });
+  }
+  ASSERT_TRUE(run_until(io_ctx, [&] { return acked == 8; }));
+  EXPECT_EQ(ids(server), (std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8}));
+
+  auto stats = transport.stats();
+  EXPECT_EQ(stats.connects, 2u);
+  EXPECT_EQ(stats.disconnects, 1u);
+  EXPECT_EQ(stats.replayed, 8u);
+  EXPECT_EQ(stats.queued, 0u);
+  EXPECT_EQ(server.connects, 2);
+}
+
+// 重放期间状态报文不排在暂存报文之后，连上即发出
+TEST(ReconnectingTransportTests, ControlBypassesReplay) {
+  asio::io_context io_ctx;
+  FakeServer server;
+  ReconnectingTransport transport(
+      io_ctx, std::make_unique<FakeTransport>(io_ctx, server), fast_config());
+
+  int acked = 0;
+  for (uint8_t id = 1; id <= 3; ++id) {
+    transport.async_send_buffer(message(id),
+                                [&](std::error_code) { ++acked; });
+  }
+  std::error_code control_result = kNotYet;
+  transport.async_connect("127.0.0.1", 19300, [&](std::error_code ec) {
+    ASSERT_FALSE(ec);
+    // 此时暂存的报文还没有开始重放
+    transport.async_send_buffer(
+        message(99), [&](std::error_code ec) { control_result = ec; },
+        MessageClass::Control);
+  });
+  ASSERT_TRUE(run_until(io_ctx, [&] {
+    return acked == 3 && control_result != kNotYet;
+  }));
+  EXPECT_FALSE(control_result);
+  EXPECT_EQ(ids(server), (std::vector<uint8_t>{99, 1, 2, 3}));
+}
+
+TEST(ReconnectingTransportTests, DropsOldestWhenQueueIsFull) {
+  asio::io_context io_ctx;
+  FakeServer server;
+  auto config = fast_config();
+  config.max_queued_messages = 2;
+  ReconnectingTransport transport(
+      io_ctx, std::make_unique<FakeTransport>(io_ctx, server), config);
+
+  std::vector<std::error_code> results(3);
+  for (uint8_t id = 0; id < 3; ++id) {
+    transport.async_send_buffer(message(id), [&results, id](std::error_code ec) {
+      results[id] = ec;
+    });
+  }
+  EXPECT_EQ(results[0], std::errc::no_buffer_space);
+  EXPECT_EQ(transport.stats().dropped, 1u);
+
+  transport.async_connect("127.0.0.1", 19300, [](std::error_code) {});
+  ASSERT_TRUE(run_until(io_ctx, [&] { return server.received.size() == 2; }));
+  EXPECT_EQ(ids(server), (std::vector<uint8_t>{1, 2}));
+}
+
+TEST(ReconnectingTransportTests, SpilledReportsSurviveRestart) {
+  const auto spill_path =
+      std::filesystem::temp_directory_path() / "reconnecting_transport.spill";
+  std::filesystem::remove(spill_path);
+
+  asio::io_context io_ctx;
+  FakeServer server;
+  auto config = fast_config();
+  config.max_queued_messages = 1;
+  config.spill_path = spill_path.string();
+  // 回调可能在析构时执行，结果要比 transport 活得久
+  std::vector<std::error_code> results(4);
+  std::vector<bool> completed(4, false);
+  {
+    ReconnectingTransport transport(
+        io_ctx, std::make_unique<FakeTransport>(io_ctx, server), config);
+    for (uint8_t id = 1; id <= 4; ++id) {
+      transport.async_send_buffer(message(id), [&, id](std::error_code ec) {
+        results[id - 1] = ec;
+        completed[id - 1] = true;
+      });
+    }
+    // 发送线程不写文件，溢写由 io 线程完成
+    EXPECT_EQ(completed, (std::vector<bool>(4, false)));
+    EXPECT_EQ(transport.stats().spilled, 0u);
+    // 第一条在内存里，其余写入文件即算完成
+    ASSERT_TRUE(run_until(io_ctx, [&] { return completed[3]; }));
+    EXPECT_EQ(completed, (std::vector<bool>{false, true, true, true}));
+    EXPECT_EQ(transport.stats().spill_pending, 3u);
+  }
+  // 内存里的那条在析构时以 operation_aborted 回调
+  EXPECT_TRUE(completed[0]);
+  EXPECT_EQ(results[0], asio::error::operation_aborted);
+  for (size_t i = 1; i < results.size(); ++i) {
+    EXPECT_FALSE(results[i]) << i;
+  }
+  ASSERT_TRUE(std::filesystem::exists(spill_path));
+
+  // 重启后读回上次溢写的报文，连上后按顺序发出
+  ReconnectingTransport transport(
+      io_ctx, std::make_unique<FakeTransport>(io_ctx, server), config);
+  EXPECT_EQ(transport.stats().spill_pending, 3u);
+  transport.async_connect("127.0.0.1", 19300, [](std::error_code) {});
+  ASSERT_TRUE(run_until(io_ctx, [&] { return server.received.size() == 3; }));
+  EXPECT_EQ(ids(server), (std::vector<uint8_t>{2, 3, 4}));
+  EXPECT_FALSE(std::filesystem::exists(spill_path));
+}
+
+// 还没轮到 io 线程写出的溢写报文，关闭时同步写完，重启后照常重放
+TEST(ReconnectingTransportTests, CloseWritesPendingSpill) {
+  const auto spill_path = std::filesystem::temp_directory_path() /
+                          "reconnecting_transport_close.spill";
+  std::filesystem::remove(spill_path);
+
+  asio::io_context io_ctx;
+  FakeServer server;
+  auto config = fast_config();
+  config.max_queued_messages = 1;
+  config.spill_path = spill_path.string();
+  std::vector<std::error_code> results(3, kNotYet);
+  {
+    ReconnectingTransport transport(
+        io_ctx, std::make_unique<FakeTransport>(io_ctx, server), config);
+    for (uint8_t id = 1; id <= 3; ++id) {
+      transport.async_send_buffer(message(id), [&, id](std::error_code ec) {
+        results[id - 1] = ec;
+      });
+    }
+    transport.close();
+    EXPECT_EQ(results[0], asio::error::operation_aborted);
+    EXPECT_FALSE(results[1]);
+    EXPECT_FALSE(results[2]);
+  }
+
+  ReconnectingTransport transport(
+      io_ctx, std::make_unique<FakeTransport>(io_ctx, server), config);
+  EXPECT_EQ(transport.stats().spill_pending, 2u);
+  transport.async_connect("127.0.0.1", 19300, [](std::error_code) {});
+  ASSERT_TRUE(run_until(io_ctx, [&] { return server.received.size() == 2; }));
+  EXPECT_EQ(ids(server), (std::vector<uint8_t>{2, 3}));
+}
+
+// 溢写和读回交给 io 线程后，内存、文件和待写队列里的报文仍按发送顺序发出
+TEST(ReconnectingTransportTests, ReplaysSpilledReportsInOrder) {
+  const auto spill_path = std::filesystem::temp_directory_path() /
+                          "reconnecting_transport_order.spill";
+  std::filesystem::remove(spill_path);
+
+  asio::io_context io_ctx;
+  FakeServer server;
+  auto config = fast_config();
+  config.max_queued_messages = 2;
+  config.spill_path = spill_path.string();
+  ReconnectingTransport transport(
+      io_ctx, std::make_unique<FakeTransport>(io_ctx, server), config);
+
+  int acked = 0;
+  auto send = [&](uint8_t id) {
+    transport.async_send_buffer(message(id), [&](std::error_code ec) {
+      EXPECT_FALSE(ec);
+      ++acked;
+    });
+  };
+  for (uint8_t id = 1; id <= 6; ++id) {
+    send(id);
+  }
+  ASSERT_TRUE(run_until(io_ctx, [&] { return acked == 4; }));
+  // 这两条还在待写队列里时就开始重放
+  send(7);
+  send(8);
+  transport.async_connect("127.0.0.1", 19300, [](std::error_code) {});
+  ASSERT_TRUE(run_until(io_ctx, [&] { return server.received.size() == 8; }));
+  EXPECT_EQ(ids(server), (std::vector<uint8_t>{1, 2, 3, 4, 5, 6, 7, 8}));
+
+  const auto stats = transport.stats();
+  EXPECT_EQ(stats.spilled, 6u);
+  EXPECT_EQ(stats.spill_pending, 0u);
+  EXPECT_FALSE(std::filesystem::exists(spill_path));
+}
+
+// 已投递的重连任务在对象析构后才执行时直接返回
+TEST(ReconnectingTransportTests, PendingReconnectOutlivesTransport) {
+  asio::io_context io_ctx;
+  FakeServer server;
+  server.refuse = 1;
+  {
+    ReconnectingTransport transport(
+        io_ctx, std::make_unique<FakeTransport>(io_ctx, server),
+        fast_config());
+    std::error_code connect_result = kNotYet;
+    transport.async_connect("127.0.0.1", 19300,
+                            [&](std::error_code ec) { connect_result = ec; });
+    // 只执行连接失败的回调，重连任务留在队列里
+    while (connect_result == kNotYet && io_ctx.run_one() > 0) {
+    }
+    EXPECT_EQ(connect_result, std::errc::connection_refused);
+  }
+  io_ctx.restart();
+  io_ctx.run_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(server.connects, 0);
+}
@@ -0,0 +1,101 @@
+/*
+ *  Copyright © 2025-2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: ReportImageEncoderTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "protocol/ReportImageEncoder.hpp"
+
+using namespace protocol;
+
+namespace {
+
+std::shared_ptr<CapturedFrame> make_frame(int width, int height) {
+  auto frame = std::make_shared<CapturedFrame>();
+  frame->meta.iWidth = width;
+  frame->meta.iHeight = height;
+  frame->meta.bitDepth = 8;
+  frame->data.assign(static_cast<size_t>(width) * height, 0x7F);
+  return frame;
+}
+
+}  // namespace
+
+TEST(ReportImageEncoderTests, RawFormatSharesFrameBuffer) {
+  ReportImageConfig config;
+  config.format = ReportImageFormat::Raw;
+  ReportImageEncoder encoder(config);
+
+  auto frame = make_frame(64, 32);
+  const uint8_t* pixels = frame->data.data();
+  std::weak_ptr<CapturedFrame> watch = frame;
+
+  ReportImageEncoder::SharedImage image;
+  encoder.submit(frame, [&image](auto shared) { image = std::move(shared); });
+  frame.reset();
+
+  // 图片就是帧缓冲区本身，持有图片期间帧不会被回收
+  ASSERT_TRUE(image);
+  EXPECT_EQ(image->data(), pixels);
+  EXPECT_EQ(image->size(), 64u * 32u);
+  EXPECT_FALSE(watch.expired());
+  image.reset();
+  EXPECT_TRUE(watch.expired());
+
+  const auto stats = encoder.stats();
+  EXPECT_EQ(stats.shared, 1u);
+  EXPECT_EQ(stats.pending, 0u);
+}
+
+TEST(ReportImageEncoderTests, CallbacksFollowSubmissionOrder) {
+  ReportImageConfig config;
+  config.format = ReportImageFormat::Raw;
+  ReportImageEncoder encoder(config);
+
+  std::vector<int> order;
+  std::vector<size_t> sizes;
+  auto record = [&](int id) {
+    return [&order, &sizes, id](ReportImageEncoder::SharedImage image) {
+      order.push_back(id);
+      sizes.push_back(image ? image->size() : 0);
+    };
+  };
+
+  auto frame = make_frame(16, 16);
+  encoder.submit(frame, record(0));
+  encoder.submit(nullptr, record(1));  // 没有帧时回调拿到空图片
+  encoder.submit(frame, record(2), cv::Rect(4, 4, 8, 2));
+
+  EXPECT_EQ(order, (std::vector<int>{0, 1, 2}));
+  EXPECT_EQ(sizes, (std::vector<size_t>{256, 0, 16}));
+  EXPECT_EQ(encoder.stats().encoded, 1u);
+  EXPECT_THROW(parse_report_image_format("bmp"), std::invalid_argument);
+  EXPECT_EQ(parse_report_image_format("JPG"), ReportImageFormat::Jpeg);
+}
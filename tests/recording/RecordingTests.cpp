@@ -0,0 +1,156 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: RecordingTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>  //NOLINT
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cameras/Recording/FrameRecorder.hpp"
+#include "cameras/Recording/RecordingFormat.hpp"
+#include "cameras/Recording/RecordingReader.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+CapturedFrame make_frame(int id, size_t bytes) {
+  CapturedFrame frame;
+  frame.data.resize(bytes);
+  for (size_t i = 0; i < bytes; ++i) {
+    frame.data[i] = static_cast<uint8_t>(id * 31 + i);
+  }
+  frame.meta.iWidth = static_cast<int>(bytes);
+  frame.meta.iHeight = 1;
+  frame.meta.format = 0;
+  frame.meta.fExposure = 100.0 + id;
+  frame.meta.fGain = 1.5;
+  frame.meta.uTimestamp = 1000u + id;
+  frame.meta.cameraId = "cam" + std::to_string(id % 2);
+  frame.meta.bitDepth = 8;
+  return frame;
+}
+
+// 录制若干帧：小块强制跨块，最后一帧大于块大小
+std::vector<CapturedFrame> record_frames(const fs::path& path) {
+  std::vector<CapturedFrame> frames;
+  for (int i = 0; i < 20; ++i) {
+    frames.push_back(make_frame(i, 100000 + i * 7));
+  }
+  frames.push_back(make_frame(20, 3u << 20));
+
+  FrameRecorderConfig config;
+  config.path = path.string();
+  config.chunk_bytes = 1u << 20;
+  config.max_pending_chunks = 64;
+  FrameRecorder recorder(config);
+  EXPECT_TRUE(recorder.open());
+  for (const auto& frame : frames) {
+    recorder.process(frame);
+  }
+  recorder.close();
+  EXPECT_EQ(recorder.stats().frames_written, frames.size());
+  EXPECT_EQ(recorder.stats().frames_dropped, 0u);
+  return frames;
+}
+
+void expect_same(const RecordingReader& reader,
+                 const std::vector<CapturedFrame>& frames) {
+  ASSERT_EQ(reader.size(), frames.size());
+  for (size_t i = 0; i < frames.size(); ++i) {
+    auto view = reader.frame(i);
+    ASSERT_EQ(view.size, frames[i].data.size());
+    EXPECT_EQ(std::memcmp(view.data, frames[i].data.data(), view.size), 0);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(view.data) %
+                  recording::kRecordAlignment,
+              0u);
+    EXPECT_EQ(view.meta.uTimestamp, frames[i].meta.uTimestamp);
+    EXPECT_EQ(view.meta.cameraId, frames[i].meta.cameraId);
+    EXPECT_DOUBLE_EQ(view.meta.fExposure, frames[i].meta.fExposure);
+  }
+}
+
+}  // namespace
+
+// 录制后回读内容和元信息逐字节一致
+TEST(RecordingTests, RoundTripIsBitExact) {
+  const fs::path path = fs::temp_directory_path() / "cfp_roundtrip.cfpr";
+  auto frames = record_frames(path);
+
+  RecordingReader reader;
+  ASSERT_TRUE(reader.open(path.string()));
+  EXPECT_TRUE(reader.has_footer_index());
+  expect_same(reader, frames);
+  reader.close();
+  fs::remove(path);
+}
+
+// 缺少文件尾索引时通过扫描块恢复
+TEST(RecordingTests, RebuildsIndexWithoutFooter) {
+  const fs::path path = fs::temp_directory_path() / "cfp_truncated.cfpr";
+  auto frames = record_frames(path);
+
+  const auto size = fs::file_size(path);
+  const auto index_bytes = frames.size() * sizeof(recording::IndexEntry);
+  fs::resize_file(path, size - index_bytes - sizeof(recording::FileFooter));
+
+  RecordingReader reader;
+  ASSERT_TRUE(reader.open(path.string()));
+  EXPECT_FALSE(reader.has_footer_index());
+  expect_same(reader, frames);
+  reader.close();
+  fs::remove(path);
+}
+
+// 文件尾索引指向文件之外时不信任索引，改为扫描块恢复
+TEST(RecordingTests, RejectsIndexPointingOutsideFile) {
+  const fs::path path = fs::temp_directory_path() / "cfp_bad_index.cfpr";
+  auto frames = record_frames(path);
+
+  const auto size = fs::file_size(path);
+  const auto index_offset =
+      size - frames.size() * sizeof(recording::IndexEntry) -
+      sizeof(recording::FileFooter);
+  {
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    recording::IndexEntry entry{};
+    file.seekg(static_cast<std::streamoff>(index_offset));
+    file.read(reinterpret_cast<char*>(&entry), sizeof(entry));
+    entry.record_offset = size + 4096;
+    file.seekp(static_cast<std::streamoff>(index_offset));
+    file.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+  }
+
+  RecordingReader reader;
+  ASSERT_TRUE(reader.open(path.string()));
+  EXPECT_FALSE(reader.has_footer_index());
+  expect_same(reader, frames);
+  reader.close();
+  fs::remove(path);
+}
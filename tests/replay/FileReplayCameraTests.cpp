@@ -0,0 +1,187 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: FileReplayCameraTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>  //NOLINT
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include "cameras/Recording/FrameRecorder.hpp"
+#include "cameras/Recording/RecordingReader.hpp"
+#include "cameras/Replay/FileReplayCameraCapture.hpp"
+
+namespace fs = std::filesystem;
+
+// 原始帧文件按 roi 尺寸切帧，非循环模式播放一遍后结束
+TEST(FileReplayCameraTests, RawDumpPlaysOnce) {
+  const fs::path raw = fs::temp_directory_path() / "cfp_replay_test.raw";
+  {
+    std::ofstream out(raw, std::ios::binary);
+    std::vector<char> bytes(4 * 2 * 3);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      bytes[i] = static_cast<char>(i / 8);  // 每帧内容为帧序号
+    }
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+
+  ReplayConfig cfg;
+  cfg.source_path = raw.string();
+  cfg.roi_w = 4;
+  cfg.roi_h = 2;
+  cfg.mono_state = true;
+  cfg.loop = false;
+
+  FileReplayCameraCapture camera("replay0", cfg);
+  camera.set_frame_queue_enabled(true);
+  ASSERT_TRUE(camera.start());
+  while (!camera.finished()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  camera.stop();
+
+  EXPECT_EQ(camera.frames_emitted(), 3u);
+
+  std::vector<int> first_bytes;
+  std::shared_ptr<CapturedFrame> frame;
+  while (camera.get_frame_queue().try_dequeue(frame)) {
+    EXPECT_EQ(frame->width(), 4);
+    EXPECT_EQ(frame->height(), 2);
+    EXPECT_EQ(frame->camera_id(), "replay0");
+    ASSERT_EQ(frame->data.size(), 8u);
+    first_bytes.push_back(frame->data[0]);
+  }
+  EXPECT_EQ(first_bytes, (std::vector<int>{0, 1, 2}));
+
+  fs::remove(raw);
+}
+
+// 录制文件回放时保留原始元信息
+TEST(FileReplayCameraTests, RecordingKeepsOriginalMetadata) {
+  const fs::path path = fs::temp_directory_path() / "cfp_replay_test.cfpr";
+  {
+    FrameRecorderConfig config;
+    config.path = path.string();
+    FrameRecorder recorder(config);
+    ASSERT_TRUE(recorder.open());
+    for (int i = 0; i < 3; ++i) {
+      CapturedFrame frame;
+      frame.data.assign(16, static_cast<uint8_t>(i));
+      frame.meta.iWidth = 4;
+      frame.meta.iHeight = 4;
+      frame.meta.uTimestamp = 500u + i;
+      frame.meta.cameraId = "line_cam";
+      recorder.process(frame);
+    }
+    recorder.close();
+  }
+
+  ReplayConfig cfg;
+  cfg.source_path = path.string();
+  cfg.loop = false;
+  FileReplayCameraCapture camera("replay0", cfg);
+  camera.set_frame_queue_enabled(true);
+  ASSERT_TRUE(camera.start());
+  while (!camera.finished()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  camera.stop();
+
+  std::vector<uint64_t> timestamps;
+  std::shared_ptr<CapturedFrame> frame;
+  while (camera.get_frame_queue().try_dequeue(frame)) {
+    EXPECT_EQ(frame->camera_id(), "line_cam");
+    ASSERT_EQ(frame->data.size(), 16u);
+    EXPECT_EQ(frame->data[0], frame->meta.uTimestamp - 500u);
+    timestamps.push_back(frame->meta.uTimestamp);
+  }
+  EXPECT_EQ(timestamps, (std::vector<uint64_t>{500, 501, 502}));
+
+  fs::remove(path);
+}
+
+// 数据源不存在时启动失败
+TEST(FileReplayCameraTests, MissingSourceFailsToStart) {
+  ReplayConfig cfg;
+  cfg.source_path = "/nonexistent/cfp_replay";
+  FileReplayCameraCapture camera("replay0", cfg);
+  EXPECT_FALSE(camera.start());
+}
+
+// 相机按基类引用保存 clone() 出的处理器，录制器的副本仍写同一个文件
+TEST(FileReplayCameraTests, AttachedRecorderWritesFrames) {
+  const fs::path raw = fs::temp_directory_path() / "cfp_replay_record.raw";
+  const fs::path path = fs::temp_directory_path() / "cfp_replay_record.cfpr";
+  {
+    std::ofstream out(raw, std::ios::binary);
+    std::vector<char> bytes(4 * 2 * 3);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+      bytes[i] = static_cast<char>(i / 8);
+    }
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+
+  FrameRecorderConfig recorder_config;
+  recorder_config.path = path.string();
+  FrameRecorder recorder(recorder_config);
+  ASSERT_TRUE(recorder.open());
+
+  ReplayConfig cfg;
+  cfg.source_path = raw.string();
+  cfg.roi_w = 4;
+  cfg.roi_h = 2;
+  cfg.mono_state = true;
+  cfg.loop = false;
+  FileReplayCameraCapture camera("replay0", cfg);
+  camera.add_frame_processor(recorder);
+  ASSERT_TRUE(camera.start());
+  const auto deadline =
+      std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (camera.get_pipeline_stats().processed < 3 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  camera.stop();
+  recorder.close();
+  EXPECT_EQ(recorder.stats().frames_written, 3u);
+  // 没有打开预览时原始图像队列不占住帧
+  EXPECT_EQ(camera.get_frame_queue().size_approx(), 0u);
+
+  RecordingReader reader;
+  ASSERT_TRUE(reader.open(path.string()));
+  ASSERT_EQ(reader.size(), 3u);
+  for (size_t i = 0; i < reader.size(); ++i) {
+    auto view = reader.frame(i);
+    ASSERT_EQ(view.size, 8u);
+    EXPECT_EQ(view.data[0], i);
+  }
+  reader.close();
+
+  fs::remove(raw);
+  fs::remove(path);
+}
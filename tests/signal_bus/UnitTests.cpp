@@ -0,0 +1,317 @@
+/*
+ *  Copyright © 2026 [caomengxuan666]
+ *
+ *  Permission is hereby granted, free of charge, to any person obtaining a copy
+ *  of this software and associated documentation files (the “Software”), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ *  The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ *  THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ *  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *  - File: UnitTests.cpp
+ *  - Username: Administrator
+ *  - CopyrightYear: 2026
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <opencv2/core.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cameras/ImageSignalBus.hpp"
+
+// 共享投递：所有订阅者看到同一块缓冲区
+TEST(ImageSignalBusTests, SharedDeliveryDoesNotCopy) {
+  auto& bus = ImageSignalBus::instance("test_shared_delivery");
+  bus.declare_signal("img");
+
+  cv::Mat src(16, 16, CV_8UC1, cv::Scalar(7));
+  const uchar* first = nullptr;
+  const uchar* second = nullptr;
+  bus.subscribe(
+      "img", [&first](const cv::Mat& img) { first = img.data; },
+      ImageSignalBus::ImageDelivery::Shared);
+  bus.subscribe_shared("img",
+                       [&second](const ImageSignalBus::SharedImage& img) {
+                         second = img->data;
+                       });
+
+  bus.emit("img", src);
+  EXPECT_EQ(first, src.data);
+  EXPECT_EQ(second, src.data);
+}
+
+// 外部内存视图只拷贝一次，订阅者之间仍然共享
+TEST(ImageSignalBusTests, ExternalBufferCopiedOnce) {
+  auto& bus = ImageSignalBus::instance("test_external_buffer");
+  bus.declare_signal("img");
+
+  std::vector<uchar> storage(16 * 16, 3);
+  cv::Mat view(16, 16, CV_8UC1, storage.data());
+  const uchar* first = nullptr;
+  const uchar* second = nullptr;
+  bus.subscribe(
+      "img", [&first](const cv::Mat& img) { first = img.data; },
+      ImageSignalBus::ImageDelivery::Shared);
+  bus.subscribe(
+      "img", [&second](const cv::Mat& img) { second = img.data; },
+      ImageSignalBus::ImageDelivery::Shared);
+
+  bus.emit("img", view);
+  EXPECT_NE(first, storage.data());
+  EXPECT_EQ(first, second);
+}
+
+namespace {
+
+// 统计 Mat 缓冲区分配次数，实际分配仍交给 OpenCV 默认分配器
+class CountingAllocator : public cv::MatAllocator {
+ public:
+  cv::UMatData* allocate(int dims, const int* sizes, int type, void* data,
+                         size_t* step, cv::AccessFlag flags,
+                         cv::UMatUsageFlags usage) const override {
+    ++count;
+    return cv::Mat::getStdAllocator()->allocate(dims, sizes, type, data, step,
+                                                flags, usage);
+  }
+  bool allocate(cv::UMatData* data, cv::AccessFlag flags,
+                cv::UMatUsageFlags usage) const override {
+    return cv::Mat::getStdAllocator()->allocate(data, flags, usage);
+  }
+  void deallocate(cv::UMatData* data) const override {
+    cv::Mat::getStdAllocator()->deallocate(data);
+  }
+
+  mutable std::atomic<int> count{0};
+};
+
+}  // namespace
+
+// 外部内存视图：PrivateCopy 订阅者直接从视图拷贝，不再先拷一份共享缓冲区
+TEST(ImageSignalBusTests, ExternalBufferPrivateCopiesFromView) {
+  auto& bus = ImageSignalBus::instance("test_external_private_copy");
+  bus.declare_signal("img");
+
+  std::vector<uchar> storage(16 * 16, 5);
+  cv::Mat view(16, 16, CV_8UC1, storage.data());
+  std::vector<cv::Mat> received;
+  for (int i = 0; i < 2; ++i) {
+    bus.subscribe("img",
+                  [&received](const cv::Mat& img) { received.push_back(img); });
+  }
+
+  CountingAllocator counter;
+  cv::MatAllocator* previous = cv::Mat::getDefaultAllocator();
+  cv::Mat::setDefaultAllocator(&counter);
+  bus.emit("img", view);
+  cv::Mat::setDefaultAllocator(previous);
+
+  // 每个订阅者一份副本，没有多余的共享拷贝
+  EXPECT_EQ(counter.count.load(), 2);
+  ASSERT_EQ(received.size(), 2u);
+  for (const auto& img : received) {
+    EXPECT_NE(img.data, storage.data());
+    EXPECT_NE(img.u, nullptr);  // 副本自己持有缓冲区
+    EXPECT_EQ(img.at<uchar>(0, 0), 5);
+  }
+  EXPECT_NE(received[0].data, received[1].data);
+}
+
+// 默认私有副本：订阅者独占缓冲区
+TEST(ImageSignalBusTests, PrivateCopyIsIndependent) {
+  auto& bus = ImageSignalBus::instance("test_private_copy");
+  bus.declare_signal("img");
+
+  cv::Mat src(16, 16, CV_8UC1, cv::Scalar(9));
+  cv::Mat received;
+  bus.subscribe("img", [&received](const cv::Mat& img) { received = img; });
+
+  bus.emit("img", src);
+  ASSERT_FALSE(received.empty());
+  EXPECT_NE(received.data, src.data);
+  EXPECT_EQ(received.at<uchar>(0, 0), 9);
+}
+
+// 句柄与字符串接口解析到同一个信号，先订阅后声明也一样
+TEST(ImageSignalBusTests, HandleAndNameReachSameSubscribers) {
+  auto& bus = ImageSignalBus::instance("test_signal_handle");
+  int by_name = 0;
+  bus.subscribe_feature("features",
+                        [&by_name](const ImageSignalBus::FeatureData&) {
+                          ++by_name;
+                        });
+
+  auto features = bus.declare_feature("features");
+  ASSERT_TRUE(features.valid());
+  EXPECT_EQ(features.index, bus.declare_feature("features").index);
+
+  bus.emit_feature(features, ImageSignalBus::FeatureData{});
+  bus.emit_feature("features", ImageSignalBus::FeatureData{});
+  EXPECT_EQ(by_name, 2);
+
+  // 无效句柄和未声明的信号名都不会触发回调
+  bus.emit_feature(ImageSignalBus::FeatureSignal{},
+                   ImageSignalBus::FeatureData{});
+  bus.emit_feature("unknown", ImageSignalBus::FeatureData{});
+  EXPECT_EQ(by_name, 2);
+}
+
+// 回调执行时不持有总线的锁，可以在回调中继续订阅，新订阅从下一次生效
+TEST(ImageSignalBusTests, SubscribeFromCallback) {
+  auto& bus = ImageSignalBus::instance("test_signal_reentrant");
+  auto img = bus.declare_signal("img");
+
+  int outer = 0;
+  int inner = 0;
+  bus.subscribe("img", [&](const cv::Mat&) {
+    if (outer++ == 0) {
+      bus.subscribe("img", [&inner](const cv::Mat&) { ++inner; });
+    }
+  });
+
+  cv::Mat src(4, 4, CV_8UC1, cv::Scalar(1));
+  bus.emit(img, src);
+  EXPECT_EQ(inner, 0);
+  bus.emit(img, src);
+  EXPECT_EQ(outer, 2);
+  EXPECT_EQ(inner, 1);
+}
+
+// 慢订阅者只积压自己的队列，LatestOnly 只保留最新的图像
+TEST(ImageSignalBusTests, AsyncLatestOnlyDoesNotBlockEmitter) {
+  auto& bus = ImageSignalBus::instance("test_async_latest");
+  auto img = bus.declare_signal("img");
+
+  std::promise<void> release;
+  std::shared_future<void> gate = release.get_future().share();
+  std::mutex mutex;
+  std::vector<int> seen;
+  auto subscription = bus.subscribe_async(
+      "img", [&](const ImageSignalBus::SharedImage& frame) {
+        gate.wait();
+        std::lock_guard lock(mutex);
+        seen.push_back(frame->at<uchar>(0, 0));
+      });
+  ASSERT_TRUE(subscription);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 10; ++i) {
+    bus.emit(img, cv::Mat(4, 4, CV_8UC1, cv::Scalar(i)));
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(500));
+
+  release.set_value();
+  for (int i = 0; i < 200 && subscription->stats().depth > 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  subscription->stop();
+
+  // 第一帧可能已被投递线程取走，其余只剩最后一帧
+  std::lock_guard lock(mutex);
+  ASSERT_FALSE(seen.empty());
+  EXPECT_LE(seen.size(), 2u);
+  EXPECT_EQ(seen.back(), 9);
+  EXPECT_GE(subscription->stats().dropped, 8u);
+}
+
+// Lossless 按顺序投递全部特征
+TEST(ImageSignalBusTests, AsyncLosslessDeliversInOrder) {
+  auto& bus = ImageSignalBus::instance("test_async_lossless");
+  auto features = bus.declare_feature("features");
+
+  std::mutex mutex;
+  std::vector<std::string> seen;
+  auto subscription = bus.subscribe_feature_async(
+      "features", [&](const ImageSignalBus::FeatureData& data) {
+        std::lock_guard lock(mutex);
+        seen.push_back(data.roll_id);
+      });
+
+  for (int i = 0; i < 100; ++i) {
+    ImageSignalBus::FeatureData data{};
+    data.roll_id = std::to_string(i);
+    bus.emit_feature(features, data);
+  }
+  for (int i = 0; i < 200 && subscription->stats().delivered < 100; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  subscription->stop();
+
+  std::lock_guard lock(mutex);
+  ASSERT_EQ(seen.size(), 100u);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(seen[i], std::to_string(i));
+  }
+  EXPECT_EQ(subscription->stats().dropped, 0u);
+}
+
+// 回调里释放最后一个引用：析构发生在投递线程上，不能访问已释放的队列
+TEST(ImageSignalBusTests, AsyncQueueReleasedFromHandler) {
+  std::promise<void> released;
+  auto done = released.get_future();
+  std::shared_ptr<AsyncDeliveryQueue<int>> queue;
+  queue = std::make_shared<AsyncDeliveryQueue<int>>(
+      [&queue, &released](const int&) {
+        queue.reset();
+        released.set_value();
+      },
+      AsyncDeliveryConfig{});
+  queue->push(1);
+  ASSERT_EQ(done.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+  EXPECT_FALSE(queue);
+}
+
+// Lossless 积压到上限时阻塞发射线程，放行后仍按顺序全部投递
+TEST(ImageSignalBusTests, AsyncLosslessAppliesBackpressure) {
+  std::promise<void> release;
+  std::shared_future<void> gate = release.get_future().share();
+  std::mutex mutex;
+  std::vector<int> seen;
+  AsyncDeliveryQueue<int> queue(
+      [&](const int& value) {
+        gate.wait();
+        std::lock_guard lock(mutex);
+        seen.push_back(value);
+      },
+      AsyncDeliveryConfig{1, DeliveryOverflow::Lossless, 2});
+
+  auto producer = std::async(std::launch::async, [&queue]() {
+    for (int i = 0; i < 6; ++i) {
+      queue.push(i);
+    }
+  });
+  EXPECT_EQ(producer.wait_for(std::chrono::milliseconds(100)),
+            std::future_status::timeout);
+  EXPECT_LE(queue.stats().depth, 2u);
+  EXPECT_GT(queue.stats().blocked, 0u);
+
+  release.set_value();
+  producer.get();
+  for (int i = 0; i < 200 && queue.stats().delivered < 6; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  queue.stop();
+
+  std::lock_guard lock(mutex);
+  EXPECT_EQ(seen, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+  EXPECT_EQ(queue.stats().dropped, 0u);
+}